@@ -31,6 +31,7 @@
 #include "cinfo3d_visu.h"
 #include <3d_rendering/3d_render_raytracing/shapes2D/cpolygon2d.h>
 #include <class_board.h>
+#include <board_change_bus.h>
 #include <3d_math.h>
 #include "3d_fastmath.h"
 #include <colors_selection.h>
@@ -89,6 +90,16 @@ CINFO3D_VISU::CINFO3D_VISU() :
     m_calc_seg_min_factor3DU = 0.0f;
     m_calc_seg_max_factor3DU = 0.0f;
 
+    m_dirtyAll = true;
+    m_dirtyLayers.reset();
+    m_dirtyHoles = true;
+    m_dirtyModules.clear();
+
+    m_buildSerial = 0;
+    m_rebuiltAll = true;
+    m_rebuiltLayers.reset();
+    m_rebuiltHoles = true;
+    m_changedModules.clear();
 
     memset( m_layerZcoordTop, 0, sizeof( m_layerZcoordTop ) );
     memset( m_layerZcoordBottom, 0, sizeof( m_layerZcoordBottom ) );
@@ -302,19 +313,61 @@ void CINFO3D_VISU::InitSettings( REPORTER *aStatusTextReporter )
     if( ( bbbox.GetWidth() == 0 ) && ( bbbox.GetHeight() == 0 ) )
         bbbox.Inflate( Millimeter2iu( 10 ) );
 
-    m_boardSize = bbbox.GetSize();
-    m_boardPos  = bbbox.Centre();
-
-    wxASSERT( (m_boardSize.x > 0) && (m_boardSize.y > 0) );
-
-    m_boardPos.y = -m_boardPos.y; // The y coord is inverted in 3D viewer
+    wxPoint boardPos = bbbox.Centre();
 
-    m_copperLayersCount = m_board->GetCopperLayerCount();
+    boardPos.y = -boardPos.y; // The y coord is inverted in 3D viewer
 
     // Ensure the board has 2 sides for 3D views, because it is hard to find
     // a *really* single side board in the true life...
-    if( m_copperLayersCount < 2 )
-        m_copperLayersCount = 2;
+    const unsigned int copperLayersCount = std::max( m_board->GetCopperLayerCount(), 2 );
+
+    const float epoxyThickness3DU = m_board->GetDesignSettings().GetBoardThickness() *
+                                    m_biuTo3Dunits;
+
+    // As long as the scale, the outline and the stackup are the same, only the
+    // layers and holes touched by the board changes have to be built again
+    if( !m_dirtyAll &&
+        !m_dirtyLayers.test( Edge_Cuts ) &&
+        ( bbbox.GetSize() == m_boardSize ) &&
+        ( boardPos == m_boardPos ) &&
+        ( copperLayersCount == m_copperLayersCount ) &&
+        ( epoxyThickness3DU == m_epoxyThickness3DU ) )
+    {
+        m_rebuiltAll    = false;
+        m_rebuiltLayers = m_dirtyLayers;
+        m_rebuiltHoles  = m_dirtyHoles;
+        m_changedModules.swap( m_dirtyModules );
+
+        m_dirtyLayers.reset();
+        m_dirtyHoles = false;
+        m_dirtyModules.clear();
+        m_buildSerial++;
+
+        if( aStatusTextReporter )
+            aStatusTextReporter->Report( _( "Update layers" ) );
+
+        createLayers( aStatusTextReporter, m_rebuiltLayers, m_rebuiltHoles );
+
+        return;
+    }
+
+    m_rebuiltAll    = true;
+    m_rebuiltLayers = LSET::AllLayersMask();
+    m_rebuiltHoles  = true;
+    m_changedModules.clear();
+
+    m_dirtyAll = false;
+    m_dirtyLayers.reset();
+    m_dirtyHoles = false;
+    m_dirtyModules.clear();
+    m_buildSerial++;
+
+    m_boardSize = bbbox.GetSize();
+    m_boardPos  = boardPos;
+
+    wxASSERT( (m_boardSize.x > 0) && (m_boardSize.y > 0) );
+
+    m_copperLayersCount = copperLayersCount;
 
     // Calculate the convertion to apply to all positions.
     m_biuTo3Dunits = RANGE_SCALE_3D / std::max( m_boardSize.x, m_boardSize.y );
@@ -456,7 +509,7 @@ void CINFO3D_VISU::InitSettings( REPORTER *aStatusTextReporter )
     if( aStatusTextReporter )
         aStatusTextReporter->Report( _( "Create layers" ) );
 
-    createLayers( aStatusTextReporter );
+    createLayers( aStatusTextReporter, m_rebuiltLayers, m_rebuiltHoles );
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
     unsigned stats_stopCreateLayersTime = GetRunningMicroSecs();
@@ -471,6 +524,46 @@ void CINFO3D_VISU::InitSettings( REPORTER *aStatusTextReporter )
 }
 
 
+void CINFO3D_VISU::InvalidateItems( const BOARD_CHANGE_SET &aChanges )
+{
+    for( const BOARD_CHANGE& change : aChanges.Changes() )
+    {
+        LSET layers = change.m_layers;
+
+        if( change.m_change == CHT_MODIFY )
+        {
+            // The undo list does not keep a copy of a flipped item
+            if( change.m_prevLayers.any() )
+                layers |= change.m_prevLayers;
+            else
+                layers |= FlipLayerMask( change.m_layers );
+        }
+
+        m_dirtyLayers |= layers;
+
+        switch( change.m_type )
+        {
+        case PCB_MODULE_T:
+            m_dirtyModules.insert( change.m_item );
+            break;
+
+        case PCB_VIA_T:
+            m_dirtyHoles = true;
+            break;
+
+        case PCB_PAD_T:
+            // Only a SMD pad is on a single copper layer
+            if( ( layers & LSET::AllCuMask() ).count() != 1 )
+                m_dirtyHoles = true;
+            break;
+
+        default:
+            break;
+        }
+    }
+}
+
+
 void CINFO3D_VISU::createBoardPolygon()
 {
     m_board_poly.RemoveAllContours();
@@ -30,6 +30,7 @@
 #ifndef CINFO3D_VISU_H
 #define CINFO3D_VISU_H
 
+#include <set>
 #include <vector>
 #include "../3d_rendering/3d_render_raytracing/accelerators/ccontainer2d.h"
 #include "../3d_rendering/3d_render_raytracing/accelerators/ccontainer.h"
@@ -61,6 +62,9 @@ typedef std::map< LAYER_ID, SHAPE_POLY_SET *> MAP_POLY;
 /// -(RANGE_SCALE_3D/2) .. +(RANGE_SCALE_3D/2)
 #define RANGE_SCALE_3D 8.0f
 
+class BOARD_CHANGE_SET;
+class BOARD_ITEMS_BY_LAYER;
+
 
 /**
  *  Class CINFO3D_VISU
@@ -118,7 +122,13 @@ class CINFO3D_VISU
      * @brief SetBoard - Set current board to be rendered
      * @param aBoard: board to process
      */
-    void SetBoard( BOARD *aBoard ) { m_board = aBoard; }
+    void SetBoard( BOARD *aBoard )
+    {
+        if( aBoard != m_board )
+            m_dirtyAll = true;
+
+        m_board = aBoard;
+    }
 
     /**
      * @brief GetBoard - Get current board to be rendered
@@ -133,6 +143,52 @@ class CINFO3D_VISU
      */
     void InitSettings( REPORTER *aStatusTextReporter );
 
+    /**
+     * @brief InvalidateAll - The next InitSettings will build everything again
+     */
+    void InvalidateAll() { m_dirtyAll = true; }
+
+    /**
+     * @brief InvalidateItems - Mark the layers, holes and footprints touched by
+     * board changes, so the next InitSettings only builds them again
+     * @param aChanges: the changes of the board since the last InitSettings
+     */
+    void InvalidateItems( const BOARD_CHANGE_SET &aChanges );
+
+    /**
+     * @brief GetBuildSerial - Get a number incremented by each InitSettings, so a
+     * render can tell if the settings were last built for it
+     * @return the serial number of the last build
+     */
+    unsigned int GetBuildSerial() const { return m_buildSerial; }
+
+    /**
+     * @brief WasFullyRebuilt - Check what the last InitSettings built
+     * @return true if everything was built, false if it only built the layers
+     * and holes reported by GetRebuiltLayers and WereHolesRebuilt
+     */
+    bool WasFullyRebuilt() const { return m_rebuiltAll; }
+
+    /**
+     * @brief GetRebuiltLayers - Get the layers built by the last InitSettings
+     * @return the layers whose containers and polygons were created again
+     */
+    const LSET &GetRebuiltLayers() const { return m_rebuiltLayers; }
+
+    /**
+     * @brief WereHolesRebuilt - Check if the last InitSettings built the holes
+     * @return true if the through holes and the layers holes were created again
+     */
+    bool WereHolesRebuilt() const { return m_rebuiltHoles; }
+
+    /**
+     * @brief GetChangedModules - Get the footprints changed since the previous
+     * InitSettings, when it did not build everything
+     * @return the footprints, some of them may no more be on the board so they
+     * must not be dereferenced
+     */
+    const std::set< const BOARD_ITEM * > &GetChangedModules() const { return m_changedModules; }
+
     /**
      * @brief BiuTo3Dunits - Board integer units To 3D units
      * @return the conversion factor to transform a position from the board to 3d units
@@ -418,8 +474,12 @@ class CINFO3D_VISU
 
  private:
     void createBoardPolygon();
-    void createLayers( REPORTER *aStatusTextReporter );
+    void createLayers( REPORTER *aStatusTextReporter, const LSET &aLayers, bool aHoles );
+    void createHoles( const BOARD_ITEMS_BY_LAYER &aByLayer,
+                      const std::vector< LAYER_ID > &aCopperLayers );
     void destroyLayers();
+    void destroyLayer( LAYER_ID aLayerId );
+    void destroyHoles();
 
     // Helper functions to create the board
     COBJECT2D *createNewTrack( const TRACK* aTrack , int aClearanceValue ) const;
@@ -527,6 +587,30 @@ class CINFO3D_VISU
     MATERIAL_MODE       m_material_mode;
 
 
+    // Board changes
+
+    /// everything must be built again
+    bool                m_dirtyAll;
+
+    /// layers to build again
+    LSET                m_dirtyLayers;
+
+    /// the holes must be built again
+    bool                m_dirtyHoles;
+
+    /// footprints changed since the last build
+    std::set< const BOARD_ITEM * > m_dirtyModules;
+
+    /// incremented on each build
+    unsigned int        m_buildSerial;
+
+    /// what the last build created again
+    bool                m_rebuiltAll;
+    LSET                m_rebuiltLayers;
+    bool                m_rebuiltHoles;
+    std::set< const BOARD_ITEM * > m_changedModules;
+
+
     // Pcb board position
 
     /// center board actual position in board units
@@ -1039,43 +1039,69 @@ void CINFO3D_VISU::destroyLayers()
         m_layers_poly.clear();
     }
 
-    if( !m_layers_inner_holes_poly.empty() )
+    if( !m_layers_container2D.empty() )
     {
-        for( MAP_POLY::iterator ii = m_layers_inner_holes_poly.begin();
-             ii != m_layers_inner_holes_poly.end();
+        for( MAP_CONTAINER_2D::iterator ii = m_layers_container2D.begin();
+             ii != m_layers_container2D.end();
              ++ii )
         {
             delete ii->second;
             ii->second = NULL;
         }
 
-        m_layers_inner_holes_poly.clear();
+        m_layers_container2D.clear();
     }
 
-    if( !m_layers_outer_holes_poly.empty() )
+    destroyHoles();
+}
+
+
+void CINFO3D_VISU::destroyLayer( LAYER_ID aLayerId )
+{
+    MAP_POLY::iterator poly = m_layers_poly.find( aLayerId );
+
+    if( poly != m_layers_poly.end() )
     {
-        for( MAP_POLY::iterator ii = m_layers_outer_holes_poly.begin();
-             ii != m_layers_outer_holes_poly.end();
+        delete poly->second;
+        m_layers_poly.erase( poly );
+    }
+
+    MAP_CONTAINER_2D::iterator container = m_layers_container2D.find( aLayerId );
+
+    if( container != m_layers_container2D.end() )
+    {
+        delete container->second;
+        m_layers_container2D.erase( container );
+    }
+}
+
+
+void CINFO3D_VISU::destroyHoles()
+{
+    if( !m_layers_inner_holes_poly.empty() )
+    {
+        for( MAP_POLY::iterator ii = m_layers_inner_holes_poly.begin();
+             ii != m_layers_inner_holes_poly.end();
              ++ii )
         {
             delete ii->second;
             ii->second = NULL;
         }
 
-        m_layers_outer_holes_poly.clear();
+        m_layers_inner_holes_poly.clear();
     }
 
-    if( !m_layers_container2D.empty() )
+    if( !m_layers_outer_holes_poly.empty() )
     {
-        for( MAP_CONTAINER_2D::iterator ii = m_layers_container2D.begin();
-             ii != m_layers_container2D.end();
+        for( MAP_POLY::iterator ii = m_layers_outer_holes_poly.begin();
+             ii != m_layers_outer_holes_poly.end();
              ++ii )
         {
             delete ii->second;
             ii->second = NULL;
         }
 
-        m_layers_container2D.clear();
+        m_layers_outer_holes_poly.clear();
     }
 
     if( !m_layers_holes2D.empty() )
@@ -1104,7 +1130,9 @@ void CINFO3D_VISU::destroyLayers()
 }
 
 
-void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
+void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter,
+                                 const LSET &aLayers,
+                                 bool aHoles )
 {
     // Number of segments to draw a circle using segments (used on countour zones
     // and text copper elements )
@@ -1117,7 +1145,11 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     const int segcountInStrokeFont  = 12;
     const double correctionFactorStroke = GetCircleCorrectionFactor( segcountInStrokeFont );
 
-    destroyLayers();
+    if( aHoles )
+        destroyHoles();
+
+    for( LSEQ seq = aLayers.Seq(); seq; ++seq )
+        destroyLayer( *seq );
 
     // Build Copper layers
     // Based on: https://github.com/KiCad/kicad-source-mirror/blob/master/3d-viewer/3d_draw.cpp#L692
@@ -1136,15 +1168,13 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     m_stats_track_med_width         = 0;
     m_stats_nr_vias                 = 0;
     m_stats_via_med_hole_diameter   = 0;
-    m_stats_nr_holes                = 0;
-    m_stats_hole_med_diameter       = 0;
 
-    // Prepare track list, convert in a vector. Calc statistic for the holes
+    // Bucket the board items by layer, so each layer pass below only visits its own items
     // /////////////////////////////////////////////////////////////////////////
-    std::vector< const TRACK *> trackList;
-    trackList.clear();
-    trackList.reserve( m_board->m_Track.GetCount() );
+    const BOARD_ITEMS_BY_LAYER byLayer( m_board );
 
+    // Calc statistic for the holes
+    // /////////////////////////////////////////////////////////////////////////
     for( const TRACK* track = m_board->m_Track; track; track = track->Next() )
     {
         if( !Is3DLayerEnabled( track->GetLayer() ) ) // Skip non enabled layers
@@ -1152,7 +1182,6 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
         // Note: a TRACK holds normal segment tracks and
         // also vias circles (that have also drill values)
-        trackList.push_back( track );
 
         if( track->Type() == PCB_VIA_T )
         {
@@ -1185,6 +1214,10 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     layer_id.clear();
     layer_id.reserve( m_copperLayersCount );
 
+    // All the enabled copper layers, even the ones not rebuilt, for the holes
+    std::vector< LAYER_ID > cu_layers;
+    cu_layers.reserve( m_copperLayersCount );
+
     for( unsigned i = 0; i < DIM( cu_seq ); ++i )
         cu_seq[i] = ToLAYER_ID( B_Cu - i );
 
@@ -1195,6 +1228,11 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
         if( !Is3DLayerEnabled( curr_layer_id ) ) // Skip non enabled layers
             continue;
 
+        cu_layers.push_back( curr_layer_id );
+
+        if( !aLayers.test( curr_layer_id ) )
+            continue;
+
         layer_id.push_back( curr_layer_id );
 
         CBVHCONTAINER2D *layerContainer = new CBVHCONTAINER2D;
@@ -1227,14 +1265,10 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
         CBVHCONTAINER2D *layerContainer = m_layers_container2D[curr_layer_id];
 
         // ADD TRACKS
-        unsigned int nTracks = trackList.size();
-
-        for( unsigned int trackIdx = 0; trackIdx < nTracks; ++trackIdx )
+        for( const TRACK* track : byLayer.Tracks( curr_layer_id ) )
         {
-            const TRACK *track = trackList[trackIdx];
-
             // NOTE: Vias can be on multiple layers
-            if( !track->IsOnLayer( curr_layer_id ) )
+            if( !Is3DLayerEnabled( track->GetLayer() ) ) // Skip non enabled layers
                 continue;
 
             // Add object item to layer container
@@ -1247,199 +1281,77 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     start_Time = GetRunningMicroSecs();
 #endif
 
-    // Create VIAS and THTs objects and add it to holes containers
+    // Creates outline contours of the tracks and add it to the poly of the layer
     // /////////////////////////////////////////////////////////////////////////
-    for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
+    if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) &&
+        (m_render_engine == RENDER_ENGINE_OPENGL_LEGACY) )
     {
-        const LAYER_ID curr_layer_id = layer_id[lIdx];
-
-        // ADD TRACKS
-        unsigned int nTracks = trackList.size();
-
-        for( unsigned int trackIdx = 0; trackIdx < nTracks; ++trackIdx )
+        for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
         {
-            const TRACK *track = trackList[trackIdx];
-
-            if( !track->IsOnLayer( curr_layer_id ) )
-                continue;
-
-            // ADD VIAS and THT
-            if( track->Type() == PCB_VIA_T )
-            {
-                const VIA *via = static_cast< const VIA*>( track );
-                const VIATYPE_T viatype = via->GetViaType();
-                const float holediameter = via->GetDrillValue() * BiuTo3Dunits();
-                const float thickness = GetCopperThickness3DU();
-                const float hole_inner_radius = ( holediameter / 2.0f );
-
-                const SFVEC2F via_center(  via->GetStart().x * m_biuTo3Dunits,
-                                          -via->GetStart().y * m_biuTo3Dunits );
-
-                if( viatype != VIA_THROUGH )
-                {
-
-                    // Add hole objects
-                    // /////////////////////////////////////////////////////////
-
-                    CBVHCONTAINER2D *layerHoleContainer = NULL;
+            const LAYER_ID curr_layer_id = layer_id[lIdx];
 
-                    // Check if the layer is already created
-                    if( m_layers_holes2D.find( curr_layer_id ) == m_layers_holes2D.end() )
-                    {
-                        // not found, create a new container
-                        layerHoleContainer = new CBVHCONTAINER2D;
-                        m_layers_holes2D[curr_layer_id] = layerHoleContainer;
-                    }
-                    else
-                    {
-                        // found
-                        layerHoleContainer = m_layers_holes2D[curr_layer_id];
-                    }
+            wxASSERT( m_layers_poly.find( curr_layer_id ) != m_layers_poly.end() );
 
-                    // Add a hole for this layer
-                    layerHoleContainer->Add( new CFILLEDCIRCLE2D( via_center,
-                                                                  hole_inner_radius + thickness,
-                                                                  *track ) );
-                }
-                else if( lIdx == 0 ) // it only adds once the THT holes
-                {
-                    // Add through hole object
-                    // /////////////////////////////////////////////////////////
-                    m_through_holes_outer.Add( new CFILLEDCIRCLE2D( via_center,
-                                                                    hole_inner_radius + thickness,
-                                                                    *track ) );
+            SHAPE_POLY_SET *layerPoly = m_layers_poly[curr_layer_id];
 
-                    m_through_holes_vias_outer.Add(
-                                new CFILLEDCIRCLE2D( via_center,
-                                                     hole_inner_radius + thickness,
-                                                     *track ) );
+            // ADD TRACKS
+            for( const TRACK* track : byLayer.Tracks( curr_layer_id ) )
+            {
+                if( !Is3DLayerEnabled( track->GetLayer() ) ) // Skip non enabled layers
+                    continue;
 
-                    m_through_holes_inner.Add( new CFILLEDCIRCLE2D( via_center,
-                                                                    hole_inner_radius,
-                                                                    *track ) );
+                // Add the track contour
+                int nrSegments = GetNrSegmentsCircle( track->GetWidth() );
 
-                    //m_through_holes_vias_inner.Add( new CFILLEDCIRCLE2D( via_center,
-                    //                                                     hole_inner_radius,
-                    //                                                     *track ) );
-                }
+                track->TransformShapeWithClearanceToPolygon(
+                            *layerPoly,
+                            0,
+                            nrSegments,
+                            GetCircleCorrectionFactor( nrSegments ) );
             }
         }
     }
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T04: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
+    printf( "T06: %.3f ms\n", (float)( GetRunningMicroSecs()  - start_Time  ) / 1e3 );
     start_Time = GetRunningMicroSecs();
 #endif
 
-    // Create VIAS and THTs objects and add it to holes containers
+    // Add modules PADs objects to containers
     // /////////////////////////////////////////////////////////////////////////
     for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
     {
         const LAYER_ID curr_layer_id = layer_id[lIdx];
 
-        // ADD TRACKS
-        const unsigned int nTracks = trackList.size();
-
-        for( unsigned int trackIdx = 0; trackIdx < nTracks; ++trackIdx )
-        {
-            const TRACK *track = trackList[trackIdx];
-
-            if( !track->IsOnLayer( curr_layer_id ) )
-                continue;
-
-            // ADD VIAS and THT
-            if( track->Type() == PCB_VIA_T )
-            {
-                const VIA *via = static_cast< const VIA*>( track );
-                const VIATYPE_T viatype = via->GetViaType();
-
-                if( viatype != VIA_THROUGH )
-                {
-
-                    // Add VIA hole contourns
-                    // /////////////////////////////////////////////////////////
-
-                    // Add outter holes of VIAs
-                    SHAPE_POLY_SET *layerOuterHolesPoly = NULL;
-                    SHAPE_POLY_SET *layerInnerHolesPoly = NULL;
-
-                    // Check if the layer is already created
-                    if( m_layers_outer_holes_poly.find( curr_layer_id ) ==
-                        m_layers_outer_holes_poly.end() )
-                    {
-                        // not found, create a new container
-                        layerOuterHolesPoly = new SHAPE_POLY_SET;
-                        m_layers_outer_holes_poly[curr_layer_id] = layerOuterHolesPoly;
-
-                        wxASSERT( m_layers_inner_holes_poly.find( curr_layer_id ) ==
-                                  m_layers_inner_holes_poly.end() );
-
-                        layerInnerHolesPoly = new SHAPE_POLY_SET;
-                        m_layers_inner_holes_poly[curr_layer_id] = layerInnerHolesPoly;
-                    }
-                    else
-                    {
-                        // found
-                        layerOuterHolesPoly = m_layers_outer_holes_poly[curr_layer_id];
-
-                        wxASSERT( m_layers_inner_holes_poly.find( curr_layer_id ) !=
-                                  m_layers_inner_holes_poly.end() );
-
-                        layerInnerHolesPoly = m_layers_inner_holes_poly[curr_layer_id];
-                    }
-
-                    const int holediameter = via->GetDrillValue();
-                    const int hole_outer_radius = (holediameter / 2) + GetCopperThicknessBIU();
-
-                    TransformCircleToPolygon( *layerOuterHolesPoly,
-                                              via->GetStart(),
-                                              hole_outer_radius,
-                                              GetNrSegmentsCircle( hole_outer_radius * 2 ) );
-
-                    TransformCircleToPolygon( *layerInnerHolesPoly,
-                                              via->GetStart(),
-                                              holediameter / 2,
-                                              GetNrSegmentsCircle( holediameter ) );
-                }
-                else if( lIdx == 0 ) // it only adds once the THT holes
-                {
-                    const int holediameter = via->GetDrillValue();
-                    const int hole_outer_radius = (holediameter / 2)+ GetCopperThicknessBIU();
-
-                    // Add through hole contourns
-                    // /////////////////////////////////////////////////////////
-                    TransformCircleToPolygon( m_through_outer_holes_poly,
-                                              via->GetStart(),
-                                              hole_outer_radius,
-                                              GetNrSegmentsCircle( hole_outer_radius * 2 ) );
-
-                    TransformCircleToPolygon( m_through_inner_holes_poly,
-                                              via->GetStart(),
-                                              holediameter / 2,
-                                              GetNrSegmentsCircle( holediameter ) );
+        wxASSERT( m_layers_container2D.find( curr_layer_id ) != m_layers_container2D.end() );
 
-                    // Add samething for vias only
+        CBVHCONTAINER2D *layerContainer = m_layers_container2D[curr_layer_id];
 
-                    TransformCircleToPolygon( m_through_outer_holes_vias_poly,
-                                              via->GetStart(),
-                                              hole_outer_radius,
-                                              GetNrSegmentsCircle( hole_outer_radius * 2 ) );
+        // ADD PADS
+        for( const MODULE* module = m_board->m_Modules; module; module = module->Next() )
+        {
+            // Note: NPTH pads are not drawn on copper layers when the pad
+            // has same shape as its hole
+            AddPadsShapesWithClearanceToContainer( module,
+                                                   layerContainer,
+                                                   curr_layer_id,
+                                                   0,
+                                                   true );
 
-                    //TransformCircleToPolygon( m_through_inner_holes_vias_poly,
-                    //                          via->GetStart(),
-                    //                          holediameter / 2,
-                    //                          GetNrSegmentsCircle( holediameter ) );
-                }
-            }
+            // Micro-wave modules may have items on copper layers
+            AddGraphicsShapesWithClearanceToContainer( module,
+                                                       layerContainer,
+                                                       curr_layer_id,
+                                                       0 );
         }
     }
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T05: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
+    printf( "T09: %.3f ms\n", (float)( GetRunningMicroSecs()  - start_Time  ) / 1e3 );
     start_Time = GetRunningMicroSecs();
 #endif
 
-    // Creates outline contours of the tracks and add it to the poly of the layer
+    // Add modules PADs poly contourns
     // /////////////////////////////////////////////////////////////////////////
     if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) &&
         (m_render_engine == RENDER_ENGINE_OPENGL_LEGACY) )
@@ -1452,176 +1364,21 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
             SHAPE_POLY_SET *layerPoly = m_layers_poly[curr_layer_id];
 
-            // ADD TRACKS
-            unsigned int nTracks = trackList.size();
-
-            for( unsigned int trackIdx = 0; trackIdx < nTracks; ++trackIdx )
+            // ADD PADS
+            for( const MODULE* module = m_board->m_Modules;
+                 module;
+                 module = module->Next() )
             {
-                const TRACK *track = trackList[trackIdx];
+                // Construct polys
+                // /////////////////////////////////////////////////////////////
 
-                if( !track->IsOnLayer( curr_layer_id ) )
-                    continue;
-
-                // Add the track contour
-                int nrSegments = GetNrSegmentsCircle( track->GetWidth() );
-
-                track->TransformShapeWithClearanceToPolygon(
-                            *layerPoly,
-                            0,
-                            nrSegments,
-                            GetCircleCorrectionFactor( nrSegments ) );
-            }
-        }
-    }
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T06: %.3f ms\n", (float)( GetRunningMicroSecs()  - start_Time  ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
-
-    // Add holes of modules
-    // /////////////////////////////////////////////////////////////////////////
-    for( const MODULE* module = m_board->m_Modules; module; module = module->Next() )
-    {
-        const D_PAD* pad = module->Pads();
-
-        for( ; pad; pad = pad->Next() )
-        {
-            const wxSize padHole = pad->GetDrillSize();
-
-            if( !padHole.x )    // Not drilled pad like SMD pad
-                continue;
-
-            // The hole in the body is inflated by copper thickness,
-            // if not plated, no copper
-            const int inflate = (pad->GetAttribute () != PAD_ATTRIB_HOLE_NOT_PLATED) ?
-                                GetCopperThicknessBIU() : 0;
-
-            m_stats_nr_holes++;
-            m_stats_hole_med_diameter += ( ( pad->GetDrillSize().x +
-                                             pad->GetDrillSize().y ) / 2.0f ) * m_biuTo3Dunits;
-
-            m_through_holes_outer.Add( createNewPadDrill( pad, inflate ) );
-            m_through_holes_inner.Add( createNewPadDrill( pad,       0 ) );
-        }
-    }
-    if( m_stats_nr_holes )
-        m_stats_hole_med_diameter /= (float)m_stats_nr_holes;
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T07: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
-
-    // Add contours of the pad holes (pads can be Circle or Segment holes)
-    // /////////////////////////////////////////////////////////////////////////
-    for( const MODULE* module = m_board->m_Modules; module; module = module->Next() )
-    {
-        const D_PAD* pad = module->Pads();
-
-        for( ; pad; pad = pad->Next() )
-        {
-            const wxSize padHole = pad->GetDrillSize();
-
-            if( !padHole.x ) // Not drilled pad like SMD pad
-                continue;
-
-            // The hole in the body is inflated by copper thickness.
-            const int inflate = GetCopperThicknessBIU();
-
-            // we use the hole diameter to calculate the seg count.
-            // for round holes, padHole.x == padHole.y
-            // for oblong holes, the diameter is the smaller of (padHole.x, padHole.y)
-            const int diam = std::min( padHole.x, padHole.y );
-
-
-            if( pad->GetAttribute () != PAD_ATTRIB_HOLE_NOT_PLATED )
-            {
-                pad->BuildPadDrillShapePolygon( m_through_outer_holes_poly,
-                                                inflate,
-                                                GetNrSegmentsCircle( diam ) );
-
-                pad->BuildPadDrillShapePolygon( m_through_inner_holes_poly,
-                                                0,
-                                                GetNrSegmentsCircle( diam ) );
-            }
-            else
-            {
-                // If not plated, no copper.
-                pad->BuildPadDrillShapePolygon( m_through_outer_holes_poly_NPTH,
-                                                inflate,
-                                                GetNrSegmentsCircle( diam ) );
-            }
-        }
-    }
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T08: %.3f ms\n", (float)( GetRunningMicroSecs()  - start_Time  ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
-
-    // Add modules PADs objects to containers
-    // /////////////////////////////////////////////////////////////////////////
-    for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
-    {
-        const LAYER_ID curr_layer_id = layer_id[lIdx];
-
-        wxASSERT( m_layers_container2D.find( curr_layer_id ) != m_layers_container2D.end() );
-
-        CBVHCONTAINER2D *layerContainer = m_layers_container2D[curr_layer_id];
-
-        // ADD PADS
-        for( const MODULE* module = m_board->m_Modules; module; module = module->Next() )
-        {
-            // Note: NPTH pads are not drawn on copper layers when the pad
-            // has same shape as its hole
-            AddPadsShapesWithClearanceToContainer( module,
-                                                   layerContainer,
-                                                   curr_layer_id,
-                                                   0,
-                                                   true );
-
-            // Micro-wave modules may have items on copper layers
-            AddGraphicsShapesWithClearanceToContainer( module,
-                                                       layerContainer,
-                                                       curr_layer_id,
-                                                       0 );
-        }
-    }
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T09: %.3f ms\n", (float)( GetRunningMicroSecs()  - start_Time  ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
-
-    // Add modules PADs poly contourns
-    // /////////////////////////////////////////////////////////////////////////
-    if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) &&
-        (m_render_engine == RENDER_ENGINE_OPENGL_LEGACY) )
-    {
-        for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
-        {
-            const LAYER_ID curr_layer_id = layer_id[lIdx];
-
-            wxASSERT( m_layers_poly.find( curr_layer_id ) != m_layers_poly.end() );
-
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[curr_layer_id];
-
-            // ADD PADS
-            for( const MODULE* module = m_board->m_Modules;
-                 module;
-                 module = module->Next() )
-            {
-                // Construct polys
-                // /////////////////////////////////////////////////////////////
-
-                // Note: NPTH pads are not drawn on copper layers when the pad
-                // has same shape as its hole
-                transformPadsShapesWithClearanceToPolygon( module->Pads(),
-                                                           curr_layer_id,
-                                                           *layerPoly,
-                                                           0,
-                                                           true );
+                // Note: NPTH pads are not drawn on copper layers when the pad
+                // has same shape as its hole
+                transformPadsShapesWithClearanceToPolygon( module->Pads(),
+                                                           curr_layer_id,
+                                                           *layerPoly,
+                                                           0,
+                                                           true );
 
                 // Micro-wave modules may have items on copper layers
                 module->TransformGraphicTextWithClearanceToPolygonSet( curr_layer_id,
@@ -1651,13 +1408,8 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
         CBVHCONTAINER2D *layerContainer = m_layers_container2D[curr_layer_id];
 
         // ADD GRAPHIC ITEMS ON COPPER LAYERS (texts)
-        for( const BOARD_ITEM* item = m_board->m_Drawings;
-             item;
-             item = item->Next() )
+        for( const BOARD_ITEM* item : byLayer.Drawings( curr_layer_id ) )
         {
-            if( !item->IsOnLayer( curr_layer_id ) )
-                continue;
-
             switch( item->Type() )
             {
             case PCB_LINE_T:  // should not exist on copper layers
@@ -1704,13 +1456,8 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
             SHAPE_POLY_SET *layerPoly = m_layers_poly[curr_layer_id];
 
             // ADD GRAPHIC ITEMS ON COPPER LAYERS (texts)
-            for( const BOARD_ITEM* item = m_board->m_Drawings;
-                 item;
-                 item = item->Next() )
+            for( const BOARD_ITEM* item : byLayer.Drawings( curr_layer_id ) )
             {
-                if( !item->IsOnLayer( curr_layer_id ) )
-                    continue;
-
                 switch( item->Type() )
                 {
                 case PCB_LINE_T: // should not exist on copper layers
@@ -1769,17 +1516,11 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
             CBVHCONTAINER2D *layerContainer = m_layers_container2D[curr_layer_id];
 
             // ADD COPPER ZONES
-            for( int ii = 0; ii < m_board->GetAreaCount(); ++ii )
+            for( const ZONE_CONTAINER* zone : byLayer.Zones( curr_layer_id ) )
             {
-                const ZONE_CONTAINER* zone = m_board->GetArea( ii );
-                const LAYER_ID zonelayer = zone->GetLayer();
-
-                if( zonelayer == curr_layer_id )
-                {
-                    AddSolidAreasShapesToContainer( zone,
-                                                    layerContainer,
-                                                    curr_layer_id );
-                }
+                AddSolidAreasShapesToContainer( zone,
+                                                layerContainer,
+                                                curr_layer_id );
             }
         }
     }
@@ -1804,17 +1545,11 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
             SHAPE_POLY_SET *layerPoly = m_layers_poly[curr_layer_id];
 
             // ADD COPPER ZONES
-            for( int ii = 0; ii < m_board->GetAreaCount(); ++ii )
+            for( const ZONE_CONTAINER* zone : byLayer.Zones( curr_layer_id ) )
             {
-                const ZONE_CONTAINER* zone = m_board->GetArea( ii );
-                const LAYER_NUM zonelayer = zone->GetLayer();
-
-                if( zonelayer == curr_layer_id )
-                {
-                    zone->TransformSolidAreasShapesToPolygonSet( *layerPoly,
-                                                                 segcountforcircle,
-                                                                 correctionFactor );
-                }
+                zone->TransformSolidAreasShapesToPolygonSet( *layerPoly,
+                                                             segcountforcircle,
+                                                             correctionFactor );
             }
         }
     }
@@ -1853,46 +1588,9 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
     printf( "T15: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
-
-    // Simplify holes polygon contours
-    // /////////////////////////////////////////////////////////////////////////
-    if( aStatusTextReporter )
-        aStatusTextReporter->Report( _( "Simplify holes contours" ) );
-
-    for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
-    {
-        const LAYER_ID curr_layer_id = layer_id[lIdx];
-
-        if( m_layers_outer_holes_poly.find( curr_layer_id ) !=
-            m_layers_outer_holes_poly.end() )
-        {
-            // found
-            SHAPE_POLY_SET *polyLayer = m_layers_outer_holes_poly[curr_layer_id];
-            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
-
-            wxASSERT( m_layers_inner_holes_poly.find( curr_layer_id ) !=
-                      m_layers_inner_holes_poly.end() );
-
-            polyLayer = m_layers_inner_holes_poly[curr_layer_id];
-            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
-        }
-    }
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T16: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time ) / 1e3 );
 #endif
     // End Build Copper layers
 
-
-    // This will make a union of all added contourns
-    m_through_inner_holes_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_through_outer_holes_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_through_outer_holes_poly_NPTH.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_through_outer_holes_vias_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
-    //m_through_inner_holes_vias_poly.Simplify( SHAPE_POLY_SET::PM_FAST ); // Not in use
-
 #ifdef PRINT_STATISTICS_3D_VIEWER
     unsigned stats_endCopperLayersTime = GetRunningMicroSecs();
 #endif
@@ -1929,7 +1627,7 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
         };
 
     // User layers are not drawn here, only technical layers
-    for( LSEQ seq = LSET::AllNonCuMask().Seq( teckLayerList, DIM( teckLayerList ) );
+    for( LSEQ seq = ( LSET::AllNonCuMask() & aLayers ).Seq( teckLayerList, DIM( teckLayerList ) );
          seq;
          ++seq )
     {
@@ -1946,11 +1644,8 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
         // Add drawing objects
         // /////////////////////////////////////////////////////////////////////
-        for( BOARD_ITEM* item = m_board->m_Drawings; item; item = item->Next() )
+        for( const BOARD_ITEM* item : byLayer.Drawings( curr_layer_id ) )
         {
-            if( !item->IsOnLayer( curr_layer_id ) )
-                continue;
-
             switch( item->Type() )
             {
             case PCB_LINE_T:
@@ -1975,11 +1670,8 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
         // Add drawing contours
         // /////////////////////////////////////////////////////////////////////
-        for( BOARD_ITEM* item = m_board->m_Drawings; item; item = item->Next() )
+        for( const BOARD_ITEM* item : byLayer.Drawings( curr_layer_id ) )
         {
-            if( !item->IsOnLayer( curr_layer_id ) )
-                continue;
-
             switch( item->Type() )
             {
             case PCB_LINE_T:
@@ -2085,25 +1777,15 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
         // /////////////////////////////////////////////////////////////////////
         if( GetFlag( FL_ZONE ) )
         {
-            for( int ii = 0; ii < m_board->GetAreaCount(); ++ii )
+            for( const ZONE_CONTAINER* zone : byLayer.Zones( curr_layer_id ) )
             {
-                ZONE_CONTAINER* zone = m_board->GetArea( ii );
-
-                if( !zone->IsOnLayer( curr_layer_id ) )
-                    continue;
-
                 AddSolidAreasShapesToContainer( zone,
                                                 layerContainer,
                                                 curr_layer_id );
             }
 
-            for( int ii = 0; ii < m_board->GetAreaCount(); ++ii )
+            for( const ZONE_CONTAINER* zone : byLayer.Zones( curr_layer_id ) )
             {
-                ZONE_CONTAINER* zone = m_board->GetArea( ii );
-
-                if( !zone->IsOnLayer( curr_layer_id ) )
-                    continue;
-
                 zone->TransformSolidAreasShapesToPolygonSet( *layerPoly,
                                                              // Use the same segcount as stroke font
                                                              segcountInStrokeFont,
@@ -2121,42 +1803,23 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 #endif
 
 
-    // Build BVH for holes and vias
+    // Build the holes, shared by the copper layers
     // /////////////////////////////////////////////////////////////////////////
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    unsigned stats_startHolesBVHTime = GetRunningMicroSecs();
-#endif
-
-    m_through_holes_inner.BuildBVH();
-    m_through_holes_outer.BuildBVH();
-
-    if( !m_layers_holes2D.empty() )
-    {
-        for( MAP_CONTAINER_2D::iterator ii = m_layers_holes2D.begin();
-             ii != m_layers_holes2D.end();
-             ++ii )
-        {
-            ((CBVHCONTAINER2D *)(ii->second))->BuildBVH();
-        }
-    }
+    if( aHoles )
+        createHoles( byLayer, cu_layers );
 
     // We only need the Solder mask to initialize the BVH
     // because..?
-    if( (CBVHCONTAINER2D *)m_layers_container2D[B_Mask] )
+    if( aLayers.test( B_Mask ) && (CBVHCONTAINER2D *)m_layers_container2D[B_Mask] )
         ((CBVHCONTAINER2D *)m_layers_container2D[B_Mask])->BuildBVH();
 
-    if( (CBVHCONTAINER2D *)m_layers_container2D[F_Mask] )
+    if( aLayers.test( F_Mask ) && (CBVHCONTAINER2D *)m_layers_container2D[F_Mask] )
         ((CBVHCONTAINER2D *)m_layers_container2D[F_Mask])->BuildBVH();
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
-    unsigned stats_endHolesBVHTime = GetRunningMicroSecs();
-
     printf( "CINFO3D_VISU::createLayers times\n" );
     printf( "  Copper Layers:          %.3f ms\n",
             (float)( stats_endCopperLayersTime  - stats_startCopperLayersTime  ) / 1e3 );
-    printf( "  Holes BVH creation:     %.3f ms\n",
-            (float)( stats_endHolesBVHTime      - stats_startHolesBVHTime      ) / 1e3 );
     printf( "  Tech Layers:            %.3f ms\n",
             (float)( stats_endTechLayersTime    - stats_startTechLayersTime    ) / 1e3 );
     printf( "Statistics:\n" );
@@ -2169,3 +1832,346 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     printf( "  m_calc_seg_max_factor3DU      (3DU) %f\n", m_calc_seg_max_factor3DU );
 #endif
 }
+
+
+void CINFO3D_VISU::createHoles( const BOARD_ITEMS_BY_LAYER &aByLayer,
+                                const std::vector< LAYER_ID > &aCopperLayers )
+{
+#ifdef PRINT_STATISTICS_3D_VIEWER
+    unsigned stats_startHolesTime = GetRunningMicroSecs();
+
+    unsigned start_Time = stats_startHolesTime;
+#endif
+
+    m_stats_nr_holes          = 0;
+    m_stats_hole_med_diameter = 0;
+
+    // Create VIAS and THTs objects and add it to holes containers
+    // /////////////////////////////////////////////////////////////////////////
+    for( unsigned int lIdx = 0; lIdx < aCopperLayers.size(); ++lIdx )
+    {
+        const LAYER_ID curr_layer_id = aCopperLayers[lIdx];
+
+        // ADD TRACKS
+        for( const TRACK* track : aByLayer.Tracks( curr_layer_id ) )
+        {
+            if( !Is3DLayerEnabled( track->GetLayer() ) ) // Skip non enabled layers
+                continue;
+
+            // ADD VIAS and THT
+            if( track->Type() == PCB_VIA_T )
+            {
+                const VIA *via = static_cast< const VIA*>( track );
+                const VIATYPE_T viatype = via->GetViaType();
+                const float holediameter = via->GetDrillValue() * BiuTo3Dunits();
+                const float thickness = GetCopperThickness3DU();
+                const float hole_inner_radius = ( holediameter / 2.0f );
+
+                const SFVEC2F via_center(  via->GetStart().x * m_biuTo3Dunits,
+                                          -via->GetStart().y * m_biuTo3Dunits );
+
+                if( viatype != VIA_THROUGH )
+                {
+
+                    // Add hole objects
+                    // /////////////////////////////////////////////////////////
+
+                    CBVHCONTAINER2D *layerHoleContainer = NULL;
+
+                    // Check if the layer is already created
+                    if( m_layers_holes2D.find( curr_layer_id ) == m_layers_holes2D.end() )
+                    {
+                        // not found, create a new container
+                        layerHoleContainer = new CBVHCONTAINER2D;
+                        m_layers_holes2D[curr_layer_id] = layerHoleContainer;
+                    }
+                    else
+                    {
+                        // found
+                        layerHoleContainer = m_layers_holes2D[curr_layer_id];
+                    }
+
+                    // Add a hole for this layer
+                    layerHoleContainer->Add( new CFILLEDCIRCLE2D( via_center,
+                                                                  hole_inner_radius + thickness,
+                                                                  *track ) );
+                }
+                else if( lIdx == 0 ) // it only adds once the THT holes
+                {
+                    // Add through hole object
+                    // /////////////////////////////////////////////////////////
+                    m_through_holes_outer.Add( new CFILLEDCIRCLE2D( via_center,
+                                                                    hole_inner_radius + thickness,
+                                                                    *track ) );
+
+                    m_through_holes_vias_outer.Add(
+                                new CFILLEDCIRCLE2D( via_center,
+                                                     hole_inner_radius + thickness,
+                                                     *track ) );
+
+                    m_through_holes_inner.Add( new CFILLEDCIRCLE2D( via_center,
+                                                                    hole_inner_radius,
+                                                                    *track ) );
+
+                    //m_through_holes_vias_inner.Add( new CFILLEDCIRCLE2D( via_center,
+                    //                                                     hole_inner_radius,
+                    //                                                     *track ) );
+                }
+            }
+        }
+    }
+
+#ifdef PRINT_STATISTICS_3D_VIEWER
+    printf( "T04: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
+    start_Time = GetRunningMicroSecs();
+#endif
+
+    // Create VIAS and THTs objects and add it to holes containers
+    // /////////////////////////////////////////////////////////////////////////
+    for( unsigned int lIdx = 0; lIdx < aCopperLayers.size(); ++lIdx )
+    {
+        const LAYER_ID curr_layer_id = aCopperLayers[lIdx];
+
+        // ADD TRACKS
+        for( const TRACK* track : aByLayer.Tracks( curr_layer_id ) )
+        {
+            if( !Is3DLayerEnabled( track->GetLayer() ) ) // Skip non enabled layers
+                continue;
+
+            // ADD VIAS and THT
+            if( track->Type() == PCB_VIA_T )
+            {
+                const VIA *via = static_cast< const VIA*>( track );
+                const VIATYPE_T viatype = via->GetViaType();
+
+                if( viatype != VIA_THROUGH )
+                {
+
+                    // Add VIA hole contourns
+                    // /////////////////////////////////////////////////////////
+
+                    // Add outter holes of VIAs
+                    SHAPE_POLY_SET *layerOuterHolesPoly = NULL;
+                    SHAPE_POLY_SET *layerInnerHolesPoly = NULL;
+
+                    // Check if the layer is already created
+                    if( m_layers_outer_holes_poly.find( curr_layer_id ) ==
+                        m_layers_outer_holes_poly.end() )
+                    {
+                        // not found, create a new container
+                        layerOuterHolesPoly = new SHAPE_POLY_SET;
+                        m_layers_outer_holes_poly[curr_layer_id] = layerOuterHolesPoly;
+
+                        wxASSERT( m_layers_inner_holes_poly.find( curr_layer_id ) ==
+                                  m_layers_inner_holes_poly.end() );
+
+                        layerInnerHolesPoly = new SHAPE_POLY_SET;
+                        m_layers_inner_holes_poly[curr_layer_id] = layerInnerHolesPoly;
+                    }
+                    else
+                    {
+                        // found
+                        layerOuterHolesPoly = m_layers_outer_holes_poly[curr_layer_id];
+
+                        wxASSERT( m_layers_inner_holes_poly.find( curr_layer_id ) !=
+                                  m_layers_inner_holes_poly.end() );
+
+                        layerInnerHolesPoly = m_layers_inner_holes_poly[curr_layer_id];
+                    }
+
+                    const int holediameter = via->GetDrillValue();
+                    const int hole_outer_radius = (holediameter / 2) + GetCopperThicknessBIU();
+
+                    TransformCircleToPolygon( *layerOuterHolesPoly,
+                                              via->GetStart(),
+                                              hole_outer_radius,
+                                              GetNrSegmentsCircle( hole_outer_radius * 2 ) );
+
+                    TransformCircleToPolygon( *layerInnerHolesPoly,
+                                              via->GetStart(),
+                                              holediameter / 2,
+                                              GetNrSegmentsCircle( holediameter ) );
+                }
+                else if( lIdx == 0 ) // it only adds once the THT holes
+                {
+                    const int holediameter = via->GetDrillValue();
+                    const int hole_outer_radius = (holediameter / 2)+ GetCopperThicknessBIU();
+
+                    // Add through hole contourns
+                    // /////////////////////////////////////////////////////////
+                    TransformCircleToPolygon( m_through_outer_holes_poly,
+                                              via->GetStart(),
+                                              hole_outer_radius,
+                                              GetNrSegmentsCircle( hole_outer_radius * 2 ) );
+
+                    TransformCircleToPolygon( m_through_inner_holes_poly,
+                                              via->GetStart(),
+                                              holediameter / 2,
+                                              GetNrSegmentsCircle( holediameter ) );
+
+                    // Add samething for vias only
+
+                    TransformCircleToPolygon( m_through_outer_holes_vias_poly,
+                                              via->GetStart(),
+                                              hole_outer_radius,
+                                              GetNrSegmentsCircle( hole_outer_radius * 2 ) );
+
+                    //TransformCircleToPolygon( m_through_inner_holes_vias_poly,
+                    //                          via->GetStart(),
+                    //                          holediameter / 2,
+                    //                          GetNrSegmentsCircle( holediameter ) );
+                }
+            }
+        }
+    }
+
+#ifdef PRINT_STATISTICS_3D_VIEWER
+    printf( "T05: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
+    start_Time = GetRunningMicroSecs();
+#endif
+
+    // Add holes of modules
+    // /////////////////////////////////////////////////////////////////////////
+    for( const MODULE* module = m_board->m_Modules; module; module = module->Next() )
+    {
+        const D_PAD* pad = module->Pads();
+
+        for( ; pad; pad = pad->Next() )
+        {
+            const wxSize padHole = pad->GetDrillSize();
+
+            if( !padHole.x )    // Not drilled pad like SMD pad
+                continue;
+
+            // The hole in the body is inflated by copper thickness,
+            // if not plated, no copper
+            const int inflate = (pad->GetAttribute () != PAD_ATTRIB_HOLE_NOT_PLATED) ?
+                                GetCopperThicknessBIU() : 0;
+
+            m_stats_nr_holes++;
+            m_stats_hole_med_diameter += ( ( pad->GetDrillSize().x +
+                                             pad->GetDrillSize().y ) / 2.0f ) * m_biuTo3Dunits;
+
+            m_through_holes_outer.Add( createNewPadDrill( pad, inflate ) );
+            m_through_holes_inner.Add( createNewPadDrill( pad,       0 ) );
+        }
+    }
+    if( m_stats_nr_holes )
+        m_stats_hole_med_diameter /= (float)m_stats_nr_holes;
+
+#ifdef PRINT_STATISTICS_3D_VIEWER
+    printf( "T07: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
+    start_Time = GetRunningMicroSecs();
+#endif
+
+    // Add contours of the pad holes (pads can be Circle or Segment holes)
+    // /////////////////////////////////////////////////////////////////////////
+    for( const MODULE* module = m_board->m_Modules; module; module = module->Next() )
+    {
+        const D_PAD* pad = module->Pads();
+
+        for( ; pad; pad = pad->Next() )
+        {
+            const wxSize padHole = pad->GetDrillSize();
+
+            if( !padHole.x ) // Not drilled pad like SMD pad
+                continue;
+
+            // The hole in the body is inflated by copper thickness.
+            const int inflate = GetCopperThicknessBIU();
+
+            // we use the hole diameter to calculate the seg count.
+            // for round holes, padHole.x == padHole.y
+            // for oblong holes, the diameter is the smaller of (padHole.x, padHole.y)
+            const int diam = std::min( padHole.x, padHole.y );
+
+
+            if( pad->GetAttribute () != PAD_ATTRIB_HOLE_NOT_PLATED )
+            {
+                pad->BuildPadDrillShapePolygon( m_through_outer_holes_poly,
+                                                inflate,
+                                                GetNrSegmentsCircle( diam ) );
+
+                pad->BuildPadDrillShapePolygon( m_through_inner_holes_poly,
+                                                0,
+                                                GetNrSegmentsCircle( diam ) );
+            }
+            else
+            {
+                // If not plated, no copper.
+                pad->BuildPadDrillShapePolygon( m_through_outer_holes_poly_NPTH,
+                                                inflate,
+                                                GetNrSegmentsCircle( diam ) );
+            }
+        }
+    }
+
+#ifdef PRINT_STATISTICS_3D_VIEWER
+    printf( "T08: %.3f ms\n", (float)( GetRunningMicroSecs()  - start_Time  ) / 1e3 );
+    start_Time = GetRunningMicroSecs();
+#endif
+
+    // Simplify holes polygon contours
+    // /////////////////////////////////////////////////////////////////////////
+    for( unsigned int lIdx = 0; lIdx < aCopperLayers.size(); ++lIdx )
+    {
+        const LAYER_ID curr_layer_id = aCopperLayers[lIdx];
+
+        if( m_layers_outer_holes_poly.find( curr_layer_id ) !=
+            m_layers_outer_holes_poly.end() )
+        {
+            // found
+            SHAPE_POLY_SET *polyLayer = m_layers_outer_holes_poly[curr_layer_id];
+            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
+
+            wxASSERT( m_layers_inner_holes_poly.find( curr_layer_id ) !=
+                      m_layers_inner_holes_poly.end() );
+
+            polyLayer = m_layers_inner_holes_poly[curr_layer_id];
+            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
+        }
+    }
+
+#ifdef PRINT_STATISTICS_3D_VIEWER
+    printf( "T16: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time ) / 1e3 );
+#endif
+
+
+    // This will make a union of all added contourns
+    m_through_inner_holes_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
+    m_through_outer_holes_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
+    m_through_outer_holes_poly_NPTH.Simplify( SHAPE_POLY_SET::PM_FAST );
+    m_through_outer_holes_vias_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
+    //m_through_inner_holes_vias_poly.Simplify( SHAPE_POLY_SET::PM_FAST ); // Not in use
+
+
+    // Build BVH for holes and vias
+    // /////////////////////////////////////////////////////////////////////////
+
+#ifdef PRINT_STATISTICS_3D_VIEWER
+    unsigned stats_startHolesBVHTime = GetRunningMicroSecs();
+#endif
+
+    m_through_holes_inner.BuildBVH();
+    m_through_holes_outer.BuildBVH();
+
+    if( !m_layers_holes2D.empty() )
+    {
+        for( MAP_CONTAINER_2D::iterator ii = m_layers_holes2D.begin();
+             ii != m_layers_holes2D.end();
+             ++ii )
+        {
+            ((CBVHCONTAINER2D *)(ii->second))->BuildBVH();
+        }
+    }
+
+#ifdef PRINT_STATISTICS_3D_VIEWER
+    unsigned stats_endHolesBVHTime = GetRunningMicroSecs();
+
+    printf( "CINFO3D_VISU::createHoles times\n" );
+    printf( "  Holes:                  %.3f ms\n",
+            (float)( stats_startHolesBVHTime    - stats_startHolesTime         ) / 1e3 );
+    printf( "  Holes BVH creation:     %.3f ms\n",
+            (float)( stats_endHolesBVHTime      - stats_startHolesBVHTime      ) / 1e3 );
+#endif
+}
@@ -228,6 +228,22 @@ void EDA_3D_CANVAS::ReloadRequest( BOARD *aBoard , S3D_CACHE *aCachePointer )
 }
 
 
+void EDA_3D_CANVAS::ReloadRequest( const BOARD_CHANGE_SET &aChanges,
+                                   BOARD *aBoard, S3D_CACHE *aCachePointer )
+{
+    if( aCachePointer != NULL )
+        m_settings.Set3DCacheManager( aCachePointer );
+
+    if( aBoard != NULL )
+        m_settings.SetBoard( aBoard );
+
+    m_settings.InvalidateItems( aChanges );
+
+    if( m_3d_render )
+        m_3d_render->UpdateRequest();
+}
+
+
 void EDA_3D_CANVAS::RenderRaytracingRequest()
 {
     m_3d_render = m_3d_render_raytracing;
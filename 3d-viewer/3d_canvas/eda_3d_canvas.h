@@ -75,6 +75,14 @@ class EDA_3D_CANVAS : public wxGLCanvas
 
     void ReloadRequest( BOARD *aBoard = NULL, S3D_CACHE *aCachePointer = NULL );
 
+    /**
+     * @brief ReloadRequest - Schedule a reload of only the parts of the scene
+     * touched by some board changes
+     * @param aChanges: the changes of the board since the previous request
+     */
+    void ReloadRequest( const BOARD_CHANGE_SET &aChanges,
+                        BOARD *aBoard = NULL, S3D_CACHE *aCachePointer = NULL );
+
     /**
      * @brief IsReloadRequestPending - Query if there is a pending reload request
      * @return true if it wants to reload, false if there is no reload pending
@@ -334,39 +334,8 @@ CLAYERS_OGL_DISP_LISTS *C3D_RENDER_OGL_LEGACY::generate_holes_display_list(
 }
 
 
-void C3D_RENDER_OGL_LEGACY::reload( REPORTER *aStatusTextReporter )
+void C3D_RENDER_OGL_LEGACY::generate_board_display_list()
 {
-    m_reloadRequested = false;
-
-    ogl_free_all_display_lists();
-
-    COBJECT2D_STATS::Instance().ResetStats();
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf("InitSettings...\n");
-#endif
-
-    unsigned stats_startReloadTime = GetRunningMicroSecs();
-
-    m_settings.InitSettings( aStatusTextReporter );
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    unsigned stats_endReloadTime = GetRunningMicroSecs();
-#endif
-
-    SFVEC3F camera_pos = m_settings.GetBoardCenter3DU();
-    m_settings.CameraGet().SetBoardLookAtPos( camera_pos );
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    unsigned stats_start_OpenGL_Load_Time = GetRunningMicroSecs();
-#endif
-
-    if( aStatusTextReporter )
-        aStatusTextReporter->Report( _( "Load OpenGL: board" ) );
-
-    // Create Board
-    // /////////////////////////////////////////////////////////////////////////
-
     CCONTAINER2D boardContainer;
     Convert_shape_line_polygon_to_triangles( m_settings.GetBoardPoly(),
                                              boardContainer,
@@ -428,13 +397,14 @@ void C3D_RENDER_OGL_LEGACY::reload( REPORTER *aStatusTextReporter )
 
         delete layerTriangles;
     }
+}
 
+
+void C3D_RENDER_OGL_LEGACY::generate_holes_display_lists()
+{
     // Create Through Holes and vias
     // /////////////////////////////////////////////////////////////////////////
 
-    if( aStatusTextReporter )
-        aStatusTextReporter->Report( _( "Load OpenGL: holes and vias" ) );
-
     m_ogl_disp_list_through_holes_outer = generate_holes_display_list(
                 m_settings.GetThroughHole_Outer().GetList(),
                 m_settings.GetThroughHole_Outer_poly(),
@@ -527,6 +497,66 @@ void C3D_RENDER_OGL_LEGACY::reload( REPORTER *aStatusTextReporter )
 
     // Generate vertical cylinders of vias and pads (copper)
     generate_3D_Vias_and_Pads();
+}
+
+
+void C3D_RENDER_OGL_LEGACY::reload( REPORTER *aStatusTextReporter )
+{
+    m_reloadRequested = false;
+
+    COBJECT2D_STATS::Instance().ResetStats();
+
+#ifdef PRINT_STATISTICS_3D_VIEWER
+    printf("InitSettings...\n");
+#endif
+
+    unsigned stats_startReloadTime = GetRunningMicroSecs();
+
+    initSettings( aStatusTextReporter );
+
+#ifdef PRINT_STATISTICS_3D_VIEWER
+    unsigned stats_endReloadTime = GetRunningMicroSecs();
+#endif
+
+    const LSET &rebuiltLayers = m_settings.GetRebuiltLayers();
+
+    // Only the display lists of what was built again in the settings are
+    // replaced, the others are still valid
+    if( m_settings.WasFullyRebuilt() )
+    {
+        ogl_free_all_display_lists();
+
+        SFVEC3F camera_pos = m_settings.GetBoardCenter3DU();
+        m_settings.CameraGet().SetBoardLookAtPos( camera_pos );
+    }
+    else
+    {
+        for( LSEQ seq = rebuiltLayers.Seq(); seq; ++seq )
+            ogl_free_layer_display_lists( *seq );
+
+        if( m_settings.WereHolesRebuilt() )
+            ogl_free_holes_display_lists();
+    }
+
+#ifdef PRINT_STATISTICS_3D_VIEWER
+    unsigned stats_start_OpenGL_Load_Time = GetRunningMicroSecs();
+#endif
+
+    if( m_settings.WasFullyRebuilt() )
+    {
+        if( aStatusTextReporter )
+            aStatusTextReporter->Report( _( "Load OpenGL: board" ) );
+
+        generate_board_display_list();
+    }
+
+    if( m_settings.WereHolesRebuilt() )
+    {
+        if( aStatusTextReporter )
+            aStatusTextReporter->Report( _( "Load OpenGL: holes and vias" ) );
+
+        generate_holes_display_lists();
+    }
 
     // Add layers maps
     // /////////////////////////////////////////////////////////////////////////
@@ -540,7 +570,7 @@ void C3D_RENDER_OGL_LEGACY::reload( REPORTER *aStatusTextReporter )
     {
         LAYER_ID layer_id = static_cast<LAYER_ID>(ii->first);
 
-        if( !m_settings.Is3DLayerEnabled( layer_id ) )
+        if( !m_settings.Is3DLayerEnabled( layer_id ) || !rebuiltLayers.test( layer_id ) )
             continue;
 
         const CBVHCONTAINER2D *container2d = static_cast<const CBVHCONTAINER2D *>(ii->second);
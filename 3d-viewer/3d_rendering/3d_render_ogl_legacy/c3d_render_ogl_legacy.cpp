@@ -849,27 +849,6 @@ void C3D_RENDER_OGL_LEGACY::ogl_free_all_display_lists()
     m_ogl_disp_lists_layers.clear();
 
 
-    for( MAP_OGL_DISP_LISTS::const_iterator ii = m_ogl_disp_lists_layers_holes_outer.begin();
-         ii != m_ogl_disp_lists_layers_holes_outer.end();
-         ++ii )
-    {
-        CLAYERS_OGL_DISP_LISTS *pLayerDispList = static_cast<CLAYERS_OGL_DISP_LISTS*>(ii->second);
-        delete pLayerDispList;
-    }
-
-    m_ogl_disp_lists_layers_holes_outer.clear();
-
-
-    for( MAP_OGL_DISP_LISTS::const_iterator ii = m_ogl_disp_lists_layers_holes_inner.begin();
-         ii != m_ogl_disp_lists_layers_holes_inner.end();
-         ++ii )
-    {
-        CLAYERS_OGL_DISP_LISTS *pLayerDispList = static_cast<CLAYERS_OGL_DISP_LISTS*>(ii->second);
-        delete pLayerDispList;
-    }
-
-    m_ogl_disp_lists_layers_holes_inner.clear();
-
     for( MAP_TRIANGLES::const_iterator ii = m_triangles.begin();
          ii != m_triangles.end();
          ++ii )
@@ -895,6 +874,53 @@ void C3D_RENDER_OGL_LEGACY::ogl_free_all_display_lists()
     delete m_ogl_disp_list_board;
     m_ogl_disp_list_board = 0;
 
+    ogl_free_holes_display_lists();
+}
+
+
+void C3D_RENDER_OGL_LEGACY::ogl_free_layer_display_lists( LAYER_ID aLayerId )
+{
+    MAP_OGL_DISP_LISTS::iterator dispList = m_ogl_disp_lists_layers.find( aLayerId );
+
+    if( dispList != m_ogl_disp_lists_layers.end() )
+    {
+        delete dispList->second;
+        m_ogl_disp_lists_layers.erase( dispList );
+    }
+
+    MAP_TRIANGLES::iterator triangles = m_triangles.find( aLayerId );
+
+    if( triangles != m_triangles.end() )
+    {
+        delete triangles->second;
+        m_triangles.erase( triangles );
+    }
+}
+
+
+void C3D_RENDER_OGL_LEGACY::ogl_free_holes_display_lists()
+{
+    for( MAP_OGL_DISP_LISTS::const_iterator ii = m_ogl_disp_lists_layers_holes_outer.begin();
+         ii != m_ogl_disp_lists_layers_holes_outer.end();
+         ++ii )
+    {
+        CLAYERS_OGL_DISP_LISTS *pLayerDispList = static_cast<CLAYERS_OGL_DISP_LISTS*>(ii->second);
+        delete pLayerDispList;
+    }
+
+    m_ogl_disp_lists_layers_holes_outer.clear();
+
+
+    for( MAP_OGL_DISP_LISTS::const_iterator ii = m_ogl_disp_lists_layers_holes_inner.begin();
+         ii != m_ogl_disp_lists_layers_holes_inner.end();
+         ++ii )
+    {
+        CLAYERS_OGL_DISP_LISTS *pLayerDispList = static_cast<CLAYERS_OGL_DISP_LISTS*>(ii->second);
+        delete pLayerDispList;
+    }
+
+    m_ogl_disp_lists_layers_holes_inner.clear();
+
     delete m_ogl_disp_list_through_holes_outer_with_npth;
     m_ogl_disp_list_through_holes_outer_with_npth = 0;
 
@@ -76,6 +76,8 @@ private:
     void ogl_set_arrow_material();
 
     void ogl_free_all_display_lists();
+    void ogl_free_layer_display_lists( LAYER_ID aLayerId );
+    void ogl_free_holes_display_lists();
     MAP_OGL_DISP_LISTS      m_ogl_disp_lists_layers;
     MAP_OGL_DISP_LISTS      m_ogl_disp_lists_layers_holes_outer;
     MAP_OGL_DISP_LISTS      m_ogl_disp_lists_layers_holes_inner;
@@ -110,6 +112,9 @@ private:
     void generate_through_outer_holes();
     void generate_through_inner_holes();
 
+    void generate_board_display_list();
+    void generate_holes_display_lists();
+
     CLAYERS_OGL_DISP_LISTS *generate_holes_display_list( const LIST_OBJECT2D &aListHolesObject2d,
                                                          const SHAPE_POLY_SET &aPoly,
                                                          float aZtop,
@@ -237,7 +237,43 @@ CBVH_PBRT::CBVH_PBRT( const CGENERICCONTAINER &aObjectContainer,
     m_maxPrimsInNode( std::min( 255, aMaxPrimsInNode ) ),
     m_splitMethod( aSplitMethod )
 {
-    if( aObjectContainer.GetList().empty() )
+    // Convert the objects list to vector of objects
+    // /////////////////////////////////////////////////////////////////////////
+    aObjectContainer.ConvertTo( m_primitives );
+
+    wxASSERT( aObjectContainer.GetList().size() == m_primitives.size() );
+
+    build();
+}
+
+
+CBVH_PBRT::CBVH_PBRT( const std::vector< const CGENERICCONTAINER * > &aObjectContainers,
+                      int aMaxPrimsInNode,
+                      SPLITMETHOD aSplitMethod ) :
+    m_maxPrimsInNode( std::min( 255, aMaxPrimsInNode ) ),
+    m_splitMethod( aSplitMethod )
+{
+    size_t nrObjects = 0;
+
+    for( const CGENERICCONTAINER *container : aObjectContainers )
+        nrObjects += container->GetList().size();
+
+    m_primitives.reserve( nrObjects );
+
+    for( const CGENERICCONTAINER *container : aObjectContainers )
+    {
+        const LIST_OBJECT &objects = container->GetList();
+
+        m_primitives.insert( m_primitives.end(), objects.begin(), objects.end() );
+    }
+
+    build();
+}
+
+
+void CBVH_PBRT::build()
+{
+    if( m_primitives.empty() )
     {
         m_nodes = NULL;
 
@@ -250,12 +286,6 @@ CBVH_PBRT::CBVH_PBRT( const CGENERICCONTAINER &aObjectContainer,
         m_I[i] = i;
     }
 
-    // Convert the objects list to vector of objects
-    // /////////////////////////////////////////////////////////////////////////
-    aObjectContainer.ConvertTo( m_primitives );
-
-    wxASSERT( aObjectContainer.GetList().size() == m_primitives.size() );
-
     // Initialize _primitiveInfo_ array for primitives
     // /////////////////////////////////////////////////////////////////////////
     std::vector<BVHPrimitiveInfo> primitiveInfo( m_primitives.size() );
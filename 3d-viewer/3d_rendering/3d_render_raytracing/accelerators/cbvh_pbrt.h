@@ -115,6 +115,11 @@ public:
                int aMaxPrimsInNode = 4,
                SPLITMETHOD aSplitMethod = SPLIT_SAH );
 
+    /// Builds a single tree over the objects of all the containers
+    CBVH_PBRT( const std::vector< const CGENERICCONTAINER * > &aObjectContainers,
+               int aMaxPrimsInNode = 4,
+               SPLITMETHOD aSplitMethod = SPLIT_SAH );
+
     ~CBVH_PBRT();
 
     // Imported from CGENERICACCELERATOR
@@ -125,6 +130,8 @@ public:
 
 private:
 
+    void build();
+
     BVHBuildNode *recursiveBuild( std::vector<BVHPrimitiveInfo> &primitiveInfo,
                                   int start,
                                   int end,
@@ -239,8 +239,6 @@ void C3D_RENDER_RAYTRACING::reload( REPORTER *aStatusTextReporter )
 {
     m_reloadRequested = false;
 
-    m_model_materials.clear();
-
     COBJECT2D_STATS::Instance().ResetStats();
     COBJECT3D_STATS::Instance().ResetStats();
 
@@ -250,173 +248,96 @@ void C3D_RENDER_RAYTRACING::reload( REPORTER *aStatusTextReporter )
 
     unsigned stats_startReloadTime = GetRunningMicroSecs();
 
-    m_settings.InitSettings( aStatusTextReporter );
+    initSettings( aStatusTextReporter );
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
     unsigned stats_endReloadTime = GetRunningMicroSecs();
     unsigned stats_startConvertTime = GetRunningMicroSecs();
  #endif
 
-    SFVEC3F camera_pos = m_settings.GetBoardCenter3DU();
-    m_settings.CameraGet().SetBoardLookAtPos( camera_pos );
-
-    m_object_container.Clear();
-    m_containerWithObjectsToDelete.Clear();
+    // The accelerator refers the objects of the parts about to be replaced
+    delete m_accelerator;
+    m_accelerator = 0;
 
+    const bool rebuildAll   = m_settings.WasFullyRebuilt();
+    const bool rebuildHoles = m_settings.WereHolesRebuilt();
 
-    // Create and add the outline board
-    // /////////////////////////////////////////////////////////////////////////
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf("Create outline board...\n");
-#endif
+    // The 3D objects refer the 2D objects of the settings, so the parts of the
+    // scene made of what the settings built again are replaced. The holes cut
+    // the board body and the solder masks, and also the other layers when they
+    // are shown in the zones.
+    LSET layersToUpdate = m_settings.GetRebuiltLayers();
 
-    delete m_outlineBoard2dObjects;
+    if( rebuildHoles )
+    {
+        layersToUpdate.set( B_Mask );
+        layersToUpdate.set( F_Mask );
 
-    m_outlineBoard2dObjects = new CCONTAINER2D;
+        if( m_settings.GetFlag( FL_RENDER_SHOW_HOLES_IN_ZONES ) )
+            layersToUpdate = LSET::AllLayersMask();
+    }
 
-    if( ((const SHAPE_POLY_SET &)m_settings.GetBoardPoly()).OutlineCount() == 1 )
+    for( MAP_SCENE_PARTS::iterator ii = m_layerParts.begin(); ii != m_layerParts.end(); )
     {
-        float divFactor = 0.0f;
-
-        if( m_settings.GetStats_Nr_Vias() )
-            divFactor = m_settings.GetStats_Med_Via_Hole_Diameter3DU() * 18.0f;
+        if( layersToUpdate.test( ii->first ) )
+            ii = m_layerParts.erase( ii );
         else
-            if( m_settings.GetStats_Nr_Holes() )
-                divFactor = m_settings.GetStats_Med_Hole_Diameter3DU() * 8.0f;
-
-        SHAPE_POLY_SET boardPolyCopy = m_settings.GetBoardPoly();
-        boardPolyCopy.Fracture( SHAPE_POLY_SET::PM_FAST );
-
-        Convert_path_polygon_to_polygon_blocks_and_dummy_blocks(
-                    boardPolyCopy,
-                    *m_outlineBoard2dObjects,
-                    m_settings.BiuTo3Dunits(),
-                    divFactor,
-                    (const BOARD_ITEM &)*m_settings.GetBoard() );
-
-        if( m_settings.GetFlag( FL_SHOW_BOARD_BODY ) )
-        {
-            const LIST_OBJECT2D &listObjects = m_outlineBoard2dObjects->GetList();
-
-            for( LIST_OBJECT2D::const_iterator object2d_iterator = listObjects.begin();
-                 object2d_iterator != listObjects.end();
-                 ++object2d_iterator )
-            {
-                const COBJECT2D *object2d_A = static_cast<const COBJECT2D *>(*object2d_iterator);
-
-                std::vector<const COBJECT2D *> *object2d_B = new std::vector<const COBJECT2D *>();
-
-                // Check if there are any THT that intersects this outline object part
-                if( !m_settings.GetThroughHole_Outer().GetList().empty() )
-                {
-
-                    CONST_LIST_OBJECT2D intersectionList;
-                    m_settings.GetThroughHole_Outer().GetListObjectsIntersects(
-                                object2d_A->GetBBox(),
-                                intersectionList );
-
-                    if( !intersectionList.empty() )
-                    {
-                        for( CONST_LIST_OBJECT2D::const_iterator hole = intersectionList.begin();
-                             hole != intersectionList.end();
-                             ++hole )
-                        {
-                            const COBJECT2D *hole2d = static_cast<const COBJECT2D *>(*hole);
-
-                            if( object2d_A->Intersects( hole2d->GetBBox() ) )
-                            //if( object2d_A->GetBBox().Intersects( hole2d->GetBBox() ) )
-                                object2d_B->push_back( hole2d );
-                        }
-                    }
-                }
+            ++ii;
+    }
 
-                if( object2d_B->empty() )
-                {
-                    delete object2d_B;
-                    object2d_B = CSGITEM_EMPTY;
-                }
+    if( rebuildHoles )
+    {
+        m_boardPart.Clear();
+        m_holesPart.Clear();
+    }
 
-                if( object2d_B == CSGITEM_EMPTY )
-                {
-        #if 0
-                    create_3d_object_from( m_object_container, object2d_A,
-                                           m_settings.GetLayerBottomZpos3DU( F_Cu ),
-                                           m_settings.GetLayerBottomZpos3DU( B_Cu ),
-                                           &m_materials.m_EpoxyBoard,
-                                           g_epoxyColor );
-        #else
-                    CLAYERITEM *objPtr = new CLAYERITEM( object2d_A,
-                                                         m_settings.GetLayerBottomZpos3DU( F_Cu ),
-                                                         m_settings.GetLayerBottomZpos3DU( B_Cu ) );
-
-                    objPtr->SetMaterial( &m_materials.m_EpoxyBoard );
-                    objPtr->SetColor( (SFVEC3F)m_settings.m_BoardBodyColor );
-                    m_object_container.Add( objPtr );
-        #endif
-                }
-                else
-                {
-                    CITEMLAYERCSG2D *itemCSG2d = new CITEMLAYERCSG2D(
-                                object2d_A,
-                                object2d_B,
-                                CSGITEM_FULL,
-                                (const BOARD_ITEM &)*m_settings.GetBoard() );
+    if( rebuildAll )
+    {
+        SFVEC3F camera_pos = m_settings.GetBoardCenter3DU();
+        m_settings.CameraGet().SetBoardLookAtPos( camera_pos );
 
-                    m_containerWithObjectsToDelete.Add( itemCSG2d );
+        // The triangles of the models refer these materials
+        m_modelParts.clear();
+        m_model_materials.clear();
 
-                    CLAYERITEM *objPtr = new CLAYERITEM( itemCSG2d,
-                                                         m_settings.GetLayerBottomZpos3DU( F_Cu ),
-                                                         m_settings.GetLayerBottomZpos3DU( B_Cu ) );
+        // Create the outline board
+        // /////////////////////////////////////////////////////////////////////
 
-                    objPtr->SetMaterial( &m_materials.m_EpoxyBoard );
-                    objPtr->SetColor( (SFVEC3F)m_settings.m_BoardBodyColor );
-                    m_object_container.Add( objPtr );
-                }
-            }
+#ifdef PRINT_STATISTICS_3D_VIEWER
+        printf("Create outline board...\n");
+#endif
 
-            // Add cylinders of the board body to container
-            // Note: This is actually a workarround for the holes in the board.
-            // The issue is because if a hole is in a border of a divided polygon ( ex
-            // a polygon or dummyblock) it will cut also the render of the hole.
-            // So this will add a full hole.
-            // In fact, that is not need if the hole have copper.
-            // /////////////////////////////////////////////////////////////////////////
-            if( !m_settings.GetThroughHole_Outer().GetList().empty() )
-            {
-                const LIST_OBJECT2D &holeList = m_settings.GetThroughHole_Outer().GetList();
+        delete m_outlineBoard2dObjects;
 
-                for( LIST_OBJECT2D::const_iterator hole = holeList.begin();
-                     hole != holeList.end();
-                     ++hole )
-                {
-                    const COBJECT2D *hole2d = static_cast<const COBJECT2D *>(*hole);
+        m_outlineBoard2dObjects = new CCONTAINER2D;
 
-                    switch( hole2d->GetObjectType() )
-                    {
-                    case OBJ2D_FILLED_CIRCLE:
-                    {
-                        const float radius = hole2d->GetBBox().GetExtent().x * 0.5f * 0.999f;
-
-                        CVCYLINDER *objPtr = new CVCYLINDER(
-                                    hole2d->GetCentroid(),
-                                    NextFloatDown( m_settings.GetLayerBottomZpos3DU( F_Cu ) ),
-                                    NextFloatUp( m_settings.GetLayerBottomZpos3DU( B_Cu ) ),
-                                    radius );
+        if( ((const SHAPE_POLY_SET &)m_settings.GetBoardPoly()).OutlineCount() == 1 )
+        {
+            float divFactor = 0.0f;
 
-                        objPtr->SetMaterial( &m_materials.m_EpoxyBoard );
-                        objPtr->SetColor( (SFVEC3F)m_settings.m_BoardBodyColor );
+            if( m_settings.GetStats_Nr_Vias() )
+                divFactor = m_settings.GetStats_Med_Via_Hole_Diameter3DU() * 18.0f;
+            else
+                if( m_settings.GetStats_Nr_Holes() )
+                    divFactor = m_settings.GetStats_Med_Hole_Diameter3DU() * 8.0f;
+
+            SHAPE_POLY_SET boardPolyCopy = m_settings.GetBoardPoly();
+            boardPolyCopy.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+            Convert_path_polygon_to_polygon_blocks_and_dummy_blocks(
+                        boardPolyCopy,
+                        *m_outlineBoard2dObjects,
+                        m_settings.BiuTo3Dunits(),
+                        divFactor,
+                        (const BOARD_ITEM &)*m_settings.GetBoard() );
+        }
+    }
 
-                        m_object_container.Add( objPtr );
-                    }
-                    break;
+    if( rebuildHoles )
+    {
+        create_board_body( m_boardPart );
 
-                    default:
-                        break;
-                    }
-                }
-            }
-        }
+        add_3D_vias_and_pads_to_container( m_holesPart );
     }
 
 
@@ -437,185 +358,13 @@ void C3D_RENDER_RAYTRACING::reload( REPORTER *aStatusTextReporter )
         if( (layer_id == B_Mask) || (layer_id == F_Mask) )
             continue;
 
-        CMATERIAL *materialLayer = &m_materials.m_SilkS;
-        SFVEC3F layerColor = SFVEC3F( 0.0f, 0.0f, 0.0f );
-
-        switch( layer_id )
-        {
-            case B_Adhes:
-            case F_Adhes:
-            break;
-
-            case B_Paste:
-            case F_Paste:
-                materialLayer = &m_materials.m_Paste;
-
-                if( m_settings.GetFlag( FL_USE_REALISTIC_MODE ) )
-                    layerColor = m_settings.m_SolderPasteColor;
-                else
-                    layerColor = m_settings.GetLayerColor( layer_id );
-            break;
-
-            case B_SilkS:
-            case F_SilkS:
-                materialLayer = &m_materials.m_SilkS;
-
-                if( m_settings.GetFlag( FL_USE_REALISTIC_MODE ) )
-                    layerColor = m_settings.m_SilkScreenColor;
-                else
-                    layerColor = m_settings.GetLayerColor( layer_id );
-            break;
-
-            case Dwgs_User:
-            case Cmts_User:
-            case Eco1_User:
-            case Eco2_User:
-            case Edge_Cuts:
-            case Margin:
-            break;
-
-            case B_CrtYd:
-            case F_CrtYd:
-            break;
-
-            case B_Fab:
-            case F_Fab:
-            break;
-
-            default:
-                materialLayer = &m_materials.m_Copper;
-
-                if( m_settings.GetFlag( FL_USE_REALISTIC_MODE ) )
-                    layerColor = m_settings.m_CopperColor;
-                else
-                    layerColor = m_settings.GetLayerColor( layer_id );
-            break;
-        }
-
-        const CBVHCONTAINER2D *container2d = static_cast<const CBVHCONTAINER2D *>(ii->second);
-        const LIST_OBJECT2D &listObject2d = container2d->GetList();
-
-        for( LIST_OBJECT2D::const_iterator itemOnLayer = listObject2d.begin();
-             itemOnLayer != listObject2d.end();
-             ++itemOnLayer )
-        {
-            const COBJECT2D *object2d_A = static_cast<const COBJECT2D *>(*itemOnLayer);
-
-            // not yet used / implemented (can be used in future to clip the objects in the board borders
-            COBJECT2D *object2d_C = CSGITEM_FULL;
-
-            std::vector<const COBJECT2D *> *object2d_B = CSGITEM_EMPTY;
-
-            if( m_settings.GetFlag( FL_RENDER_SHOW_HOLES_IN_ZONES ) )
-            {
-                object2d_B = new std::vector<const COBJECT2D *>();
-
-                // Check if there are any layerhole that intersects this object
-                // Eg: a segment is cutted by a via hole or THT hole.
-                // /////////////////////////////////////////////////////////////
-                const MAP_CONTAINER_2D &layerHolesMap = m_settings.GetMapLayersHoles();
-
-                if( layerHolesMap.find(layer_id) != layerHolesMap.end() )
-                {
-                    MAP_CONTAINER_2D::const_iterator ii_hole = layerHolesMap.find(layer_id);
-
-                    const CBVHCONTAINER2D *containerLayerHoles2d =
-                            static_cast<const CBVHCONTAINER2D *>(ii_hole->second);
-
-
-                    CONST_LIST_OBJECT2D intersectionList;
-                    containerLayerHoles2d->GetListObjectsIntersects( object2d_A->GetBBox(),
-                                                                     intersectionList );
-
-                    if( !intersectionList.empty() )
-                    {
-                        for( CONST_LIST_OBJECT2D::const_iterator holeOnLayer =
-                             intersectionList.begin();
-                             holeOnLayer != intersectionList.end();
-                             ++holeOnLayer )
-                        {
-                            const COBJECT2D *hole2d = static_cast<const COBJECT2D *>(*holeOnLayer);
-
-                            //if( object2d_A->Intersects( hole2d->GetBBox() ) )
-                                //if( object2d_A->GetBBox().Intersects( hole2d->GetBBox() ) )
-                                    object2d_B->push_back( hole2d );
-                        }
-                    }
-                }
-
-                // Check if there are any THT that intersects this object
-                // /////////////////////////////////////////////////////////////
-                if( !m_settings.GetThroughHole_Outer().GetList().empty() )
-                {
-                    CONST_LIST_OBJECT2D intersectionList;
-
-                    m_settings.GetThroughHole_Outer().GetListObjectsIntersects(
-                                object2d_A->GetBBox(),
-                                intersectionList );
-
-                    if( !intersectionList.empty() )
-                    {
-                        for( CONST_LIST_OBJECT2D::const_iterator hole = intersectionList.begin();
-                             hole != intersectionList.end();
-                             ++hole )
-                        {
-                            const COBJECT2D *hole2d = static_cast<const COBJECT2D *>(*hole);
-
-                            //if( object2d_A->Intersects( hole2d->GetBBox() ) )
-                                //if( object2d_A->GetBBox().Intersects( hole2d->GetBBox() ) )
-                                    object2d_B->push_back( hole2d );
-                        }
-                    }
-                }
-
-                if( object2d_B->empty() )
-                {
-                    delete object2d_B;
-                    object2d_B = CSGITEM_EMPTY;
-                }
-            }
-
-            if( (object2d_B == CSGITEM_EMPTY) &&
-                (object2d_C == CSGITEM_FULL) )
-            {
-#if 0
-               create_3d_object_from( m_object_container,
-                                      object2d_A,
-                                      m_settings.GetLayerBottomZpos3DU( layer_id ),
-                                      m_settings.GetLayerTopZpos3DU( layer_id ),
-                                      materialLayer,
-                                      layerColor );
-#else
-                CLAYERITEM *objPtr = new CLAYERITEM( object2d_A,
-                                                     m_settings.GetLayerBottomZpos3DU( layer_id ),
-                                                     m_settings.GetLayerTopZpos3DU( layer_id ) );
-                objPtr->SetMaterial( materialLayer );
-                objPtr->SetColor( layerColor );
-                m_object_container.Add( objPtr );
-#endif
-            }
-            else
-            {
-#if 1
-                CITEMLAYERCSG2D *itemCSG2d = new CITEMLAYERCSG2D( object2d_A,
-                                                                  object2d_B,
-                                                                  object2d_C,
-                                                                  object2d_A->GetBoardItem() );
-                m_containerWithObjectsToDelete.Add( itemCSG2d );
-
-                CLAYERITEM *objPtr = new CLAYERITEM( itemCSG2d,
-                                                     m_settings.GetLayerBottomZpos3DU( layer_id ),
-                                                     m_settings.GetLayerTopZpos3DU( layer_id ) );
-
-                objPtr->SetMaterial( materialLayer );
-                objPtr->SetColor( layerColor );
-
-                m_object_container.Add( objPtr );
-#endif
-            }
-        }
-    }// for each layer on map
+        if( !layersToUpdate.test( layer_id ) )
+            continue;
 
+        create_layer( layer_id,
+                      static_cast<const CBVHCONTAINER2D *>(ii->second),
+                      m_layerParts[layer_id] );
+    }
 
 
     // Add Mask layer
@@ -627,139 +376,25 @@ void C3D_RENDER_RAYTRACING::reload( REPORTER *aStatusTextReporter )
     if( m_settings.GetFlag( FL_SOLDERMASK ) &&
         (m_outlineBoard2dObjects->GetList().size() >= 1) )
     {
-        CMATERIAL *materialLayer = &m_materials.m_SolderMask;
-
         for( MAP_CONTAINER_2D::const_iterator ii = m_settings.GetMapLayers().begin();
              ii != m_settings.GetMapLayers().end();
              ++ii )
         {
             LAYER_ID layer_id = static_cast<LAYER_ID>(ii->first);
 
-            const CBVHCONTAINER2D *containerLayer2d =
-                    static_cast<const CBVHCONTAINER2D *>(ii->second);
-
             // Only get the Solder mask layers
             if( !((layer_id == B_Mask) || (layer_id == F_Mask)) )
                 continue;
 
-            SFVEC3F layerColor;
-            if( m_settings.GetFlag( FL_USE_REALISTIC_MODE ) )
-                layerColor = m_settings.m_SolderMaskColor;
-            else
-                layerColor = m_settings.GetLayerColor( layer_id );
-
-            const float zLayerMin = m_settings.GetLayerBottomZpos3DU( layer_id );
-            const float zLayerMax = m_settings.GetLayerTopZpos3DU( layer_id );
-
-            // Get the outline board objects
-            const LIST_OBJECT2D &listObjects = m_outlineBoard2dObjects->GetList();
-
-            for( LIST_OBJECT2D::const_iterator object2d_iterator = listObjects.begin();
-                 object2d_iterator != listObjects.end();
-                 ++object2d_iterator )
-            {
-                const COBJECT2D *object2d_A = static_cast<const COBJECT2D *>(*object2d_iterator);
-
-                std::vector<const COBJECT2D *> *object2d_B = new std::vector<const COBJECT2D *>();
-
-                // Check if there are any THT that intersects this outline object part
-                if( !m_settings.GetThroughHole_Outer().GetList().empty() )
-                {
-
-                    CONST_LIST_OBJECT2D intersectionList;
-
-                    m_settings.GetThroughHole_Outer().GetListObjectsIntersects(
-                                object2d_A->GetBBox(),
-                                intersectionList );
-
-                    if( !intersectionList.empty() )
-                    {
-                        for( CONST_LIST_OBJECT2D::const_iterator hole = intersectionList.begin();
-                             hole != intersectionList.end();
-                             ++hole )
-                        {
-                            const COBJECT2D *hole2d = static_cast<const COBJECT2D *>(*hole);
-
-                            if( object2d_A->Intersects( hole2d->GetBBox() ) )
-                            //if( object2d_A->GetBBox().Intersects( hole2d->GetBBox() ) )
-                                object2d_B->push_back( hole2d );
-                        }
-                    }
-                }
-
-                // Check if there are any objects in the layer to subtract with the
-                // corrent object
-                if( !containerLayer2d->GetList().empty() )
-                {
-                    CONST_LIST_OBJECT2D intersectionList;
-
-                    containerLayer2d->GetListObjectsIntersects( object2d_A->GetBBox(),
-                                                                intersectionList );
-
-                    if( !intersectionList.empty() )
-                    {
-                        for( CONST_LIST_OBJECT2D::const_iterator obj = intersectionList.begin();
-                             obj != intersectionList.end();
-                             ++obj )
-                        {
-                            const COBJECT2D *obj2d = static_cast<const COBJECT2D *>(*obj);
-
-                            //if( object2d_A->Intersects( obj2d->GetBBox() ) )
-                            //if( object2d_A->GetBBox().Intersects( obj2d->GetBBox() ) )
-                                object2d_B->push_back( obj2d );
-                        }
-                    }
-                }
-
-                if( object2d_B->empty() )
-                {
-                    delete object2d_B;
-                    object2d_B = CSGITEM_EMPTY;
-                }
-
-                if( object2d_B == CSGITEM_EMPTY )
-                {
-        #if 0
-                   create_3d_object_from( m_object_container,
-                                          object2d_A,
-                                          zLayerMin,
-                                          zLayerMax,
-                                          materialLayer,
-                                          layerColor );
-        #else
-                    CLAYERITEM *objPtr =  new CLAYERITEM( object2d_A,
-                                                          zLayerMin,
-                                                          zLayerMax );
-
-                    objPtr->SetMaterial( materialLayer );
-                    objPtr->SetColor( layerColor );
-
-                    m_object_container.Add( objPtr );
-        #endif
-                }
-                else
-                {
-                    CITEMLAYERCSG2D *itemCSG2d = new CITEMLAYERCSG2D( object2d_A,
-                                                                      object2d_B,
-                                                                      CSGITEM_FULL,
-                                                                      object2d_A->GetBoardItem() );
-
-                    m_containerWithObjectsToDelete.Add( itemCSG2d );
-
-                    CLAYERITEM *objPtr =  new CLAYERITEM( itemCSG2d,
-                                                          zLayerMin,
-                                                          zLayerMax );
-                    objPtr->SetMaterial( materialLayer );
-                    objPtr->SetColor( layerColor );
+            if( !layersToUpdate.test( layer_id ) )
+                continue;
 
-                    m_object_container.Add( objPtr );
-                }
-            }
+            create_solder_mask_layer( layer_id,
+                                      static_cast<const CBVHCONTAINER2D *>(ii->second),
+                                      m_layerParts[layer_id] );
         }
     }
 
-    add_3D_vias_and_pads_to_container();
-
 #ifdef PRINT_STATISTICS_3D_VIEWER
     unsigned stats_endConvertTime = GetRunningMicroSecs();
     unsigned stats_startLoad3DmodelsTime = stats_endConvertTime;
@@ -775,17 +410,31 @@ void C3D_RENDER_RAYTRACING::reload( REPORTER *aStatusTextReporter )
 
     // Add floor
     // /////////////////////////////////////////////////////////////////////////
+    m_floorPart.Clear();
+
     if( m_settings.GetFlag( FL_RENDER_RAYTRACING_BACKFLOOR ) )
     {
+        std::vector< const CGENERICCONTAINER * > containers;
+        CBBOX sceneBBox;
+
+        sceneBBox.Reset();
+        collect_scene_containers( containers );
+
+        for( const CGENERICCONTAINER *container : containers )
+        {
+            if( !container->GetList().empty() )
+                sceneBBox.Union( container->GetBBox() );
+        }
+
         CBBOX boardBBox = m_settings.GetBBox3DU();
 
         if( boardBBox.IsInitialized() )
         {
             boardBBox.Scale( 3.0f );
 
-            if( m_object_container.GetList().size() > 0 )
+            if( sceneBBox.IsInitialized() )
             {
-                CBBOX containerBBox = m_object_container.GetBBox();
+                CBBOX containerBBox = sceneBBox;
 
                 containerBBox.Scale( 1.3f );
 
@@ -814,8 +463,8 @@ void C3D_RENDER_RAYTRACING::reload( REPORTER *aStatusTextReporter )
                 CTRIANGLE *newTriangle1 = new CTRIANGLE( v1, v2, v3 );
                 CTRIANGLE *newTriangle2 = new CTRIANGLE( v3, v4, v1 );
 
-                m_object_container.Add( newTriangle1 );
-                m_object_container.Add( newTriangle2 );
+                m_floorPart.m_objects.Add( newTriangle1 );
+                m_floorPart.m_objects.Add( newTriangle2 );
 
                 newTriangle1->SetMaterial( (const CMATERIAL *)&m_materials.m_Floor );
                 newTriangle2->SetMaterial( (const CMATERIAL *)&m_materials.m_Floor );
@@ -826,7 +475,6 @@ void C3D_RENDER_RAYTRACING::reload( REPORTER *aStatusTextReporter )
         }
     }
 
-
     // Init initial lights
     // /////////////////////////////////////////////////////////////////////////
     m_lights.Clear();
@@ -901,14 +549,14 @@ void C3D_RENDER_RAYTRACING::reload( REPORTER *aStatusTextReporter )
     unsigned stats_startAcceleratorTime = GetRunningMicroSecs();
 #endif
 
-    if( m_accelerator )
-    {
-        delete m_accelerator;
-    }
-    m_accelerator = 0;
+    // A single tree is built over all the parts, as the anti-aliasing refers
+    // the nodes of the tree that the first hits went through
+    std::vector< const CGENERICCONTAINER * > containers;
+
+    collect_scene_containers( containers );
 
     //m_accelerator = new CGRID( m_object_container );
-    m_accelerator = new CBVH_PBRT( m_object_container );
+    m_accelerator = new CBVH_PBRT( containers );
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
     unsigned stats_endAcceleratorTime = GetRunningMicroSecs();
@@ -955,10 +603,462 @@ void C3D_RENDER_RAYTRACING::reload( REPORTER *aStatusTextReporter )
 }
 
 
+void C3D_RENDER_RAYTRACING::create_board_body( SCENE_PART &aDst )
+{
+    if( !m_settings.GetFlag( FL_SHOW_BOARD_BODY ) ||
+        m_outlineBoard2dObjects->GetList().empty() )
+        return;
+
+    const LIST_OBJECT2D &listObjects = m_outlineBoard2dObjects->GetList();
+
+    for( LIST_OBJECT2D::const_iterator object2d_iterator = listObjects.begin();
+         object2d_iterator != listObjects.end();
+         ++object2d_iterator )
+    {
+        const COBJECT2D *object2d_A = static_cast<const COBJECT2D *>(*object2d_iterator);
+
+        std::vector<const COBJECT2D *> *object2d_B = new std::vector<const COBJECT2D *>();
+
+        // Check if there are any THT that intersects this outline object part
+        if( !m_settings.GetThroughHole_Outer().GetList().empty() )
+        {
+
+            CONST_LIST_OBJECT2D intersectionList;
+            m_settings.GetThroughHole_Outer().GetListObjectsIntersects(
+                        object2d_A->GetBBox(),
+                        intersectionList );
+
+            if( !intersectionList.empty() )
+            {
+                for( CONST_LIST_OBJECT2D::const_iterator hole = intersectionList.begin();
+                     hole != intersectionList.end();
+                     ++hole )
+                {
+                    const COBJECT2D *hole2d = static_cast<const COBJECT2D *>(*hole);
+
+                    if( object2d_A->Intersects( hole2d->GetBBox() ) )
+                    //if( object2d_A->GetBBox().Intersects( hole2d->GetBBox() ) )
+                        object2d_B->push_back( hole2d );
+                }
+            }
+        }
+
+        if( object2d_B->empty() )
+        {
+            delete object2d_B;
+            object2d_B = CSGITEM_EMPTY;
+        }
+
+        if( object2d_B == CSGITEM_EMPTY )
+        {
+#if 0
+            create_3d_object_from( aDst.m_objects, object2d_A,
+                                   m_settings.GetLayerBottomZpos3DU( F_Cu ),
+                                   m_settings.GetLayerBottomZpos3DU( B_Cu ),
+                                   &m_materials.m_EpoxyBoard,
+                                   g_epoxyColor );
+#else
+            CLAYERITEM *objPtr = new CLAYERITEM( object2d_A,
+                                                 m_settings.GetLayerBottomZpos3DU( F_Cu ),
+                                                 m_settings.GetLayerBottomZpos3DU( B_Cu ) );
+
+            objPtr->SetMaterial( &m_materials.m_EpoxyBoard );
+            objPtr->SetColor( (SFVEC3F)m_settings.m_BoardBodyColor );
+            aDst.m_objects.Add( objPtr );
+#endif
+        }
+        else
+        {
+            CITEMLAYERCSG2D *itemCSG2d = new CITEMLAYERCSG2D(
+                        object2d_A,
+                        object2d_B,
+                        CSGITEM_FULL,
+                        (const BOARD_ITEM &)*m_settings.GetBoard() );
+
+            aDst.m_objects2D.Add( itemCSG2d );
+
+            CLAYERITEM *objPtr = new CLAYERITEM( itemCSG2d,
+                                                 m_settings.GetLayerBottomZpos3DU( F_Cu ),
+                                                 m_settings.GetLayerBottomZpos3DU( B_Cu ) );
+
+            objPtr->SetMaterial( &m_materials.m_EpoxyBoard );
+            objPtr->SetColor( (SFVEC3F)m_settings.m_BoardBodyColor );
+            aDst.m_objects.Add( objPtr );
+        }
+    }
+
+    // Add cylinders of the board body to container
+    // Note: This is actually a workarround for the holes in the board.
+    // The issue is because if a hole is in a border of a divided polygon ( ex
+    // a polygon or dummyblock) it will cut also the render of the hole.
+    // So this will add a full hole.
+    // In fact, that is not need if the hole have copper.
+    // /////////////////////////////////////////////////////////////////////////
+    if( !m_settings.GetThroughHole_Outer().GetList().empty() )
+    {
+        const LIST_OBJECT2D &holeList = m_settings.GetThroughHole_Outer().GetList();
+
+        for( LIST_OBJECT2D::const_iterator hole = holeList.begin();
+             hole != holeList.end();
+             ++hole )
+        {
+            const COBJECT2D *hole2d = static_cast<const COBJECT2D *>(*hole);
+
+            switch( hole2d->GetObjectType() )
+            {
+            case OBJ2D_FILLED_CIRCLE:
+            {
+                const float radius = hole2d->GetBBox().GetExtent().x * 0.5f * 0.999f;
+
+                CVCYLINDER *objPtr = new CVCYLINDER(
+                            hole2d->GetCentroid(),
+                            NextFloatDown( m_settings.GetLayerBottomZpos3DU( F_Cu ) ),
+                            NextFloatUp( m_settings.GetLayerBottomZpos3DU( B_Cu ) ),
+                            radius );
+
+                objPtr->SetMaterial( &m_materials.m_EpoxyBoard );
+                objPtr->SetColor( (SFVEC3F)m_settings.m_BoardBodyColor );
+
+                aDst.m_objects.Add( objPtr );
+            }
+            break;
+
+            default:
+                break;
+            }
+        }
+    }
+}
+
+
+void C3D_RENDER_RAYTRACING::create_layer( LAYER_ID aLayerID,
+                                          const CBVHCONTAINER2D *aContainer2d,
+                                          SCENE_PART &aDst )
+{
+    CMATERIAL *materialLayer = &m_materials.m_SilkS;
+    SFVEC3F layerColor = SFVEC3F( 0.0f, 0.0f, 0.0f );
+
+    switch( aLayerID )
+    {
+        case B_Adhes:
+        case F_Adhes:
+        break;
+
+        case B_Paste:
+        case F_Paste:
+            materialLayer = &m_materials.m_Paste;
+
+            if( m_settings.GetFlag( FL_USE_REALISTIC_MODE ) )
+                layerColor = m_settings.m_SolderPasteColor;
+            else
+                layerColor = m_settings.GetLayerColor( aLayerID );
+        break;
+
+        case B_SilkS:
+        case F_SilkS:
+            materialLayer = &m_materials.m_SilkS;
+
+            if( m_settings.GetFlag( FL_USE_REALISTIC_MODE ) )
+                layerColor = m_settings.m_SilkScreenColor;
+            else
+                layerColor = m_settings.GetLayerColor( aLayerID );
+        break;
+
+        case Dwgs_User:
+        case Cmts_User:
+        case Eco1_User:
+        case Eco2_User:
+        case Edge_Cuts:
+        case Margin:
+        break;
+
+        case B_CrtYd:
+        case F_CrtYd:
+        break;
+
+        case B_Fab:
+        case F_Fab:
+        break;
+
+        default:
+            materialLayer = &m_materials.m_Copper;
+
+            if( m_settings.GetFlag( FL_USE_REALISTIC_MODE ) )
+                layerColor = m_settings.m_CopperColor;
+            else
+                layerColor = m_settings.GetLayerColor( aLayerID );
+        break;
+    }
+
+    const LIST_OBJECT2D &listObject2d = aContainer2d->GetList();
+
+    for( LIST_OBJECT2D::const_iterator itemOnLayer = listObject2d.begin();
+         itemOnLayer != listObject2d.end();
+         ++itemOnLayer )
+    {
+        const COBJECT2D *object2d_A = static_cast<const COBJECT2D *>(*itemOnLayer);
+
+        // not yet used / implemented (can be used in future to clip the objects in the board borders
+        COBJECT2D *object2d_C = CSGITEM_FULL;
+
+        std::vector<const COBJECT2D *> *object2d_B = CSGITEM_EMPTY;
+
+        if( m_settings.GetFlag( FL_RENDER_SHOW_HOLES_IN_ZONES ) )
+        {
+            object2d_B = new std::vector<const COBJECT2D *>();
+
+            // Check if there are any layerhole that intersects this object
+            // Eg: a segment is cutted by a via hole or THT hole.
+            // /////////////////////////////////////////////////////////////
+            const MAP_CONTAINER_2D &layerHolesMap = m_settings.GetMapLayersHoles();
+
+            if( layerHolesMap.find(aLayerID) != layerHolesMap.end() )
+            {
+                MAP_CONTAINER_2D::const_iterator ii_hole = layerHolesMap.find(aLayerID);
+
+                const CBVHCONTAINER2D *containerLayerHoles2d =
+                        static_cast<const CBVHCONTAINER2D *>(ii_hole->second);
+
+
+                CONST_LIST_OBJECT2D intersectionList;
+                containerLayerHoles2d->GetListObjectsIntersects( object2d_A->GetBBox(),
+                                                                 intersectionList );
+
+                if( !intersectionList.empty() )
+                {
+                    for( CONST_LIST_OBJECT2D::const_iterator holeOnLayer =
+                         intersectionList.begin();
+                         holeOnLayer != intersectionList.end();
+                         ++holeOnLayer )
+                    {
+                        const COBJECT2D *hole2d = static_cast<const COBJECT2D *>(*holeOnLayer);
+
+                        //if( object2d_A->Intersects( hole2d->GetBBox() ) )
+                            //if( object2d_A->GetBBox().Intersects( hole2d->GetBBox() ) )
+                                object2d_B->push_back( hole2d );
+                    }
+                }
+            }
+
+            // Check if there are any THT that intersects this object
+            // /////////////////////////////////////////////////////////////
+            if( !m_settings.GetThroughHole_Outer().GetList().empty() )
+            {
+                CONST_LIST_OBJECT2D intersectionList;
+
+                m_settings.GetThroughHole_Outer().GetListObjectsIntersects(
+                            object2d_A->GetBBox(),
+                            intersectionList );
+
+                if( !intersectionList.empty() )
+                {
+                    for( CONST_LIST_OBJECT2D::const_iterator hole = intersectionList.begin();
+                         hole != intersectionList.end();
+                         ++hole )
+                    {
+                        const COBJECT2D *hole2d = static_cast<const COBJECT2D *>(*hole);
+
+                        //if( object2d_A->Intersects( hole2d->GetBBox() ) )
+                            //if( object2d_A->GetBBox().Intersects( hole2d->GetBBox() ) )
+                                object2d_B->push_back( hole2d );
+                    }
+                }
+            }
+
+            if( object2d_B->empty() )
+            {
+                delete object2d_B;
+                object2d_B = CSGITEM_EMPTY;
+            }
+        }
+
+        if( (object2d_B == CSGITEM_EMPTY) &&
+            (object2d_C == CSGITEM_FULL) )
+        {
+#if 0
+           create_3d_object_from( aDst.m_objects,
+                                  object2d_A,
+                                  m_settings.GetLayerBottomZpos3DU( aLayerID ),
+                                  m_settings.GetLayerTopZpos3DU( aLayerID ),
+                                  materialLayer,
+                                  layerColor );
+#else
+            CLAYERITEM *objPtr = new CLAYERITEM( object2d_A,
+                                                 m_settings.GetLayerBottomZpos3DU( aLayerID ),
+                                                 m_settings.GetLayerTopZpos3DU( aLayerID ) );
+            objPtr->SetMaterial( materialLayer );
+            objPtr->SetColor( layerColor );
+            aDst.m_objects.Add( objPtr );
+#endif
+        }
+        else
+        {
+#if 1
+            CITEMLAYERCSG2D *itemCSG2d = new CITEMLAYERCSG2D( object2d_A,
+                                                              object2d_B,
+                                                              object2d_C,
+                                                              object2d_A->GetBoardItem() );
+            aDst.m_objects2D.Add( itemCSG2d );
+
+            CLAYERITEM *objPtr = new CLAYERITEM( itemCSG2d,
+                                                 m_settings.GetLayerBottomZpos3DU( aLayerID ),
+                                                 m_settings.GetLayerTopZpos3DU( aLayerID ) );
+
+            objPtr->SetMaterial( materialLayer );
+            objPtr->SetColor( layerColor );
+
+            aDst.m_objects.Add( objPtr );
+#endif
+        }
+    }
+}
+
+
+void C3D_RENDER_RAYTRACING::create_solder_mask_layer( LAYER_ID aLayerID,
+                                                      const CBVHCONTAINER2D *aContainerLayer2d,
+                                                      SCENE_PART &aDst )
+{
+    CMATERIAL *materialLayer = &m_materials.m_SolderMask;
+
+    SFVEC3F layerColor;
+    if( m_settings.GetFlag( FL_USE_REALISTIC_MODE ) )
+        layerColor = m_settings.m_SolderMaskColor;
+    else
+        layerColor = m_settings.GetLayerColor( aLayerID );
+
+    const float zLayerMin = m_settings.GetLayerBottomZpos3DU( aLayerID );
+    const float zLayerMax = m_settings.GetLayerTopZpos3DU( aLayerID );
+
+    // Get the outline board objects
+    const LIST_OBJECT2D &listObjects = m_outlineBoard2dObjects->GetList();
+
+    for( LIST_OBJECT2D::const_iterator object2d_iterator = listObjects.begin();
+         object2d_iterator != listObjects.end();
+         ++object2d_iterator )
+    {
+        const COBJECT2D *object2d_A = static_cast<const COBJECT2D *>(*object2d_iterator);
+
+        std::vector<const COBJECT2D *> *object2d_B = new std::vector<const COBJECT2D *>();
+
+        // Check if there are any THT that intersects this outline object part
+        if( !m_settings.GetThroughHole_Outer().GetList().empty() )
+        {
+
+            CONST_LIST_OBJECT2D intersectionList;
+
+            m_settings.GetThroughHole_Outer().GetListObjectsIntersects(
+                        object2d_A->GetBBox(),
+                        intersectionList );
+
+            if( !intersectionList.empty() )
+            {
+                for( CONST_LIST_OBJECT2D::const_iterator hole = intersectionList.begin();
+                     hole != intersectionList.end();
+                     ++hole )
+                {
+                    const COBJECT2D *hole2d = static_cast<const COBJECT2D *>(*hole);
+
+                    if( object2d_A->Intersects( hole2d->GetBBox() ) )
+                    //if( object2d_A->GetBBox().Intersects( hole2d->GetBBox() ) )
+                        object2d_B->push_back( hole2d );
+                }
+            }
+        }
+
+        // Check if there are any objects in the layer to subtract with the
+        // corrent object
+        if( !aContainerLayer2d->GetList().empty() )
+        {
+            CONST_LIST_OBJECT2D intersectionList;
+
+            aContainerLayer2d->GetListObjectsIntersects( object2d_A->GetBBox(),
+                                                        intersectionList );
+
+            if( !intersectionList.empty() )
+            {
+                for( CONST_LIST_OBJECT2D::const_iterator obj = intersectionList.begin();
+                     obj != intersectionList.end();
+                     ++obj )
+                {
+                    const COBJECT2D *obj2d = static_cast<const COBJECT2D *>(*obj);
+
+                    //if( object2d_A->Intersects( obj2d->GetBBox() ) )
+                    //if( object2d_A->GetBBox().Intersects( obj2d->GetBBox() ) )
+                        object2d_B->push_back( obj2d );
+                }
+            }
+        }
+
+        if( object2d_B->empty() )
+        {
+            delete object2d_B;
+            object2d_B = CSGITEM_EMPTY;
+        }
+
+        if( object2d_B == CSGITEM_EMPTY )
+        {
+#if 0
+           create_3d_object_from( aDst.m_objects,
+                                  object2d_A,
+                                  zLayerMin,
+                                  zLayerMax,
+                                  materialLayer,
+                                  layerColor );
+#else
+            CLAYERITEM *objPtr =  new CLAYERITEM( object2d_A,
+                                                  zLayerMin,
+                                                  zLayerMax );
+
+            objPtr->SetMaterial( materialLayer );
+            objPtr->SetColor( layerColor );
+
+            aDst.m_objects.Add( objPtr );
+#endif
+        }
+        else
+        {
+            CITEMLAYERCSG2D *itemCSG2d = new CITEMLAYERCSG2D( object2d_A,
+                                                              object2d_B,
+                                                              CSGITEM_FULL,
+                                                              object2d_A->GetBoardItem() );
+
+            aDst.m_objects2D.Add( itemCSG2d );
+
+            CLAYERITEM *objPtr =  new CLAYERITEM( itemCSG2d,
+                                                  zLayerMin,
+                                                  zLayerMax );
+            objPtr->SetMaterial( materialLayer );
+            objPtr->SetColor( layerColor );
+
+            aDst.m_objects.Add( objPtr );
+        }
+    }
+}
+
+
+void C3D_RENDER_RAYTRACING::collect_scene_containers(
+        std::vector< const CGENERICCONTAINER * > &aContainers ) const
+{
+    aContainers.push_back( &m_boardPart.m_objects );
+    aContainers.push_back( &m_holesPart.m_objects );
+    aContainers.push_back( &m_floorPart.m_objects );
+
+    for( MAP_SCENE_PARTS::const_iterator ii = m_layerParts.begin();
+         ii != m_layerParts.end();
+         ++ii )
+        aContainers.push_back( &ii->second.m_objects );
+
+    for( MAP_MODEL_PARTS::const_iterator ii = m_modelParts.begin();
+         ii != m_modelParts.end();
+         ++ii )
+        aContainers.push_back( &ii->second.m_objects );
+}
+
+
 
 // Based on draw3DViaHole from
 // 3d_draw_helper_functions.cpp
-void C3D_RENDER_RAYTRACING::insert3DViaHole( const VIA* aVia )
+void C3D_RENDER_RAYTRACING::insert3DViaHole( const VIA* aVia, SCENE_PART &aDst )
 {
     LAYER_ID    top_layer, bottom_layer;
     int radiusBUI = (aVia->GetDrillValue() / 2);
@@ -980,7 +1080,7 @@ void C3D_RENDER_RAYTRACING::insert3DViaHole( const VIA* aVia )
                                  m_settings.BiuTo3Dunits(),
                                  *aVia );
 
-    m_containerWithObjectsToDelete.Add( ring );
+    aDst.m_objects2D.Add( ring );
 
 
     CLAYERITEM *objPtr = new CLAYERITEM( ring, topZ, botZ );
@@ -992,13 +1092,13 @@ void C3D_RENDER_RAYTRACING::insert3DViaHole( const VIA* aVia )
     else
         objPtr->SetColor( m_settings.GetItemColor( VIAS_VISIBLE + aVia->GetViaType() ) );
 
-    m_object_container.Add( objPtr );
+    aDst.m_objects.Add( objPtr );
 }
 
 
 // Based on draw3DPadHole from
 // 3d_draw_helper_functions.cpp
-void C3D_RENDER_RAYTRACING::insert3DPadHole( const D_PAD* aPad )
+void C3D_RENDER_RAYTRACING::insert3DPadHole( const D_PAD* aPad, SCENE_PART &aDst )
 {
     const COBJECT2D *object2d_A = NULL;
 
@@ -1033,7 +1133,7 @@ void C3D_RENDER_RAYTRACING::insert3DPadHole( const D_PAD* aPad )
                                      m_settings.BiuTo3Dunits(),
                                      *aPad );
 
-        m_containerWithObjectsToDelete.Add( ring );
+        aDst.m_objects2D.Add( ring );
 
         object2d_A = ring;
     }
@@ -1085,9 +1185,9 @@ void C3D_RENDER_RAYTRACING::insert3DPadHole( const D_PAD* aPad )
                                                           CSGITEM_FULL,
                                                           *aPad );
 
-        m_containerWithObjectsToDelete.Add( itemCSG2d );
-        m_containerWithObjectsToDelete.Add( innerSeg );
-        m_containerWithObjectsToDelete.Add( outterSeg );
+        aDst.m_objects2D.Add( itemCSG2d );
+        aDst.m_objects2D.Add( innerSeg );
+        aDst.m_objects2D.Add( outterSeg );
 
         object2d_A = itemCSG2d;
     }
@@ -1133,7 +1233,7 @@ void C3D_RENDER_RAYTRACING::insert3DPadHole( const D_PAD* aPad )
 
             objPtr->SetMaterial( &m_materials.m_Copper );
             objPtr->SetColor( objColor );
-            m_object_container.Add( objPtr );
+            aDst.m_objects.Add( objPtr );
         }
         else
         {
@@ -1142,20 +1242,20 @@ void C3D_RENDER_RAYTRACING::insert3DPadHole( const D_PAD* aPad )
                                                               CSGITEM_FULL,
                                                               (const BOARD_ITEM &)*aPad );
 
-            m_containerWithObjectsToDelete.Add( itemCSG2d );
+            aDst.m_objects2D.Add( itemCSG2d );
 
             CLAYERITEM *objPtr = new CLAYERITEM( itemCSG2d, topZ, botZ );
 
             objPtr->SetMaterial( &m_materials.m_Copper );
             objPtr->SetColor( objColor );
 
-            m_object_container.Add( objPtr );
+            aDst.m_objects.Add( objPtr );
         }
     }
 }
 
 
-void C3D_RENDER_RAYTRACING::add_3D_vias_and_pads_to_container()
+void C3D_RENDER_RAYTRACING::add_3D_vias_and_pads_to_container( SCENE_PART &aDst )
 {
     // Insert plated vertical holes inside the board
     // /////////////////////////////////////////////////////////////////////////
@@ -1168,7 +1268,7 @@ void C3D_RENDER_RAYTRACING::add_3D_vias_and_pads_to_container()
         if( track->Type() == PCB_VIA_T )
         {
             const VIA *via = static_cast<const VIA*>(track);
-            insert3DViaHole( via );
+            insert3DViaHole( via, aDst );
         }
     }
 
@@ -1180,7 +1280,7 @@ void C3D_RENDER_RAYTRACING::add_3D_vias_and_pads_to_container()
         for( const D_PAD* pad = module->Pads(); pad; pad = pad->Next() )
             if( pad->GetAttribute () != PAD_ATTRIB_HOLE_NOT_PLATED )
             {
-                insert3DPadHole( pad );
+                insert3DPadHole( pad, aDst );
             }
     }
 }
@@ -1188,11 +1288,24 @@ void C3D_RENDER_RAYTRACING::add_3D_vias_and_pads_to_container()
 
 void C3D_RENDER_RAYTRACING::load_3D_models()
 {
+    const bool rebuildAll = m_settings.WasFullyRebuilt();
+    const std::set< const BOARD_ITEM * > &changedModules = m_settings.GetChangedModules();
+
+    // The changed footprints may have been deleted, so they are only used as keys
+    if( !rebuildAll )
+    {
+        for( const BOARD_ITEM *module : changedModules )
+            m_modelParts.erase( module );
+    }
+
     // Go for all modules
     for( const MODULE* module = m_settings.GetBoard()->m_Modules;
          module;
          module = module->Next() )
     {
+        if( !rebuildAll && !changedModules.count( module ) )
+            continue;
+
         if( (!module->Models().empty() ) &&
             m_settings.ShouldModuleBeDisplayed( (MODULE_ATTR_T)module->GetAttributes() ) )
         {
@@ -1276,7 +1389,7 @@ void C3D_RENDER_RAYTRACING::load_3D_models()
                                                        sM->m_Scale.y,
                                                        sM->m_Scale.z ) );
 
-                    add_3D_models( modelPtr, modelMatrix );
+                    add_3D_models( modelPtr, modelMatrix, m_modelParts[module].m_objects );
                 }
 
                 ++sM;
@@ -1287,7 +1400,8 @@ void C3D_RENDER_RAYTRACING::load_3D_models()
 
 
 void C3D_RENDER_RAYTRACING::add_3D_models( const S3DMODEL *a3DModel,
-                                           const glm::mat4 &aModelMatrix )
+                                           const glm::mat4 &aModelMatrix,
+                                           CCONTAINER &aDstContainer )
 {
 
     // Validate a3DModel pointers
@@ -1476,7 +1590,7 @@ void C3D_RENDER_RAYTRACING::add_3D_models( const S3DMODEL *a3DModel,
 
 
 
-                        m_object_container.Add( newTriangle );
+                        aDstContainer.Add( newTriangle );
                         newTriangle->SetMaterial( (const CMATERIAL *)&blinn_material );
 
                         if( mesh.m_Color == NULL )
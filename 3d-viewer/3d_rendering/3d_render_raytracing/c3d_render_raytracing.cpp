@@ -62,6 +62,7 @@ C3D_RENDER_RAYTRACING::C3D_RENDER_RAYTRACING( CINFO3D_VISU &aSettings ) :
     m_outlineBoard2dObjects = NULL;
     m_firstHitinfo = NULL;
     m_shaderBuffer = NULL;
+    m_shaderBufferHalf = NULL;
     m_camera_light = NULL;
 
     m_xoffset = 0;
@@ -85,6 +86,9 @@ C3D_RENDER_RAYTRACING::~C3D_RENDER_RAYTRACING()
     delete m_shaderBuffer;
     m_shaderBuffer = NULL;
 
+    delete[] m_shaderBufferHalf;
+    m_shaderBufferHalf = NULL;
+
     opengl_delete_pbo();
 }
 
@@ -509,10 +513,79 @@ void C3D_RENDER_RAYTRACING::rt_shades_packet(const SFVEC3F *bgColorY,
 }
 
 
+// Adaptive anti aliasing: two samples of a pixel, or two neighbour pixels, which
+// differ by less than these thresholds are considered as the same surface and
+// the pixel does not get the extra anti aliasing samples.
+#define AA_COLOR_THRESHOLD  ( 3.0f / 255.0f )
+#define AA_DEPTH_THRESHOLD  0.01f
+
+static bool aaColorsDiffer( const SFVEC3F &aColorA, const SFVEC3F &aColorB )
+{
+    const SFVEC3F diff = glm::abs( aColorA - aColorB );
+
+    return glm::max( diff.r, glm::max( diff.g, diff.b ) ) > AA_COLOR_THRESHOLD;
+}
+
+
+static bool aaHitsDiffer( const HITINFO_PACKET &aHitA, const HITINFO_PACKET &aHitB )
+{
+    if( aHitA.m_hitresult != aHitB.m_hitresult )
+        return true;
+
+    if( !aHitA.m_hitresult )
+        return false;
+
+    const float tA = aHitA.m_HitInfo.m_tHit;
+    const float tB = aHitB.m_HitInfo.m_tHit;
+
+    return glm::abs( tA - tB ) > AA_DEPTH_THRESHOLD * glm::max( tA, tB );
+}
+
+
+/**
+ * @brief selectPixelsToRefine - flags the pixels of a packet which need more
+ * anti aliasing samples: those whose first two samples differ, or which differ
+ * from their right and bottom neighbours (the area covered by the extra samples)
+ * in color or depth.
+ * @return false if the whole block is smooth, so no extra rays are needed at all
+ */
+static bool selectPixelsToRefine( const HITINFO_PACKET *aHitPck_X0Y0,
+                                  const HITINFO_PACKET *aHitPck_AA_X1Y1,
+                                  const SFVEC3F *aColor_X0Y0,
+                                  const SFVEC3F *aColor_AA_X1Y1,
+                                  bool *aOutRefinePixel )
+{
+    bool anyPixel = false;
+
+    for( unsigned int y = 0, i = 0; y < RAYPACKET_DIM; ++y )
+    {
+        for( unsigned int x = 0; x < RAYPACKET_DIM; ++x, ++i )
+        {
+            bool refine = aaColorsDiffer( aColor_X0Y0[i], aColor_AA_X1Y1[i] ) ||
+                          aaHitsDiffer( aHitPck_X0Y0[i], aHitPck_AA_X1Y1[i] );
+
+            if( !refine && ( x < (RAYPACKET_DIM - 1) ) )
+                refine = aaColorsDiffer( aColor_X0Y0[i], aColor_X0Y0[i + 1] ) ||
+                         aaHitsDiffer( aHitPck_X0Y0[i], aHitPck_X0Y0[i + 1] );
+
+            if( !refine && ( y < (RAYPACKET_DIM - 1) ) )
+                refine = aaColorsDiffer( aColor_X0Y0[i], aColor_X0Y0[i + RAYPACKET_DIM] ) ||
+                         aaHitsDiffer( aHitPck_X0Y0[i], aHitPck_X0Y0[i + RAYPACKET_DIM] );
+
+            aOutRefinePixel[i] = refine;
+            anyPixel |= refine;
+        }
+    }
+
+    return anyPixel;
+}
+
+
 void C3D_RENDER_RAYTRACING::rt_trace_AA_packet( const SFVEC3F *aBgColorY,
                                                 const HITINFO_PACKET *aHitPck_X0Y0,
                                                 const HITINFO_PACKET *aHitPck_AA_X1Y1,
                                                 const RAY *aRayPck,
+                                                const bool *aRefinePixel,
                                                 SFVEC3F *aOutHitColor )
 {
     // If post processing is using, do not calculate shadows as they will not be
@@ -524,6 +597,10 @@ void C3D_RENDER_RAYTRACING::rt_trace_AA_packet( const SFVEC3F *aBgColorY,
     {
         for( unsigned int x = 0; x < RAYPACKET_DIM; ++x, ++i )
         {
+            // Smooth pixels keep the average of the first two samples
+            if( !aRefinePixel[i] )
+                continue;
+
             const RAY &rayAA = aRayPck[i];
 
             HITINFO hitAA;
@@ -770,63 +847,82 @@ void C3D_RENDER_RAYTRACING::rt_render_trace_block( GLubyte *ptrPBO ,
                               );
         }
 
-        SFVEC3F hitColor_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
-        SFVEC3F hitColor_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
-        SFVEC3F hitColor_AA_X0Y1_half[RAYPACKET_RAYS_PER_PACKET];
+        // Only the pixels on edges, or where the two first samples disagree, get
+        // the three extra samples. The others, and the whole block if it is smooth,
+        // are the average of the two first samples.
+        bool refinePixel[RAYPACKET_RAYS_PER_PACKET];
 
-        for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+        if( !selectPixelsToRefine( hitPacket_X0Y0, hitPacket_AA_X1Y1,
+                                   hitColor_X0Y0, hitColor_AA_X1Y1,
+                                   refinePixel ) )
         {
-            const SFVEC3F color_average = ( hitColor_X0Y0[i] +
-                                            hitColor_AA_X1Y1[i] ) * SFVEC3F(0.5f);
-
-            hitColor_AA_X1Y0[i] = color_average;
-            hitColor_AA_X0Y1[i] = color_average;
-            hitColor_AA_X0Y1_half[i] = color_average;
+            for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+                hitColor_X0Y0[i] = ( hitColor_X0Y0[i] +
+                                     hitColor_AA_X1Y1[i] ) * SFVEC3F(0.5f);
         }
-
-        RAY blockRayPck_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
-        RAY blockRayPck_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
-        RAY blockRayPck_AA_X1Y1_half[RAYPACKET_RAYS_PER_PACKET];
-
-        RAYPACKET_InitRays_with2DDisplacement( m_settings.CameraGet(),
-                                               (SFVEC2F)blockPosI + SFVEC2F(0.5f - DISP_FACTOR, DISP_FACTOR),
-                                               SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
-                                               blockRayPck_AA_X1Y0 );
-
-        RAYPACKET_InitRays_with2DDisplacement( m_settings.CameraGet(),
-                                               (SFVEC2F)blockPosI + SFVEC2F(DISP_FACTOR, 0.5f - DISP_FACTOR),
-                                               SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
-                                               blockRayPck_AA_X0Y1 );
-
-        RAYPACKET_InitRays_with2DDisplacement( m_settings.CameraGet(),
-                                               (SFVEC2F)blockPosI + SFVEC2F(0.25f - DISP_FACTOR, 0.25f - DISP_FACTOR),
-                                               SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
-                                               blockRayPck_AA_X1Y1_half );
-
-        rt_trace_AA_packet( bgColor,
-                            hitPacket_X0Y0, hitPacket_AA_X1Y1,
-                            blockRayPck_AA_X1Y0,
-                            hitColor_AA_X1Y0 );
-
-        rt_trace_AA_packet( bgColor,
-                            hitPacket_X0Y0, hitPacket_AA_X1Y1,
-                            blockRayPck_AA_X0Y1,
-                            hitColor_AA_X0Y1 );
-
-        rt_trace_AA_packet( bgColor,
-                            hitPacket_X0Y0, hitPacket_AA_X1Y1,
-                            blockRayPck_AA_X1Y1_half,
-                            hitColor_AA_X0Y1_half );
-
-        // Average the result
-        for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+        else
         {
-            hitColor_X0Y0[i] = ( hitColor_X0Y0[i] +
-                                 hitColor_AA_X1Y1[i] +
-                                 hitColor_AA_X1Y0[i] +
-                                 hitColor_AA_X0Y1[i] +
-                                 hitColor_AA_X0Y1_half[i]
-                                 ) * SFVEC3F(1.0f / 5.0f);
+            SFVEC3F hitColor_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
+            SFVEC3F hitColor_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
+            SFVEC3F hitColor_AA_X0Y1_half[RAYPACKET_RAYS_PER_PACKET];
+
+            for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+            {
+                const SFVEC3F color_average = ( hitColor_X0Y0[i] +
+                                                hitColor_AA_X1Y1[i] ) * SFVEC3F(0.5f);
+
+                hitColor_AA_X1Y0[i] = color_average;
+                hitColor_AA_X0Y1[i] = color_average;
+                hitColor_AA_X0Y1_half[i] = color_average;
+            }
+
+            RAY blockRayPck_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
+            RAY blockRayPck_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
+            RAY blockRayPck_AA_X1Y1_half[RAYPACKET_RAYS_PER_PACKET];
+
+            RAYPACKET_InitRays_with2DDisplacement( m_settings.CameraGet(),
+                                                   (SFVEC2F)blockPosI + SFVEC2F(0.5f - DISP_FACTOR, DISP_FACTOR),
+                                                   SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
+                                                   blockRayPck_AA_X1Y0 );
+
+            RAYPACKET_InitRays_with2DDisplacement( m_settings.CameraGet(),
+                                                   (SFVEC2F)blockPosI + SFVEC2F(DISP_FACTOR, 0.5f - DISP_FACTOR),
+                                                   SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
+                                                   blockRayPck_AA_X0Y1 );
+
+            RAYPACKET_InitRays_with2DDisplacement( m_settings.CameraGet(),
+                                                   (SFVEC2F)blockPosI + SFVEC2F(0.25f - DISP_FACTOR, 0.25f - DISP_FACTOR),
+                                                   SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
+                                                   blockRayPck_AA_X1Y1_half );
+
+            rt_trace_AA_packet( bgColor,
+                                hitPacket_X0Y0, hitPacket_AA_X1Y1,
+                                blockRayPck_AA_X1Y0,
+                                refinePixel,
+                                hitColor_AA_X1Y0 );
+
+            rt_trace_AA_packet( bgColor,
+                                hitPacket_X0Y0, hitPacket_AA_X1Y1,
+                                blockRayPck_AA_X0Y1,
+                                refinePixel,
+                                hitColor_AA_X0Y1 );
+
+            rt_trace_AA_packet( bgColor,
+                                hitPacket_X0Y0, hitPacket_AA_X1Y1,
+                                blockRayPck_AA_X1Y1_half,
+                                refinePixel,
+                                hitColor_AA_X0Y1_half );
+
+            // Average the result
+            for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+            {
+                hitColor_X0Y0[i] = ( hitColor_X0Y0[i] +
+                                     hitColor_AA_X1Y1[i] +
+                                     hitColor_AA_X1Y0[i] +
+                                     hitColor_AA_X0Y1[i] +
+                                     hitColor_AA_X0Y1_half[i]
+                                     ) * SFVEC3F(1.0f / 5.0f);
+            }
         }
     }
 
@@ -904,7 +1000,21 @@ void C3D_RENDER_RAYTRACING::rt_render_post_process_shade( GLubyte *ptrPBO,
         if( aStatusTextReporter )
             aStatusTextReporter->Report( _("Rendering: Post processing shader") );
 
-        // Compute the shader value
+        // Compute the shader value at half resolution, on the even pixels
+        #pragma omp parallel for schedule(dynamic)
+        for( signed int y = 0; y < (int)m_shaderBufferHalfSize.y; ++y )
+        {
+            SFVEC3F *ptr = &m_shaderBufferHalf[ y * m_shaderBufferHalfSize.x ];
+
+            for( signed int x = 0; x < (int)m_shaderBufferHalfSize.x; ++x )
+            {
+                *ptr = m_postshader_ssao.Shade( SFVEC2I( x * 2, y * 2 ) );
+                ptr++;
+            }
+        }
+
+        // Upsample it, the pixels on edges which do not match any of the
+        // computed ones are shaded at full resolution
         #pragma omp parallel for schedule(dynamic)
         for( signed int y = 0; y < (int)m_realBufferSize.y; ++y )
         {
@@ -912,7 +1022,16 @@ void C3D_RENDER_RAYTRACING::rt_render_post_process_shade( GLubyte *ptrPBO,
 
             for( signed int x = 0; x < (int)m_realBufferSize.x; ++x )
             {
-                *ptr = m_postshader_ssao.Shade( SFVEC2I( x, y ) );
+                const SFVEC2I shaderPos( x, y );
+
+                if( ( (x | y) & 1 ) == 0 )
+                    *ptr = m_shaderBufferHalf[ (x / 2) + (y / 2) * m_shaderBufferHalfSize.x ];
+                else if( !m_postshader_ssao.UpsampleShade( shaderPos,
+                                                           m_shaderBufferHalf,
+                                                           m_shaderBufferHalfSize,
+                                                           *ptr ) )
+                    *ptr = m_postshader_ssao.Shade( shaderPos );
+
                 ptr++;
             }
         }
@@ -1910,6 +2029,12 @@ SFVEC3F C3D_RENDER_RAYTRACING::shadeHit( const SFVEC3F &aBgColor,
                                  (1.0f / ( 1.0f + 0.75f * reflectedHit.m_tHit *
                                                           reflectedHit.m_tHit) ); // Falloff factor
                 }
+                else
+                {
+                    // The reflected vector is not randomized, so the other samples
+                    // would miss as well
+                    break;
+                }
             }
 
             outColor += (sum_color / SFVEC3F( (float)reflection_number_of_samples) );
@@ -2110,5 +2235,11 @@ void C3D_RENDER_RAYTRACING::initialize_block_positions()
     delete m_shaderBuffer;
     m_shaderBuffer = new SFVEC3F[m_realBufferSize.x * m_realBufferSize.y];
 
+    m_shaderBufferHalfSize = SFVEC2UI( (m_realBufferSize.x + 1) / 2,
+                                       (m_realBufferSize.y + 1) / 2 );
+
+    delete[] m_shaderBufferHalf;
+    m_shaderBufferHalf = new SFVEC3F[m_shaderBufferHalfSize.x * m_shaderBufferHalfSize.y];
+
     opengl_init_pbo();
 }
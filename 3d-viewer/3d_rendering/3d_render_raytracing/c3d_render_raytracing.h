@@ -40,6 +40,7 @@
 #include <plugins/3dapi/c3dmodel.h>
 
 #include <map>
+#include <vector>
 
 /// Vector of materials
 typedef std::vector< CBLINN_PHONG_MATERIAL > MODEL_MATERIALS;
@@ -47,6 +48,32 @@ typedef std::vector< CBLINN_PHONG_MATERIAL > MODEL_MATERIALS;
 /// Maps a S3DMODEL pointer with a created CBLINN_PHONG_MATERIAL vector
 typedef std::map< const S3DMODEL * , MODEL_MATERIALS > MAP_MODEL_MATERIALS;
 
+/**
+ * Struct SCENE_PART
+ * holds the 3D objects created for a piece of the board (a layer, the holes, a
+ * footprint...) and the 2D objects created for them, so that the piece can be
+ * replaced alone when the board changes.
+ */
+struct SCENE_PART
+{
+    CCONTAINER m_objects;
+
+    /// 2D objects special for RT, referred by m_objects
+    CCONTAINER2D m_objects2D;
+
+    void Clear()
+    {
+        m_objects.Clear();
+        m_objects2D.Clear();
+    }
+};
+
+/// Maps a layer with the part of the scene created from its 2D items
+typedef std::map< LAYER_ID, SCENE_PART > MAP_SCENE_PARTS;
+
+/// Maps a footprint with the part of the scene holding its 3D models
+typedef std::map< const BOARD_ITEM *, SCENE_PART > MAP_MODEL_PARTS;
+
 typedef enum
 {
     RT_RENDER_STATE_TRACING = 0,
@@ -93,6 +120,7 @@ private:
                              const HITINFO_PACKET *aHitPck_X0Y0,
                              const HITINFO_PACKET *aHitPck_AA_X1Y1,
                              const RAY *aRayPck,
+                             const bool *aRefinePixel,
                              SFVEC3F *aOutHitColor );
 
     // Materials
@@ -143,11 +171,12 @@ private:
     GLuint m_pboId;
     GLuint m_pboDataSize;
 
-    CCONTAINER m_object_container;
-
-    /// This will store the list of created objects special for RT,
-    /// that will be clear in the end
-    CCONTAINER2D m_containerWithObjectsToDelete;
+    // The scene, split in parts that can be rebuilt alone
+    SCENE_PART      m_boardPart;
+    SCENE_PART      m_holesPart;
+    SCENE_PART      m_floorPart;
+    MAP_SCENE_PARTS m_layerParts;
+    MAP_MODEL_PARTS m_modelParts;
 
     CCONTAINER2D *m_outlineBoard2dObjects;
 
@@ -175,6 +204,10 @@ private:
 
     SFVEC3F *m_shaderBuffer;
 
+    /// Post processing shader values computed at the even pixels only
+    SFVEC3F *m_shaderBufferHalf;
+    SFVEC2UI m_shaderBufferHalfSize;
+
     // Display Offset
     unsigned int m_xoffset;
     unsigned int m_yoffset;
@@ -189,12 +222,26 @@ private:
                                 const CMATERIAL *aMaterial,
                                 const SFVEC3F &aObjColor );
 
-    void add_3D_vias_and_pads_to_container();
-    void insert3DViaHole( const VIA* aVia );
-    void insert3DPadHole( const D_PAD* aPad );
+    void create_board_body( SCENE_PART &aDst );
+
+    void create_layer( LAYER_ID aLayerID,
+                       const CBVHCONTAINER2D *aContainer2d,
+                       SCENE_PART &aDst );
+
+    void create_solder_mask_layer( LAYER_ID aLayerID,
+                                   const CBVHCONTAINER2D *aContainerLayer2d,
+                                   SCENE_PART &aDst );
+
+    /// Appends the 3D objects containers of all the parts of the scene
+    void collect_scene_containers( std::vector< const CGENERICCONTAINER * > &aContainers ) const;
+
+    void add_3D_vias_and_pads_to_container( SCENE_PART &aDst );
+    void insert3DViaHole( const VIA* aVia, SCENE_PART &aDst );
+    void insert3DPadHole( const D_PAD* aPad, SCENE_PART &aDst );
     void load_3D_models();
     void add_3D_models( const S3DMODEL *a3DModel,
-                        const glm::mat4 &aModelMatrix );
+                        const glm::mat4 &aModelMatrix,
+                        CCONTAINER &aDstContainer );
 
     /// Stores materials of the 3D models
     MAP_MODEL_MATERIALS m_model_materials;
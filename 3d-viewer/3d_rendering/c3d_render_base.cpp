@@ -47,6 +47,7 @@ C3D_RENDER_BASE::C3D_RENDER_BASE(CINFO3D_VISU &aSettings) :
     m_is_opengl_initialized = false;
     m_windowSize            = wxSize( -1, -1 );
     m_reloadRequested       = true;
+    m_settingsSerial        = 0;
 }
 
 
@@ -54,3 +55,13 @@ C3D_RENDER_BASE::~C3D_RENDER_BASE()
 {
 }
 
+
+void C3D_RENDER_BASE::initSettings( REPORTER *aStatusTextReporter )
+{
+    if( m_settingsSerial != m_settings.GetBuildSerial() )
+        m_settings.InvalidateAll();
+
+    m_settings.InitSettings( aStatusTextReporter );
+
+    m_settingsSerial = m_settings.GetBuildSerial();
+}
@@ -67,10 +67,19 @@ public:
     virtual bool Redraw( bool aIsMoving, REPORTER *aStatusTextReporter = NULL ) = 0;
 
     /**
-     * @brief ReloadRequest - !TODO: this must be reviewed to add flags to
-     * improve specific render
+     * @brief ReloadRequest - Ask to build the whole scene again
      */
-    void ReloadRequest() { m_reloadRequested = true; }
+    void ReloadRequest()
+    {
+        m_settings.InvalidateAll();
+        m_reloadRequested = true;
+    }
+
+    /**
+     * @brief UpdateRequest - Ask to build again only what was invalidated in
+     * the settings since the last reload
+     */
+    void UpdateRequest() { m_reloadRequested = true; }
 
     /**
      * @brief IsReloadRequestPending - Query if there is a pending reload request
@@ -86,6 +95,16 @@ public:
      */
     virtual int GetWaitForEditingTimeOut() = 0;
 
+protected:
+
+    /**
+     * @brief initSettings - Build the settings for this render. The settings are
+     * shared by the renders, so if another one built them after this render did,
+     * everything is built again as this render does not know what changed.
+     * @param aStatusTextReporter: a pointer to the status progress reporter
+     */
+    void initSettings( REPORTER *aStatusTextReporter );
+
     // Attributes
 
 protected:
@@ -99,6 +118,9 @@ protected:
     /// !TODO: this must be reviewed in order to flag change types
     bool m_reloadRequested;
 
+    /// the build serial of the settings when this render last built them
+    unsigned int m_settingsSerial;
+
     /// The window size that this camera is working.
     wxSize m_windowSize;
 
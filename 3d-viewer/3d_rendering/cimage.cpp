@@ -31,6 +31,11 @@
 #include "buffers_debug.h"
 #include <string.h> // For memcpy
 
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#include <emmintrin.h>
+#define CIMAGE_USE_SSE2
+#endif
+
 #ifndef CLAMP
 #define CLAMP(n, min, max) {if( n < min ) n=min; else if( n > max ) n = max;}
 #endif
@@ -462,6 +467,60 @@ static const S_FILTER FILTERS[] =   {
 //        do it without use the getpixel function.
 //        Optimization can be done to m_pixels[ix + iy * m_width]
 //        but keep in mind the parallel process of the algorithm
+static inline unsigned char filterResult( int aSum, const S_FILTER &aFilter )
+{
+    int v = aSum;
+
+    v /= aFilter.div;
+
+    v += aFilter.offset;
+
+    CLAMP(v, 0, 255);
+
+    return v;
+}
+
+
+/// Filters a pixel near the borders, reading the source with clamped coordinates
+static unsigned char filterPixelClamped( const CIMAGE *aInImg, const S_FILTER &aFilter,
+                                         int aX, int aY )
+{
+    int v = 0;
+
+    for( int sy = 0; sy < 5; sy++ )
+    {
+        for( int sx = 0; sx < 5; sx++ )
+        {
+            int factor = aFilter.kernel[sx][sy];
+            unsigned char pixelv = aInImg->Getpixel( aX + sx - 2,
+                                                     aY + sy - 2 );
+
+            v += pixelv * factor;
+        }
+    }
+
+    return filterResult( v, aFilter );
+}
+
+
+/// Filters a pixel at least 2 pixels away from the borders
+static inline unsigned char filterPixelInner( const unsigned char *aSrc, int aStride,
+                                              const S_FILTER &aFilter )
+{
+    int v = 0;
+
+    for( int sy = 0; sy < 5; sy++ )
+    {
+        const unsigned char *row = aSrc + (sy - 2) * aStride - 2;
+
+        for( int sx = 0; sx < 5; sx++ )
+            v += row[sx] * aFilter.kernel[sx][sy];
+    }
+
+    return filterResult( v, aFilter );
+}
+
+
 void CIMAGE::EfxFilter( CIMAGE *aInImg, E_FILTER aFilterType )
 {
     S_FILTER filter = FILTERS[aFilterType];
@@ -469,33 +528,84 @@ void CIMAGE::EfxFilter( CIMAGE *aInImg, E_FILTER aFilterType )
     aInImg->m_wraping = WRAP_CLAMP;
     m_wraping = WRAP_CLAMP;
 
+    const int width  = (int)m_width;
+    const int height = (int)m_height;
+
+    // The inner pixels read the source buffer directly, it must have the same size
+    const bool sameSize = ( aInImg->m_width == m_width ) && ( aInImg->m_height == m_height );
+
+#ifdef CIMAGE_USE_SSE2
+    // Kernel factors in the low 16 bits of each 32 bit lane: a _mm_madd_epi16 of
+    // a pixel zero extended to 32 bits with it gives pixel * factor
+    __m128i kernel[5][5];
+
+    for( int sy = 0; sy < 5; sy++ )
+        for( int sx = 0; sx < 5; sx++ )
+            kernel[sx][sy] = _mm_set1_epi32( (unsigned short)filter.kernel[sx][sy] );
+#endif
+
     #pragma omp parallel for
-    for( int iy = 0; iy < (int)m_height; iy++)
+    for( int iy = 0; iy < height; iy++)
     {
-        for( int ix = 0; ix < (int)m_width; ix++ )
+        unsigned char *dst = &m_pixels[iy * m_width];
+
+        if( !sameSize || ( iy < 2 ) || ( iy >= height - 2 ) )
         {
-            int v = 0;
+            for( int ix = 0; ix < width; ix++ )
+                dst[ix] = filterPixelClamped( aInImg, filter, ix, iy );
+
+            continue;
+        }
+
+        const unsigned char *src = &aInImg->m_pixels[iy * m_width];
+
+        for( int ix = 0; ( ix < 2 ) && ( ix < width ); ix++ )
+            dst[ix] = filterPixelClamped( aInImg, filter, ix, iy );
+
+        int ix = 2;
+
+#ifdef CIMAGE_USE_SSE2
+        // 8 pixels at a time
+        const __m128i zero = _mm_setzero_si128();
+
+        for( ; ix + 8 <= width - 2; ix += 8 )
+        {
+            __m128i sumLo = _mm_setzero_si128();
+            __m128i sumHi = _mm_setzero_si128();
 
             for( int sy = 0; sy < 5; sy++ )
             {
+                const unsigned char *row = src + (sy - 2) * width + ix - 2;
+
                 for( int sx = 0; sx < 5; sx++ )
                 {
-                    int factor = filter.kernel[sx][sy];
-                    unsigned char pixelv = aInImg->Getpixel( ix + sx - 2,
-                                                             iy + sy - 2 );
-
-                    v += pixelv * factor;
+                    const __m128i pixels16 = _mm_unpacklo_epi8(
+                            _mm_loadl_epi64( (const __m128i *)( row + sx ) ), zero );
+
+                    sumLo = _mm_add_epi32( sumLo,
+                                           _mm_madd_epi16( _mm_unpacklo_epi16( pixels16, zero ),
+                                                           kernel[sx][sy] ) );
+                    sumHi = _mm_add_epi32( sumHi,
+                                           _mm_madd_epi16( _mm_unpackhi_epi16( pixels16, zero ),
+                                                           kernel[sx][sy] ) );
                 }
             }
 
-            v /= filter.div;
-
-            v += filter.offset;
+            int sums[8];
 
-            CLAMP(v, 0, 255);
+            _mm_storeu_si128( (__m128i *)&sums[0], sumLo );
+            _mm_storeu_si128( (__m128i *)&sums[4], sumHi );
 
-            m_pixels[ix + iy * m_width] = v;
+            for( int i = 0; i < 8; i++ )
+                dst[ix + i] = filterResult( sums[i], filter );
         }
+#endif
+
+        for( ; ix < width - 2; ix++ )
+            dst[ix] = filterPixelInner( &src[ix], width, filter );
+
+        for( ; ix < width; ix++ )
+            dst[ix] = filterPixelClamped( aInImg, filter, ix, iy );
     }
 }
 
@@ -188,6 +188,77 @@ const float &CPOSTSHADER::GetShadowFactorAt( const SFVEC2I &aPos ) const
 }
 
 
+bool CPOSTSHADER::UpsampleShade( const SFVEC2I &aShaderPos,
+                                 const SFVEC3F *aHalfResShade,
+                                 const SFVEC2UI &aHalfResSize,
+                                 SFVEC3F &aOutShade ) const
+{
+    const unsigned int idx = getIndex( aShaderPos );
+    const float depth = m_depth[ idx ];
+
+    // Background, the shaders do not process it
+    if( depth <= FLT_EPSILON )
+    {
+        aOutShade = SFVEC3F( 0.0f );
+
+        return true;
+    }
+
+    const SFVEC3F &normal = m_normals[ idx ];
+
+    // The 2x2 low resolution samples around the pixel and their bilinear weights
+    const int hx0 = aShaderPos.x / 2;
+    const int hy0 = aShaderPos.y / 2;
+    const int hx1 = glm::min( hx0 + (aShaderPos.x & 1), (int)aHalfResSize.x - 1 );
+    const int hy1 = glm::min( hy0 + (aShaderPos.y & 1), (int)aHalfResSize.y - 1 );
+
+    const int sampleX[4] = { hx0, hx1, hx0, hx1 };
+    const int sampleY[4] = { hy0, hy0, hy1, hy1 };
+
+    const float fx = (aShaderPos.x & 1) ? 0.5f : 0.0f;
+    const float fy = (aShaderPos.y & 1) ? 0.5f : 0.0f;
+
+    const float bilinear[4] = { (1.0f - fx) * (1.0f - fy),
+                                fx * (1.0f - fy),
+                                (1.0f - fx) * fy,
+                                fx * fy };
+
+    SFVEC3F sum = SFVEC3F( 0.0f );
+    float sumWeight = 0.0f;
+
+    for( unsigned int i = 0; i < 4; ++i )
+    {
+        if( bilinear[i] <= 0.0f )
+            continue;
+
+        const unsigned int sampleIdx = getIndex( SFVEC2I( sampleX[i] * 2, sampleY[i] * 2 ) );
+        const float sampleDepth = m_depth[ sampleIdx ];
+
+        if( sampleDepth <= FLT_EPSILON )
+            continue;
+
+        const float depthDiff = glm::abs( sampleDepth - depth ) / depth;
+        const float normalDot = glm::dot( m_normals[ sampleIdx ], normal );
+
+        // Samples of another surface are not used at all
+        if( (depthDiff > 0.02f) || (normalDot < 0.9f) )
+            continue;
+
+        const float weight = bilinear[i] * normalDot / ( 1.0f + depthDiff * 100.0f );
+
+        sum += aHalfResShade[ sampleX[i] + sampleY[i] * aHalfResSize.x ] * weight;
+        sumWeight += weight;
+    }
+
+    if( sumWeight <= FLT_EPSILON )
+        return false;
+
+    aOutShade = sum / sumWeight;
+
+    return true;
+}
+
+
 void CPOSTSHADER::DebugBuffersOutputAsImages() const
 {
     DBG_SaveBuffer( "m_shadow_att_factor", m_shadow_att_factor, m_size.x, m_size.y );
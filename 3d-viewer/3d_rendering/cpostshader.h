@@ -56,6 +56,24 @@ public:
 
     const SFVEC3F &GetColorAtNotProtected( const SFVEC2I &aPos ) const;
 
+    /**
+     * @brief UpsampleShade - bilateral upsampling of shader values computed at
+     * half resolution, i.e. for the pixels of even coordinates only. The low
+     * resolution samples are weighted by their distance and by how much their
+     * depth and normal match the ones of the pixel, so the shade does not leak
+     * across edges.
+     * @param aShaderPos full resolution position of the pixel
+     * @param aHalfResShade Shade() values of the even pixels, aHalfResSize.x wide
+     * @param aHalfResSize size of the half resolution buffer
+     * @param aOutShade the upsampled value
+     * @return false if no low resolution sample lies on the same surface, in which
+     * case Shade() must be computed for the pixel itself
+     */
+    bool UpsampleShade( const SFVEC2I &aShaderPos,
+                        const SFVEC3F *aHalfResShade,
+                        const SFVEC2UI &aHalfResSize,
+                        SFVEC3F &aOutShade ) const;
+
     void DebugBuffersOutputAsImages() const;
 
 protected:
@@ -235,6 +235,13 @@ void EDA_3D_VIEWER::ReloadRequest()
 }
 
 
+void EDA_3D_VIEWER::ReloadRequest( const BOARD_CHANGE_SET &aChanges )
+{
+    if( m_canvas )
+        m_canvas->ReloadRequest( aChanges, GetBoard(), Prj().Get3DCacheManager() );
+}
+
+
 void EDA_3D_VIEWER::Exit3DFrame( wxCommandEvent &event )
 {
     wxLogTrace( m_logTrace, wxT( "EDA_3D_VIEWER::Exit3DFrame" ) );
@@ -65,6 +65,11 @@ class EDA_3D_VIEWER : public KIWAY_PLAYER
 
     void ReloadRequest();
 
+    /**
+     * Reload only what the changes \a aChanges of the board touched
+     */
+    void ReloadRequest( const BOARD_CHANGE_SET &aChanges );
+
     // !TODO: review this function
     // !TODO: this need a way to tell what changed to the reload will only
     // change the things on a need base
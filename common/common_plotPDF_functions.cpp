@@ -40,6 +40,18 @@
 #include <wx/mstream.h>
 
 
+PDF_PLOTTER::~PDF_PLOTTER()
+{
+    // Emergency cleanup: the temporary file of a stream is normally removed
+    // when the stream is compressed.
+    if( workFile )
+    {
+        fclose( workFile );
+        ::wxRemoveFile( workFilename );
+    }
+}
+
+
 /*
  * Open or create the plot file aFullFilename
  * return true if success, false if the file cannot be created/opened
@@ -435,6 +447,21 @@ int PDF_PLOTTER::startPdfStream(int handle)
 {
     wxASSERT( outputFile );
     wxASSERT( !workFile );
+    handle = beginPdfStream( handle );
+
+    // Open a temporary file to accumulate the stream
+    workFilename = filename + wxT(".tmp");
+    workFile = wxFopen( workFilename, wxT( "w+b" ));
+    wxASSERT( workFile );
+    return handle;
+}
+
+
+/**
+ * Emit the header of a stream object, its length being deferred
+ */
+int PDF_PLOTTER::beginPdfStream( int handle )
+{
     handle = startPdfObject( handle );
 
     // This is guaranteed to be handle+1 but needs to be allocated since
@@ -442,12 +469,7 @@ int PDF_PLOTTER::startPdfStream(int handle)
     streamLengthHandle = allocPdfObject();
     fprintf( outputFile,
              "<< /Length %d 0 R /Filter /FlateDecode >>\n" // Length is deferred
-             "stream\n", handle + 1 );
-
-    // Open a temporary file to accumulate the stream
-    workFilename = filename + wxT(".tmp");
-    workFile = wxFopen( workFilename, wxT( "w+b" ));
-    wxASSERT( workFile );
+             "stream\n", streamLengthHandle );
     return handle;
 }
 
@@ -459,12 +481,38 @@ void PDF_PLOTTER::closePdfStream()
 {
     wxASSERT( workFile );
 
+    endPdfStream( deflateWorkFile() );
+}
+
+
+/**
+ * Emit the compressed stream data, then the deferred length
+ */
+void PDF_PLOTTER::endPdfStream( const std::string& aStream )
+{
+    fwrite( aStream.data(), 1, aStream.size(), outputFile );
+
+    fputs( "endstream\n", outputFile );
+    closePdfObject();
+
+    // Writing the deferred length as an indirect object
+    startPdfObject( streamLengthHandle );
+    fprintf( outputFile, "%u\n", (unsigned) aStream.size() );
+    closePdfObject();
+}
+
+
+/**
+ * Read back the stream accumulated in workFile, close it and DEFLATE it
+ */
+std::string PDF_PLOTTER::deflateWorkFile()
+{
     long stream_len = ftell( workFile );
 
     if( stream_len < 0 )
     {
         wxASSERT( false );
-        return;
+        return std::string();
     }
 
     // Rewind the file, read in the page stream and DEFLATE it
@@ -501,17 +549,7 @@ void PDF_PLOTTER::closePdfStream()
 
     wxStreamBuffer* sb = memos.GetOutputStreamBuffer();
 
-    unsigned out_count = sb->Tell();
-
-    fwrite( sb->GetBufferStart(), 1, out_count, outputFile );
-
-    fputs( "endstream\n", outputFile );
-    closePdfObject();
-
-    // Writing the deferred length as an indirect object
-    startPdfObject( streamLengthHandle );
-    fprintf( outputFile, "%u\n", out_count );
-    closePdfObject();
+    return std::string( (const char*) sb->GetBufferStart(), sb->Tell() );
 }
 
 /**
@@ -522,16 +560,51 @@ void PDF_PLOTTER::StartPage()
     wxASSERT( outputFile );
     wxASSERT( !workFile );
 
-    // Compute the paper size in IUs
-    paperSize = pageInfo.GetSizeMils();
-    paperSize.x *= 10.0 / iuPerDeviceUnit;
-    paperSize.y *= 10.0 / iuPerDeviceUnit;
-
     // Open the content stream; the page object will go later
     pageStreamHandle = startPdfStream();
 
     /* Now, until ClosePage *everything* must be wrote in workFile, to be
        compressed later in closePdfStream */
+    startPageContent();
+}
+
+
+/**
+ * Start the content stream of a page plotted apart from its document, see AddPage
+ */
+bool PDF_PLOTTER::StartPageStream( const wxString& aWorkFilename )
+{
+    wxASSERT( !outputFile );
+    wxASSERT( !workFile );
+
+    workFilename = aWorkFilename;
+    workFile = wxFopen( workFilename, wxT( "w+b" ));
+
+    if( !workFile )
+        return false;
+
+    startPageContent();
+    return true;
+}
+
+
+std::string PDF_PLOTTER::EndPageStream()
+{
+    wxASSERT( workFile );
+
+    return deflateWorkFile();
+}
+
+
+/**
+ * Write the default graphic settings at the beginning of a page stream
+ */
+void PDF_PLOTTER::startPageContent()
+{
+    // Compute the paper size in IUs
+    paperSize = pageInfo.GetSizeMils();
+    paperSize.x *= 10.0 / iuPerDeviceUnit;
+    paperSize.y *= 10.0 / iuPerDeviceUnit;
 
     // Default graphic settings (coordinate system, default color and line style)
     fprintf( workFile,
@@ -550,6 +623,30 @@ void PDF_PLOTTER::ClosePage()
     // Close the page stream (and compress it)
     closePdfStream();
 
+    emitPageObject();
+}
+
+
+/**
+ * Add a page whose compressed content stream was plotted by a page plotter
+ */
+void PDF_PLOTTER::AddPage( const std::string& aStream )
+{
+    wxASSERT( outputFile );
+    wxASSERT( !workFile );
+
+    pageStreamHandle = beginPdfStream( -1 );
+    endPdfStream( aStream );
+
+    emitPageObject();
+}
+
+
+/**
+ * Emit the page object of the current page stream and put it in the page list
+ */
+void PDF_PLOTTER::emitPageObject()
+{
     // Emit the page object and put it in the page list for later
     pageHandles.push_back( startPdfObject() );
 
@@ -589,6 +686,18 @@ void PDF_PLOTTER::ClosePage()
  * each page parameters can be set
  */
 bool PDF_PLOTTER::StartPlot()
+{
+    StartDocument();
+
+    /* Now, the PDF is read from the end, (more or less)... so we start
+       with the page stream for page 1. Other more important stuff is written
+       at the end */
+    StartPage();
+    return true;
+}
+
+
+bool PDF_PLOTTER::StartDocument()
 {
     wxASSERT( outputFile );
 
@@ -609,10 +718,6 @@ bool PDF_PLOTTER::StartPlot()
        (it *could* be inherited via the Pages tree */
     fontResDictHandle = allocPdfObject();
 
-    /* Now, the PDF is read from the end, (more or less)... so we start
-       with the page stream for page 1. Other more important stuff is written
-       at the end */
-    StartPage();
     return true;
 }
 
@@ -621,8 +726,10 @@ bool PDF_PLOTTER::EndPlot()
 {
     wxASSERT( outputFile );
 
-    // Close the current page (often the only one)
-    ClosePage();
+    // Close the current page (often the only one), unless the pages were added
+    // by AddPage()
+    if( workFile )
+        ClosePage();
 
     /* We need to declare the resources we're using (fonts in particular)
        The useful standard one is the Helvetica family. Adding external fonts
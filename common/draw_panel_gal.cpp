@@ -44,6 +44,8 @@
 #include <profile.h>
 #endif /* PROFILE */
 
+#include <profile_trace.h>
+
 
 EDA_DRAW_PANEL_GAL::EDA_DRAW_PANEL_GAL( wxWindow* aParentWindow, wxWindowID aWindowId,
                                         const wxPoint& aPosition, const wxSize& aSize,
@@ -155,6 +157,8 @@ void EDA_DRAW_PANEL_GAL::SetFocus()
 
 void EDA_DRAW_PANEL_GAL::onPaint( wxPaintEvent& WXUNUSED( aEvent ) )
 {
+    PROF_ZONE_SCOPE( "EDA_DRAW_PANEL_GAL::onPaint", "redraw" );
+
     m_pendingRefresh = false;
 
     if( m_drawing )
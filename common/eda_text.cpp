@@ -492,7 +492,8 @@ void EDA_TEXT::Format( OUTPUTFORMATTER* aFormatter, int aNestLevel, int aControl
 // each segment is stored as 2 wxPoints: its starting point and its ending point
 // we are using DrawGraphicText to create the segments.
 // and therefore a call-back function is needed
-static std::vector<wxPoint>* s_cornerBuffer;
+// (one buffer per thread, texts can be converted concurrently)
+static thread_local std::vector<wxPoint>* s_cornerBuffer;
 
 // This is a call back function, used by DrawGraphicText to put each segment in buffer
 static void addTextSegmToBuffer( int x0, int y0, int xf, int yf )
@@ -28,13 +28,6 @@
  */
 
 
-/**
-    No. concurrent threads doing "http(s) GET". More than 6 is not significantly
-    faster, less than 6 is likely slower. Main thread is in this count, so if
-    set to 1 then no temp threads are created.
-*/
-#define READER_THREADS      6
-
 /*
  * Functions to read footprint libraries and fill m_footprints by available footprints names
  * and their documentation (comments and keywords)
@@ -50,7 +43,7 @@
 #include <fp_lib_table.h>
 #include <lib_id.h>
 #include <class_module.h>
-#include <thread>
+#include <task_scheduler.h>
 #include <html_messagebox.h>
 
 
@@ -204,7 +197,7 @@ bool FOOTPRINT_LIST::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxString* a
 
         // Even though the PLUGIN API implementation is the place for the
         // locale toggling, in order to keep LOCAL_IO::C_count at 1 or greater
-        // for the duration of all helper threads, we increment by one here via instantiation.
+        // for the duration of all loader tasks, we increment by one here via instantiation.
         // Only done here because of the multi-threaded nature of this code.
         // Without this C_count skips in and out of "equal to zero" and causes
         // needless locale toggling among the threads, based on which of them
@@ -212,42 +205,18 @@ bool FOOTPRINT_LIST::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxString* a
         // none of them.
         LOCALE_IO   top_most_nesting;
 
-        // Something which will not invoke a thread copy constructor, one of many ways obviously:
-        typedef std::vector< std::thread >  MYTHREADS;
+        // One task per library, the scheduler spreads them over its workers and
+        // this thread takes part until all of them are done.
+        TASK_GROUP loaders( Pgm().Scheduler() );
 
-        MYTHREADS threads;
-
-        unsigned jobz = (nicknames.size() + READER_THREADS - 1) / READER_THREADS;
-
-        // Give each thread JOBZ nicknames to process.  The last portion of, or if the entire
-        // size() is small, I'll do myself.
-        for( unsigned i=0; i<nicknames.size();  )
+        for( unsigned i=0; i<nicknames.size();  ++i )
         {
-            if( i + jobz >= nicknames.size() )  // on the last iteration of this for(;;)
-            {
-                jobz = nicknames.size() - i;
+            const wxString* nickname = &nicknames[i];
 
-                // Only a little bit to do, I'll do it myself on current thread.
-                // I am part of the READER_THREADS count.
-                loader_job( &nicknames[i], jobz );
-            }
-            else
-            {
-                // Delegate the job to a temporary thread created here.
-                threads.push_back( std::thread( &FOOTPRINT_LIST::loader_job,
-                        this, &nicknames[i], jobz ) );
-            }
-
-            i += jobz;
+            loaders.Run( [this, nickname]() { loader_job( nickname, 1 ); } );
         }
 
-        // Wait for all the worker threads to complete, it does not matter in what order
-        // we wait for them as long as a full sweep is made.  Think of the great race,
-        // everyone must finish.
-        for( unsigned i=0;  i<threads.size();  ++i )
-        {
-            threads[i].join();
-        }
+        loaders.Wait();
 
         m_list.sort();
     }
@@ -31,6 +31,8 @@
 #include <pgm_base.h>
 
 #include <common.h>
+#include <profile_trace.h>
+#include <string_pool.h>
 
 /// Initialize aDst SEARCH_STACK with KIFACE (DSO) specific settings.
 /// A non-member function so it an be moved easily, plus it's nobody's business.
@@ -93,6 +95,13 @@ static void setSearchPaths( SEARCH_STACK* aDst, KIWAY::FACE_T aId )
 bool KIFACE_I::start_common( int aCtlBits )
 {
     m_start_flags = aCtlBits;
+
+    // Record the tracing zones of this kiface into the collector of the program.
+    PROF_TRACE::Bind( &Pgm().ProfileTrace() );
+
+    // Intern the strings of this kiface into the pool of the program.
+    STRING_POOL::Bind( &Pgm().StringPool() );
+
     m_bm.Init();
     setSearchPaths( &m_bm.m_search, m_id );
 
@@ -113,8 +113,8 @@ static int okRevision( const std::string& aField )
 
 void LIB_ID::clear()
 {
-    nickname.clear();
-    item_name.clear();
+    nickname = INTERNED_STRING();
+    item_name = INTERNED_STRING();
     revision.clear();
 }
 
@@ -213,7 +213,7 @@ int LIB_ID::SetLibNickname( const UTF8& aLogical )
 
     if( offset == -1 )
     {
-        nickname = aLogical;
+        nickname = FROM_UTF8( aLogical.c_str() );
     }
 
     return offset;
@@ -226,12 +226,12 @@ int LIB_ID::SetLibItemName( const UTF8& aLibItemName )
 
     if( separation != -1 )
     {
-        item_name = aLibItemName.substr( 0, separation-1 );
+        item_name = FROM_UTF8( aLibItemName.substr( 0, separation-1 ).c_str() );
         return separation;
     }
     else
     {
-        item_name = aLibItemName;
+        item_name = FROM_UTF8( aLibItemName.c_str() );
     }
 
     return -1;
@@ -255,13 +255,13 @@ UTF8 LIB_ID::Format() const
 {
     UTF8    ret;
 
-    if( nickname.size() )
+    if( !nickname.IsEmpty() )
     {
-        ret += nickname;
+        ret += nickname.GetUTF8();
         ret += ':';
     }
 
-    ret += item_name;
+    ret += item_name.GetUTF8();
 
     if( revision.size() )
     {
@@ -340,12 +340,17 @@ int LIB_ID::compare( const LIB_ID& aLibId ) const
     if( this == &aLibId )
         return 0;
 
-    int retv = nickname.compare( aLibId.nickname );
+    int retv = 0;
+
+    // Interned strings are equal when they share the same entry.
+    if( nickname != aLibId.nickname )
+        retv = nickname.GetUTF8().compare( aLibId.nickname.GetUTF8() );
 
     if( retv != 0 )
         return retv;
 
-    retv = item_name.compare( aLibId.item_name );
+    if( item_name != aLibId.item_name )
+        retv = item_name.GetUTF8().compare( aLibId.item_name.GetUTF8() );
 
     if( retv != 0 )
         return retv;
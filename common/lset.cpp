@@ -25,11 +25,105 @@
 
 #include <stdarg.h>
 #include <assert.h>
+#include <algorithm>
 
 #include <layers_id_colors_and_visibility.h>
 #include <class_board.h>
 
 
+// The wish list sequences are shared by the LSEQ builders and the LSET_RANGE walkers.
+
+/// Copper layers, from the front/top to the back/bottom.
+static const LAYER_ID s_cuStack[] = {
+    F_Cu,
+    In1_Cu,
+    In2_Cu,
+    In3_Cu,
+    In4_Cu,
+    In5_Cu,
+    In6_Cu,
+    In7_Cu,
+    In8_Cu,
+    In9_Cu,
+    In10_Cu,
+    In11_Cu,
+    In12_Cu,
+    In13_Cu,
+    In14_Cu,
+    In15_Cu,
+    In16_Cu,
+    In17_Cu,
+    In18_Cu,
+    In19_Cu,
+    In20_Cu,
+    In21_Cu,
+    In22_Cu,
+    In23_Cu,
+    In24_Cu,
+    In25_Cu,
+    In26_Cu,
+    In27_Cu,
+    In28_Cu,
+    In29_Cu,
+    In30_Cu,
+    B_Cu,           // 31
+};
+
+/// The stack-up, from the bottom to the top.
+static const LAYER_ID s_stackupBottom2Top[] = {
+    B_Fab,
+    B_CrtYd,
+    B_Adhes,
+    B_SilkS,
+    B_Paste,
+    B_Mask,
+    B_Cu,
+    In30_Cu,
+    In29_Cu,
+    In28_Cu,
+    In27_Cu,
+    In26_Cu,
+    In25_Cu,
+    In24_Cu,
+    In23_Cu,
+    In22_Cu,
+    In21_Cu,
+    In20_Cu,
+    In19_Cu,
+    In18_Cu,
+    In17_Cu,
+    In16_Cu,
+    In15_Cu,
+    In14_Cu,
+    In13_Cu,
+    In12_Cu,
+    In11_Cu,
+    In10_Cu,
+    In9_Cu,
+    In8_Cu,
+    In7_Cu,
+    In6_Cu,
+    In5_Cu,
+    In4_Cu,
+    In3_Cu,
+    In2_Cu,
+    In1_Cu,
+    F_Cu,
+    F_Mask,
+    F_Paste,
+    F_SilkS,
+    F_Adhes,
+    F_CrtYd,
+    F_Fab,
+    Dwgs_User,
+    Cmts_User,
+    Eco1_User,
+    Eco2_User,
+    Margin,
+    Edge_Cuts,
+};
+
+
 LSET::LSET( const LAYER_ID* aArray, unsigned aCount ) :
     BASE_SET()
 {
@@ -145,43 +239,13 @@ const wxChar* LSET::Name( LAYER_ID aLayerId )
 
 LSEQ LSET::CuStack() const
 {
-    // desired sequence
-    static const LAYER_ID sequence[] = {
-        F_Cu,
-        In1_Cu,
-        In2_Cu,
-        In3_Cu,
-        In4_Cu,
-        In5_Cu,
-        In6_Cu,
-        In7_Cu,
-        In8_Cu,
-        In9_Cu,
-        In10_Cu,
-        In11_Cu,
-        In12_Cu,
-        In13_Cu,
-        In14_Cu,
-        In15_Cu,
-        In16_Cu,
-        In17_Cu,
-        In18_Cu,
-        In19_Cu,
-        In20_Cu,
-        In21_Cu,
-        In22_Cu,
-        In23_Cu,
-        In24_Cu,
-        In25_Cu,
-        In26_Cu,
-        In27_Cu,
-        In28_Cu,
-        In29_Cu,
-        In30_Cu,
-        B_Cu,           // 31
-    };
+    return Seq( s_cuStack, DIM( s_cuStack ) );
+}
+
 
-    return Seq( sequence, DIM( sequence ) );
+LSET_RANGE LSET::CuStackLayers() const
+{
+    return LSET_RANGE( *this, s_cuStack, DIM( s_cuStack ) );
 }
 
 
@@ -337,6 +401,8 @@ LSEQ LSET::Seq( const LAYER_ID* aWishListSequence, unsigned aCount ) const
 {
     LSEQ ret;
 
+    ret.reserve( std::min<size_t>( aCount, count() ) );
+
 #if defined(DEBUG) && 0
     LSET    dup_detector;
 
@@ -371,6 +437,8 @@ LSEQ LSET::Seq() const
 {
     LSEQ    ret;
 
+    ret.reserve( count() );
+
     for( unsigned i=0;  i<size();  ++i )
     {
         if( test(i) )
@@ -383,61 +451,13 @@ LSEQ LSET::Seq() const
 
 LSEQ LSET::SeqStackupBottom2Top() const
 {
-    // bottom-to-top stack-up layers
-    static const LAYER_ID sequence[] = {
-        B_Fab,
-        B_CrtYd,
-        B_Adhes,
-        B_SilkS,
-        B_Paste,
-        B_Mask,
-        B_Cu,
-        In30_Cu,
-        In29_Cu,
-        In28_Cu,
-        In27_Cu,
-        In26_Cu,
-        In25_Cu,
-        In24_Cu,
-        In23_Cu,
-        In22_Cu,
-        In21_Cu,
-        In20_Cu,
-        In19_Cu,
-        In18_Cu,
-        In17_Cu,
-        In16_Cu,
-        In15_Cu,
-        In14_Cu,
-        In13_Cu,
-        In12_Cu,
-        In11_Cu,
-        In10_Cu,
-        In9_Cu,
-        In8_Cu,
-        In7_Cu,
-        In6_Cu,
-        In5_Cu,
-        In4_Cu,
-        In3_Cu,
-        In2_Cu,
-        In1_Cu,
-        F_Cu,
-        F_Mask,
-        F_Paste,
-        F_SilkS,
-        F_Adhes,
-        F_CrtYd,
-        F_Fab,
-        Dwgs_User,
-        Cmts_User,
-        Eco1_User,
-        Eco2_User,
-        Margin,
-        Edge_Cuts,
-    };
+    return Seq( s_stackupBottom2Top, DIM( s_stackupBottom2Top ) );
+}
 
-    return Seq( sequence, DIM( sequence ) );
+
+LSET_RANGE LSET::StackupBottom2TopLayers() const
+{
+    return LSET_RANGE( *this, s_stackupBottom2Top, DIM( s_stackupBottom2Top ) );
 }
 
 
@@ -750,16 +770,18 @@ LSET LSET::BackMask()
 
 LSEQ LSET::UIOrder() const
 {
-    LAYER_ID order[LAYER_ID_COUNT];
-
     // Assmuming that the LAYER_ID order is according to preferred UI order, as of
     // today this is true.  When that becomes not true, its easy to change the order
     // in here to compensate.
 
-    for( unsigned i=0;  i<DIM(order);  ++i )
-        order[i] = LAYER_ID( i );
+    return Seq();
+}
+
 
-    return Seq( order, DIM( order ) );
+LSET_RANGE LSET::UIOrderLayers() const
+{
+    // Same order as UIOrder()
+    return LSET_RANGE( *this );
 }
 
 
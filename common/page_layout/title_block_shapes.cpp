@@ -62,12 +62,20 @@
 #include <worksheet_shape_builder.h>
 #include <class_worksheet_dataitem.h>
 
+#include <mutex>
+
 
 void WS_DRAW_ITEM_LIST::BuildWorkSheetGraphicList(
                        const PAGE_INFO& aPageInfo,
                        const TITLE_BLOCK& aTitleBlock,
                        EDA_COLOR_T aColor, EDA_COLOR_T aAltColor )
 {
+    // The list is built from the WORKSHEET_DATAITEM static settings (units, corners and
+    // colors) and the full texts and text sizes stored in the shared layout items, so
+    // only one list is built at a time.  Lists are then drawn or plotted concurrently.
+    static std::mutex buildLock;
+    std::lock_guard<std::mutex> guard( buildLock );
+
     WORKSHEET_LAYOUT& pglayout = WORKSHEET_LAYOUT::GetTheInstance();
 
     #define milsTomm (25.4/1000)
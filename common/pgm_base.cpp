@@ -51,6 +51,9 @@
 #include <menus_helpers.h>
 #include <confirm.h>
 #include <dialog_env_var_config.h>
+#include <profile_trace.h>
+#include <string_pool.h>
+#include <task_scheduler.h>
 
 
 #define KICAD_COMMON                     wxT( "kicad_common" )
@@ -62,7 +65,9 @@ const wxChar PGM_BASE::workingDirKey[] = wxT( "WorkingDir" );     // public
 static const wxChar languageCfgKey[]   = wxT( "LanguageID" );
 static const wxChar pathEnvVariables[] = wxT( "EnvironmentVariables" );
 static const wxChar showEnvVarWarningDialog[] = wxT( "ShowEnvVarWarningDialog" );
+static const wxChar workerThreadsKey[] = wxT( "WorkerThreads" );
 static const wxChar traceEnvVars[]     = wxT( "KIENVVARS" );
+static const wxChar profileTraceEnvVar[] = wxT( "KICAD_PROFILE_TRACE" );
 
 
 /**
@@ -284,6 +289,8 @@ PGM_BASE::PGM_BASE()
     m_pgm_checker = NULL;
     m_locale = NULL;
     m_common_settings = NULL;
+    m_scheduler = NULL;
+    m_worker_count = 0;
 
     m_show_env_var_dialog = true;
 
@@ -303,6 +310,16 @@ void PGM_BASE::Destroy()
 {
     // unlike a normal destructor, this is designed to be called more than once safely:
 
+    if( !m_profile_trace_file.IsEmpty() )
+    {
+        ProfileTrace().Enable( false );
+        ProfileTrace().ExportChromeTrace( TO_UTF8( m_profile_trace_file ) );
+        m_profile_trace_file.Clear();
+    }
+
+    // Joins the worker threads, after they have drained their queues.
+    delete m_scheduler.exchange( NULL );
+
     delete m_common_settings;
     m_common_settings = 0;
 
@@ -321,6 +338,59 @@ wxApp& PGM_BASE::App()
 }
 
 
+TASK_SCHEDULER& PGM_BASE::Scheduler()
+{
+    TASK_SCHEDULER* scheduler = m_scheduler.load( std::memory_order_acquire );
+
+    if( !scheduler )
+    {
+        // Only for the programs not calling InitPgm() (the python module), the first
+        // callers can be worker contexts of their own.
+        std::lock_guard<std::mutex> lock( m_schedulerLock );
+
+        scheduler = m_scheduler.load( std::memory_order_relaxed );
+
+        if( !scheduler )
+        {
+            scheduler = new TASK_SCHEDULER( m_worker_count );
+            m_scheduler.store( scheduler, std::memory_order_release );
+        }
+    }
+
+    return *scheduler;
+}
+
+
+PROF_TRACE& PGM_BASE::ProfileTrace()
+{
+    return PROF_TRACE::Instance();
+}
+
+
+STRING_POOL& PGM_BASE::StringPool()
+{
+    return STRING_POOL::Instance();
+}
+
+
+void PGM_BASE::SetWorkerCount( int aCount )
+{
+    if( aCount < 0 )
+        aCount = 0;
+
+    std::lock_guard<std::mutex> lock( m_schedulerLock );
+
+    if( aCount == m_worker_count && m_scheduler.load() )
+        return;
+
+    m_worker_count = aCount;
+
+    // Joins the old worker threads before starting the new ones.
+    delete m_scheduler.exchange( NULL );
+    m_scheduler.store( new TASK_SCHEDULER( m_worker_count ), std::memory_order_release );
+}
+
+
 void PGM_BASE::SetEditorName( const wxString& aFileName )
 {
     m_editor_name = aFileName;
@@ -395,6 +465,11 @@ bool PGM_BASE::InitPgm()
 
     wxConfigBase::DontCreateOnDemand();
 
+    // KICAD_PROFILE_TRACE=<file> collects the tracing zones of the whole session,
+    // they are written to <file> in Chrome trace-event format on exit.
+    if( wxGetEnv( profileTraceEnvVar, &m_profile_trace_file ) && !m_profile_trace_file.IsEmpty() )
+        ProfileTrace().Enable( true );
+
     wxInitAllImageHandlers();
 
     m_pgm_checker = new wxSingleInstanceChecker( pgm_name.GetName().Lower() + wxT( "-" ) +
@@ -586,6 +661,10 @@ void PGM_BASE::loadCommonSettings()
 
     m_common_settings->Read( showEnvVarWarningDialog, &m_show_env_var_dialog );
 
+    long workers = 0;
+    m_common_settings->Read( workerThreadsKey, &workers, 0L );
+    SetWorkerCount( (int) workers );
+
     m_editor_name = m_common_settings->Read( wxT( "Editor" ) );
 
     wxString entry, oldPath;
@@ -625,6 +704,7 @@ void PGM_BASE::SaveCommonSettings()
 
         m_common_settings->Write( workingDirKey, cur_dir );
         m_common_settings->Write( showEnvVarWarningDialog, m_show_env_var_dialog );
+        m_common_settings->Write( workerThreadsKey, (long) m_worker_count );
 
         // Save the local environment variables.
         m_common_settings->SetPath( pathEnvVariables );
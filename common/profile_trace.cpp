@@ -0,0 +1,226 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file profile_trace.cpp
+ */
+
+#include <profile_trace.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+
+PROF_TRACE* PROF_TRACE::s_instance = nullptr;
+
+// Per thread state.  The ring itself is owned by PROF_TRACE so that it
+// survives the thread which filled it.  Only the module owning the bound
+// collector touches them, through its virtual functions.
+static thread_local int                 s_zoneDepth = 0;
+static thread_local void*               s_threadRing = nullptr;
+
+
+static uint64_t steadyMicroseconds()
+{
+    using namespace std::chrono;
+
+    return duration_cast<microseconds>( steady_clock::now().time_since_epoch() ).count();
+}
+
+
+/// Writes \a aText as a JSON string literal body.
+static void writeJsonString( std::ostream& aStream, const char* aText )
+{
+    for( const char* p = aText; p && *p; ++p )
+    {
+        switch( *p )
+        {
+        case '"':  aStream << "\\\""; break;
+        case '\\': aStream << "\\\\"; break;
+        case '\n': aStream << "\\n";  break;
+        case '\t': aStream << "\\t";  break;
+        default:
+            if( (unsigned char) *p >= 0x20 )
+                aStream << *p;
+        }
+    }
+}
+
+
+PROF_TRACE::RING::RING( int aThreadId, size_t aSize ) :
+    m_events( aSize ),
+    m_head( 0 ),
+    m_count( 0 ),
+    m_threadId( aThreadId )
+{
+}
+
+
+PROF_TRACE::PROF_TRACE() :
+    m_enabled( false ),
+    m_epoch( steadyMicroseconds() )
+{
+}
+
+
+PROF_TRACE& PROF_TRACE::Instance()
+{
+    static PROF_TRACE instance;
+
+    if( !s_instance )
+        s_instance = &instance;
+
+    return *s_instance;
+}
+
+
+void PROF_TRACE::Bind( PROF_TRACE* aTrace )
+{
+    s_instance = aTrace;
+}
+
+
+void PROF_TRACE::Enable( bool aEnable )
+{
+    m_enabled.store( aEnable, std::memory_order_relaxed );
+}
+
+
+void PROF_TRACE::Clear()
+{
+    std::lock_guard<std::mutex> lock( m_ringsLock );
+
+    for( auto& ring : m_rings )
+    {
+        std::lock_guard<std::mutex> ringLock( ring->m_lock );
+
+        ring->m_head  = 0;
+        ring->m_count = 0;
+    }
+}
+
+
+uint64_t PROF_TRACE::Now() const
+{
+    return steadyMicroseconds() - m_epoch;
+}
+
+
+int PROF_TRACE::EnterZone()
+{
+    return s_zoneDepth++;
+}
+
+
+void PROF_TRACE::LeaveZone()
+{
+    --s_zoneDepth;
+}
+
+
+PROF_TRACE::RING* PROF_TRACE::threadRing()
+{
+    if( !s_threadRing )
+    {
+        std::lock_guard<std::mutex> lock( m_ringsLock );
+
+        m_rings.emplace_back( new RING( (int) m_rings.size() + 1, DEFAULT_RING_SIZE ) );
+        s_threadRing = m_rings.back().get();
+    }
+
+    return static_cast<RING*>( s_threadRing );
+}
+
+
+void PROF_TRACE::Record( const char* aName, const char* aCategory, uint64_t aStart,
+                         uint64_t aEnd, int aDepth )
+{
+    RING* ring = threadRing();
+
+    // The lock is owned by this thread except during an export, so it is cheap.
+    std::lock_guard<std::mutex> lock( ring->m_lock );
+
+    PROF_EVENT& ev = ring->m_events[ring->m_head];
+
+    ev.m_name     = aName;
+    ev.m_category = aCategory;
+    ev.m_start    = aStart;
+    ev.m_duration = aEnd >= aStart ? aEnd - aStart : 0;
+    ev.m_depth    = aDepth;
+
+    ring->m_head = ( ring->m_head + 1 ) % ring->m_events.size();
+    ring->m_count = std::min( ring->m_count + 1, ring->m_events.size() );
+}
+
+
+void PROF_TRACE::ExportChromeTrace( std::ostream& aStream )
+{
+    std::lock_guard<std::mutex> lock( m_ringsLock );
+
+    aStream << "{\"traceEvents\":[\n";
+
+    bool first = true;
+
+    for( auto& ring : m_rings )
+    {
+        std::lock_guard<std::mutex> ringLock( ring->m_lock );
+
+        size_t size = ring->m_events.size();
+        size_t tail = ( ring->m_head + size - ring->m_count ) % size;
+
+        for( size_t i = 0; i < ring->m_count; ++i )
+        {
+            const PROF_EVENT& ev = ring->m_events[( tail + i ) % size];
+
+            if( !first )
+                aStream << ",\n";
+
+            first = false;
+
+            aStream << "{\"name\":\"";
+            writeJsonString( aStream, ev.m_name );
+            aStream << "\",\"cat\":\"";
+            writeJsonString( aStream, ev.m_category );
+            aStream << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring->m_threadId
+                    << ",\"ts\":" << ev.m_start
+                    << ",\"dur\":" << ev.m_duration
+                    << ",\"args\":{\"depth\":" << ev.m_depth << "}}";
+        }
+    }
+
+    aStream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+
+bool PROF_TRACE::ExportChromeTrace( const std::string& aFileName )
+{
+    std::ofstream out( aFileName.c_str(), std::ios::out | std::ios::trunc );
+
+    if( !out.is_open() )
+        return false;
+
+    ExportChromeTrace( out );
+
+    return out.good();
+}
@@ -0,0 +1,142 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file string_pool.cpp
+ */
+
+#include <string_pool.h>
+#include <hashtables.h>
+
+
+STRING_POOL* STRING_POOL::s_instance = nullptr;
+
+
+STRING_POOL::STRING_POOL() :
+    m_nextId( 0 ),
+    m_count( 0 ),
+    m_empty( NULL )
+{
+    // The pool keeps the reference of the empty string, so it is never freed.
+    m_empty = Intern( wxEmptyString );
+}
+
+
+STRING_POOL::~STRING_POOL()
+{
+    for( SHARD& shard : m_shards )
+    {
+        for( auto& entry : shard.m_index )
+            delete entry.second;
+    }
+}
+
+
+STRING_POOL& STRING_POOL::Instance()
+{
+    // Leaked on purpose: items holding interned strings may be destroyed
+    // by static destructors, after the pool would have been.
+    // The pool of this module is only created if none was bound before.
+    static STRING_POOL* pool = s_instance ? s_instance : ( s_instance = new STRING_POOL );
+
+    (void) pool;
+    return *s_instance;
+}
+
+
+void STRING_POOL::Bind( STRING_POOL* aPool )
+{
+    s_instance = aPool;
+}
+
+
+const STRING_POOL_ENTRY* STRING_POOL::Intern( const wxString& aText )
+{
+    size_t  hash = WXSTRING_HASH()( aText );
+    SHARD&  s = shard( hash );
+
+    std::lock_guard<std::mutex> lock( s.m_lock );
+
+    auto range = s.m_index.equal_range( hash );
+
+    for( auto it = range.first; it != range.second; ++it )
+    {
+        if( it->second->m_Text == aText )
+        {
+            it->second->m_RefCount++;
+            return it->second;
+        }
+    }
+
+    STRING_POOL_ENTRY* entry = new STRING_POOL_ENTRY;
+    entry->m_Text = aText;
+    entry->m_Utf8 = aText;
+    entry->m_Hash = hash;
+    entry->m_Id   = m_nextId++;
+    entry->m_Pool = this;
+    entry->m_RefCount = 1;
+
+    s.m_index.insert( std::make_pair( hash, entry ) );
+    m_count++;
+
+    return entry;
+}
+
+
+void STRING_POOL::Release( const STRING_POOL_ENTRY* aEntry )
+{
+    // The count only drops to zero under the lock of the shard, so Intern()
+    // cannot hand out an entry which is being freed.
+    unsigned count = aEntry->m_RefCount.load();
+
+    while( count > 1 && !aEntry->m_RefCount.compare_exchange_weak( count, count - 1 ) )
+        ;
+
+    if( count <= 1 )
+        aEntry->m_Pool->release( aEntry );
+}
+
+
+void STRING_POOL::release( const STRING_POOL_ENTRY* aEntry )
+{
+    SHARD& s = shard( aEntry->m_Hash );
+
+    std::lock_guard<std::mutex> lock( s.m_lock );
+
+    if( --aEntry->m_RefCount > 0 )
+        return;
+
+    auto range = s.m_index.equal_range( aEntry->m_Hash );
+
+    for( auto it = range.first; it != range.second; ++it )
+    {
+        if( it->second == aEntry )
+        {
+            s.m_index.erase( it );
+            break;
+        }
+    }
+
+    m_count--;
+    delete aEntry;
+}
@@ -0,0 +1,289 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file task_scheduler.cpp
+ */
+
+#include <task_scheduler.h>
+#include <reporter.h>
+#include <macros.h>
+
+#include <algorithm>
+#include <chrono>
+
+
+// The scheduler and queue owned by the current thread, if it is a worker.
+static thread_local TASK_SCHEDULER* s_currentScheduler = nullptr;
+static thread_local int             s_currentQueue = -1;
+
+
+TASK_GROUP::TASK_GROUP( TASK_SCHEDULER& aScheduler, const TASK_CANCEL_TOKEN& aToken ) :
+    m_scheduler( aScheduler ),
+    m_token( aToken ),
+    m_submitted( 0 ),
+    m_completed( 0 ),
+    m_failed( false )
+{
+}
+
+
+TASK_GROUP::~TASK_GROUP()
+{
+    try
+    {
+        Wait();
+    }
+    catch( ... )
+    {
+        // The owner did not call Wait() itself, so it is not interested in errors.
+    }
+}
+
+
+void TASK_GROUP::Run( const std::function<void()>& aTask )
+{
+    ++m_submitted;
+    m_scheduler.submit( this, aTask );
+}
+
+
+void TASK_GROUP::taskDone( std::exception_ptr aError )
+{
+    // Everything is done under the lock: once m_completed reaches m_submitted,
+    // Wait() may return and the group be destroyed as soon as the lock is released.
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    if( aError && !m_error )
+    {
+        m_error = aError;
+        m_failed = true;        // skip what remains of the group
+    }
+
+    ++m_completed;
+    m_done.notify_all();
+}
+
+
+void TASK_GROUP::Wait( REPORTER* aReporter, const wxString& aTitle )
+{
+    int home = ( s_currentScheduler == &m_scheduler ) ? s_currentQueue : -1;
+    int lastDecile = -1;
+
+    while( m_completed.load() < m_submitted.load() )
+    {
+        if( aReporter )
+        {
+            int total = m_submitted.load();
+            int done = m_completed.load();
+            int decile = total ? ( done * 10 ) / total : 10;
+
+            if( decile != lastDecile )
+            {
+                lastDecile = decile;
+                aReporter->Report( wxString::Format( wxT( "%s %d/%d" ),
+                                                     GetChars( aTitle ), done, total ),
+                                   REPORTER::RPT_INFO );
+            }
+        }
+
+        // Help with the work rather than sleeping.
+        if( !m_scheduler.runOne( home ) )
+        {
+            std::unique_lock<std::mutex> lock( m_lock );
+
+            m_done.wait_for( lock, std::chrono::milliseconds( 10 ), [this]() {
+                return m_completed.load() >= m_submitted.load();
+            } );
+        }
+    }
+
+    std::exception_ptr error;
+
+    {
+        // Synchronize with the last taskDone() before the group can go away.
+        std::unique_lock<std::mutex> lock( m_lock );
+
+        m_done.wait( lock, [this]() { return m_completed.load() >= m_submitted.load(); } );
+
+        std::swap( error, m_error );
+    }
+
+    if( aReporter && lastDecile >= 0 && lastDecile < 10 )
+        aReporter->Report( wxString::Format( wxT( "%s %d/%d" ), GetChars( aTitle ),
+                                             m_completed.load(), m_submitted.load() ),
+                           REPORTER::RPT_INFO );
+
+    if( error )
+        std::rethrow_exception( error );
+}
+
+
+TASK_SCHEDULER::TASK_SCHEDULER( int aWorkerCount ) :
+    m_nextQueue( 0 ),
+    m_pending( 0 ),
+    m_quit( false )
+{
+    int count = DefaultWorkerCount( aWorkerCount );
+
+    for( int i = 0; i <= count; ++i )
+        m_workers.emplace_back( new WORKER );
+
+    for( int i = 1; i <= count; ++i )
+        m_threads.push_back( std::thread( &TASK_SCHEDULER::workerLoop, this, i ) );
+}
+
+
+TASK_SCHEDULER::~TASK_SCHEDULER()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_sleepLock );
+        m_quit = true;
+    }
+
+    m_wakeUp.notify_all();
+
+    for( std::thread& thread : m_threads )
+        thread.join();
+}
+
+
+int TASK_SCHEDULER::DefaultWorkerCount( int aRequested )
+{
+    if( aRequested > 0 )
+        return aRequested;
+
+    int hwThreads = (int) std::thread::hardware_concurrency();
+
+    return std::max( hwThreads - 1, 1 );
+}
+
+
+void TASK_SCHEDULER::submit( TASK_GROUP* aGroup, const std::function<void()>& aFunc )
+{
+    int queue;
+
+    if( s_currentScheduler == this )
+        queue = s_currentQueue;     // keep the work local, other workers will steal it
+    else
+        queue = m_nextQueue++ % m_workers.size();
+
+    {
+        WORKER& worker = *m_workers[queue];
+        std::lock_guard<std::mutex> lock( worker.m_lock );
+
+        TASK task;
+        task.m_func  = aFunc;
+        task.m_group = aGroup;
+        worker.m_tasks.push_back( std::move( task ) );
+    }
+
+    ++m_pending;
+
+    {
+        std::lock_guard<std::mutex> lock( m_sleepLock );
+    }
+
+    m_wakeUp.notify_one();
+}
+
+
+bool TASK_SCHEDULER::runOne( int aHome )
+{
+    TASK task;
+    bool found = false;
+
+    // Newest task of our own queue first, it is the most likely to be cache hot.
+    if( aHome >= 0 )
+    {
+        WORKER& worker = *m_workers[aHome];
+        std::lock_guard<std::mutex> lock( worker.m_lock );
+
+        if( !worker.m_tasks.empty() )
+        {
+            task = std::move( worker.m_tasks.back() );
+            worker.m_tasks.pop_back();
+            found = true;
+        }
+    }
+
+    // Then steal the oldest task of somebody else.
+    int count = (int) m_workers.size();
+    int start = aHome >= 0 ? aHome + 1 : 0;
+
+    for( int i = 0; i < count && !found; ++i )
+    {
+        WORKER& worker = *m_workers[( start + i ) % count];
+        std::lock_guard<std::mutex> lock( worker.m_lock );
+
+        if( !worker.m_tasks.empty() )
+        {
+            task = std::move( worker.m_tasks.front() );
+            worker.m_tasks.pop_front();
+            found = true;
+        }
+    }
+
+    if( !found )
+        return false;
+
+    --m_pending;
+
+    std::exception_ptr error;
+
+    if( !task.m_group->IsCancelled() && !task.m_group->m_failed.load() )
+    {
+        try
+        {
+            task.m_func();
+        }
+        catch( ... )
+        {
+            error = std::current_exception();
+        }
+    }
+
+    task.m_group->taskDone( error );
+
+    return true;
+}
+
+
+void TASK_SCHEDULER::workerLoop( int aIndex )
+{
+    s_currentScheduler = this;
+    s_currentQueue = aIndex;
+
+    while( true )
+    {
+        if( runOne( aIndex ) )
+            continue;
+
+        std::unique_lock<std::mutex> lock( m_sleepLock );
+
+        m_wakeUp.wait( lock, [this]() { return m_quit || m_pending.load() > 0; } );
+
+        if( m_quit && m_pending.load() <= 0 )
+            break;
+    }
+}
@@ -68,13 +68,18 @@ void ACTION_MANAGER::RegisterAction( TOOL_ACTION* aAction )
     // TOOL_ACTIONs must have unique names & ids
     assert( m_actionNameIndex.find( aAction->m_name ) == m_actionNameIndex.end() );
 
+    if( aAction->m_id == -1 )
+        aAction->m_id = MakeActionId( aAction->m_name );
+
     m_actionNameIndex[aAction->m_name] = aAction;
+    m_actionIdIndex[aAction->m_id] = aAction;
 }
 
 
 void ACTION_MANAGER::UnregisterAction( TOOL_ACTION* aAction )
 {
     m_actionNameIndex.erase( aAction->m_name );
+    m_actionIdIndex.erase( aAction->m_id );
     int hotkey = GetHotKey( *aAction );
 
     if( hotkey )
@@ -100,7 +105,7 @@ int ACTION_MANAGER::MakeActionId( const std::string& aActionName )
 
 TOOL_ACTION* ACTION_MANAGER::FindAction( const std::string& aActionName ) const
 {
-    std::map<std::string, TOOL_ACTION*>::const_iterator it = m_actionNameIndex.find( aActionName );
+    auto it = m_actionNameIndex.find( aActionName );
 
     if( it != m_actionNameIndex.end() )
         return it->second;
@@ -109,6 +114,17 @@ TOOL_ACTION* ACTION_MANAGER::FindAction( const std::string& aActionName ) const
 }
 
 
+TOOL_ACTION* ACTION_MANAGER::FindAction( int aActionId ) const
+{
+    auto it = m_actionIdIndex.find( aActionId );
+
+    if( it != m_actionIdIndex.end() )
+        return it->second;
+
+    return NULL;
+}
+
+
 bool ACTION_MANAGER::RunHotKey( int aHotKey ) const
 {
     int key = aHotKey & ~MD_MODIFIER_MASK;
@@ -197,7 +213,8 @@ void ACTION_MANAGER::UpdateHotKeys()
     m_actionHotKeys.clear();
     m_hotkeys.clear();
 
-    for( TOOL_ACTION* action : m_actionNameIndex | boost::adaptors::map_values )
+    // Actions bound to the same hot key are listed in the order of their registration.
+    for( TOOL_ACTION* action : m_actionIdIndex | boost::adaptors::map_values )
     {
         int hotkey = processHotKey( action );
 
@@ -27,6 +27,7 @@
 
 #include <tool/tool_manager.h>
 #include <tool/tool_dispatcher.h>
+#include <tool/tool_event_recorder.h>
 #include <tools/common_actions.h>
 #include <view/view.h>
 #include <view/wx_view_controls.h>
@@ -36,6 +37,9 @@
 
 #include <boost/optional.hpp>
 
+///> Environment variable naming the file the issued TOOL_EVENTs are recorded to
+static const wxChar recordToolEventsEnvVar[] = wxT( "KICAD_RECORD_TOOL_EVENTS" );
+
 ///> Stores information about a mouse button state
 struct TOOL_DISPATCHER::BUTTON_STATE
 {
@@ -115,7 +119,8 @@ struct TOOL_DISPATCHER::BUTTON_STATE
 
 
 TOOL_DISPATCHER::TOOL_DISPATCHER( TOOL_MANAGER* aToolMgr ) :
-    m_toolMgr( aToolMgr )
+    m_toolMgr( aToolMgr ),
+    m_recorder( NULL )
 {
     m_buttons.push_back( new BUTTON_STATE( BUT_LEFT, wxEVT_LEFT_DOWN,
                          wxEVT_LEFT_UP, wxEVT_LEFT_DCLICK ) );
@@ -125,6 +130,19 @@ TOOL_DISPATCHER::TOOL_DISPATCHER( TOOL_MANAGER* aToolMgr ) :
                          wxEVT_MIDDLE_UP, wxEVT_MIDDLE_DCLICK ) );
 
     ResetState();
+
+    wxString recordFile;
+
+    if( wxGetEnv( recordToolEventsEnvVar, &recordFile ) && !recordFile.IsEmpty() )
+    {
+        m_recorder = new TOOL_EVENT_RECORDER( TO_UTF8( recordFile ) );
+
+        if( !m_recorder->IsOpen() )
+        {
+            delete m_recorder;
+            m_recorder = NULL;
+        }
+    }
 }
 
 
@@ -132,6 +150,8 @@ TOOL_DISPATCHER::~TOOL_DISPATCHER()
 {
     for( BUTTON_STATE* st : m_buttons )
         delete st;
+
+    delete m_recorder;
 }
 
 
@@ -231,7 +251,7 @@ bool TOOL_DISPATCHER::handleMouseButton( wxEvent& aEvent, int aIndex, bool aMoti
     if( evt )
     {
         evt->SetMousePosition( isClick ? st->downPosition : m_lastMousePos );
-        m_toolMgr->ProcessEvent( *evt );
+        processEvent( *evt );
 
         return true;
     }
@@ -319,7 +339,7 @@ void TOOL_DISPATCHER::DispatchWxEvent( wxEvent& aEvent )
     }
 
     if( evt )
-        m_toolMgr->ProcessEvent( *evt );
+        processEvent( *evt );
 
     // pass the event to the GUI, it might still be interested in it
 #ifdef __APPLE__
@@ -344,7 +364,7 @@ void TOOL_DISPATCHER::DispatchWxCommand( wxCommandEvent& aEvent )
     boost::optional<TOOL_EVENT> evt = COMMON_ACTIONS::TranslateLegacyId( aEvent.GetId() );
 
     if( evt )
-        m_toolMgr->ProcessEvent( *evt );
+        processEvent( *evt );
     else
         aEvent.Skip();
 
@@ -352,6 +372,15 @@ void TOOL_DISPATCHER::DispatchWxCommand( wxCommandEvent& aEvent )
 }
 
 
+void TOOL_DISPATCHER::processEvent( const TOOL_EVENT& aEvent )
+{
+    if( m_recorder )
+        m_recorder->Record( aEvent );
+
+    m_toolMgr->ProcessEvent( aEvent );
+}
+
+
 void TOOL_DISPATCHER::updateUI()
 {
     // TODO I don't feel it is the right place for updating UI,
@@ -0,0 +1,99 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <cstdlib>
+#include <sstream>
+
+#include <tool/tool_event_recorder.h>
+
+
+TOOL_EVENT_RECORDER::TOOL_EVENT_RECORDER( const std::string& aFileName )
+{
+    m_file = fopen( aFileName.c_str(), "w" );
+}
+
+
+TOOL_EVENT_RECORDER::~TOOL_EVENT_RECORDER()
+{
+    if( m_file )
+        fclose( m_file );
+}
+
+
+void TOOL_EVENT_RECORDER::Record( const TOOL_EVENT& aEvent )
+{
+    if( !m_file )
+        return;
+
+    fprintf( m_file, "0x%x 0x%x", aEvent.Category(), aEvent.Action() );
+
+    switch( aEvent.Category() )
+    {
+    case TC_MOUSE:
+        fprintf( m_file, " 0x%x", aEvent.Buttons() | aEvent.Modifier() );
+        break;
+
+    case TC_KEYBOARD:
+        fprintf( m_file, " 0x%x", aEvent.KeyCode() | aEvent.Modifier() );
+        break;
+
+    case TC_COMMAND:
+    case TC_MESSAGE:
+        if( aEvent.GetCommandStr() )
+            fprintf( m_file, " %s", aEvent.GetCommandStr()->c_str() );
+        else if( aEvent.GetCommandId() )
+            fprintf( m_file, " #%d", *aEvent.GetCommandId() );
+        break;
+
+    default:
+        break;
+    }
+
+    fputc( '\n', m_file );
+}
+
+
+bool TOOL_EVENT_RECORDER::Parse( const std::string& aLine, TOOL_EVENT& aEvent )
+{
+    std::istringstream fields( aLine );
+    std::string category, action, argument;
+
+    if( !( fields >> category >> action ) || category[0] == '#' )
+        return false;
+
+    fields >> argument;
+
+    TOOL_EVENT_CATEGORY cat = (TOOL_EVENT_CATEGORY) strtol( category.c_str(), NULL, 0 );
+    TOOL_ACTIONS act = (TOOL_ACTIONS) strtol( action.c_str(), NULL, 0 );
+
+    if( argument.empty() )
+        aEvent = TOOL_EVENT( cat, act );
+    else if( cat == TC_MOUSE || cat == TC_KEYBOARD )
+        aEvent = TOOL_EVENT( cat, act, (int) strtol( argument.c_str(), NULL, 0 ) );
+    else if( argument[0] == '#' )
+        aEvent = TOOL_EVENT( cat, act, atoi( argument.c_str() + 1 ) );
+    else
+        aEvent = TOOL_EVENT( cat, act, argument );
+
+    return true;
+}
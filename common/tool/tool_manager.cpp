@@ -27,6 +27,7 @@
 #include <deque>
 #include <stack>
 #include <algorithm>
+#include <unordered_map>
 
 #include <boost/scoped_ptr.hpp>
 #include <boost/optional.hpp>
@@ -55,7 +56,8 @@ using boost::optional;
 struct TOOL_MANAGER::TOOL_STATE
 {
     TOOL_STATE( TOOL_BASE* aTool ) :
-        theTool( aTool )
+        theTool( aTool ),
+        waitCategories( 0 )
     {
         clear();
     }
@@ -71,7 +73,12 @@ struct TOOL_MANAGER::TOOL_STATE
         cofunc = aState.cofunc;
         wakeupEvent = aState.wakeupEvent;
         waitEvents = aState.waitEvents;
+        waitCategories = aState.waitCategories;
         transitions = aState.transitions;
+        transitionCategories = aState.transitionCategories;
+        transitionMasks = aState.transitionMasks;
+        namedTransitions = aState.namedTransitions;
+        otherTransitions = aState.otherTransitions;
         // do not copy stateStack
     }
 
@@ -108,10 +115,26 @@ struct TOOL_MANAGER::TOOL_STATE
     /// List of events the tool is currently waiting for
     TOOL_EVENT_LIST waitEvents;
 
+    /// Event categories accepted by waitEvents, so most events are rejected without
+    /// running the matchers
+    int waitCategories;
+
     /// List of possible transitions (ie. association of events and state handlers that are executed
     /// upon the event reception
     std::vector<TRANSITION> transitions;
 
+    /// Event categories accepted by at least one of the transitions
+    int transitionCategories;
+
+    /// Event categories accepted by each of the transitions
+    std::vector<int> transitionMasks;
+
+    /// Transitions matching command and message events by name, indexed by the name hash
+    std::unordered_multimap<size_t, unsigned> namedTransitions;
+
+    /// Transitions having an event which is not a named command or message, in order
+    std::vector<unsigned> otherTransitions;
+
     void operator=( const TOOL_STATE& aState )
     {
         theTool = aState.theTool;
@@ -123,7 +146,12 @@ struct TOOL_MANAGER::TOOL_STATE
         cofunc = aState.cofunc;
         wakeupEvent = aState.wakeupEvent;
         waitEvents = aState.waitEvents;
+        waitCategories = aState.waitCategories;
         transitions = aState.transitions;
+        transitionCategories = aState.transitionCategories;
+        transitionMasks = aState.transitionMasks;
+        namedTransitions = aState.namedTransitions;
+        otherTransitions = aState.otherTransitions;
         // do not copy stateStack
     }
 
@@ -137,6 +165,115 @@ struct TOOL_MANAGER::TOOL_STATE
         return aRhs.theTool != this->theTool;
     }
 
+    /**
+     * Function SetWaitEvents()
+     * Sets the list of events the tool waits for.
+     */
+    void SetWaitEvents( const TOOL_EVENT_LIST& aEvents )
+    {
+        waitEvents = aEvents;
+        waitCategories = 0;
+
+        for( auto it = aEvents.cbegin(); it != aEvents.cend(); ++it )
+            waitCategories |= it->Category();
+    }
+
+    /**
+     * Function AddTransition()
+     * Appends a transition to the table and indexes it by the names and categories
+     * of its events.
+     */
+    void AddTransition( const TRANSITION& aTransition )
+    {
+        unsigned index = transitions.size();
+        int mask = 0;
+        bool unnamed = false;
+
+        transitions.push_back( aTransition );
+
+        for( auto it = aTransition.first.cbegin(); it != aTransition.first.cend(); ++it )
+        {
+            boost::optional<std::string> name = it->GetCommandStr();
+
+            mask |= it->Category();
+
+            // TOOL_EVENT::Matches() compares the names of command and message
+            // events when both events have one
+            if( name && ( it->Category() == TC_COMMAND || it->Category() == TC_MESSAGE ) )
+                namedTransitions.insert( std::make_pair( std::hash<std::string>()( *name ), index ) );
+            else
+                unnamed = true;
+        }
+
+        if( unnamed )
+            otherTransitions.push_back( index );
+
+        transitionMasks.push_back( mask );
+        transitionCategories |= mask;
+    }
+
+    /**
+     * Function ClearTransitions()
+     * Removes all the transitions.
+     */
+    void ClearTransitions()
+    {
+        transitions.clear();
+        transitionMasks.clear();
+        namedTransitions.clear();
+        otherTransitions.clear();
+        transitionCategories = 0;
+    }
+
+    /**
+     * Function FindTransition()
+     * Returns the index of the first transition matching an event, -1 if there is none.
+     * @param aEvent is the event.
+     * @param aName is the name of the event, NULL for events without a name.
+     * @param aNameHash is the std::hash of the name.
+     */
+    int FindTransition( const TOOL_EVENT& aEvent, const std::string* aName, size_t aNameHash ) const
+    {
+        int category = aEvent.Category();
+
+        if( !( transitionCategories & category ) )
+            return -1;
+
+        int found = -1;
+
+        auto test = [&]( unsigned aIndex )
+        {
+            if( ( found < 0 || (int) aIndex < found ) && ( transitionMasks[aIndex] & category )
+                    && transitions[aIndex].first.Matches( aEvent ) )
+                found = aIndex;
+        };
+
+        if( aName )
+        {
+            // A named event matches only named transitions carrying the same name,
+            // or transitions with unnamed events
+            for( unsigned index : otherTransitions )
+            {
+                test( index );
+
+                if( found >= 0 )
+                    break;
+            }
+
+            auto range = namedTransitions.equal_range( aNameHash );
+
+            for( auto it = range.first; it != range.second; ++it )
+                test( it->second );
+        }
+        else
+        {
+            for( unsigned index = 0; index < transitions.size() && found < 0; ++index )
+                test( index );
+        }
+
+        return found;
+    }
+
     /**
      * Function Push()
      * Stores the current state of the tool on stack. Stacks are stored internally and are not
@@ -188,7 +325,7 @@ private:
         cofunc = NULL;
         contextMenu = NULL;
         contextMenuTrigger = CMENU_OFF;
-        transitions.clear();
+        ClearTransitions();
     }
 };
 
@@ -296,17 +433,7 @@ bool TOOL_MANAGER::RunAction( const std::string& aActionName, bool aNow, void* a
 
     if( action )
     {
-        TOOL_EVENT event = action->MakeEvent();
-
-        // Allow to override the action parameter
-        if( aParam )
-            event.SetParameter( aParam );
-
-        if( aNow )
-            ProcessEvent( event );
-        else
-            PostEvent( event );
-
+        RunAction( *action, aNow, aParam );
         return true;
     }
 
@@ -466,7 +593,7 @@ void TOOL_MANAGER::ScheduleNextState( TOOL_BASE* aTool, TOOL_STATE_FUNC& aHandle
 {
     TOOL_STATE* st = m_toolState[aTool];
 
-    st->transitions.push_back( TRANSITION( aConditions, aHandler ) );
+    st->AddTransition( TRANSITION( aConditions, aHandler ) );
 }
 
 
@@ -487,7 +614,7 @@ optional<TOOL_EVENT> TOOL_MANAGER::ScheduleWait( TOOL_BASE* aTool,
     // indicate to the manager that we are going to sleep and we shall be
     // woken up when an event matching aConditions arrive
     st->pendingWait = true;
-    st->waitEvents = aConditions;
+    st->SetWaitEvents( aConditions );
 
     // switch context back to event dispatcher loop
     st->cofunc->Yield();
@@ -498,6 +625,11 @@ optional<TOOL_EVENT> TOOL_MANAGER::ScheduleWait( TOOL_BASE* aTool,
 
 void TOOL_MANAGER::dispatchInternal( const TOOL_EVENT& aEvent )
 {
+    // Transitions are indexed by the hash of the event names, see TOOL_STATE::FindTransition()
+    boost::optional<std::string> name = aEvent.GetCommandStr();
+    size_t nameHash = name ? std::hash<std::string>()( *name ) : 0;
+    int category = aEvent.Category();
+
     // iterate over all registered tools
     for( auto it = m_activeTools.begin(); it != m_activeTools.end(); /* iteration is done inside */)
     {
@@ -506,7 +638,7 @@ void TOOL_MANAGER::dispatchInternal( const TOOL_EVENT& aEvent )
         ++it;       // it might be overwritten, if the tool is removed the m_activeTools deque
 
         // the tool state handler is waiting for events (i.e. called Wait() method)
-        if( st->pendingWait )
+        if( st->pendingWait && ( st->waitCategories & category ) )
         {
             if( st->waitEvents.Matches( aEvent ) )
             {
@@ -516,7 +648,7 @@ void TOOL_MANAGER::dispatchInternal( const TOOL_EVENT& aEvent )
                 // got matching event? clear wait list and wake up the coroutine
                 st->wakeupEvent = aEvent;
                 st->pendingWait = false;
-                st->waitEvents.clear();
+                st->SetWaitEvents( TOOL_EVENT_LIST() );
 
                 if( st->cofunc && !st->cofunc->Resume() )
                 {
@@ -538,30 +670,26 @@ void TOOL_MANAGER::dispatchInternal( const TOOL_EVENT& aEvent )
         // Go() method that match the event.
         if( !st->pendingWait && !st->transitions.empty() )
         {
-            for( TRANSITION& tr : st->transitions )
-            {
-                if( tr.first.Matches( aEvent ) )
-                {
-                    auto func_copy = tr.second;
+            int index = st->FindTransition( aEvent, name ? &*name : NULL, nameHash );
 
-                    // if there is already a context, then store it
-                    if( st->cofunc )
-                        st->Push();
+            if( index >= 0 )
+            {
+                auto func_copy = st->transitions[index].second;
 
-                    st->cofunc = new COROUTINE<int, const TOOL_EVENT&>( std::move( func_copy ) );
+                // if there is already a context, then store it
+                if( st->cofunc )
+                    st->Push();
 
-                    // as the state changes, the transition table has to be set up again
-                    st->transitions.clear();
+                st->cofunc = new COROUTINE<int, const TOOL_EVENT&>( std::move( func_copy ) );
 
-                    // got match? Run the handler.
-                    st->cofunc->Call( aEvent );
+                // as the state changes, the transition table has to be set up again
+                st->ClearTransitions();
 
-                    if( !st->cofunc->Running() )
-                        finishTool( st ); // The couroutine has finished immediately?
+                // got match? Run the handler.
+                st->cofunc->Call( aEvent );
 
-                    // there is no point in further checking, as transitions got cleared
-                    break;
-                }
+                if( !st->cofunc->Running() )
+                    finishTool( st ); // The couroutine has finished immediately?
             }
         }
     }
@@ -612,7 +740,7 @@ void TOOL_MANAGER::dispatchContextMenu( const TOOL_EVENT& aEvent )
                 break;
 
             st->pendingWait = true;
-            st->waitEvents = TOOL_EVENT( TC_ANY, TA_ANY );
+            st->SetWaitEvents( TOOL_EVENT( TC_ANY, TA_ANY ) );
 
             // Store the menu pointer in case it is changed by the TOOL when handling menu events
             CONTEXT_MENU* m = st->contextMenu;
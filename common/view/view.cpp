@@ -38,6 +38,8 @@
 #include <profile.h>
 #endif /* __WXDEBUG__  */
 
+#include <profile_trace.h>
+
 using namespace KIGFX;
 
 VIEW::VIEW( bool aIsDynamic ) :
@@ -767,6 +769,8 @@ void VIEW::ClearTargets()
 
 void VIEW::Redraw()
 {
+    PROF_ZONE_SCOPE( "VIEW::Redraw", "redraw" );
+
 #ifdef __WXDEBUG__
     prof_counter totalRealTime;
     prof_start( &totalRealTime );
@@ -303,37 +303,39 @@ void SCH_EDIT_FRAME::EndSegment( wxDC* DC )
     SCH_LINE* firstsegment = (SCH_LINE*) s_wires.GetFirst();
     wxPoint startPoint = firstsegment->GetStartPoint();
 
-    // Save the old wires for the undo command
-    DLIST< SCH_ITEM > oldWires;                     // stores here the old wires
-    GetScreen()->ExtractWires( oldWires, true );    // Save them in oldWires list
-    // Put the snap shot of the previous wire, buses, and junctions in the undo/redo list.
-    PICKED_ITEMS_LIST oldItems;
-    oldItems.m_Status = UR_WIRE_IMAGE;
-
-    while( oldWires.GetCount() != 0 )
-    {
-        ITEM_PICKER picker = ITEM_PICKER( oldWires.PopFront(), UR_WIRE_IMAGE );
-        oldItems.PushItem( picker );
-    }
-
-    SaveCopyInUndoList( oldItems, UR_WIRE_IMAGE );
-
     // Remove segments backtracking over others
     RemoveBacktracks( s_wires );
 
+    // The undo command only records the new wires and the segments and junctions
+    // modified or deleted by the clean up, not a copy of all the wires of the sheet.
+    PICKED_ITEMS_LIST itemList;
+
+    for( SCH_ITEM* wire = s_wires.begin(); wire; wire = wire->Next() )
+        itemList.PushItem( ITEM_PICKER( wire, UR_NEW ) );
+
     // Add the new wires
     screen->Append( s_wires );
 
     // Correct and remove segments that need to be merged.
-    screen->SchematicCleanUp();
+    screen->SchematicCleanUp( &itemList );
 
     // A junction could be needed to connect the end point of the last created segment.
     if( screen->IsJunctionNeeded( endpoint ) )
-        screen->Append( AddJunction( DC, endpoint ) );
+    {
+        SCH_JUNCTION* junction = AddJunction( DC, endpoint );
+        screen->Append( junction );
+        itemList.PushItem( ITEM_PICKER( junction, UR_NEW ) );
+    }
 
     // A junction could be needed to connect the start point of the set of new created wires
     if( screen->IsJunctionNeeded( startPoint ) )
-        screen->Append( AddJunction( DC, startPoint ) );
+    {
+        SCH_JUNCTION* junction = AddJunction( DC, startPoint );
+        screen->Append( junction );
+        itemList.PushItem( ITEM_PICKER( junction, UR_NEW ) );
+    }
+
+    SaveCopyInUndoList( itemList, UR_NEW );
 
     m_canvas->Refresh();
 
@@ -313,6 +313,141 @@ void LIB_PART::SetName( const wxString& aName )
 }
 
 
+void LIB_PART::collectDrawItems( DRAW_CACHE& aCache, int aUnit, int aConvert, bool aDrawFields,
+                                 bool aOnlySelected ) const
+{
+    for( const LIB_ITEM& item : drawings )
+    {
+        if( aOnlySelected && !item.IsSelected() )
+            continue;
+
+        // Do not draw items not attached to the current part
+        if( aUnit && item.m_Unit && ( item.m_Unit != aUnit ) )
+            continue;
+
+        if( aConvert && item.m_Convert && ( item.m_Convert != aConvert ) )
+            continue;
+
+        if( item.Type() == LIB_FIELD_T )
+        {
+            if( aDrawFields )
+                aCache.m_items.push_back( const_cast<LIB_ITEM*>( &item ) );
+
+            continue;
+        }
+
+        if( item.m_Fill == FILLED_WITH_BG_BODYCOLOR )
+            aCache.m_backgrounds.push_back( const_cast<LIB_ITEM*>( &item ) );
+
+        aCache.m_items.push_back( const_cast<LIB_ITEM*>( &item ) );
+    }
+}
+
+
+const LIB_PART::DRAW_CACHE& LIB_PART::getDrawCache( int aUnit, int aConvert ) const
+{
+    std::lock_guard<std::mutex> lock( m_cacheLock );
+
+    auto it = m_drawCache.find( std::make_pair( aUnit, aConvert ) );
+
+    if( it != m_drawCache.end() )
+        return it->second;
+
+    DRAW_CACHE& cache = m_drawCache[ std::make_pair( aUnit, aConvert ) ];
+
+    collectDrawItems( cache, aUnit, aConvert, false, false );
+
+    bool initialized = false;
+
+    for( const LIB_ITEM* item : cache.m_items )
+    {
+        // Hidden pins are drawn when the user asks for them.
+        EDA_RECT bBox = item->Type() == LIB_PIN_T
+                        ? static_cast<const LIB_PIN*>( item )->GetBoundingBox( true )
+                        : item->GetBoundingBox();
+
+        if( initialized )
+            cache.m_extents.Merge( bBox );
+        else
+            cache.m_extents = bBox;
+
+        initialized = true;
+    }
+
+    // Room for the pen widths and the dangling pin targets.
+    cache.m_extents.Inflate( 2 * TARGET_PIN_RADIUS + GetDefaultLineThickness() );
+
+    return cache;
+}
+
+
+const LIB_PART::GEOMETRY_CACHE& LIB_PART::getGeometryCache( const DRAW_CACHE& aItems,
+                                                            int aUnit, int aConvert,
+                                                            const TRANSFORM& aTransform ) const
+{
+    std::lock_guard<std::mutex> lock( m_cacheLock );
+
+    GEOMETRY_KEY key( aUnit, aConvert, aTransform.x1, aTransform.y1, aTransform.x2,
+                      aTransform.y2 );
+    auto it = m_geometryCache.find( key );
+
+    if( it != m_geometryCache.end() )
+        return it->second;
+
+    GEOMETRY_CACHE& cache = m_geometryCache[ key ];
+
+    cache.m_backgrounds.resize( aItems.m_backgrounds.size() );
+    cache.m_items.resize( aItems.m_items.size() );
+
+    for( size_t ii = 0; ii < aItems.m_backgrounds.size(); ii++ )
+        aItems.m_backgrounds[ii]->transformGeometry( cache.m_backgrounds[ii], aTransform );
+
+    for( size_t ii = 0; ii < aItems.m_items.size(); ii++ )
+        aItems.m_items[ii]->transformGeometry( cache.m_items[ii], aTransform );
+
+    return cache;
+}
+
+
+const LIB_PART::UNIT_CACHE& LIB_PART::getUnitCache( int aUnit, int aConvert ) const
+{
+    std::lock_guard<std::mutex> lock( m_cacheLock );
+
+    auto it = m_unitCache.find( std::make_pair( aUnit, aConvert ) );
+
+    if( it != m_unitCache.end() )
+        return it->second;
+
+    UNIT_CACHE& cache = m_unitCache[ std::make_pair( aUnit, aConvert ) ];
+
+    cache.m_bodyBBox = computeBodyBoundingBox( aUnit, aConvert );
+
+    // Same filtering as GetPins()
+    for( const LIB_ITEM& item : drawings )
+    {
+        if( item.Type() != LIB_PIN_T )
+            continue;
+
+        if( aUnit && item.m_Unit && ( item.m_Unit != aUnit ) )
+            continue;
+
+        if( aConvert && item.m_Convert && ( item.m_Convert != aConvert ) )
+            continue;
+
+        LIB_PIN* pin = (LIB_PIN*) &item;
+        wxString number;
+
+        pin->PinStringNum( number );
+
+        cache.m_pins.push_back( pin );
+        cache.m_pinOffsets.push_back( pin->GetPosition() );
+        cache.m_pinsByNumber.emplace( number, pin );     // GetPin() returns the first one
+    }
+
+    return cache;
+}
+
+
 void LIB_PART::Draw( EDA_DRAW_PANEL* aPanel, wxDC* aDc, const wxPoint& aOffset, int aMulti,
                      int aConvert, GR_DRAWMODE aDrawMode, EDA_COLOR_T aColor,
                      const TRANSFORM& aTransform, bool aShowPinText, bool aDrawFields,
@@ -323,6 +458,22 @@ void LIB_PART::Draw( EDA_DRAW_PANEL* aPanel, wxDC* aDc, const wxPoint& aOffset,
 
     GRSetDrawMode( aDc, aDrawMode );
 
+    // A schematic draws whole units without their library fields, many times: the
+    // lists of items to draw are cached for that case instead of being filtered anew.
+    DRAW_CACHE  uncached;
+    bool        useCache = !aDrawFields && !aOnlySelected;
+
+    if( !useCache )
+        collectDrawItems( uncached, aMulti, aConvert, aDrawFields, aOnlySelected );
+
+    const DRAW_CACHE& items = useCache ? getDrawCache( aMulti, aConvert ) : uncached;
+
+    // The graphic items of a schematic component are drawn from their points mapped by
+    // the component orientation, also cached: only the position changes between redraws.
+    const GEOMETRY_CACHE* geometry = useCache
+                                     ? &getGeometryCache( items, aMulti, aConvert, aTransform )
+                                     : NULL;
+
     /* draw background for filled items using background option
      * Solid lines will be drawn after the background
      * Note also, background is not drawn when:
@@ -332,64 +483,40 @@ void LIB_PART::Draw( EDA_DRAW_PANEL* aPanel, wxDC* aDc, const wxPoint& aOffset,
     if( ! (screen && screen->m_IsPrinting && GetGRForceBlackPenState())
             && (aColor == UNSPECIFIED_COLOR) )
     {
-        for( LIB_ITEM& drawItem : drawings )
+        for( size_t ii = 0; ii < items.m_backgrounds.size(); ii++ )
         {
-            if( drawItem.m_Fill != FILLED_WITH_BG_BODYCOLOR )
-                continue;
-
-            if( aOnlySelected && !drawItem.IsSelected() )
-                continue;
+            LIB_ITEM* drawItem = items.m_backgrounds[ii];
 
             // Do not draw an item while moving (the cursor handler does that)
-            if( drawItem.m_Flags & IS_MOVED )
-                continue;
-
-            // Do not draw items not attached to the current part
-            if( aMulti && drawItem.m_Unit && ( drawItem.m_Unit != aMulti ) )
-                continue;
-
-            if( aConvert && drawItem.m_Convert && ( drawItem.m_Convert != aConvert ) )
+            if( drawItem->m_Flags & IS_MOVED )
                 continue;
 
-            if( drawItem.Type() == LIB_FIELD_T )
-                continue;
-
-            if( drawItem.Type() == LIB_FIELD_T )
-            {
-                drawItem.Draw( aPanel, aDc, aOffset, aColor, aDrawMode, (void*) NULL, aTransform );
-            }
-
             // Now, draw only the background for items with
             // m_Fill == FILLED_WITH_BG_BODYCOLOR:
-            drawItem.Draw( aPanel, aDc, aOffset, aColor, aDrawMode, (void*) false, aTransform );
+            if( geometry && !geometry->m_backgrounds[ii].m_points.empty()
+                    && !drawItem->InEditMode() )
+                drawItem->drawGeometry( aPanel, aDc, aOffset, aColor, aDrawMode, (void*) false,
+                                        geometry->m_backgrounds[ii] );
+            else
+                drawItem->Draw( aPanel, aDc, aOffset, aColor, aDrawMode, (void*) false,
+                                aTransform );
         }
     }
 
     // Track the index into the dangling pins list
     size_t pin_index = 0;
 
-    for( LIB_ITEM& drawItem : drawings )
+    for( size_t ii = 0; ii < items.m_items.size(); ii++ )
     {
-        if( aOnlySelected && !drawItem.IsSelected() )
-            continue;
+        LIB_ITEM& drawItem = *items.m_items[ii];
 
         // Do not draw an item while moving (the cursor handler does that)
         if( drawItem.m_Flags & IS_MOVED )
             continue;
 
-        // Do not draw items not attached to the current part
-        if( aMulti && drawItem.m_Unit && ( drawItem.m_Unit != aMulti ) )
-            continue;
-
-        if( aConvert && drawItem.m_Convert && ( drawItem.m_Convert != aConvert ) )
-            continue;
-
-        if( !aDrawFields && drawItem.Type() == LIB_FIELD_T )
-            continue;
-
         if( drawItem.Type() == LIB_PIN_T )
         {
-            LIB_PIN& pin = dynamic_cast<LIB_PIN&>( drawItem );
+            LIB_PIN& pin = static_cast<LIB_PIN&>( drawItem );
 
             uintptr_t flags = 0;
             if( aShowPinText )
@@ -415,8 +542,14 @@ void LIB_PART::Draw( EDA_DRAW_PANEL* aPanel, wxDC* aDc, const wxPoint& aOffset,
         else
         {
             bool forceNoFill = drawItem.m_Fill == FILLED_WITH_BG_BODYCOLOR;
-            drawItem.Draw( aPanel, aDc, aOffset, aColor, aDrawMode, (void*) forceNoFill,
-                           aTransform );
+
+            if( geometry && !geometry->m_items[ii].m_points.empty()
+                    && !drawItem.InEditMode() )
+                drawItem.drawGeometry( aPanel, aDc, aOffset, aColor, aDrawMode,
+                                       (void*) forceNoFill, geometry->m_items[ii] );
+            else
+                drawItem.Draw( aPanel, aDc, aOffset, aColor, aDrawMode, (void*) forceNoFill,
+                               aTransform );
         }
 
     }
@@ -525,6 +658,8 @@ void LIB_PART::PlotLibFields( PLOTTER* aPlotter, int aUnit, int aConvert,
 
 void LIB_PART::RemoveDrawItem( LIB_ITEM* aItem, EDA_DRAW_PANEL* aPanel, wxDC* aDc )
 {
+    ClearCaches();
+
     wxASSERT( aItem != NULL );
 
     // none of the MANDATORY_FIELDS may be removed in RAM, but they may be
@@ -563,6 +698,8 @@ void LIB_PART::RemoveDrawItem( LIB_ITEM* aItem, EDA_DRAW_PANEL* aPanel, wxDC* aD
 
 void LIB_PART::AddDrawItem( LIB_ITEM* aItem )
 {
+    ClearCaches();
+
     wxASSERT( aItem != NULL );
 
     drawings.push_back( aItem );
@@ -635,22 +772,13 @@ void LIB_PART::GetPins( LIB_PINS& aList, int aUnit, int aConvert )
 
 LIB_PIN* LIB_PART::GetPin( const wxString& aNumber, int aUnit, int aConvert )
 {
-    wxString pNumber;
-    LIB_PINS pinList;
-
-    GetPins( pinList, aUnit, aConvert );
-
-    for( size_t i = 0; i < pinList.size(); i++ )
-    {
-        wxASSERT( pinList[i]->Type() == LIB_PIN_T );
-
-        pinList[i]->PinStringNum( pNumber );
+    const UNIT_CACHE& cache = getUnitCache( aUnit, aConvert );
+    auto it = cache.m_pinsByNumber.find( aNumber );
 
-        if( aNumber == pNumber )
-            return pinList[i];
-    }
+    if( it == cache.m_pinsByNumber.end() )
+        return NULL;
 
-    return NULL;
+    return it->second;
 }
 
 
@@ -850,6 +978,7 @@ bool LIB_PART::Save( OUTPUTFORMATTER& aFormatter )
 
 bool LIB_PART::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
 {
+    char*    saveptr;
     int      unused;
     char*    p;
     char*    componentName;
@@ -861,7 +990,7 @@ bool LIB_PART::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
 
     line = aLineReader.Line();
 
-    p = strtok( line, " \t\r\n" );
+    p = strtok_r( line, " \t\r\n", &saveptr );
 
     if( strcmp( p, "DEF" ) != 0 )
     {
@@ -874,17 +1003,17 @@ bool LIB_PART::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
     char drawnum = 0;
     char drawname = 0;
 
-    if( ( componentName = strtok( NULL, " \t\n" ) ) == NULL  // Part name:
-        || ( prefix = strtok( NULL, " \t\n" ) ) == NULL      // Prefix name:
-        || ( p = strtok( NULL, " \t\n" ) ) == NULL           // NumOfPins:
+    if( ( componentName = strtok_r( NULL, " \t\n", &saveptr ) ) == NULL  // Part name:
+        || ( prefix = strtok_r( NULL, " \t\n", &saveptr ) ) == NULL      // Prefix name:
+        || ( p = strtok_r( NULL, " \t\n", &saveptr ) ) == NULL           // NumOfPins:
         || sscanf( p, "%d", &unused ) != 1
-        || ( p = strtok( NULL, " \t\n" ) ) == NULL           // TextInside:
+        || ( p = strtok_r( NULL, " \t\n", &saveptr ) ) == NULL           // TextInside:
         || sscanf( p, "%d", &m_pinNameOffset ) != 1
-        || ( p = strtok( NULL, " \t\n" ) ) == NULL           // DrawNums:
+        || ( p = strtok_r( NULL, " \t\n", &saveptr ) ) == NULL           // DrawNums:
         || sscanf( p, "%c", &drawnum ) != 1
-        || ( p = strtok( NULL, " \t\n" ) ) == NULL           // DrawNums:
+        || ( p = strtok_r( NULL, " \t\n", &saveptr ) ) == NULL           // DrawNums:
         || sscanf( p, "%c", &drawname ) != 1
-        || ( p = strtok( NULL, " \t\n" ) ) == NULL           // m_unitCount:
+        || ( p = strtok_r( NULL, " \t\n", &saveptr ) ) == NULL           // m_unitCount:
         || sscanf( p, "%d", &m_unitCount ) != 1 )
     {
         aErrorMsg.Printf( wxT( "Wrong DEF format in line %d, skipped." ),
@@ -892,7 +1021,7 @@ bool LIB_PART::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
 
         while( (line = aLineReader.ReadLine()) != NULL )
         {
-            p = strtok( line, " \t\n" );
+            p = strtok_r( line, " \t\n", &saveptr );
 
             if( p && strcasecmp( p, "ENDDEF" ) == 0 )
                 break;
@@ -939,16 +1068,16 @@ bool LIB_PART::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
     }
 
     // Copy optional infos
-    if( ( p = strtok( NULL, " \t\n" ) ) != NULL && *p == 'L' )
+    if( ( p = strtok_r( NULL, " \t\n", &saveptr ) ) != NULL && *p == 'L' )
         m_unitsLocked = true;
 
-    if( ( p = strtok( NULL, " \t\n" ) ) != NULL  && *p == 'P' )
+    if( ( p = strtok_r( NULL, " \t\n", &saveptr ) ) != NULL  && *p == 'P' )
         m_options = ENTRY_POWER;
 
     // Read next lines, until "ENDDEF" is found
     while( ( line = aLineReader.ReadLine() ) != NULL )
     {
-        p = strtok( line, " \t\r\n" );
+        p = strtok_r( line, " \t\r\n", &saveptr );
 
         // This is the error flag ( if an error occurs, result = false)
         result = true;
@@ -969,7 +1098,7 @@ bool LIB_PART::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
             result = LoadDrawEntries( aLineReader, Msg );
         else if( strncmp( p, "ALIAS", 5 ) == 0 )
         {
-            p = strtok( NULL, "\r\n" );
+            p = strtok_r( NULL, "\r\n", &saveptr );
             result = LoadAliases( p, aErrorMsg );
         }
         else if( strncmp( p, "$FPLIST", 5 ) == 0 )
@@ -1090,12 +1219,13 @@ bool LIB_PART::LoadDrawEntries( LINE_READER& aLineReader, wxString& aErrorMsg )
 
 bool LIB_PART::LoadAliases( char* aLine, wxString& aErrorMsg )
 {
-    char* text = strtok( aLine, " \t\r\n" );
+    char*    saveptr;
+    char* text = strtok_r( aLine, " \t\r\n", &saveptr );
 
     while( text )
     {
         m_aliases.push_back( new LIB_ALIAS( FROM_UTF8( text ), this ) );
-        text = strtok( NULL, " \t\r\n" );
+        text = strtok_r( NULL, " \t\r\n", &saveptr );
     }
 
     return true;
@@ -1139,6 +1269,7 @@ bool LIB_PART::LoadField( LINE_READER& aLineReader, wxString& aErrorMsg )
 
 bool LIB_PART::LoadFootprints( LINE_READER& aLineReader, wxString& aErrorMsg )
 {
+    char*    saveptr;
     char* line;
     char* p;
 
@@ -1150,7 +1281,7 @@ bool LIB_PART::LoadFootprints( LINE_READER& aLineReader, wxString& aErrorMsg )
             return false;
         }
 
-        p = strtok( line, " \t\r\n" );
+        p = strtok_r( line, " \t\r\n", &saveptr );
 
         if( strcasecmp( p, "$ENDFPLIST" ) == 0 )
             break;
@@ -1195,6 +1326,12 @@ const EDA_RECT LIB_PART::GetUnitBoundingBox( int aUnit, int aConvert ) const
 
 
 const EDA_RECT LIB_PART::GetBodyBoundingBox( int aUnit, int aConvert ) const
+{
+    return getUnitCache( aUnit, aConvert ).m_bodyBBox;
+}
+
+
+const EDA_RECT LIB_PART::computeBodyBoundingBox( int aUnit, int aConvert ) const
 {
     EDA_RECT bBox;
     bool initialized = false;
@@ -1228,6 +1365,8 @@ const EDA_RECT LIB_PART::GetBodyBoundingBox( int aUnit, int aConvert ) const
 
 void LIB_PART::deleteAllFields()
 {
+    ClearCaches();
+
     LIB_ITEMS::iterator it;
 
     for( it = drawings.begin();  it != drawings.end();  /* deleting */  )
@@ -1246,6 +1385,7 @@ void LIB_PART::deleteAllFields()
 
 void LIB_PART::SetFields( const std::vector <LIB_FIELD>& aFields )
 {
+    ClearCaches();
     deleteAllFields();
 
     for( unsigned i=0;  i<aFields.size();  ++i )
@@ -1370,11 +1510,12 @@ bool LIB_PART::SaveDateAndTime( OUTPUTFORMATTER& aFormatter )
 
 bool LIB_PART::LoadDateAndTime( char* aLine )
 {
+    char*    saveptr;
     int   year, mon, day, hour, min, sec;
 
     year = mon = day = hour = min = sec = 0;
-    strtok( aLine, " \r\t\n" );
-    strtok( NULL, " \r\t\n" );
+    strtok_r( aLine, " \r\t\n", &saveptr );
+    strtok_r( NULL, " \r\t\n", &saveptr );
 
     if( sscanf( aLine, "%d/%d/%d %d:%d:%d", &year, &mon, &day, &hour, &min, &sec ) != 6 )
         return false;
@@ -1389,6 +1530,8 @@ bool LIB_PART::LoadDateAndTime( char* aLine )
 
 void LIB_PART::SetOffset( const wxPoint& aOffset )
 {
+    ClearCaches();
+
     for( LIB_ITEM& item : drawings )
     {
         item.SetOffset( aOffset );
@@ -1398,6 +1541,7 @@ void LIB_PART::SetOffset( const wxPoint& aOffset )
 
 void LIB_PART::RemoveDuplicateDrawItems()
 {
+    ClearCaches();
     drawings.unique();
 }
 
@@ -1457,6 +1601,8 @@ int LIB_PART::SelectItems( EDA_RECT& aRect, int aUnit, int aConvert, bool aEditP
 
 void LIB_PART::MoveSelectedItems( const wxPoint& aOffset )
 {
+    ClearCaches();
+
     for( LIB_ITEM& item : drawings )
     {
         if( !item.IsSelected() )
@@ -1481,6 +1627,8 @@ void LIB_PART::ClearSelectedItems()
 
 void LIB_PART::DeleteSelectedItems()
 {
+    ClearCaches();
+
     LIB_ITEMS::iterator item = drawings.begin();
 
     // We *do not* remove the 2 mandatory fields: reference and value
@@ -1511,6 +1659,8 @@ void LIB_PART::DeleteSelectedItems()
 
 void LIB_PART::CopySelectedItems( const wxPoint& aOffset )
 {
+    ClearCaches();
+
     /* *do not* use iterators here, because new items
      * are added to drawings that is a  boost::ptr_vector.
      * When push_back elements in buffer,
@@ -1544,6 +1694,8 @@ void LIB_PART::CopySelectedItems( const wxPoint& aOffset )
 
 void LIB_PART::MirrorSelectedItemsH( const wxPoint& aCenter )
 {
+    ClearCaches();
+
     for( LIB_ITEM& item : drawings )
     {
         if( !item.IsSelected() )
@@ -1558,6 +1710,8 @@ void LIB_PART::MirrorSelectedItemsH( const wxPoint& aCenter )
 
 void LIB_PART::MirrorSelectedItemsV( const wxPoint& aCenter )
 {
+    ClearCaches();
+
     for( LIB_ITEM& item : drawings )
     {
         if( !item.IsSelected() )
@@ -1572,6 +1726,8 @@ void LIB_PART::MirrorSelectedItemsV( const wxPoint& aCenter )
 
 void LIB_PART::RotateSelectedItems( const wxPoint& aCenter )
 {
+    ClearCaches();
+
     for( LIB_ITEM& item : drawings )
     {
         if( !item.IsSelected() )
@@ -1627,6 +1783,8 @@ LIB_ITEM* LIB_PART::LocateDrawItem( int aUnit, int aConvert, KICAD_T aType,
 
 void LIB_PART::SetUnitCount( int aCount )
 {
+    ClearCaches();
+
     if( m_unitCount == aCount )
         return;
 
@@ -1674,6 +1832,8 @@ void LIB_PART::SetUnitCount( int aCount )
 
 void LIB_PART::SetConversion( bool aSetConvert )
 {
+    ClearCaches();
+
     if( aSetConvert == HasConversion() )
         return;
 
@@ -34,6 +34,10 @@
 #include <lib_id.h>
 #include <lib_draw_item.h>
 #include <lib_field.h>
+#include <hashtables.h>
+#include <map>
+#include <mutex>
+#include <tuple>
 #include <vector>
 #include <memory>
 
@@ -213,8 +217,69 @@ class LIB_PART : public EDA_ITEM
                                             ///< from the part number: only 'A', 'a' or '1' can be used,
                                             ///< other values have no sense.
 private:
+    /// The items Draw() handles for a unit and body style, see getDrawCache().
+    struct DRAW_CACHE
+    {
+        std::vector<LIB_ITEM*>  m_backgrounds;  ///< items filled with the body background color
+        std::vector<LIB_ITEM*>  m_items;        ///< the items to draw, in drawing order
+        EDA_RECT                m_extents;      ///< area covered by m_items, Y axis reversed
+    };
+
+    /// Draw caches by ( unit, convert ), fields excluded, built on first use.
+    mutable std::map< std::pair<int, int>, DRAW_CACHE > m_drawCache;
+
+    /// The graphic items of a DRAW_CACHE mapped by a transform, see getGeometryCache().
+    struct GEOMETRY_CACHE
+    {
+        std::vector<LIB_GEOMETRY>   m_backgrounds;  ///< DRAW_CACHE::m_backgrounds points
+        std::vector<LIB_GEOMETRY>   m_items;        ///< DRAW_CACHE::m_items points, none for
+                                                    ///< the items drawGeometry() does not draw
+    };
+
+    /// ( unit, convert, TRANSFORM x1, y1, x2, y2 )
+    typedef std::tuple<int, int, int, int, int, int> GEOMETRY_KEY;
+
+    /// Geometry caches by unit, body style and orientation, built on first use.
+    mutable std::map< GEOMETRY_KEY, GEOMETRY_CACHE > m_geometryCache;
+
+    /// The geometry schematic instances ask for, for a unit and body style.
+    struct UNIT_CACHE
+    {
+        EDA_RECT                m_bodyBBox;     ///< GetBodyBoundingBox()
+        LIB_PINS                m_pins;         ///< GetPins(), in draw list order
+        std::vector<wxPoint>    m_pinOffsets;   ///< positions of m_pins, library coordinates
+        std::unordered_map<wxString, LIB_PIN*, WXSTRING_HASH> m_pinsByNumber;
+    };
+
+    /// Unit caches by ( unit, convert ), built on first use.
+    mutable std::map< std::pair<int, int>, UNIT_CACHE > m_unitCache;
+
+    /// Guards the creation of the cache entries, parts are shared by many threads.
+    mutable std::mutex  m_cacheLock;
+
     void deleteAllFields();
 
+    /**
+     * Function collectDrawItems
+     * fills \a aCache with the items Draw() handles with the same parameters.
+     */
+    void collectDrawItems( DRAW_CACHE& aCache, int aUnit, int aConvert, bool aDrawFields,
+                           bool aOnlySelected ) const;
+
+    const DRAW_CACHE& getDrawCache( int aUnit, int aConvert ) const;
+
+    /**
+     * Function getGeometryCache
+     * returns the points of the graphic items of \a aItems, the draw cache of \a aUnit
+     * and \a aConvert, mapped by \a aTransform.
+     */
+    const GEOMETRY_CACHE& getGeometryCache( const DRAW_CACHE& aItems, int aUnit, int aConvert,
+                                            const TRANSFORM& aTransform ) const;
+
+    const UNIT_CACHE& getUnitCache( int aUnit, int aConvert ) const;
+
+    const EDA_RECT computeBodyBoundingBox( int aUnit, int aConvert ) const;
+
     // LIB_PART()  { }     // not legal
 
 public:
@@ -306,6 +371,7 @@ public:
      *  If aUnit == 0, unit is not used
      *  if aConvert == 0 Convert is non used
      *  Fields are not taken in account
+     *  The box is cached until the drawings change.
      **/
     const EDA_RECT GetBodyBoundingBox( int aUnit, int aConvert ) const;
 
@@ -530,6 +596,26 @@ public:
      */
     LIB_PIN* GetPin( const wxString& aNumber, int aUnit = 0, int aConvert = 0 );
 
+    /**
+     * Function GetUnitPins
+     * returns the pins GetPins() returns for \a aUnit and \a aConvert, from a table
+     * cached until the drawings change.
+     */
+    const LIB_PINS& GetUnitPins( int aUnit, int aConvert ) const
+    {
+        return getUnitCache( aUnit, aConvert ).m_pins;
+    }
+
+    /**
+     * Function GetUnitPinOffsets
+     * returns the positions of the pins of GetUnitPins(), in library coordinates: a
+     * component gets the positions of its pins with a single transform.
+     */
+    const std::vector<wxPoint>& GetUnitPinOffsets( int aUnit, int aConvert ) const
+    {
+        return getUnitCache( aUnit, aConvert ).m_pinOffsets;
+    }
+
     /**
      * Function PinsConflictWith
      * returns true if this part's pins do not match another part's pins. This
@@ -664,7 +750,37 @@ public:
      *
      * @return LIB_ITEMS& - Reference to the draw item object list.
      */
-    LIB_ITEMS& GetDrawItemList() { return drawings; }
+    LIB_ITEMS& GetDrawItemList()
+    {
+        // The caller may well modify the items.
+        ClearCaches();
+        return drawings;
+    }
+
+    /**
+     * Function GetDrawExtents
+     * returns the area Draw() can paint for \a aUnit and \a aConvert, fields excluded,
+     * pin texts and hidden pins included, in library coordinates with the Y axis
+     * reversed like the item bounding boxes.  It is cached and cheap to call.
+     */
+    const EDA_RECT& GetDrawExtents( int aUnit, int aConvert ) const
+    {
+        return getDrawCache( aUnit, aConvert ).m_extents;
+    }
+
+    /**
+     * Function ClearCaches
+     * forgets the data cached for drawing, bounding boxes and pin tables.  It must be
+     * called when the drawings change.
+     */
+    void ClearCaches()
+    {
+        std::lock_guard<std::mutex> lock( m_cacheLock );
+
+        m_drawCache.clear();
+        m_geometryCache.clear();
+        m_unitCache.clear();
+    }
 
     /**
      * Set the units per part count.
@@ -743,7 +859,7 @@ public:
      *
      * @param aOffset - The offset in mils.
      */
-    void SetPinNameOffset( int aOffset ) { m_pinNameOffset = aOffset; }
+    void SetPinNameOffset( int aOffset ) { m_pinNameOffset = aOffset; ClearCaches(); }
 
     int GetPinNameOffset() { return m_pinNameOffset; }
 
@@ -752,7 +868,7 @@ public:
      *
      * @param aShow - True to make the part pin names visible.
      */
-    void SetShowPinNames( bool aShow ) { m_showPinNames = aShow; }
+    void SetShowPinNames( bool aShow ) { m_showPinNames = aShow; ClearCaches(); }
 
     bool ShowPinNames() { return m_showPinNames; }
 
@@ -761,7 +877,7 @@ public:
      *
      * @param aShow - True to make the part pin numbers visible.
      */
-    void SetShowPinNumbers( bool aShow ) { m_showPinNumbers = aShow; }
+    void SetShowPinNumbers( bool aShow ) { m_showPinNumbers = aShow; ClearCaches(); }
 
     bool ShowPinNumbers() { return m_showPinNumbers; }
 
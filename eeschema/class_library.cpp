@@ -39,6 +39,8 @@
 #include <config_params.h>
 #include <wildcards_and_files_ext.h>
 #include <project_rescue.h>
+#include <pgm_base.h>
+#include <task_scheduler.h>
 
 #include <general.h>
 #include <class_library.h>
@@ -47,6 +49,11 @@
 #include <wx/tokenzr.h>
 #include <wx/regex.h>
 
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <vector>
+
 #define DUPLICATE_NAME_MSG  \
     _(  "Library '%s' has duplicate entry name '%s'.\n" \
         "This may cause some unexpected behavior when loading components into a schematic." )
@@ -55,7 +62,7 @@
 PART_LIB::PART_LIB( int aType, const wxString& aFileName ) :
     // start @ != 0 so each additional library added
     // is immediately detectable, zero would not be.
-    m_mod_hash( PART_LIBS::s_modify_generation )
+    m_mod_hash( ++PART_LIBS::s_modify_generation )
 {
     type = aType;
     isModified = false;
@@ -457,13 +464,14 @@ void PART_LIB::LoadAliases( LIB_PART* aPart )
 bool PART_LIB::LoadHeader( LINE_READER& aLineReader )
 {
     char* line, * text, * data;
+    char* saveptr;
 
     while( aLineReader.ReadLine() )
     {
         line = (char*) aLineReader;
 
-        text = strtok( line, " \t\r\n" );
-        data = strtok( NULL, " \t\r\n" );
+        text = strtok_r( line, " \t\r\n", &saveptr );
+        data = strtok_r( NULL, " \t\r\n", &saveptr );
 
         if( strcasecmp( text, "TimeStamp" ) == 0 )
             timeStamp = atol( data );
@@ -480,6 +488,7 @@ bool PART_LIB::LoadDocs( wxString& aErrorMsg )
 {
     int        lineNumber = 0;
     char       line[8000], * name, * text;
+    char*      saveptr;
     LIB_ALIAS* entry;
     FILE*      file;
     wxFileName fn = fileName;
@@ -521,7 +530,7 @@ bool PART_LIB::LoadDocs( wxString& aErrorMsg )
         }
 
         // Read one $CMP/$ENDCMP part entry from library:
-        name = strtok( line + 5, "\n\r" );
+        name = strtok_r( line + 5, "\n\r", &saveptr );
 
         wxString cmpname = FROM_UTF8( name );
 
@@ -532,7 +541,7 @@ bool PART_LIB::LoadDocs( wxString& aErrorMsg )
             if( strncmp( line, "$ENDCMP", 7 ) == 0 )
                 break;
 
-            text = strtok( line + 2, "\n\r" );
+            text = strtok_r( line + 2, "\n\r", &saveptr );
 
             if( entry )
             {
@@ -637,10 +646,16 @@ bool PART_LIB::SaveHeader( OUTPUTFORMATTER& aFormatter )
 
 PART_LIB* PART_LIB::LoadLibrary( const wxString& aFileName ) throw( IO_ERROR, boost::bad_pointer )
 {
-    std::unique_ptr<PART_LIB> lib( new PART_LIB( LIBRARY_TYPE_EESCHEMA, aFileName ) );
-
     wxBusyCursor ShowWait;  // Do we want UI elements in PART_LIB?
 
+    return loadLibrary( aFileName );
+}
+
+
+PART_LIB* PART_LIB::loadLibrary( const wxString& aFileName ) throw( IO_ERROR, boost::bad_pointer )
+{
+    std::unique_ptr<PART_LIB> lib( new PART_LIB( LIBRARY_TYPE_EESCHEMA, aFileName ) );
+
     wxString errorMsg;
 
 #ifdef KICAD_USE_SCH_IO_MANAGER
@@ -750,6 +765,13 @@ wxArrayString PART_LIBS::GetLibraryNames( bool aSorted )
 
 LIB_PART* PART_LIBS::FindLibPart( const wxString& aPartName, const wxString& aLibraryName )
 {
+    if( aLibraryName.IsEmpty() )
+    {
+        LIB_ALIAS* alias = FindLibraryAlias( aPartName );
+
+        return alias ? alias->GetPart() : NULL;
+    }
+
     LIB_PART* part = NULL;
 
     for( PART_LIB& lib : *this )
@@ -769,6 +791,12 @@ LIB_PART* PART_LIBS::FindLibPart( const wxString& aPartName, const wxString& aLi
 
 LIB_ALIAS* PART_LIBS::FindLibraryAlias( const wxString& aEntryName, const wxString& aLibraryName )
 {
+    if( !aLibraryName )
+    {
+        UpdateNameIndex();
+        return FindIndexedAlias( aEntryName );
+    }
+
     LIB_ALIAS* entry = NULL;
 
     for( PART_LIB& lib : *this )
@@ -786,6 +814,90 @@ LIB_ALIAS* PART_LIBS::FindLibraryAlias( const wxString& aEntryName, const wxStri
 }
 
 
+void PART_LIBS::UpdateNameIndex()
+{
+    bool sameLibs = m_indexedLibs.size() == size();
+
+    for( unsigned i = 0; sameLibs && i < size(); ++i )
+        sameLibs = m_indexedLibs[i].m_lib == &(*this)[i];
+
+    if( !sameLibs )
+    {
+        // The library indexes stored in the index are not valid anymore.
+        m_nameIndex.clear();
+        m_indexedLibs.clear();
+
+        for( unsigned i = 0; i < size(); ++i )
+        {
+            INDEXED_LIB indexed = { &(*this)[i], 0 };
+            m_indexedLibs.push_back( indexed );
+            indexLibrary( i );
+        }
+
+        return;
+    }
+
+    for( unsigned i = 0; i < size(); ++i )
+    {
+        if( m_indexedLibs[i].m_modHash == (*this)[i].m_mod_hash )
+            continue;
+
+        // Forget what the library held, then index it again.
+        for( auto it = m_nameIndex.begin(); it != m_nameIndex.end(); )
+        {
+            std::vector<NAME_HOLDER>& holders = it->second;
+
+            holders.erase( std::remove_if( holders.begin(), holders.end(),
+                                           [i]( const NAME_HOLDER& aHolder )
+                                           {
+                                               return aHolder.m_libIndex == i;
+                                           } ),
+                           holders.end() );
+
+            if( holders.empty() )
+                it = m_nameIndex.erase( it );
+            else
+                ++it;
+        }
+
+        indexLibrary( i );
+    }
+}
+
+
+void PART_LIBS::indexLibrary( unsigned aLibIndex )
+{
+    PART_LIB& lib = (*this)[aLibIndex];
+
+    for( LIB_ALIAS_MAP::const_iterator it = lib.m_amap.begin(); it != lib.m_amap.end(); ++it )
+    {
+        std::vector<NAME_HOLDER>& holders = m_nameIndex[it->first];
+        NAME_HOLDER holder = { aLibIndex, it->second };
+
+        // Keep the holders in library order, the first one wins.
+        auto pos = std::upper_bound( holders.begin(), holders.end(), holder,
+                                     []( const NAME_HOLDER& aA, const NAME_HOLDER& aB )
+                                     {
+                                         return aA.m_libIndex < aB.m_libIndex;
+                                     } );
+        holders.insert( pos, holder );
+    }
+
+    m_indexedLibs[aLibIndex].m_modHash = lib.m_mod_hash;
+}
+
+
+LIB_ALIAS* PART_LIBS::FindIndexedAlias( const wxString& aEntryName ) const
+{
+    NAME_INDEX::const_iterator it = m_nameIndex.find( aEntryName );
+
+    if( it == m_nameIndex.end() )
+        return NULL;
+
+    return it->second.front().m_alias;
+}
+
+
 /* searches all libraries in the list for an entry, using a case insensitive comparison.
  * Used to find an entry, when the normal (case sensitive) search fails.
   */
@@ -814,7 +926,7 @@ void PART_LIBS::FindLibraryNearEntries( std::vector<LIB_ALIAS*>& aCandidates,
 }
 
 
-int PART_LIBS::s_modify_generation = 1;     // starts at 1 and goes up
+std::atomic<int> PART_LIBS::s_modify_generation( 1 );     // starts at 1 and goes up
 
 
 int PART_LIBS::GetModifyHash()
@@ -920,6 +1032,9 @@ void PART_LIBS::LoadAllLibraries( PROJECT* aProject ) throw( IO_ERROR, boost::ba
 
     wxASSERT( !size() );    // expect to load into "this" empty container.
 
+    std::vector<wxString>   filenames;
+    std::set<wxString>      loadedNames;
+
     for( unsigned i = 0; i < lib_names.GetCount();  ++i )
     {
         wxFileName fn = lib_names[i];
@@ -952,43 +1067,91 @@ void PART_LIBS::LoadAllLibraries( PROJECT* aProject ) throw( IO_ERROR, boost::ba
             filename = fn.GetFullPath();
         }
 
-        try
+        // Don't load a library twice, the first one listed wins (see AddLibrary()).
+        if( loadedNames.insert( wxFileName( filename ).GetName() ).second )
+            filenames.push_back( filename );
+    }
+
+    // The special cache library goes last.
+    wxString cache_name = CacheName( aProject->GetProjectFullName() );
+    bool     has_cache = !!cache_name;
+
+    if( has_cache && loadedNames.count( wxFileName( cache_name ).GetName() ) == 0 )
+        filenames.push_back( cache_name );
+    else
+        has_cache = false;
+
+    // Parse the libraries concurrently, each task owning its result slot, then
+    // insert them in the configured order so the search order is preserved.
+    std::vector< std::unique_ptr<PART_LIB> >    libs( filenames.size() );
+    std::vector<wxString>                       errors( filenames.size() );
+
+    {
+        wxBusyCursor    showWait;
+        TASK_GROUP      loaders( Pgm().Scheduler() );
+
+        for( size_t i = 0; i < filenames.size(); ++i )
         {
-            AddLibrary( filename );
+            loaders.Run( [&filenames, &libs, &errors, i]()
+            {
+                try
+                {
+                    libs[i].reset( PART_LIB::loadLibrary( filenames[i] ) );
+                }
+                catch( const IO_ERROR& ioe )
+                {
+                    errors[i] = ioe.What();
+                }
+            } );
         }
-        catch( const IO_ERROR& ioe )
-        {
-            wxString msg = wxString::Format( _(
-                    "Part library '%s' failed to load. Error:\n %s" ),
-                    GetChars( filename ), GetChars( ioe.What() ) );
 
-            wxLogError( msg );
-        }
+        loaders.Wait();
     }
 
-    // add the special cache library.
-    wxString cache_name = CacheName( aProject->GetProjectFullName() );
-    PART_LIB* cache_lib;
+    size_t      lib_count = has_cache ? filenames.size() - 1 : filenames.size();
+    wxString    load_errors;
 
-    if( !!cache_name )
+    for( size_t i = 0; i < lib_count; ++i )
     {
-        try
+        if( libs[i] )
         {
-            cache_lib = AddLibrary( cache_name );
-
-            if( cache_lib )
-                cache_lib->SetCache();
+            push_back( libs[i].release() );
         }
-        catch( const IO_ERROR& ioe )
+        else
+        {
+            load_errors += wxString::Format( _( "Part library '%s' failed to load. Error:\n %s" ),
+                                             GetChars( filenames[i] ), GetChars( errors[i] ) );
+            load_errors += '\n';
+        }
+    }
+
+    // Report all the broken libraries at once.
+    if( !!load_errors )
+        wxLogError( load_errors );
+
+    if( has_cache )
+    {
+        if( !libs[lib_count] )
         {
             wxString msg = wxString::Format( _(
                     "Part library '%s' failed to load.\nError: %s" ),
                     GetChars( cache_name ),
-                    GetChars( ioe.What() )
+                    GetChars( errors[lib_count] )
                     );
 
             THROW_IO_ERROR( msg );
         }
+
+        PART_LIB* cache_lib = libs[lib_count].release();
+
+        push_back( cache_lib );
+        cache_lib->SetCache();
+    }
+    else if( !!cache_name )
+    {
+        // Already listed as a regular library.
+        if( PART_LIB* cache_lib = FindLibrary( wxFileName( cache_name ).GetName() ) )
+            cache_lib->SetCache();
     }
 
     // Print the libraries not found
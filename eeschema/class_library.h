@@ -36,8 +36,11 @@
 #include <class_libentry.h>
 
 #include <project.h>
+#include <hashtables.h>
 
+#include <atomic>
 #include <map>
+#include <unordered_map>
 
 class LINE_READER;
 class OUTPUTFORMATTER;
@@ -193,7 +196,7 @@ class PART_LIBS : public PART_LIBS_BASE, public PROJECT::_ELEM
 {
 public:
 
-    static int s_modify_generation;     ///< helper for GetModifyHash()
+    static std::atomic<int> s_modify_generation;    ///< helper for GetModifyHash()
 
     PART_LIBS()
     {
@@ -311,7 +314,50 @@ public:
     void FindLibraryNearEntries( std::vector<LIB_ALIAS*>& aCandidates, const wxString& aEntryName,
                                  const wxString& aLibraryName = wxEmptyString );
 
+    /**
+     * Function UpdateNameIndex
+     * brings the entry name index merged across the libraries up to date.  Only the
+     * libraries modified since the last update are indexed again, unless libraries
+     * have been added, removed or reordered.  FindLibPart() and FindLibraryAlias()
+     * call it themselves.
+     */
+    void UpdateNameIndex();
+
+    /**
+     * Function FindIndexedAlias
+     * searches the merged name index for  aEntryName, the first library of the
+     * list having the entry taking precedence like in FindLibraryAlias().
+     * It does not update the index, so it can be called from several threads
+     * at once after an UpdateNameIndex() call, as long as no library changes.
+     *
+     * @return The entry object if found, otherwise NULL.
+     */
+    LIB_ALIAS* FindIndexedAlias( const wxString& aEntryName ) const;
+
     int GetLibraryCount() { return size(); }
+
+private:
+    /// A library holding an entry name, the index of the library in the list.
+    struct NAME_HOLDER
+    {
+        unsigned    m_libIndex;
+        LIB_ALIAS*  m_alias;
+    };
+
+    /// State of a library when it was indexed.
+    struct INDEXED_LIB
+    {
+        const PART_LIB* m_lib;
+        int             m_modHash;
+    };
+
+    /// Entry name to the libraries holding it, in library order.
+    typedef std::unordered_map< wxString, std::vector<NAME_HOLDER>, WXSTRING_HASH > NAME_INDEX;
+
+    void indexLibrary( unsigned aLibIndex );
+
+    NAME_INDEX                  m_nameIndex;
+    std::vector<INDEXED_LIB>    m_indexedLibs;
 };
 
 
@@ -543,6 +589,14 @@ public:
      * Useful to select or list only libs containing power parts
      */
     bool HasPowerParts();
+
+private:
+    /**
+     * Function loadLibrary
+     * is LoadLibrary() without any UI feedback, so it can run on worker threads:
+     * loading libraries concurrently is safe, each one being parsed independently.
+     */
+    static PART_LIB* loadLibrary( const wxString& aFileName ) throw( IO_ERROR, boost::bad_pointer );
 };
 
 
@@ -46,6 +46,81 @@
 static wxRegEx busLabelRe( wxT( "^([^[:space:]]+)(\\[[\\d]+\\.+[\\d]+\\])$" ), wxRE_ADVANCED );
 
 
+const BUS_DEFINITION& NETLIST_OBJECT_LIST::ParseBusLabel( const wxString& aLabel )
+{
+    auto it = m_busLabels.find( aLabel );
+
+    if( it != m_busLabels.end() )
+        return it->second;
+
+    BUS_DEFINITION& bus = m_busLabels[aLabel];
+
+    bus.m_isBus = false;
+    bus.m_begin = 0;
+
+    wxCHECK_MSG( busLabelRe.IsValid(), bus,
+                 wxT( "Invalid regular expression in ParseBusLabel()." ) );
+
+    if( !busLabelRe.Matches( aLabel ) )
+        return bus;
+
+    unsigned i;
+    wxString tmp, busName, busNumber;
+    long begin, end;
+
+    busName = busLabelRe.GetMatch( aLabel, 1 );
+    busNumber = busLabelRe.GetMatch( aLabel, 2 );
+
+    /* Search for  '[' because a bus label is like "busname[nn..mm]" */
+    i = busNumber.Find( '[' );
+    i++;
+
+    while( i < busNumber.Len() && busNumber[i] != '.' )
+    {
+        tmp.Append( busNumber[i] );
+        i++;
+    }
+
+    tmp.ToLong( &begin );
+
+    while( i < busNumber.Len() && busNumber[i] == '.' )
+        i++;
+
+    tmp.Empty();
+
+    while( i < busNumber.Len() && busNumber[i] != ']' )
+    {
+        tmp.Append( busNumber[i] );
+        i++;
+    }
+
+    tmp.ToLong( &end );
+
+    if( begin < 0 )
+        begin = 0;
+
+    if( end < 0 )
+        end = 0;
+
+    if( begin > end )
+        std::swap( begin, end );
+
+    bus.m_isBus = true;
+    bus.m_begin = begin;
+    bus.m_memberLabels.reserve( end - begin + 1 );
+
+    // Conversion of bus label to the root name + the member id.
+    for( long member = begin; member <= end; member++ )
+    {
+        tmp = busName;
+        tmp << member;
+        bus.m_memberLabels.push_back( tmp );
+    }
+
+    return bus;
+}
+
+
 bool IsBusLabel( const wxString& aLabel )
 {
     wxCHECK_MSG( busLabelRe.IsValid(), false,
@@ -55,6 +130,18 @@ bool IsBusLabel( const wxString& aLabel )
 }
 
 
+void* NETLIST_OBJECT::operator new( size_t aSize, NETLIST_OBJECT_LIST& aList )
+{
+    return aList.m_arena->Allocate( aSize );
+}
+
+
+void NETLIST_OBJECT::operator delete( void* aBlock, NETLIST_OBJECT_LIST& aList )
+{
+    // The block stays in the arena until the list is cleared.
+}
+
+
 #if defined(DEBUG)
 
 #include <iostream>
@@ -241,7 +328,9 @@ bool NETLIST_OBJECT::IsLabelConnected( NETLIST_OBJECT* aNetItem )
 
 void NETLIST_OBJECT::ConvertBusToNetListItems( NETLIST_OBJECT_LIST& aNetListItems )
 {
-    wxCHECK_RET( IsBusLabel( m_Label ),
+    const BUS_DEFINITION& bus = aNetListItems.ParseBusLabel( m_Label );
+
+    wxCHECK_RET( bus.m_isBus,
                  wxT( "<" ) + m_Label + wxT( "> is not a valid bus label." ) );
 
     if( m_Type == NET_HIERLABEL )
@@ -255,62 +344,19 @@ void NETLIST_OBJECT::ConvertBusToNetListItems( NETLIST_OBJECT_LIST& aNetListItem
     else
         wxCHECK_RET( false, wxT( "Net list object type is not valid." ) );
 
-    unsigned i;
-    wxString tmp, busName, busNumber;
-    long begin, end, member;
-
-    busName = busLabelRe.GetMatch( m_Label, 1 );
-    busNumber = busLabelRe.GetMatch( m_Label, 2 );
-
-    /* Search for  '[' because a bus label is like "busname[nn..mm]" */
-    i = busNumber.Find( '[' );
-    i++;
-
-    while( i < busNumber.Len() && busNumber[i] != '.' )
-    {
-        tmp.Append( busNumber[i] );
-        i++;
-    }
-
-    tmp.ToLong( &begin );
+    const std::vector<wxString>& labels = bus.m_memberLabels;
 
-    while( i < busNumber.Len() && busNumber[i] == '.' )
-        i++;
+    m_Label = labels[0];
+    m_Member = bus.m_begin;
 
-    tmp.Empty();
+    aNetListItems.reserve( aNetListItems.size() + labels.size() - 1 );
 
-    while( i < busNumber.Len() && busNumber[i] != ']' )
+    for( unsigned ii = 1; ii < labels.size(); ii++ )
     {
-        tmp.Append( busNumber[i] );
-        i++;
-    }
-
-    tmp.ToLong( &end );
+        NETLIST_OBJECT* item = new( aNetListItems ) NETLIST_OBJECT( *this );
 
-    if( begin < 0 )
-        begin = 0;
-
-    if( end < 0 )
-        end = 0;
-
-    if( begin > end )
-        std::swap( begin, end );
-
-    member = begin;
-    tmp = busName;
-    tmp << member;
-    m_Label = tmp;
-    m_Member = member;
-
-    for( member++; member <= end; member++ )
-    {
-        NETLIST_OBJECT* item = new NETLIST_OBJECT( *this );
-
-        // Conversion of bus label to the root name + the current member id.
-        tmp = busName;
-        tmp << member;
-        item->m_Label = tmp;
-        item->m_Member = member;
+        item->m_Label = labels[ii];
+        item->m_Member = bus.m_begin + ii;
 
         aNetListItems.push_back( item );
     }
@@ -35,6 +35,12 @@
 #include <sch_sheet_path.h>
 #include <lib_pin.h>      // LIB_PIN::PinStringNum( m_PinNum )
 #include <sch_item_struct.h>
+#include <hashtables.h>
+#include <memory_pool.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 class NETLIST_OBJECT_LIST;
 class SCH_COMPONENT;
@@ -140,6 +146,18 @@ public:
 
     ~NETLIST_OBJECT();
 
+    /**
+     * Net list objects are allocated with new( aNetListItems ) NETLIST_OBJECT() in the
+     * arena of the NETLIST_OBJECT_LIST they are created for, rather than from the general
+     * heap: a net list build creates one per pin, label, wire and bus member of the
+     * hierarchy, and the list frees them all at once.  They are never deleted one by one.
+     */
+    static void* operator new( size_t aSize, NETLIST_OBJECT_LIST& aList );
+    static void operator delete( void* aBlock, NETLIST_OBJECT_LIST& aList );
+
+    static void* operator new( size_t aSize ) = delete;
+    static void operator delete( void* aBlock ) = delete;
+
     // Accessors:
     void SetNet( int aNetCode ) { m_netCode = aNetCode; }
     int GetNet() const { return m_netCode; }
@@ -277,6 +295,19 @@ public:
 typedef std::vector<NETLIST_OBJECT*>    NETLIST_OBJECTS;
 
 
+/**
+ * Struct BUS_DEFINITION
+ * is the parsed form of a label text: the member labels of a bus label, nothing for
+ * any other label.
+ */
+struct BUS_DEFINITION
+{
+    bool                    m_isBus;
+    long                    m_begin;            ///< number of the first member
+    std::vector<wxString>   m_memberLabels;     ///< "name<begin>" ... "name<end>"
+};
+
+
 /**
  * Class NETLIST_OBJECT_LIST
  * is a container holding and _owning_ NETLIST_OBJECTs, which are connected items
@@ -288,6 +319,14 @@ class NETLIST_OBJECT_LIST : public NETLIST_OBJECTS
     int m_lastBusNetCode;   // Used in intermediate calculation:
                             // last net code created for bus members
 
+    /// The memory of the items, freed by Clear().
+    std::unique_ptr<MEMORY_POOL_SET> m_arena;
+
+    /// The label texts parsed by ParseBusLabel() since the last Clear().
+    std::unordered_map<wxString, BUS_DEFINITION, WXSTRING_HASH> m_busLabels;
+
+    friend class NETLIST_OBJECT;
+
 public:
     /**
      * Constructor.
@@ -297,7 +336,8 @@ public:
      * @param aIsOwner true if the instance is the owner of item list
      * (default = false)
      */
-    NETLIST_OBJECT_LIST()
+    NETLIST_OBJECT_LIST() :
+        m_arena( new MEMORY_POOL_SET )
     {
         // Do not leave some members uninitialized:
         m_lastNetCode = 0;
@@ -360,6 +400,22 @@ public:
     /** Delete all objects in list and clear list */
     void Clear();
 
+    /**
+     * Function ParseBusLabel
+     * @return the definition of the bus \a aLabel.  The same bus labels are found in many
+     *         places of a design: a text is only parsed once until the list is cleared.
+     */
+    const BUS_DEFINITION& ParseBusLabel( const wxString& aLabel );
+
+    /**
+     * Function IsBusLabel
+     * is ::IsBusLabel() for the labels of the net list build, see ParseBusLabel().
+     */
+    bool IsBusLabel( const wxString& aLabel )
+    {
+        return ParseBusLabel( aLabel ).m_isBus;
+    }
+
     /**
      * Reset the connection type of all items to UNCONNECTED type
      */
@@ -62,6 +62,9 @@ enum SCH_LINE_TEST_T
 /// Max number of sheets in a hierarchy project
 #define NB_MAX_SHEET    500
 
+/// Default upper bound of the memory held by the undo list of a screen, in bytes
+#define DEFAULT_SCH_UNDO_BUDGET ( 64 * 1024 * 1024 )
+
 
 class SCH_SCREEN : public BASE_SCREEN, public KIWAY_HOLDER
 {
@@ -85,6 +88,9 @@ private:
     int     m_modification_sync;        ///< inequality with PART_LIBS::GetModificationHash()
                                         ///< will trigger ResolveAll().
 
+    size_t  m_undoBudget;               ///< max bytes of item copies held by the undo list,
+                                        ///< 0 for no limit.
+
     /**
      * Function addConnectedItemsToBlock
      * add items connected at \a aPosition to the block pick list.
@@ -97,6 +103,14 @@ private:
      */
     void addConnectedItemsToBlock( const wxPoint& aPosition );
 
+    /**
+     * Function breakSegment
+     * splits \a aSegment at \a aPoint, which must be on it, into two segments.
+     * @return the new segment, going from \a aPoint to the former end of \a aSegment.
+     */
+    SCH_LINE* breakSegment( SCH_LINE* aSegment, const wxPoint& aPoint,
+                            PICKED_ITEMS_LIST* aUndoList );
+
 public:
 
     /**
@@ -137,11 +151,7 @@ public:
      */
     SCH_ITEM* GetDrawItems() const                          { return m_drawList.begin(); }
 
-    void Append( SCH_ITEM* aItem )
-    {
-        m_drawList.Append( aItem );
-        --m_modification_sync;
-    }
+    void Append( SCH_ITEM* aItem );
 
     /**
      * Function Append
@@ -149,11 +159,7 @@ public:
      *
      * @param aList A reference to a #DLIST containing the #SCH_ITEM to add to the sheet.
      */
-    void Append( DLIST< SCH_ITEM >& aList )
-    {
-        m_drawList.Append( aList );
-        --m_modification_sync;
-    }
+    void Append( DLIST< SCH_ITEM >& aList );
 
     /**
      * Function GetCurItem
@@ -256,9 +262,12 @@ public:
      * performs routine schematic cleaning including breaking wire and buses and
      * deleting identical objects superimposed on top of each other.
      *
+     * @param aUndoList is an optional list receiving the undo records of the changed,
+     *                  new and deleted segments and junctions.  Deleted items are not
+     *                  freed but handed over to the list.
      * @return True if any schematic clean up was performed.
      */
-    bool SchematicCleanUp();
+    bool SchematicCleanUp( PICKED_ITEMS_LIST* aUndoList = NULL );
 
     /**
      * Function TestDanglingEnds
@@ -289,6 +298,17 @@ public:
      */
     void ReplaceWires( DLIST< SCH_ITEM >& aWireList );
 
+    /**
+     * Function PutDataInPreviousState
+     * undoes or redoes the command recorded in \a aList on the items of the screen, and
+     * leaves in \a aList the records of the reverse command.  This is the work of
+     * SCH_EDIT_FRAME::PutDataInPreviousState(), which needs no frame.
+     *
+     * @param aList a PICKED_ITEMS_LIST pointer to the list of items to undo/redo
+     * @param aRedoCommand  a bool: true for redo, false for undo
+     */
+    void PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool aRedoCommand );
+
     /**
      * Function MarkConnections
      * add all wires and junctions connected to \a aSegment which are not connected any
@@ -315,22 +335,36 @@ public:
      * checks every wire and bus for a intersection at \a aPoint and break into two segments
      * at \a aPoint if an intersection is found.
      * @param aPoint Test this point for an intersection.
+     * @param aUndoList is an optional list receiving the undo records of the broken segments.
      * @return True if any wires or buses were broken.
      */
-    bool BreakSegment( const wxPoint& aPoint );
+    bool BreakSegment( const wxPoint& aPoint, PICKED_ITEMS_LIST* aUndoList = NULL );
 
     /**
      * Function BreakSegmentsOnJunctions
      * tests all junctions and bus entries in the schematic for intersections with wires and
      * buses and breaks any intersections into multiple segments.
+     * @param aUndoList is an optional list receiving the undo records of the broken segments.
      * @return True if any wires or buses were broken.
      */
-    bool BreakSegmentsOnJunctions();
+    bool BreakSegmentsOnJunctions( PICKED_ITEMS_LIST* aUndoList = NULL );
 
     /* full undo redo management : */
-    // use BASE_SCREEN::PushCommandToUndoList( PICKED_ITEMS_LIST* aItem )
     // use BASE_SCREEN::PushCommandToRedoList( PICKED_ITEMS_LIST* aItem )
 
+    /**
+     * Function PushCommandToUndoList
+     * adds \a aItem to the undo list and, on top of the command count limit of
+     * BASE_SCREEN, drops the oldest commands while the item copies held by the list
+     * exceed the undo memory budget.  The newest command is always kept.
+     */
+    virtual void PushCommandToUndoList( PICKED_ITEMS_LIST* aItem ) override;
+
+    size_t GetUndoBudget() const                { return m_undoBudget; }
+
+    /// @param aBytes is the max size of the undo list item copies, 0 for no limit.
+    void SetUndoBudget( size_t aBytes )         { m_undoBudget = aBytes; }
+
     /**
      * Function ClearUndoORRedoList
      * free the undo or redo list from List element
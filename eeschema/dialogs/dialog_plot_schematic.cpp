@@ -39,6 +39,9 @@
 #include <sch_sheet.h>
 #include <dialog_plot_schematic.h>
 #include <wx_html_report_panel.h>
+#include <task_scheduler.h>
+
+#include <unordered_map>
 
 // Keys for configuration
 #define PLOT_FORMAT_KEY wxT( "PlotFormat" )
@@ -356,3 +359,166 @@ wxFileName DIALOG_PLOT_SCHEMATIC::createPlotFileName( wxTextCtrl* aOutputDirecto
     fn.SetPath( outputDir.GetFullPath() );
     return fn;
 }
+
+
+void DIALOG_PLOT_SCHEMATIC::buildPlotSheets( bool aPlotAll, const wxString& aExtension,
+                                             std::vector<PLOT_SHEET>& aSheets, bool aSingleFile )
+{
+    /* When printing all pages, the printed page is not the current page.  In
+     * complex hierarchies, we must update component references and others
+     * parameters in the given printed SCH_SCREEN, according to the sheet path
+     * because in complex hierarchies a SCH_SCREEN (a drawing ) is shared
+     * between many sheets and component references depend on the actual sheet
+     * path used.  The references are set again by plotSheets(), the sheet number
+     * and name are captured here.
+     */
+    SCH_SHEET_LIST  sheetList;
+    REPORTER&       reporter = m_MessagesBox->Reporter();
+
+    if( aPlotAll )
+        sheetList.BuildSheetList( g_RootSheet );
+    else
+        sheetList.push_back( m_parent->GetCurrentSheet() );
+
+    aSheets.resize( sheetList.size() );
+
+    for( unsigned i = 0; i < sheetList.size(); i++ )
+    {
+        PLOT_SHEET& sheet = aSheets[i];
+
+        m_parent->SetCurrentSheet( sheetList[i] );
+        m_parent->GetCurrentSheet().UpdateAllScreenReferences();
+        m_parent->SetSheetNumberAndCount();
+
+        sheet.m_path = sheetList[i];
+        sheet.m_screen = m_parent->GetCurrentSheet().LastScreen();
+
+        if( !sheet.m_screen ) // LastScreen() may return NULL
+            sheet.m_screen = m_parent->GetScreen();
+
+        sheet.m_sheetDesc = m_parent->GetScreenDesc();
+        sheet.m_sheetNumber = sheet.m_screen->m_ScreenNumber;
+        sheet.m_sheetCount = sheet.m_screen->m_NumberOfScreens;
+        sheet.m_success = false;
+
+        if( aSingleFile && i > 0 )
+            continue;
+
+        try
+        {
+            wxString fname = m_parent->GetUniqueFilenameForCurrentSheet();
+            wxString ext = aExtension;
+            wxFileName plotFileName = createPlotFileName( m_outputDirectoryName,
+                                                          fname, ext, &reporter );
+
+            sheet.m_fileName = plotFileName.GetFullPath();
+        }
+        catch( const IO_ERROR& e )
+        {
+            sheet.m_error = e.What();
+        }
+    }
+}
+
+
+void DIALOG_PLOT_SCHEMATIC::plotSheets( std::vector<PLOT_SHEET>& aSheets,
+                                        const std::function<void( PLOT_SHEET& )>& aPlotSheet )
+{
+    // A screen shared by several sheets holds the references of a single sheet at a
+    // time, so the sheets are plotted in passes, each screen being used at most once
+    // per pass.  Designs without reused sheets are plotted in a single pass.
+    std::unordered_map<SCH_SCREEN*, unsigned>   screenUses;
+    std::vector< std::vector<PLOT_SHEET*> >     passes;
+
+    for( PLOT_SHEET& sheet : aSheets )
+    {
+        if( !sheet.m_error.IsEmpty() )
+            continue;
+
+        unsigned pass = screenUses[sheet.m_screen]++;
+
+        if( pass >= passes.size() )
+            passes.resize( pass + 1 );
+
+        passes[pass].push_back( &sheet );
+    }
+
+    // The C locale is switched here once for all the plotters, LOCALE_IO must not
+    // switch it back while other tasks are still writing numbers.
+    LOCALE_IO toggle;
+
+    for( const std::vector<PLOT_SHEET*>& pass : passes )
+    {
+        for( PLOT_SHEET* sheet : pass )
+        {
+            sheet->m_path.UpdateAllScreenReferences();
+            sheet->m_screen->CheckComponentsToPartsLinks();
+        }
+
+        TASK_GROUP group( Pgm().Scheduler() );
+
+        for( PLOT_SHEET* sheet : pass )
+        {
+            group.Run( [sheet, &aPlotSheet]()
+                       {
+                           try
+                           {
+                               aPlotSheet( *sheet );
+                           }
+                           catch( const IO_ERROR& e )
+                           {
+                               sheet->m_error = e.What();
+                           }
+                       } );
+        }
+
+        group.Wait();
+    }
+}
+
+
+void DIALOG_PLOT_SCHEMATIC::reportPlotSheets( const std::vector<PLOT_SHEET>& aSheets,
+                                              const wxString& aFormatName )
+{
+    REPORTER& reporter = m_MessagesBox->Reporter();
+    wxString msg;
+
+    for( const PLOT_SHEET& sheet : aSheets )
+    {
+        if( !sheet.m_error.IsEmpty() )
+        {
+            msg.Printf( wxT( "%s Plotter exception: %s" ),
+                        GetChars( aFormatName ), GetChars( sheet.m_error ) );
+            reporter.Report( msg, REPORTER::RPT_ERROR );
+        }
+        else if( sheet.m_success )
+        {
+            msg.Printf( _( "Plot: '%s' OK.\n" ), GetChars( sheet.m_fileName ) );
+            reporter.Report( msg, REPORTER::RPT_ACTION );
+        }
+        else
+        {
+            msg.Printf( _( "Unable to create file '%s'.\n" ), GetChars( sheet.m_fileName ) );
+            reporter.Report( msg, REPORTER::RPT_ERROR );
+        }
+    }
+}
+
+
+void DIALOG_PLOT_SCHEMATIC::restoreCurrentSheet( SCH_SHEET_PATH& aOldsheetpath )
+{
+    m_parent->SetCurrentSheet( aOldsheetpath );
+    m_parent->GetCurrentSheet().UpdateAllScreenReferences();
+    m_parent->SetSheetNumberAndCount();
+}
+
+
+void DIALOG_PLOT_SCHEMATIC::plotWorkSheet( PLOTTER* aPlotter, const PLOT_SHEET& aSheet )
+{
+    aPlotter->SetColor( BLACK );
+    PlotWorkSheet( aPlotter, aSheet.m_screen->GetTitleBlock(),
+                   aSheet.m_screen->GetPageSettings(),
+                   aSheet.m_sheetNumber, aSheet.m_sheetCount,
+                   aSheet.m_sheetDesc,
+                   aSheet.m_screen->GetFileName() );
+}
@@ -32,9 +32,13 @@
 #include <plot_common.h>
 #include <class_sch_screen.h>
 #include <schframe.h>
+#include <sch_sheet_path.h>
 #include <dialog_plot_schematic_base.h>
 #include <reporter.h>
 
+#include <functional>
+#include <vector>
+
 
 enum PageFormatReq {
     PAGE_SIZE_AUTO,
@@ -43,6 +47,25 @@ enum PageFormatReq {
 };
 
 
+/**
+ * Struct PLOT_SHEET
+ * is a sheet of the hierarchy to plot.  The sheet number and name are captured
+ * before the sheets are plotted concurrently, since the frame only knows them for
+ * its current sheet.
+ */
+struct PLOT_SHEET
+{
+    SCH_SHEET_PATH  m_path;
+    SCH_SCREEN*     m_screen;
+    wxString        m_fileName;         ///< full name of the plot file of the sheet, if any
+    wxString        m_sheetDesc;        ///< human readable sheet path
+    int             m_sheetNumber;
+    int             m_sheetCount;
+    bool            m_success;          ///< set by the plot of the sheet
+    wxString        m_error;            ///< IO_ERROR message, the sheet is not plotted
+};
+
+
 class DIALOG_PLOT_SCHEMATIC : public DIALOG_PLOT_SCHEMATIC_BASE
 {
 private:
@@ -91,9 +114,35 @@ private:
 
     void PlotSchematic( bool aPlotAll );
 
+    /**
+     * Function buildPlotSheets
+     * walks the sheets to plot (all of them or the current one) and captures what
+     * their plot needs.  The current sheet of the frame is changed, callers restore it.
+     *
+     * @param aExtension is the extension of the plot files.
+     * @param aSingleFile is true for formats plotting all the sheets in a single file,
+     *                    named after the first sheet; only this one gets a file name.
+     */
+    void buildPlotSheets( bool aPlotAll, const wxString& aExtension,
+                          std::vector<PLOT_SHEET>& aSheets, bool aSingleFile = false );
+
+    /**
+     * Function plotSheets
+     * calls \a aPlotSheet for each sheet of \a aSheets, on the task scheduler.
+     * \a aPlotSheet must not use the frame nor the dialog controls.
+     */
+    void plotSheets( std::vector<PLOT_SHEET>& aSheets,
+                     const std::function<void( PLOT_SHEET& )>& aPlotSheet );
+
+    /// Reports the result of each sheet, once they are plotted.
+    void reportPlotSheets( const std::vector<PLOT_SHEET>& aSheets, const wxString& aFormatName );
+
+    /// Plots the frame reference of \a aSheet, can be called concurrently.
+    static void plotWorkSheet( PLOTTER* aPlotter, const PLOT_SHEET& aSheet );
+
     // PDF
     void    createPDFFile( bool aPlotAll, bool aPlotFrameRef );
-    void    plotOneSheetPDF( PLOTTER* aPlotter, SCH_SCREEN* aScreen, bool aPlotFrameRef);
+    void    plotOneSheetPDF( PLOTTER* aPlotter, const PLOT_SHEET& aSheet, bool aPlotFrameRef );
     void    setupPlotPagePDF( PLOTTER* aPlotter, SCH_SCREEN* aScreen );
 
     /**
@@ -103,6 +152,9 @@ private:
     */
     void    restoreEnvironment( PDF_PLOTTER* aPlotter, SCH_SHEET_PATH& aOldsheetpath );
 
+    /// Restores the current sheet of the frame, changed by buildPlotSheets()
+    void    restoreCurrentSheet( SCH_SHEET_PATH& aOldsheetpath );
+
     // DXF
     void    CreateDXFFile( bool aPlotAll, bool aPlotFrameRef );
     bool    PlotOneSheetDXF( const wxString& aFileName, SCH_SCREEN* aScreen,
@@ -121,18 +173,19 @@ private:
 
     void    createHPGLFile( bool aPlotAll, bool aPlotFrameRef );
     void    SetHPGLPenWidth();
-    bool    Plot_1_Page_HPGL( const wxString& aFileName, SCH_SCREEN* aScreen,
-                              const PAGE_INFO& aPageInfo,
+    bool    Plot_1_Page_HPGL( const PLOT_SHEET& aSheet, const PAGE_INFO& aPageInfo,
                               wxPoint aPlot0ffset, double aScale, bool aPlotFrameRef );
 
     // PS
     void    createPSFile( bool aPlotAll, bool aPlotFrameRef );
-    bool    plotOneSheetPS( const wxString& aFileName, SCH_SCREEN* aScreen,
-                            const PAGE_INFO& aPageInfo,
-                            wxPoint aPlot0ffset, double aScale, bool aPlotFrameRef );
+    bool    plotOneSheetPS( const PLOT_SHEET& aSheet, const PAGE_INFO& aPageInfo,
+                            wxPoint aPlot0ffset, double aScale, bool aPlotColor,
+                            bool aPlotFrameRef );
 
     // SVG
     void    createSVGFile( bool aPlotAll, bool aPlotFrameRef );
+    static bool plotOneSheetSVG( const PLOT_SHEET& aSheet, bool aPlotBlackAndWhite,
+                                 bool aPlotFrameRef );
 
     /**
      * Create a file name with an absolute path name
@@ -147,11 +200,4 @@ private:
     wxFileName createPlotFileName( wxTextCtrl* aOutputDirectoryName,
                                    wxString& aPlotFileName,
                                    wxString& aExtension, REPORTER* aReporter = NULL );
-
-public:
-    // This function is static because it is called by libedit
-    // outside a dialog. This is the reason we need aFrame as parameter
-    static bool plotOneSheetSVG( EDA_DRAW_FRAME* aFrame, const wxString& aFileName,
-                                 SCH_SCREEN* aScreen,
-                                 bool aPlotBlackAndWhite, bool aPlotFrameRef );
 };
@@ -137,6 +137,30 @@ public:
               || (GetCompareFlags() != aFindReplaceData.GetCompareFlags()) );
     }
 
+    /**
+     * Function IsRefinedBy
+     * tests if the items matching \a aFindReplaceData are a subset of the items matching
+     * this search, which is the case when a plain text search string is typed further.
+     * Wildcard and whole word searches are never refined.
+     */
+    bool IsRefinedBy( const SCH_FIND_REPLACE_DATA& aFindReplaceData ) const
+    {
+        if( GetCompareFlags() != aFindReplaceData.GetCompareFlags()
+          || ( GetFlags() & ( FR_MATCH_WILDCARD | wxFR_WHOLEWORD ) ) )
+            return false;
+
+        wxString text = GetFindString();
+        wxString refinedText = aFindReplaceData.GetFindString();
+
+        if( !( GetFlags() & wxFR_MATCHCASE ) )
+        {
+            text.MakeUpper();
+            refinedText.MakeUpper();
+        }
+
+        return refinedText.Find( text ) != wxNOT_FOUND;
+    }
+
     bool IsReplacing() const { return (GetFlags() & FR_SEARCH_REPLACE) != 0; }
     bool IsWrapping() const { return (GetFlags() & FR_SEARCH_WRAP) != 0; }
 
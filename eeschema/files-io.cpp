@@ -278,6 +278,7 @@ bool SCH_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
 
     // unload current project file before loading new
     {
+        m_foundItems.InvalidateIndex();
         delete g_RootSheet;
         g_RootSheet = NULL;
 
@@ -316,6 +317,7 @@ bool SCH_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
     else
     {
 #ifdef KICAD_USE_SCH_IO_MANAGER
+        m_foundItems.InvalidateIndex();
         delete g_RootSheet;   // Delete the current project.
         g_RootSheet = NULL;   // Force CreateScreens() to build new empty project on load failure.
 
@@ -344,6 +346,7 @@ bool SCH_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
             return false;
         }
 #else
+        m_foundItems.InvalidateIndex();
         g_RootSheet->SetScreen( NULL );
 
         DBG( printf( "%s: loading schematic %s\n", __func__, TO_UTF8( fullFileName ) );)
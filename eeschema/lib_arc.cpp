@@ -411,6 +411,46 @@ void LIB_ARC::drawEditGraphics( EDA_RECT* aClipBox, wxDC* aDC, EDA_COLOR_T aColo
 void LIB_ARC::drawGraphic( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint& aOffset,
                            EDA_COLOR_T aColor, GR_DRAWMODE aDrawMode, void* aData,
                            const TRANSFORM& aTransform )
+{
+    LIB_GEOMETRY geometry;
+
+    transformGeometry( geometry, aTransform );
+    drawGeometry( aPanel, aDC, aOffset, aColor, aDrawMode, aData, geometry );
+
+    /* Set to one (1) to draw bounding box around arc to validate bounding box
+     * calculation. */
+#if 0
+    EDA_RECT bBox = GetBoundingBox();
+    bBox.RevertYAxis();
+    bBox = aTransform.TransformCoordinate( bBox );
+    bBox.Move( aOffset );
+    GRRect( aPanel ? aPanel->GetClipBox() : NULL, aDC, bBox, 0, LIGHTMAGENTA );
+#endif
+}
+
+
+bool LIB_ARC::transformGeometry( LIB_GEOMETRY& aGeometry, const TRANSFORM& aTransform ) const
+{
+    wxPoint pos1 = aTransform.TransformCoordinate( m_ArcEnd );
+    wxPoint pos2 = aTransform.TransformCoordinate( m_ArcStart );
+
+    aGeometry.m_t1 = m_t1;
+    aGeometry.m_t2 = m_t2;
+
+    if( aTransform.MapAngles( &aGeometry.m_t1, &aGeometry.m_t2 ) )
+        std::swap( pos1, pos2 );
+
+    aGeometry.m_points.clear();
+    aGeometry.m_points.push_back( pos1 );
+    aGeometry.m_points.push_back( pos2 );
+    aGeometry.m_points.push_back( aTransform.TransformCoordinate( m_Pos ) );
+    return true;
+}
+
+
+void LIB_ARC::drawGeometry( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint& aOffset,
+                            EDA_COLOR_T aColor, GR_DRAWMODE aDrawMode, void* aData,
+                            const LIB_GEOMETRY& aGeometry )
 {
     // Don't draw the arc until the end point is selected.  Only the edit indicators
     // get drawn at this time.
@@ -430,18 +470,11 @@ void LIB_ARC::drawGraphic( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint& aOf
         color = aColor;
     }
 
-    pos1 = aTransform.TransformCoordinate( m_ArcEnd ) + aOffset;
-    pos2 = aTransform.TransformCoordinate( m_ArcStart ) + aOffset;
-    posc = aTransform.TransformCoordinate( m_Pos ) + aOffset;
-    int  pt1  = m_t1;
-    int  pt2  = m_t2;
-    bool swap = aTransform.MapAngles( &pt1, &pt2 );
-
-    if( swap )
-    {
-        std::swap( pos1.x, pos2.x );
-        std::swap( pos1.y, pos2.y );
-    }
+    pos1 = aGeometry.m_points[0] + aOffset;
+    pos2 = aGeometry.m_points[1] + aOffset;
+    posc = aGeometry.m_points[2] + aOffset;
+    int  pt1  = aGeometry.m_t1;
+    int  pt2  = aGeometry.m_t2;
 
     GRSetDrawMode( aDC, aDrawMode );
 
@@ -477,16 +510,6 @@ void LIB_ARC::drawGraphic( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint& aOf
                 posc.x, posc.y, GetPenSize(), color );
 #endif
     }
-
-    /* Set to one (1) to draw bounding box around arc to validate bounding box
-     * calculation. */
-#if 0
-    EDA_RECT bBox = GetBoundingBox();
-    bBox.RevertYAxis();
-    bBox = aTransform.TransformCoordinate( bBox );
-    bBox.Move( aOffset );
-    GRRect( clipbox, aDC, bBox, 0, LIGHTMAGENTA );
-#endif
 }
 
 
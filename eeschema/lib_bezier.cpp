@@ -28,6 +28,7 @@
 #include <fctsys.h>
 #include <gr_basic.h>
 #include <macros.h>
+#include <kicad_string.h>
 #include <class_drawpanel.h>
 #include <plot_common.h>
 #include <trigo.h>
@@ -72,6 +73,7 @@ bool LIB_BEZIER::Save( OUTPUTFORMATTER& aFormatter )
 bool LIB_BEZIER::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
 {
     char*   p;
+    char*   saveptr;
     int     i, ccount = 0;
     wxPoint pt;
     char*   line = (char*) aLineReader;
@@ -90,14 +92,14 @@ bool LIB_BEZIER::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
         return false;
     }
 
-    strtok( line + 2, " \t\n" );     // Skip field
-    strtok( NULL, " \t\n" );         // Skip field
-    strtok( NULL, " \t\n" );         // Skip field
-    strtok( NULL, " \t\n" );
+    strtok_r( line + 2, " \t\n", &saveptr );     // Skip field
+    strtok_r( NULL, " \t\n", &saveptr );         // Skip field
+    strtok_r( NULL, " \t\n", &saveptr );         // Skip field
+    strtok_r( NULL, " \t\n", &saveptr );
 
     for( i = 0; i < ccount; i++ )
     {
-        p = strtok( NULL, " \t\n" );
+        p = strtok_r( NULL, " \t\n", &saveptr );
 
         if( sscanf( p, "%d", &pt.x ) != 1 )
         {
@@ -105,7 +107,7 @@ bool LIB_BEZIER::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
             return false;
         }
 
-        p = strtok( NULL, " \t\n" );
+        p = strtok_r( NULL, " \t\n", &saveptr );
 
         if( sscanf( p, "%d", &pt.y ) != 1 )
         {
@@ -118,7 +120,7 @@ bool LIB_BEZIER::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
 
     m_Fill = NO_FILL;
 
-    if( ( p = strtok( NULL, " \t\n" ) ) != NULL )
+    if( ( p = strtok_r( NULL, " \t\n", &saveptr ) ) != NULL )
     {
         if( p[0] == 'F' )
             m_Fill = FILLED_SHAPE;
@@ -127,6 +129,12 @@ bool LIB_BEZIER::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
             m_Fill = FILLED_WITH_BG_BODYCOLOR;
     }
 
+    // The bounding box and hit tests use the polygon drawGraphic() refreshes, which
+    // schematic redraws no longer call (see LIB_PART::getGeometryCache()).
+    if( m_BezierPoints.size() == 4 )
+        m_PolyPoints = Bezier2Poly( m_BezierPoints[0], m_BezierPoints[1],
+                                    m_BezierPoints[2], m_BezierPoints[3] );
+
     return true;
 }
 
@@ -256,8 +264,7 @@ void LIB_BEZIER::Plot( PLOTTER* aPlotter, const wxPoint& aOffset, bool aFill,
 {
     wxASSERT( aPlotter != NULL );
 
-    static std::vector< wxPoint > cornerList;
-    cornerList.clear();
+    std::vector< wxPoint > cornerList;
 
     for( unsigned ii = 0; ii < m_PolyPoints.size(); ii++ )
     {
@@ -288,20 +295,52 @@ void LIB_BEZIER::drawGraphic( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint&
                               EDA_COLOR_T aColor, GR_DRAWMODE aDrawMode, void* aData,
                               const TRANSFORM& aTransform )
 {
-    std::vector<wxPoint> PolyPointsTraslated;
-
-    EDA_COLOR_T color = GetLayerColor( LAYER_DEVICE );
+    LIB_GEOMETRY geometry;
 
     m_PolyPoints = Bezier2Poly( m_BezierPoints[0],
                                 m_BezierPoints[1],
                                 m_BezierPoints[2],
                                 m_BezierPoints[3] );
 
-    PolyPointsTraslated.clear();
+    transformGeometry( geometry, aTransform );
+    drawGeometry( aPanel, aDC, aOffset, aColor, aDrawMode, aData, geometry );
+
+    /* Set to one (1) to draw bounding box around bezier curve to validate
+     * bounding box calculation. */
+#if 0
+    EDA_RECT bBox = GetBoundingBox();
+    GRRect( aPanel->GetClipBox(), aDC, bBox.GetOrigin().x, bBox.GetOrigin().y,
+            bBox.GetEnd().x, bBox.GetEnd().y, 0, LIGHTMAGENTA );
+#endif
+}
+
 
-    for( unsigned int i = 0; i < m_PolyPoints.size() ; i++ )
-        PolyPointsTraslated.push_back( aTransform.TransformCoordinate( m_PolyPoints[i] ) +
-                                       aOffset );
+bool LIB_BEZIER::transformGeometry( LIB_GEOMETRY& aGeometry, const TRANSFORM& aTransform ) const
+{
+    std::vector<wxPoint> polyPoints = Bezier2Poly( m_BezierPoints[0],
+                                                   m_BezierPoints[1],
+                                                   m_BezierPoints[2],
+                                                   m_BezierPoints[3] );
+
+    aGeometry.m_points.clear();
+
+    for( unsigned int i = 0; i < polyPoints.size() ; i++ )
+        aGeometry.m_points.push_back( aTransform.TransformCoordinate( polyPoints[i] ) );
+
+    return true;
+}
+
+
+void LIB_BEZIER::drawGeometry( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint& aOffset,
+                               EDA_COLOR_T aColor, GR_DRAWMODE aDrawMode, void* aData,
+                               const LIB_GEOMETRY& aGeometry )
+{
+    std::vector<wxPoint> PolyPointsTraslated;
+
+    EDA_COLOR_T color = GetLayerColor( LAYER_DEVICE );
+
+    for( unsigned int i = 0; i < aGeometry.m_points.size() ; i++ )
+        PolyPointsTraslated.push_back( aGeometry.m_points[i] + aOffset );
 
     if( aColor < 0 )                // Used normal color or selected color
     {
@@ -321,24 +360,16 @@ void LIB_BEZIER::drawGraphic( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint&
     GRSetDrawMode( aDC, aDrawMode );
 
     if( fill == FILLED_WITH_BG_BODYCOLOR )
-        GRPoly( aPanel->GetClipBox(), aDC, m_PolyPoints.size(),
+        GRPoly( aPanel->GetClipBox(), aDC, PolyPointsTraslated.size(),
                 &PolyPointsTraslated[0], 1, GetPenSize(),
                 (m_Flags & IS_MOVED) ? color : GetLayerColor( LAYER_DEVICE_BACKGROUND ),
                 GetLayerColor( LAYER_DEVICE_BACKGROUND ) );
     else if( fill == FILLED_SHAPE  )
-        GRPoly( aPanel->GetClipBox(), aDC, m_PolyPoints.size(),
+        GRPoly( aPanel->GetClipBox(), aDC, PolyPointsTraslated.size(),
                 &PolyPointsTraslated[0], 1, GetPenSize(), color, color );
     else
-        GRPoly( aPanel->GetClipBox(), aDC, m_PolyPoints.size(),
+        GRPoly( aPanel->GetClipBox(), aDC, PolyPointsTraslated.size(),
                 &PolyPointsTraslated[0], 0, GetPenSize(), color, color );
-
-    /* Set to one (1) to draw bounding box around bezier curve to validate
-     * bounding box calculation. */
-#if 0
-    EDA_RECT bBox = GetBoundingBox();
-    GRRect( aPanel->GetClipBox(), aDC, bBox.GetOrigin().x, bBox.GetOrigin().y,
-            bBox.GetEnd().x, bBox.GetEnd().y, 0, LIGHTMAGENTA );
-#endif
 }
 
 
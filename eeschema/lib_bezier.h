@@ -46,6 +46,12 @@ class LIB_BEZIER : public LIB_ITEM
                       EDA_COLOR_T aColor, GR_DRAWMODE aDrawMode, void* aData,
                       const TRANSFORM& aTransform ) override;
 
+    bool transformGeometry( LIB_GEOMETRY& aGeometry, const TRANSFORM& aTransform ) const override;
+
+    void drawGeometry( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint& aOffset,
+                       EDA_COLOR_T aColor, GR_DRAWMODE aDrawMode, void* aData,
+                       const LIB_GEOMETRY& aGeometry ) override;
+
 public:
     LIB_BEZIER( LIB_PART * aParent );
 
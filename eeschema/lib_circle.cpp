@@ -209,6 +209,35 @@ int LIB_CIRCLE::GetPenSize() const
 void LIB_CIRCLE::drawGraphic( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint& aOffset,
                               EDA_COLOR_T aColor, GR_DRAWMODE aDrawMode, void* aData,
                               const TRANSFORM& aTransform )
+{
+    LIB_GEOMETRY geometry;
+
+    transformGeometry( geometry, aTransform );
+    drawGeometry( aPanel, aDC, aOffset, aColor, aDrawMode, aData, geometry );
+
+    /* Set to one (1) to draw bounding box around circle to validate bounding
+     * box calculation. */
+#if 0
+    EDA_RECT bBox = GetBoundingBox();
+    bBox.RevertYAxis();
+    bBox = aTransform.TransformCoordinate( bBox );
+    bBox.Move( aOffset );
+    GRRect( aPanel ? aPanel->GetClipBox() : NULL, aDC, bBox, 0, LIGHTMAGENTA );
+#endif
+}
+
+
+bool LIB_CIRCLE::transformGeometry( LIB_GEOMETRY& aGeometry, const TRANSFORM& aTransform ) const
+{
+    aGeometry.m_points.clear();
+    aGeometry.m_points.push_back( aTransform.TransformCoordinate( m_Pos ) );
+    return true;
+}
+
+
+void LIB_CIRCLE::drawGeometry( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint& aOffset,
+                               EDA_COLOR_T aColor, GR_DRAWMODE aDrawMode, void* aData,
+                               const LIB_GEOMETRY& aGeometry )
 {
     wxPoint pos1;
 
@@ -224,7 +253,7 @@ void LIB_CIRCLE::drawGraphic( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint&
         color = aColor;
     }
 
-    pos1 = aTransform.TransformCoordinate( m_Pos ) + aOffset;
+    pos1 = aGeometry.m_points[0] + aOffset;
     GRSetDrawMode( aDC, aDrawMode );
 
     FILL_T fill = aData ? NO_FILL : m_Fill;
@@ -240,16 +269,6 @@ void LIB_CIRCLE::drawGraphic( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint&
         GRFilledCircle( clipbox, aDC, pos1.x, pos1.y, m_Radius, 0, color, color );
     else
         GRCircle( clipbox, aDC, pos1.x, pos1.y, m_Radius, GetPenSize(), color );
-
-    /* Set to one (1) to draw bounding box around circle to validate bounding
-     * box calculation. */
-#if 0
-    EDA_RECT bBox = GetBoundingBox();
-    bBox.RevertYAxis();
-    bBox = aTransform.TransformCoordinate( bBox );
-    bBox.Move( aOffset );
-    GRRect( clipbox, aDC, bBox, 0, LIGHTMAGENTA );
-#endif
 }
 
 
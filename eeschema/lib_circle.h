@@ -42,6 +42,12 @@ class LIB_CIRCLE : public LIB_ITEM
                       EDA_COLOR_T aColor, GR_DRAWMODE aDrawMode, void* aData,
                       const TRANSFORM& aTransform ) override;
 
+    bool transformGeometry( LIB_GEOMETRY& aGeometry, const TRANSFORM& aTransform ) const override;
+
+    void drawGeometry( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint& aOffset,
+                       EDA_COLOR_T aColor, GR_DRAWMODE aDrawMode, void* aData,
+                       const LIB_GEOMETRY& aGeometry ) override;
+
     void calcEdit( const wxPoint& aPosition ) override;
 
 public:
@@ -69,6 +69,19 @@ typedef boost::ptr_vector< LIB_ITEM > LIB_ITEMS;
 typedef std::vector< LIB_PIN* > LIB_PINS;
 
 
+/**
+ * The points a graphic item is drawn from, mapped by a #TRANSFORM, relative to the
+ * part anchor.  They only depend on the item and the transform, so LIB_PART keeps them
+ * for the orientations its schematic instances use instead of mapping them at each redraw.
+ */
+struct LIB_GEOMETRY
+{
+    std::vector<wxPoint>    m_points;   ///< the mapped points, in the order the item uses them
+    int                     m_t1;       ///< arcs: the mapped start angle
+    int                     m_t2;       ///< arcs: the mapped end angle
+};
+
+
 /**
  * Class LIB_ITEM
  * is the base class for drawable items used by schematic library components.
@@ -95,6 +108,32 @@ class LIB_ITEM : public EDA_ITEM
                               GR_DRAWMODE aDrawMode, void* aData,
                               const TRANSFORM& aTransform ) = 0;
 
+    /**
+     * Function transformGeometry
+     *
+     * maps the points the item is drawn from with \a aTransform, for drawGeometry().
+     *
+     * @param aGeometry The mapped points.
+     * @param aTransform A reference to a #TRANSFORM object containing drawing transform.
+     * @return false if the item is only drawn by drawGraphic(), which is the default.
+     */
+    virtual bool transformGeometry( LIB_GEOMETRY& aGeometry, const TRANSFORM& aTransform ) const
+    {
+        return false;
+    }
+
+    /**
+     * Function drawGeometry
+     *
+     * draws the item like drawGraphic() does, from the points mapped by transformGeometry().
+     *
+     * @param aGeometry The points mapped by transformGeometry(), the other parameters are
+     *                  the drawGraphic() ones.
+     */
+    virtual void drawGeometry( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint& aOffset,
+                               EDA_COLOR_T aColor, GR_DRAWMODE aDrawMode, void* aData,
+                               const LIB_GEOMETRY& aGeometry ) {}
+
     /**
      * Draw any editing specific graphics when the item is being edited.
      *
@@ -29,6 +29,7 @@
 #include <fctsys.h>
 #include <gr_basic.h>
 #include <macros.h>
+#include <kicad_string.h>
 #include <class_drawpanel.h>
 #include <plot_common.h>
 #include <trigo.h>
@@ -73,6 +74,7 @@ bool LIB_POLYLINE::Save( OUTPUTFORMATTER& aFormatter )
 bool LIB_POLYLINE::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
 {
     char*   p;
+    char*   saveptr;
     int     i, ccount = 0;
     wxPoint pt;
     char*   line = (char*) aLineReader;
@@ -93,14 +95,14 @@ bool LIB_POLYLINE::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
         return false;
     }
 
-    strtok( line + 2, " \t\n" );     // Skip field
-    strtok( NULL, " \t\n" );         // Skip field
-    strtok( NULL, " \t\n" );         // Skip field
-    strtok( NULL, " \t\n" );
+    strtok_r( line + 2, " \t\n", &saveptr );     // Skip field
+    strtok_r( NULL, " \t\n", &saveptr );         // Skip field
+    strtok_r( NULL, " \t\n", &saveptr );         // Skip field
+    strtok_r( NULL, " \t\n", &saveptr );
 
     for( i = 0; i < ccount; i++ )
     {
-        p = strtok( NULL, " \t\n" );
+        p = strtok_r( NULL, " \t\n", &saveptr );
 
         if( p == NULL || sscanf( p, "%d", &pt.x ) != 1 )
         {
@@ -108,7 +110,7 @@ bool LIB_POLYLINE::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
             return false;
         }
 
-        p = strtok( NULL, " \t\n" );
+        p = strtok_r( NULL, " \t\n", &saveptr );
 
         if( p == NULL || sscanf( p, "%d", &pt.y ) != 1 )
         {
@@ -119,7 +121,7 @@ bool LIB_POLYLINE::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
         AddPoint( pt );
     }
 
-    if( ( p = strtok( NULL, " \t\n" ) ) != NULL )
+    if( ( p = strtok_r( NULL, " \t\n", &saveptr ) ) != NULL )
     {
         if( p[0] == 'F' )
             m_Fill = FILLED_SHAPE;
@@ -227,8 +229,7 @@ void LIB_POLYLINE::Plot( PLOTTER* aPlotter, const wxPoint& aOffset, bool aFill,
 {
     wxASSERT( aPlotter != NULL );
 
-    static std::vector< wxPoint > cornerList;
-    cornerList.clear();
+    std::vector< wxPoint > cornerList;
 
     for( unsigned ii = 0; ii < m_PolyPoints.size(); ii++ )
     {
@@ -265,7 +266,39 @@ void LIB_POLYLINE::drawGraphic( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint
                                 EDA_COLOR_T aColor, GR_DRAWMODE aDrawMode, void* aData,
                                 const TRANSFORM& aTransform )
 {
-    wxPoint  pos1;
+    LIB_GEOMETRY geometry;
+
+    transformGeometry( geometry, aTransform );
+    drawGeometry( aPanel, aDC, aOffset, aColor, aDrawMode, aData, geometry );
+
+    /* Set to one (1) to draw bounding box around polyline to validate bounding
+     * box calculation. */
+#if 0
+    EDA_RECT bBox = GetBoundingBox();
+    bBox.RevertYAxis();
+    bBox = aTransform.TransformCoordinate( bBox );
+    bBox.Move( aOffset );
+    GRRect( aPanel ? aPanel->GetClipBox() : NULL, aDC, bBox, 0, LIGHTMAGENTA );
+#endif
+}
+
+
+bool LIB_POLYLINE::transformGeometry( LIB_GEOMETRY& aGeometry,
+                                      const TRANSFORM& aTransform ) const
+{
+    aGeometry.m_points.clear();
+
+    for( unsigned ii = 0; ii < m_PolyPoints.size(); ii++ )
+        aGeometry.m_points.push_back( aTransform.TransformCoordinate( m_PolyPoints[ii] ) );
+
+    return true;
+}
+
+
+void LIB_POLYLINE::drawGeometry( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint& aOffset,
+                                 EDA_COLOR_T aColor, GR_DRAWMODE aDrawMode, void* aData,
+                                 const LIB_GEOMETRY& aGeometry )
+{
     EDA_COLOR_T color = GetLayerColor( LAYER_DEVICE );
     wxPoint* buffer = NULL;
 
@@ -279,11 +312,11 @@ void LIB_POLYLINE::drawGraphic( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint
         color = aColor;
     }
 
-    buffer = new wxPoint[ m_PolyPoints.size() ];
+    buffer = new wxPoint[ aGeometry.m_points.size() ];
 
-    for( unsigned ii = 0; ii < m_PolyPoints.size(); ii++ )
+    for( unsigned ii = 0; ii < aGeometry.m_points.size(); ii++ )
     {
-        buffer[ii] = aTransform.TransformCoordinate( m_PolyPoints[ii] ) + aOffset;
+        buffer[ii] = aGeometry.m_points[ii] + aOffset;
     }
 
     FILL_T fill = aData ? NO_FILL : m_Fill;
@@ -295,27 +328,17 @@ void LIB_POLYLINE::drawGraphic( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint
 
     EDA_RECT* const clipbox  = aPanel? aPanel->GetClipBox() : NULL;
     if( fill == FILLED_WITH_BG_BODYCOLOR )
-        GRPoly( clipbox, aDC, m_PolyPoints.size(), buffer, 1, GetPenSize(),
+        GRPoly( clipbox, aDC, aGeometry.m_points.size(), buffer, 1, GetPenSize(),
                 (m_Flags & IS_MOVED) ? color : GetLayerColor( LAYER_DEVICE_BACKGROUND ),
                 GetLayerColor( LAYER_DEVICE_BACKGROUND ) );
     else if( fill == FILLED_SHAPE  )
-        GRPoly( clipbox, aDC, m_PolyPoints.size(), buffer, 1, GetPenSize(),
+        GRPoly( clipbox, aDC, aGeometry.m_points.size(), buffer, 1, GetPenSize(),
                 color, color );
     else
-        GRPoly( clipbox, aDC, m_PolyPoints.size(), buffer, 0, GetPenSize(),
+        GRPoly( clipbox, aDC, aGeometry.m_points.size(), buffer, 0, GetPenSize(),
                 color, color );
 
     delete[] buffer;
-
-    /* Set to one (1) to draw bounding box around polyline to validate
-     * bounding box calculation. */
-#if 0
-    EDA_RECT bBox = GetBoundingBox();
-    bBox.RevertYAxis();
-    bBox = aTransform.TransformCoordinate( bBox );
-    bBox.Move( aOffset );
-    GRRect( clipbox, aDC, bBox, 0, LIGHTMAGENTA );
-#endif
 }
 
 
@@ -197,6 +197,37 @@ int LIB_RECTANGLE::GetPenSize() const
 void LIB_RECTANGLE::drawGraphic( EDA_DRAW_PANEL* aPanel, wxDC* aDC,
                                  const wxPoint& aOffset, EDA_COLOR_T aColor, GR_DRAWMODE aDrawMode,
                                  void* aData, const TRANSFORM& aTransform )
+{
+    LIB_GEOMETRY geometry;
+
+    transformGeometry( geometry, aTransform );
+    drawGeometry( aPanel, aDC, aOffset, aColor, aDrawMode, aData, geometry );
+
+    /* Set to one (1) to draw bounding box around rectangle to validate
+     * bounding box calculation. */
+#if 0
+    EDA_RECT bBox = GetBoundingBox();
+    bBox.RevertYAxis();
+    bBox = aTransform.TransformCoordinate( bBox );
+    bBox.Move( aOffset );
+    GRRect( aPanel ? aPanel->GetClipBox() : NULL, aDC, bBox, 0, LIGHTMAGENTA );
+#endif
+}
+
+
+bool LIB_RECTANGLE::transformGeometry( LIB_GEOMETRY& aGeometry,
+                                       const TRANSFORM& aTransform ) const
+{
+    aGeometry.m_points.clear();
+    aGeometry.m_points.push_back( aTransform.TransformCoordinate( m_Pos ) );
+    aGeometry.m_points.push_back( aTransform.TransformCoordinate( m_End ) );
+    return true;
+}
+
+
+void LIB_RECTANGLE::drawGeometry( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint& aOffset,
+                                  EDA_COLOR_T aColor, GR_DRAWMODE aDrawMode, void* aData,
+                                  const LIB_GEOMETRY& aGeometry )
 {
     wxPoint pos1, pos2;
 
@@ -212,8 +243,8 @@ void LIB_RECTANGLE::drawGraphic( EDA_DRAW_PANEL* aPanel, wxDC* aDC,
         color = aColor;
     }
 
-    pos1 = aTransform.TransformCoordinate( m_Pos ) + aOffset;
-    pos2 = aTransform.TransformCoordinate( m_End ) + aOffset;
+    pos1 = aGeometry.m_points[0] + aOffset;
+    pos2 = aGeometry.m_points[1] + aOffset;
 
     FILL_T fill = aData ? NO_FILL : m_Fill;
 
@@ -232,16 +263,6 @@ void LIB_RECTANGLE::drawGraphic( EDA_DRAW_PANEL* aPanel, wxDC* aDC,
                       GetPenSize(), color, color );
     else
         GRRect( clipbox, aDC, pos1.x, pos1.y, pos2.x, pos2.y, GetPenSize(), color );
-
-    /* Set to one (1) to draw bounding box around rectangle to validate
-     * bounding box calculation. */
-#if 0
-    EDA_RECT bBox = GetBoundingBox();
-    bBox.RevertYAxis();
-    bBox = aTransform.TransformCoordinate( bBox );
-    bBox.Move( aOffset );
-    GRRect( clipbox, aDC, bBox, 0, LIGHTMAGENTA );
-#endif
 }
 
 
@@ -999,6 +999,16 @@ LIB_PART* LIB_EDIT_FRAME::GetCurPart()
 }
 
 
+void LIB_EDIT_FRAME::OnModify()
+{
+    GetScreen()->SetModify();
+
+    // Items are edited in place, the geometry cached by the part may be stale.
+    if( m_my_part )
+        m_my_part->ClearCaches();
+}
+
+
 void LIB_EDIT_FRAME::SetCurPart( LIB_PART* aPart )
 {
     delete m_my_part;
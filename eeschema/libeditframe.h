@@ -364,10 +364,7 @@ public:
      * Must be called after a schematic change
      * in order to set the "modify" flag of the current screen
      */
-    void OnModify()
-    {
-        GetScreen()->SetModify();
-    }
+    void OnModify();
 
     const wxString& GetAliasName()      { return m_aliasName; }
 
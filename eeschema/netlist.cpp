@@ -44,6 +44,7 @@
 #include <sch_text.h>
 #include <sch_sheet.h>
 #include <algorithm>
+#include <unordered_map>
 #include <invoke_sch_dialog.h>
 
 #define IS_WIRE false
@@ -136,10 +137,14 @@ void NETLIST_OBJECT_LIST::Clear()
     for( iter = begin(); iter != end(); iter++ )
     {
         NETLIST_OBJECT* item = *iter;
-        delete item;
+        item->~NETLIST_OBJECT();
     }
 
     clear();
+
+    // Give back the memory of all the items at once.
+    m_arena.reset( new MEMORY_POOL_SET );
+    m_busLabels.clear();
 }
 
 
@@ -636,40 +641,55 @@ void NETLIST_OBJECT_LIST::connectBusLabels()
 {
     // Propagate the net code between all bus label member objects connected by they name.
     // If the net code is not yet existing, a new one is created
-    // Search is done in the entire list
+    // Members are grouped by bus net code and member number, the groups being kept
+    // in the order of their first member in the list.
+    std::unordered_map<uint64_t, unsigned> groupIndex;
+    std::vector<NETLIST_OBJECTS> groups;
+
     for( unsigned ii = 0; ii < size(); ii++ )
     {
         NETLIST_OBJECT* Label = GetItem( ii );
 
-        if( Label->IsLabelBusMemberType() )
+        if( !Label->IsLabelBusMemberType() )
+            continue;
+
+        uint64_t key = ( (uint64_t) (uint32_t) Label->m_BusNetCode << 32 )
+                       | (uint32_t) Label->m_Member;
+
+        auto it = groupIndex.find( key );
+
+        if( it == groupIndex.end() )
         {
-            if( Label->GetNet() == 0 )
-            {
-                // Not yet existiing net code: create a new one.
-                Label->SetNet( m_lastNetCode );
-                m_lastNetCode++;
-            }
+            groupIndex[key] = groups.size();
+            groups.push_back( NETLIST_OBJECTS( 1, Label ) );
+        }
+        else
+        {
+            groups[it->second].push_back( Label );
+        }
+    }
 
-            for( unsigned jj = ii + 1; jj < size(); jj++ )
-            {
-                NETLIST_OBJECT* LabelInTst =  GetItem( jj );
+    for( const NETLIST_OBJECTS& group : groups )
+    {
+        NETLIST_OBJECT* Label = group[0];
 
-                if( LabelInTst->IsLabelBusMemberType() )
-                {
-                    if( LabelInTst->m_BusNetCode != Label->m_BusNetCode )
-                        continue;
+        if( Label->GetNet() == 0 )
+        {
+            // Not yet existiing net code: create a new one.
+            Label->SetNet( m_lastNetCode );
+            m_lastNetCode++;
+        }
 
-                    if( LabelInTst->m_Member != Label->m_Member )
-                        continue;
+        for( unsigned jj = 1; jj < group.size(); jj++ )
+        {
+            NETLIST_OBJECT* LabelInTst = group[jj];
 
-                    if( LabelInTst->GetNet() == 0 )
-                        // Append this object to the current net
-                        LabelInTst->SetNet( Label->GetNet() );
-                    else
-                        // Merge the 2 net codes, they are connected.
-                        propagateNetCode( LabelInTst->GetNet(), Label->GetNet(), IS_WIRE );
-                }
-            }
+            if( LabelInTst->GetNet() == 0 )
+                // Append this object to the current net
+                LabelInTst->SetNet( Label->GetNet() );
+            else
+                // Merge the 2 net codes, they are connected.
+                propagateNetCode( LabelInTst->GetNet(), Label->GetNet(), IS_WIRE );
         }
     }
 }
@@ -110,96 +110,51 @@ void DIALOG_PLOT_SCHEMATIC::SetHPGLPenWidth()
 
 void DIALOG_PLOT_SCHEMATIC::createHPGLFile( bool aPlotAll, bool aPlotFrameRef )
 {
-    SCH_SCREEN*     screen = m_parent->GetScreen();
     SCH_SHEET_PATH  oldsheetpath = m_parent->GetCurrentSheet();
+    std::vector<PLOT_SHEET> sheets;
+    int             paperSizeSelect = m_HPGLPaperSizeOption->GetSelection();
+    bool            originCenter = GetPlotOriginCenter();
 
-    /* When printing all pages, the printed page is not the current page.
-     *  In complex hierarchies, we must setup references and other parameters
-     *  in the printed SCH_SCREEN
-     *  because in complex hierarchies a SCH_SCREEN (a schematic drawings)
-     *  is shared between many sheets
-     */
-    SCH_SHEET_LIST  sheetList;
+    SetHPGLPenWidth();
 
-    if( aPlotAll )
-        sheetList.BuildSheetList( g_RootSheet );
-    else
-        sheetList.push_back( m_parent->GetCurrentSheet() );
+    // One file per sheet: the sheets are plotted concurrently.
+    buildPlotSheets( aPlotAll, HPGL_PLOTTER::GetDefaultFileExtension(), sheets );
 
-    REPORTER& reporter = m_MessagesBox->Reporter();
+    plotSheets( sheets,
+                [this, paperSizeSelect, originCenter, aPlotFrameRef]( PLOT_SHEET& aSheet )
+                {
+                    const PAGE_INFO&    curPage = aSheet.m_screen->GetPageSettings();
 
-    SetHPGLPenWidth();
+                    PAGE_INFO           plotPage = curPage;
 
-    for( unsigned i = 0; i < sheetList.size(); i++ )
-    {
-        m_parent->SetCurrentSheet( sheetList[i] );
-        m_parent->GetCurrentSheet().UpdateAllScreenReferences();
-        m_parent->SetSheetNumberAndCount();
-
-        screen = m_parent->GetCurrentSheet().LastScreen();
-
-        if( !screen ) // LastScreen() may return NULL
-            screen = m_parent->GetScreen();
-
-        const PAGE_INFO&    curPage = screen->GetPageSettings();
-
-        PAGE_INFO           plotPage = curPage;
-
-        // if plotting on a page size other than curPage
-        if( m_HPGLPaperSizeOption->GetSelection() != PAGE_DEFAULT )
-            plotPage.SetType( plot_sheet_list( m_HPGLPaperSizeOption->GetSelection() ) );
-
-        // Calculation of conversion scales.
-        double  plot_scale = (double) plotPage.GetWidthMils() / curPage.GetWidthMils();
-
-        // Calculate offsets
-        wxPoint plotOffset;
-        wxString msg;
-
-        if( GetPlotOriginCenter() )
-        {
-            plotOffset.x    = plotPage.GetWidthIU() / 2;
-            plotOffset.y    = -plotPage.GetHeightIU() / 2;
-        }
-
-        try
-        {
-            wxString fname = m_parent->GetUniqueFilenameForCurrentSheet();
-            wxString ext = HPGL_PLOTTER::GetDefaultFileExtension();
-            wxFileName plotFileName = createPlotFileName( m_outputDirectoryName, fname,
-                                                          ext, &reporter );
-
-            LOCALE_IO toggle;
-
-            if( Plot_1_Page_HPGL( plotFileName.GetFullPath(), screen, plotPage, plotOffset,
-                                  plot_scale, aPlotFrameRef ) )
-            {
-                msg.Printf( _( "Plot: '%s' OK.\n" ), GetChars( plotFileName.GetFullPath() ) );
-                reporter.Report( msg, REPORTER::RPT_ACTION );
-            }
-            else
-            {
-                msg.Printf( _( "Unable to create file '%s'.\n" ),
-                            GetChars( plotFileName.GetFullPath() ) );
-                reporter.Report( msg, REPORTER::RPT_ERROR );
-            }
-        }
-        catch( IO_ERROR& e )
-        {
-            msg.Printf( wxT( "HPGL Plotter exception: %s"), GetChars( e.What() ) );
-            reporter.Report( msg, REPORTER::RPT_ERROR );
-        }
+                    // if plotting on a page size other than curPage
+                    if( paperSizeSelect != PAGE_DEFAULT )
+                        plotPage.SetType( plot_sheet_list( paperSizeSelect ) );
 
-    }
+                    // Calculation of conversion scales.
+                    double  plot_scale = (double) plotPage.GetWidthMils() /
+                                         curPage.GetWidthMils();
+
+                    // Calculate offsets
+                    wxPoint plotOffset;
+
+                    if( originCenter )
+                    {
+                        plotOffset.x    = plotPage.GetWidthIU() / 2;
+                        plotOffset.y    = -plotPage.GetHeightIU() / 2;
+                    }
+
+                    aSheet.m_success = Plot_1_Page_HPGL( aSheet, plotPage, plotOffset,
+                                                         plot_scale, aPlotFrameRef );
+                } );
+
+    reportPlotSheets( sheets, wxT( "HPGL" ) );
 
-    m_parent->SetCurrentSheet( oldsheetpath );
-    m_parent->GetCurrentSheet().UpdateAllScreenReferences();
-    m_parent->SetSheetNumberAndCount();
+    restoreCurrentSheet( oldsheetpath );
 }
 
 
-bool DIALOG_PLOT_SCHEMATIC::Plot_1_Page_HPGL( const wxString&   aFileName,
-                                              SCH_SCREEN*       aScreen,
+bool DIALOG_PLOT_SCHEMATIC::Plot_1_Page_HPGL( const PLOT_SHEET& aSheet,
                                               const PAGE_INFO&  aPageInfo,
                                               wxPoint           aPlot0ffset,
                                               double            aScale,
@@ -214,7 +169,7 @@ bool DIALOG_PLOT_SCHEMATIC::Plot_1_Page_HPGL( const wxString&   aFileName,
     // Init :
     plotter->SetCreator( wxT( "Eeschema-HPGL" ) );
 
-    if( ! plotter->OpenFile( aFileName ) )
+    if( ! plotter->OpenFile( aSheet.m_fileName ) )
     {
         delete plotter;
         return false;
@@ -229,14 +184,10 @@ bool DIALOG_PLOT_SCHEMATIC::Plot_1_Page_HPGL( const wxString&   aFileName,
 
     plotter->SetColor( BLACK );
 
-    if( getPlotFrameRef() )
-        PlotWorkSheet( plotter, m_parent->GetTitleBlock(),
-                       m_parent->GetPageSettings(),
-                       aScreen->m_ScreenNumber, aScreen->m_NumberOfScreens,
-                       m_parent->GetScreenDesc(),
-                       aScreen->GetFileName() );
+    if( aPlotFrameRef )
+        plotWorkSheet( plotter, aSheet );
 
-    aScreen->Plot( plotter );
+    aSheet.m_screen->Plot( plotter );
 
     plotter->EndPlot();
     delete plotter;
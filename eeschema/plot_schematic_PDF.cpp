@@ -40,89 +40,94 @@
 
 void DIALOG_PLOT_SCHEMATIC::createPDFFile( bool aPlotAll, bool aPlotFrameRef )
 {
-    SCH_SCREEN*     screen = m_parent->GetScreen();
     SCH_SHEET_PATH  oldsheetpath = m_parent->GetCurrentSheet();     // sheetpath is saved here
+    std::vector<PLOT_SHEET> sheets;
+    bool            plotColor = getModeColor();
 
-    /* When printing all pages, the printed page is not the current page.  In
-     * complex hierarchies, we must update component references and others
-     * parameters in the given printed SCH_SCREEN, accordint to the sheet path
-     * because in complex hierarchies a SCH_SCREEN (a drawing ) is shared
-     * between many sheets and component references depend on the actual sheet
-     * path used
-     */
-    SCH_SHEET_LIST sheetList;
+    // A single document, named after the first sheet
+    buildPlotSheets( aPlotAll, PDF_PLOTTER::GetDefaultFileExtension(), sheets, true );
 
-    if( aPlotAll )
-        sheetList.BuildSheetList( g_RootSheet );
-    else
-        sheetList.push_back( m_parent->GetCurrentSheet() );
+    wxString msg;
+    wxString plotFileName = sheets[0].m_fileName;
+    REPORTER& reporter = m_MessagesBox->Reporter();
+    LOCALE_IO toggle;       // Switch the locale to standard C
+
+    if( !sheets[0].m_error.IsEmpty() )
+    {
+        // Cannot plot PDF file
+        msg.Printf( wxT( "PDF Plotter exception: %s" ), GetChars( sheets[0].m_error ) );
+        reporter.Report( msg, REPORTER::RPT_ERROR );
+
+        restoreCurrentSheet( oldsheetpath );
+        return;
+    }
 
     // Allocate the plotter and set the job level parameter
     PDF_PLOTTER* plotter = new PDF_PLOTTER();
     plotter->SetDefaultLineWidth( GetDefaultLineThickness() );
-    plotter->SetColorMode( getModeColor() );
+    plotter->SetColorMode( plotColor );
     plotter->SetCreator( wxT( "Eeschema-PDF" ) );
 
-    wxString msg;
-    wxFileName plotFileName;
-    REPORTER& reporter = m_MessagesBox->Reporter();
-    LOCALE_IO toggle;       // Switch the locale to standard C
-
-    for( unsigned i = 0; i < sheetList.size(); i++ )
+    if( !plotter->OpenFile( plotFileName ) )
     {
-        m_parent->SetCurrentSheet( sheetList[i] );
-        m_parent->GetCurrentSheet().UpdateAllScreenReferences();
-        m_parent->SetSheetNumberAndCount();
-        screen = m_parent->GetCurrentSheet().LastScreen();
+        msg.Printf( _( "Unable to create file '%s'.\n" ), GetChars( plotFileName ) );
+        reporter.Report( msg, REPORTER::RPT_ERROR );
+        delete plotter;
 
-        if( i == 0 )
-        {
+        restoreCurrentSheet( oldsheetpath );
+        return;
+    }
 
-            try
-            {
-                wxString fname = m_parent->GetUniqueFilenameForCurrentSheet();
-                wxString ext = PDF_PLOTTER::GetDefaultFileExtension();
-                plotFileName = createPlotFileName( m_outputDirectoryName,
-                                                   fname, ext, &reporter );
+    // The pages are plotted concurrently, each one into a content stream of its own,
+    // and are then added to the document in the order of the sheets.
+    std::vector<std::string> pageStreams( sheets.size() );
+    const PLOT_SHEET* firstSheet = &sheets[0];
 
-                if( !plotter->OpenFile( plotFileName.GetFullPath() ) )
+    plotSheets( sheets,
+                [&]( PLOT_SHEET& aSheet )
                 {
-                    msg.Printf( _( "Unable to create file '%s'.\n" ),
-                                GetChars( plotFileName.GetFullPath() ) );
-                    reporter.Report( msg, REPORTER::RPT_ERROR );
-                    delete plotter;
-                    return;
-                }
-
-                // Open the plotter and do the first page
-                setupPlotPagePDF( plotter, screen );
-                plotter->StartPlot();
-            }
-            catch( const IO_ERROR& e )
-            {
-                // Cannot plot PDF file
-                msg.Printf( wxT( "PDF Plotter exception: %s" ), GetChars( e.What() ) );
-                reporter.Report( msg, REPORTER::RPT_ERROR );
-
-                restoreEnvironment( plotter, oldsheetpath );
-                return;
-            }
+                    unsigned    page = (unsigned) ( &aSheet - firstSheet );
+                    PDF_PLOTTER pagePlotter;
 
-        }
-        else
+                    pagePlotter.SetDefaultLineWidth( GetDefaultLineThickness() );
+                    pagePlotter.SetColorMode( plotColor );
+                    setupPlotPagePDF( &pagePlotter, aSheet.m_screen );
+
+                    // The temporary file is removed by the page plotter, even when the
+                    // page cannot be finished.
+                    wxString workFile = plotFileName +
+                                        wxString::Format( wxT( ".%u.tmp" ), page );
+
+                    if( !pagePlotter.StartPageStream( workFile ) )
+                    {
+                        aSheet.m_error.Printf( _( "Unable to create file '%s'." ),
+                                               GetChars( workFile ) );
+                        return;
+                    }
+
+                    plotOneSheetPDF( &pagePlotter, aSheet, aPlotFrameRef );
+                    pageStreams[page] = pagePlotter.EndPageStream();
+
+                    aSheet.m_success = true;
+                } );
+
+    plotter->StartDocument();
+
+    for( unsigned i = 0; i < sheets.size(); i++ )
+    {
+        if( !sheets[i].m_error.IsEmpty() )
         {
-            /* For the following pages you need to close the (finished) page,
-             *  reconfigure, and then start a new one */
-            plotter->ClosePage();
-            setupPlotPagePDF( plotter, screen );
-            plotter->StartPage();
+            msg.Printf( wxT( "PDF Plotter exception: %s" ), GetChars( sheets[i].m_error ) );
+            reporter.Report( msg, REPORTER::RPT_ERROR );
+            continue;
         }
 
-        plotOneSheetPDF( plotter, screen, aPlotFrameRef );
+        setupPlotPagePDF( plotter, sheets[i].m_screen );
+        plotter->AddPage( pageStreams[i] );
     }
 
     // Everything done, close the plot and restore the environment
-    msg.Printf( _( "Plot: '%s' OK.\n" ), GetChars( plotFileName.GetFullPath() ) );
+    msg.Printf( _( "Plot: '%s' OK.\n" ), GetChars( plotFileName ) );
     reporter.Report( msg, REPORTER::RPT_ACTION );
 
     restoreEnvironment( plotter, oldsheetpath );
@@ -136,27 +141,18 @@ void DIALOG_PLOT_SCHEMATIC::restoreEnvironment( PDF_PLOTTER* aPlotter,
     delete aPlotter;
 
     // Restore the previous sheet
-    m_parent->SetCurrentSheet( aOldsheetpath );
-    m_parent->GetCurrentSheet().UpdateAllScreenReferences();
-    m_parent->SetSheetNumberAndCount();
+    restoreCurrentSheet( aOldsheetpath );
 }
 
 
 void DIALOG_PLOT_SCHEMATIC::plotOneSheetPDF( PLOTTER* aPlotter,
-                                             SCH_SCREEN* aScreen,
+                                             const PLOT_SHEET& aSheet,
                                              bool aPlotFrameRef )
 {
     if( aPlotFrameRef )
-    {
-        aPlotter->SetColor( BLACK );
-        PlotWorkSheet( aPlotter, m_parent->GetTitleBlock(),
-                       m_parent->GetPageSettings(),
-                       aScreen->m_ScreenNumber, aScreen->m_NumberOfScreens,
-                       m_parent->GetScreenDesc(),
-                       aScreen->GetFileName() );
-    }
+        plotWorkSheet( aPlotter, aSheet );
 
-    aScreen->Plot( aPlotter );
+    aSheet.m_screen->Plot( aPlotter );
 }
 
 
@@ -38,115 +38,76 @@
 
 void DIALOG_PLOT_SCHEMATIC::createPSFile( bool aPlotAll, bool aPlotFrameRef )
 {
-    SCH_SCREEN*     screen = m_parent->GetScreen();
     SCH_SHEET_PATH  oldsheetpath = m_parent->GetCurrentSheet();  // sheetpath is saved here
-    PAGE_INFO       actualPage;                                  // page size selected in schematic
-    PAGE_INFO       plotPage;                                    // page size selected to plot
-
-    /* When printing all pages, the printed page is not the current page.
-     * In complex hierarchies, we must update component references
-     *  and others parameters in the given printed SCH_SCREEN, accordint to the sheet path
-     *  because in complex hierarchies a SCH_SCREEN (a drawing )
-     *  is shared between many sheets and component references depend on the actual sheet path used
-     */
-    SCH_SHEET_LIST  sheetList;
-
-    if( aPlotAll )
-        sheetList.BuildSheetList( g_RootSheet );
-    else
-        sheetList.push_back( m_parent->GetCurrentSheet() );
-
-    for( unsigned i = 0; i < sheetList.size(); i++ )
-    {
-        m_parent->SetCurrentSheet( sheetList[i] );
-        m_parent->GetCurrentSheet().UpdateAllScreenReferences();
-        m_parent->SetSheetNumberAndCount();
-        screen = m_parent->GetCurrentSheet().LastScreen();
-        actualPage = screen->GetPageSettings();
-
-        switch( m_pageSizeSelect )
-        {
-        case PAGE_SIZE_A:
-            plotPage.SetType( wxT( "A" ) );
-            plotPage.SetPortrait( actualPage.IsPortrait() );
-            break;
-
-        case PAGE_SIZE_A4:
-            plotPage.SetType( wxT( "A4" ) );
-            plotPage.SetPortrait( actualPage.IsPortrait() );
-            break;
-
-        case PAGE_SIZE_AUTO:
-        default:
-            plotPage = actualPage;
-            break;
-        }
-
-        double  scalex  = (double) plotPage.GetWidthMils() / actualPage.GetWidthMils();
-        double  scaley  = (double) plotPage.GetHeightMils() / actualPage.GetHeightMils();
-
-        double  scale = std::min( scalex, scaley );
-
-        wxPoint plot_offset;
-
-        wxString outputDirName = m_outputDirectoryName->GetValue();
-
-        wxString msg;
-        REPORTER& reporter = m_MessagesBox->Reporter();
-
-        try
-        {
-            wxString fname = m_parent->GetUniqueFilenameForCurrentSheet();
-            wxString ext = PS_PLOTTER::GetDefaultFileExtension();
-            wxFileName plotFileName = createPlotFileName( m_outputDirectoryName,
-                                                          fname, ext, &reporter );
-
-            if( plotOneSheetPS( plotFileName.GetFullPath(), screen, plotPage, plot_offset,
-                                scale, aPlotFrameRef ) )
-            {
-                msg.Printf( _( "Plot: '%s' OK.\n" ), GetChars( plotFileName.GetFullPath() ) );
-                reporter.Report( msg, REPORTER::RPT_ACTION );
-            }
-            else
-            {
-                // Error
-                msg.Printf( _( "Unable to create file '%s'.\n" ),
-                            GetChars( plotFileName.GetFullPath() ) );
-                reporter.Report( msg, REPORTER::RPT_ERROR );
-            }
-
-        }
-        catch( IO_ERROR& e )
-        {
-            msg.Printf( wxT( "PS Plotter exception: %s"), GetChars( e.What() ) );
-            reporter.Report( msg, REPORTER::RPT_ERROR );
-        }
-    }
-
-    m_parent->SetCurrentSheet( oldsheetpath );
-    m_parent->GetCurrentSheet().UpdateAllScreenReferences();
-    m_parent->SetSheetNumberAndCount();
+    std::vector<PLOT_SHEET> sheets;
+    int             pageSizeSelect = m_pageSizeSelect;
+    bool            plotColor = getModeColor();
+
+    // One file per sheet: the sheets are plotted concurrently.
+    buildPlotSheets( aPlotAll, PS_PLOTTER::GetDefaultFileExtension(), sheets );
+
+    plotSheets( sheets,
+                [this, pageSizeSelect, plotColor, aPlotFrameRef]( PLOT_SHEET& aSheet )
+                {
+                    // page size selected in schematic, and page size selected to plot
+                    PAGE_INFO   actualPage = aSheet.m_screen->GetPageSettings();
+                    PAGE_INFO   plotPage;
+
+                    switch( pageSizeSelect )
+                    {
+                    case PAGE_SIZE_A:
+                        plotPage.SetType( wxT( "A" ) );
+                        plotPage.SetPortrait( actualPage.IsPortrait() );
+                        break;
+
+                    case PAGE_SIZE_A4:
+                        plotPage.SetType( wxT( "A4" ) );
+                        plotPage.SetPortrait( actualPage.IsPortrait() );
+                        break;
+
+                    case PAGE_SIZE_AUTO:
+                    default:
+                        plotPage = actualPage;
+                        break;
+                    }
+
+                    double  scalex  = (double) plotPage.GetWidthMils() /
+                                      actualPage.GetWidthMils();
+                    double  scaley  = (double) plotPage.GetHeightMils() /
+                                      actualPage.GetHeightMils();
+
+                    double  scale = std::min( scalex, scaley );
+
+                    wxPoint plot_offset;
+
+                    aSheet.m_success = plotOneSheetPS( aSheet, plotPage, plot_offset, scale,
+                                                      plotColor, aPlotFrameRef );
+                } );
+
+    reportPlotSheets( sheets, wxT( "PS" ) );
+
+    restoreCurrentSheet( oldsheetpath );
 }
 
 
-bool DIALOG_PLOT_SCHEMATIC::plotOneSheetPS( const wxString&     aFileName,
-                                            SCH_SCREEN*         aScreen,
+bool DIALOG_PLOT_SCHEMATIC::plotOneSheetPS( const PLOT_SHEET&   aSheet,
                                             const PAGE_INFO&    aPageInfo,
                                             wxPoint             aPlot0ffset,
                                             double              aScale,
+                                            bool                aPlotColor,
                                             bool                aPlotFrameRef )
 {
     PS_PLOTTER* plotter = new PS_PLOTTER();
     plotter->SetPageSettings( aPageInfo );
     plotter->SetDefaultLineWidth( GetDefaultLineThickness() );
-    plotter->SetColorMode( getModeColor() );
+    plotter->SetColorMode( aPlotColor );
     // Currently, plot units are in decimil
     plotter->SetViewport( aPlot0ffset, IU_PER_MILS/10, aScale, false );
 
     // Init :
     plotter->SetCreator( wxT( "Eeschema-PS" ) );
 
-    if( ! plotter->OpenFile( aFileName ) )
+    if( ! plotter->OpenFile( aSheet.m_fileName ) )
     {
         delete plotter;
         return false;
@@ -157,16 +118,9 @@ bool DIALOG_PLOT_SCHEMATIC::plotOneSheetPS( const wxString&     aFileName,
     plotter->StartPlot();
 
     if( aPlotFrameRef )
-    {
-        plotter->SetColor( BLACK );
-        PlotWorkSheet( plotter, m_parent->GetTitleBlock(),
-                       m_parent->GetPageSettings(),
-                       aScreen->m_ScreenNumber, aScreen->m_NumberOfScreens,
-                       m_parent->GetScreenDesc(),
-                       aScreen->GetFileName() );
-    }
+        plotWorkSheet( plotter, aSheet );
 
-    aScreen->Plot( plotter );
+    aSheet.m_screen->Plot( plotter );
 
     plotter->EndPlot();
     delete plotter;
@@ -43,72 +43,33 @@
 
 void DIALOG_PLOT_SCHEMATIC::createSVGFile( bool aPrintAll, bool aPrintFrameRef )
 {
-    wxString        msg;
-    REPORTER&       reporter = m_MessagesBox->Reporter();
     SCH_SHEET_PATH  oldsheetpath = m_parent->GetCurrentSheet();
-    SCH_SHEET_LIST  sheetList;
+    std::vector<PLOT_SHEET> sheets;
+    bool            blackAndWhite = getModeColor() ? false : true;
 
-    if( aPrintAll )
-        sheetList.BuildSheetList( g_RootSheet );
-    else
-        sheetList.push_back( m_parent->GetCurrentSheet() );
+    // One file per sheet: the sheets are plotted concurrently.
+    buildPlotSheets( aPrintAll, SVG_PLOTTER::GetDefaultFileExtension(), sheets );
 
-    for( unsigned i = 0; i < sheetList.size(); i++ )
-    {
-        SCH_SCREEN*  screen;
-        m_parent->SetCurrentSheet( sheetList[i] );
-        m_parent->GetCurrentSheet().UpdateAllScreenReferences();
-        m_parent->SetSheetNumberAndCount();
-        screen = m_parent->GetCurrentSheet().LastScreen();
-
-        try
-        {
-            wxString fname = m_parent->GetUniqueFilenameForCurrentSheet();
-            wxString ext = SVG_PLOTTER::GetDefaultFileExtension();
-            wxFileName plotFileName = createPlotFileName( m_outputDirectoryName,
-                                                          fname, ext, &reporter );
-
-            bool success = plotOneSheetSVG( m_parent, plotFileName.GetFullPath(), screen,
-                                            getModeColor() ? false : true,
-                                            aPrintFrameRef );
-
-            if( !success )
-            {
-                msg.Printf( _( "Cannot create file '%s'.\n" ),
-                            GetChars( plotFileName.GetFullPath() ) );
-                reporter.Report( msg, REPORTER::RPT_ERROR );
-            }
-            else
-            {
-                msg.Printf( _( "Plot: '%s' OK.\n" ),
-                            GetChars( plotFileName.GetFullPath() ) );
-                reporter.Report( msg, REPORTER::RPT_ACTION );
-            }
-        }
-        catch( const IO_ERROR& e )
-        {
-            // Cannot plot SVG file
-            msg.Printf( wxT( "SVG Plotter exception: %s" ), GetChars( e.What() ) );
-            reporter.Report( msg, REPORTER::RPT_ERROR );
-            break;
-        }
-    }
+    plotSheets( sheets,
+                [blackAndWhite, aPrintFrameRef]( PLOT_SHEET& aSheet )
+                {
+                    aSheet.m_success = plotOneSheetSVG( aSheet, blackAndWhite, aPrintFrameRef );
+                } );
+
+    reportPlotSheets( sheets, wxT( "SVG" ) );
 
-    m_parent->SetCurrentSheet( oldsheetpath );
-    m_parent->GetCurrentSheet().UpdateAllScreenReferences();
-    m_parent->SetSheetNumberAndCount();
+    restoreCurrentSheet( oldsheetpath );
 }
 
 
-bool DIALOG_PLOT_SCHEMATIC::plotOneSheetSVG( EDA_DRAW_FRAME*    aFrame,
-                                             const wxString&    aFileName,
-                                             SCH_SCREEN*        aScreen,
+bool DIALOG_PLOT_SCHEMATIC::plotOneSheetSVG( const PLOT_SHEET& aSheet,
                                              bool               aPlotBlackAndWhite,
                                              bool               aPlotFrameRef )
 {
+    SCH_SCREEN*  screen = aSheet.m_screen;
     SVG_PLOTTER* plotter = new SVG_PLOTTER();
 
-    const PAGE_INFO&   pageInfo = aScreen->GetPageSettings();
+    const PAGE_INFO&   pageInfo = screen->GetPageSettings();
     plotter->SetPageSettings( pageInfo );
     plotter->SetDefaultLineWidth( GetDefaultLineThickness() );
     plotter->SetColorMode( aPlotBlackAndWhite ? false : true );
@@ -120,7 +81,7 @@ bool DIALOG_PLOT_SCHEMATIC::plotOneSheetSVG( EDA_DRAW_FRAME*    aFrame,
     // Init :
     plotter->SetCreator( wxT( "Eeschema-SVG" ) );
 
-    if( ! plotter->OpenFile( aFileName ) )
+    if( ! plotter->OpenFile( aSheet.m_fileName ) )
     {
         delete plotter;
         return false;
@@ -131,16 +92,9 @@ bool DIALOG_PLOT_SCHEMATIC::plotOneSheetSVG( EDA_DRAW_FRAME*    aFrame,
     plotter->StartPlot();
 
     if( aPlotFrameRef )
-    {
-        plotter->SetColor( BLACK );
-        PlotWorkSheet( plotter, aFrame->GetTitleBlock(),
-                       aFrame->GetPageSettings(),
-                       aScreen->m_ScreenNumber, aScreen->m_NumberOfScreens,
-                       aFrame->GetScreenDesc(),
-                       aScreen->GetFileName() );
-    }
+        plotWorkSheet( plotter, aSheet );
 
-    aScreen->Plot( plotter );
+    screen->Plot( plotter );
 
     plotter->EndPlot();
     delete plotter;
@@ -27,6 +27,8 @@
  */
 
 #include <macros.h>
+#include <pgm_base.h>
+#include <task_scheduler.h>
 
 #include <sch_sheet_path.h>
 #include <transform.h>
@@ -35,6 +37,8 @@
 #include <sch_line.h>
 #include <sch_bus_entry.h>
 
+#include <algorithm>
+
 
 const KICAD_T SCH_COLLECTOR::AllItems[] = {
     SCH_MARKER_T,
@@ -476,30 +480,81 @@ bool SCH_FIND_COLLECTOR::ReplaceItem( SCH_SHEET_PATH* aSheetPath )
 
 SEARCH_RESULT SCH_FIND_COLLECTOR::Inspect( EDA_ITEM* aItem, void* aTestData )
 {
-    wxPoint position;
+    if( aItem->Type() == LIB_PIN_T )
+    {
+        wxCHECK_MSG( aTestData && ( (EDA_ITEM*) aTestData )->Type() == SCH_COMPONENT_T,
+                     SEARCH_CONTINUE, wxT( "Cannot inspect invalid data.  Bad programmer!" ) );
+    }
+    else if( aItem->Type() == SCH_FIELD_T && aTestData
+           && ( (SCH_FIELD*) aItem )->GetId() == REFERENCE )
+    {
+        // The first query of the reference of a component for a sheet path may record it,
+        // do it now rather than while the candidates are matched concurrently.
+        ( (SCH_COMPONENT*) aTestData )->GetRef( &m_indexSheets[ m_sheetIndex ] );
+    }
+
+    CANDIDATE candidate;
+
+    candidate.m_item = aItem;
+    candidate.m_parent = (SCH_ITEM*) aTestData;
+    candidate.m_sheet = m_sheetIndex;
+    m_candidates.push_back( candidate );
+
+    return SEARCH_CONTINUE;
+}
+
+
+void SCH_FIND_COLLECTOR::buildIndex( SCH_SHEET_PATH* aSheetPath )
+{
+    m_candidates.clear();
+    m_indexSheets.clear();
+    m_indexSheetNames.clear();
+    m_matches.clear();
 
-    if( aItem->Matches( m_findReplaceData, m_sheetPath, &position ) )
+    if( aSheetPath )
     {
-        if( aItem->Type() == LIB_PIN_T )
-        {
-            wxCHECK_MSG( aTestData && ( (EDA_ITEM*) aTestData )->Type() == SCH_COMPONENT_T,
-                         SEARCH_CONTINUE, wxT( "Cannot inspect invalid data.  Bad programmer!" ) );
-
-            // Pin positions are relative to their parent component's position and
-            // orientation in the schematic.  The pin's position must be converted
-            // schematic coordinates.
-            SCH_COMPONENT* component = (SCH_COMPONENT*) aTestData;
-            TRANSFORM transform = component->GetTransform();
-            position.y = -position.y;
-            position = transform.TransformCoordinate( position ) + component->GetPosition();
-        }
+        m_indexSheets.push_back( *aSheetPath );
+        m_indexScope = aSheetPath->Path();
+    }
+    else
+    {
+        SCH_SHEET_LIST schematic( g_RootSheet );
 
-        Append( aItem );
-        m_data.push_back( SCH_FIND_COLLECTOR_DATA( position, m_sheetPath->PathHumanReadable(),
-                                                   (SCH_ITEM*) aTestData ) );
+        m_indexSheets.assign( schematic.begin(), schematic.end() );
+        m_indexScope = wxEmptyString;
     }
 
-    return SEARCH_CONTINUE;
+    for( m_sheetIndex = 0;  m_sheetIndex < (int) m_indexSheets.size();  m_sheetIndex++ )
+    {
+        SCH_SHEET_PATH& sheet = m_indexSheets[ m_sheetIndex ];
+
+        m_indexSheetNames.push_back( sheet.PathHumanReadable() );
+        EDA_ITEM::IterateForward( sheet.LastDrawList(), m_inspector, NULL, m_ScanTypes );
+    }
+
+    m_indexValid = true;
+}
+
+
+bool SCH_FIND_COLLECTOR::matchCandidate( const CANDIDATE& aCandidate, wxPoint& aPosition )
+{
+    EDA_ITEM* item = aCandidate.m_item;
+
+    if( !item->Matches( m_findReplaceData, &m_indexSheets[ aCandidate.m_sheet ], &aPosition ) )
+        return false;
+
+    if( item->Type() == LIB_PIN_T )
+    {
+        // Pin positions are relative to their parent component's position and
+        // orientation in the schematic.  The pin's position must be converted
+        // schematic coordinates.
+        SCH_COMPONENT* component = (SCH_COMPONENT*) aCandidate.m_parent;
+        TRANSFORM transform = component->GetTransform();
+        aPosition.y = -aPosition.y;
+        aPosition = transform.TransformCoordinate( aPosition ) + component->GetPosition();
+    }
+
+    return true;
 }
 
 
@@ -515,26 +570,83 @@ void SCH_FIND_COLLECTOR::Collect( SCH_FIND_REPLACE_DATA& aFindReplaceData,
     if( !IsSearchRequired( aFindReplaceData ) && !m_List.empty() && !m_forceSearch )
         return;
 
+    // Below this count, handing the matching over to the scheduler costs more than it saves.
+    const int minChunkSize = 1024;
+
+    wxString scope = aSheetPath ? aSheetPath->Path() : wxString( wxEmptyString );
+    bool     reindex = m_forceSearch || !m_indexValid || scope != m_indexScope;
+
+    // When the search string is only typed further, the new matches are among the
+    // previous ones.
+    bool refine = !reindex && m_findReplaceData.IsRefinedBy( aFindReplaceData );
+
+    if( reindex )
+        buildIndex( aSheetPath );
+
     m_findReplaceData = aFindReplaceData;
     Empty();                 // empty the collection just in case
     m_data.clear();
     m_foundIndex = 0;
     SetForceSearch( false );
 
-    if( aSheetPath )
+    std::vector<int> tested;
+
+    if( refine )
     {
-        m_sheetPath = aSheetPath;
-        EDA_ITEM::IterateForward( aSheetPath->LastDrawList(), m_inspector, NULL, m_ScanTypes );
+        tested.swap( m_matches );
     }
     else
     {
-        SCH_SHEET_LIST schematic( g_RootSheet );
+        tested.resize( m_candidates.size() );
+
+        for( unsigned i = 0; i < tested.size(); i++ )
+            tested[i] = i;
+    }
 
-        for( unsigned i = 0; i < schematic.size(); i++ )
+    int count = (int) tested.size();
+    std::vector<char> found( count, 0 );
+    std::vector<wxPoint> positions( count );
+
+    auto matchRange = [&]( int aFirst, int aLast )
+    {
+        for( int i = aFirst; i < aLast; i++ )
+            found[i] = matchCandidate( m_candidates[ tested[i] ], positions[i] );
+    };
+
+    if( count < 2 * minChunkSize )
+    {
+        matchRange( 0, count );
+    }
+    else
+    {
+        TASK_SCHEDULER& scheduler = Pgm().Scheduler();
+        int chunkSize = std::max( minChunkSize, count / ( 4 * scheduler.GetConcurrency() ) + 1 );
+        TASK_GROUP matchers( scheduler );
+
+        for( int first = 0; first < count; first += chunkSize )
         {
-            m_sheetPath = &schematic[i];
-            EDA_ITEM::IterateForward( m_sheetPath->LastDrawList(), m_inspector, NULL, m_ScanTypes );
+            int last = std::min( first + chunkSize, count );
+            matchers.Run( [&matchRange, first, last]() { matchRange( first, last ); } );
         }
+
+        matchers.Wait();
+    }
+
+    m_matches.clear();
+
+    // Keep the hierarchy order of the found items, whatever the order of the matching.
+    for( int i = 0; i < count; i++ )
+    {
+        if( !found[i] )
+            continue;
+
+        const CANDIDATE& candidate = m_candidates[ tested[i] ];
+
+        Append( candidate.m_item );
+        m_data.push_back( SCH_FIND_COLLECTOR_DATA( positions[i],
+                                                   m_indexSheetNames[ candidate.m_sheet ],
+                                                   candidate.m_parent ) );
+        m_matches.push_back( tested[i] );
     }
 
 #if defined(DEBUG)
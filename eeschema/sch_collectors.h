@@ -32,6 +32,7 @@
 
 #include <class_collector.h>
 #include <sch_item_struct.h>
+#include <sch_sheet_path.h>
 #include <dialogs/dialog_schematic_find.h>
 
 
@@ -218,17 +219,46 @@ public:
  * Class SCH_FIND_COLLECTOR
  * is used to iterate over all of the items in a schematic or sheet and collect all
  * the items that match the given search criteria.
+ * <p>
+ * The searchable items of the hierarchy are gathered once in an index, which is kept
+ * until the schematic or the libraries change, so that a new search only evaluates
+ * the search criteria.  When the search string is just typed further, only the items
+ * found by the previous search are tested again.
+ * </p>
  */
 class SCH_FIND_COLLECTOR : public COLLECTOR
 {
+    /// A searchable item, with its parent and the sheet it was found in.
+    struct CANDIDATE
+    {
+        EDA_ITEM*   m_item;
+        SCH_ITEM*   m_parent;
+        int         m_sheet;        ///< index in #m_indexSheets
+    };
+
     /// Data associated with each found item.
     std::vector< SCH_FIND_COLLECTOR_DATA > m_data;
 
     /// The criteria used to test for matching items.
     SCH_FIND_REPLACE_DATA m_findReplaceData;
 
-    /// The path of the sheet currently being iterated over.
-    SCH_SHEET_PATH* m_sheetPath;
+    /// The index of the sheet currently being iterated over in #m_indexSheets.
+    int     m_sheetIndex;
+
+    /// The searchable items of the indexed sheets, in the order of the hierarchy.
+    std::vector< CANDIDATE > m_candidates;
+
+    /// The sheets of the index, and their human readable paths.
+    std::vector< SCH_SHEET_PATH > m_indexSheets;
+    std::vector< wxString > m_indexSheetNames;
+
+    /// The path of the indexed sheet, or an empty string for the whole hierarchy.
+    wxString m_indexScope;
+
+    bool    m_indexValid;
+
+    /// The #m_candidates indices of the items found by the last search.
+    std::vector< int > m_matches;
 
     /// The current found item list index.
     int     m_foundIndex;
@@ -249,6 +279,22 @@ class SCH_FIND_COLLECTOR : public COLLECTOR
     void dump();
 #endif
 
+    /**
+     * Function buildIndex
+     * gathers the searchable items of \a aSheetPath, or of the whole hierarchy when
+     * \a aSheetPath is NULL, in #m_candidates.
+     */
+    void buildIndex( SCH_SHEET_PATH* aSheetPath );
+
+    /**
+     * Function matchCandidate
+     * tests \a aCandidate against the current search criteria.  It only reads the
+     * schematic and can be called from several threads at once.
+     *
+     * @param aPosition receives the position of the matching item, in schematic coordinates.
+     */
+    bool matchCandidate( const CANDIDATE& aCandidate, wxPoint& aPosition );
+
 public:
 
     /**
@@ -259,7 +305,8 @@ public:
         SetScanTypes( aScanTypes );
         m_foundIndex = 0;
         SetForceSearch( false );
-        m_sheetPath = NULL;
+        m_sheetIndex = 0;
+        m_indexValid = false;
         m_lib_hash = 0;
     }
 
@@ -272,6 +319,22 @@ public:
 
     void SetForceSearch( bool doSearch = true ) { m_forceSearch = doSearch; }
 
+    /**
+     * Function InvalidateIndex
+     * forgets the found items and the searchable items of the index, which point into the
+     * schematic.  It must be called before the root sheet is deleted or replaced.
+     */
+    void InvalidateIndex()
+    {
+        Empty();
+        m_candidates.clear();
+        m_matches.clear();
+        m_indexSheets.clear();
+        m_indexSheetNames.clear();
+        m_indexValid = false;
+        SetForceSearch();
+    }
+
     int GetLibHash() const           { return m_lib_hash; }
     void SetLibHash( int aHash )     { m_lib_hash = aHash; }
 
@@ -51,8 +51,10 @@
 
 #include <dialogs/dialog_schematic_find.h>
 
+#include <task_scheduler.h>
 #include <wx/tokenzr.h>
 #include <iostream>
+#include <algorithm>
 
 #define NULL_STRING "_NONAME_"
 
@@ -289,14 +291,46 @@ bool SCH_COMPONENT::Resolve( PART_LIBS* aLibs )
 void SCH_COMPONENT::ResolveAll(
         const SCH_COLLECTOR& aComponents, PART_LIBS* aLibs )
 {
-    for( int i = 0;  i < aComponents.GetCount();  ++i )
+    // Below this count, handing the work over to the scheduler costs more than it saves.
+    const int minChunkSize = 512;
+
+    int count = aComponents.GetCount();
+
+    aLibs->UpdateNameIndex();
+
+    auto resolveRange = [&aComponents, aLibs]( int aFirst, int aLast )
     {
-        SCH_COMPONENT* cmp = dynamic_cast<SCH_COMPONENT*>( aComponents[i] );
-        wxASSERT( cmp );
+        for( int i = aFirst;  i < aLast;  ++i )
+        {
+            SCH_COMPONENT* cmp = dynamic_cast<SCH_COMPONENT*>( aComponents[i] );
+            wxASSERT( cmp );
+
+            if( !cmp )  // cmp == NULL should not occur.
+                continue;
 
-        if( cmp )   // cmp == NULL should not occur.
-            cmp->Resolve( aLibs );
+            // The index is up to date, and only read from now on.
+            if( LIB_ALIAS* alias = aLibs->FindIndexedAlias( cmp->m_part_name ) )
+                cmp->m_part = alias->GetPart()->SharedPtr();
+        }
+    };
+
+    if( count < 2 * minChunkSize )
+    {
+        resolveRange( 0, count );
+        return;
     }
+
+    TASK_SCHEDULER& scheduler = Pgm().Scheduler();
+    int chunkSize = std::max( minChunkSize, count / ( 4 * scheduler.GetConcurrency() ) + 1 );
+    TASK_GROUP resolvers( scheduler );
+
+    for( int first = 0;  first < count;  first += chunkSize )
+    {
+        int last = std::min( first + chunkSize, count );
+        resolvers.Run( [&resolveRange, first, last]() { resolveRange( first, last ); } );
+    }
+
+    resolvers.Wait();
 }
 
 
@@ -352,11 +386,22 @@ void SCH_COMPONENT::Draw( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint& aOff
 {
     if( PART_SPTR part = m_part.lock() )
     {
-        // Draw pin targets if part is being dragged
-        bool dragging = aPanel->GetScreen()->GetCurItem() == this && aPanel->IsMouseCaptured();
+        // Skip the body when it is outside of the area being redrawn, which is most of
+        // the sheet when zoomed in.  The extents of the part are cached.
+        EDA_RECT extents = part->GetDrawExtents( m_unit, m_convert );
+        extents.RevertYAxis();
+        extents = m_transform.TransformCoordinate( extents );
+        extents.Move( m_Pos + aOffset );
+        extents.Normalize();
 
-        part->Draw( aPanel, aDC, m_Pos + aOffset, m_unit, m_convert, aDrawMode, aColor,
-                    m_transform, aDrawPinText, false, false, dragging ? NULL : &m_isDangling );
+        if( aPanel->GetClipBox()->Intersects( extents ) )
+        {
+            // Draw pin targets if part is being dragged
+            bool dragging = aPanel->GetScreen()->GetCurItem() == this && aPanel->IsMouseCaptured();
+
+            part->Draw( aPanel, aDC, m_Pos + aOffset, m_unit, m_convert, aDrawMode, aColor,
+                        m_transform, aDrawPinText, false, false, dragging ? NULL : &m_isDangling );
+        }
     }
     else    // Use dummy() part if the actual cannot be found.
     {
@@ -708,7 +753,9 @@ void SCH_COMPONENT::GetPins( std::vector<LIB_PIN*>& aPinsList )
 {
     if( PART_SPTR part = m_part.lock() )
     {
-        part->GetPins( aPinsList, m_unit, m_convert );
+        const LIB_PINS& pins = part->GetUnitPins( m_unit, m_convert );
+
+        aPinsList.insert( aPinsList.end(), pins.begin(), pins.end() );
     }
     else
         wxFAIL_MSG( "Could not obtain PART_SPTR lock" );
@@ -1207,7 +1254,7 @@ bool SCH_COMPONENT::Load( LINE_READER& aLine, wxString& aErrorMsg )
     }
     else
     {
-        m_part_name.Empty();
+        m_part_name = wxEmptyString;
         GetField( VALUE )->Empty();
         GetField( VALUE )->SetOrientation( TEXT_ORIENT_HORIZ );
         GetField( VALUE )->SetVisible( false );
@@ -1635,17 +1682,13 @@ void SCH_COMPONENT::GetEndPoints( std::vector <DANGLING_END_ITEM>& aItemList )
 {
     if( PART_SPTR part = m_part.lock() )
     {
-        for( LIB_PIN* pin = part->GetNextPin();  pin;  pin = part->GetNextPin( pin ) )
-        {
-            wxASSERT( pin->Type() == LIB_PIN_T );
-
-            if( pin->GetUnit() && m_unit && ( m_unit != pin->GetUnit() ) )
-                continue;
-
-            if( pin->GetConvert() && m_convert && ( m_convert != pin->GetConvert() ) )
-                continue;
+        const LIB_PINS& pins = part->GetUnitPins( m_unit, m_convert );
+        const std::vector<wxPoint>& offsets = part->GetUnitPinOffsets( m_unit, m_convert );
 
-            DANGLING_END_ITEM item( PIN_END, pin, GetPinPhysicalPosition( pin ) );
+        for( size_t i = 0; i < pins.size(); i++ )
+        {
+            DANGLING_END_ITEM item( PIN_END, pins[i],
+                                    m_transform.TransformCoordinate( offsets[i] ) + m_Pos );
             aItemList.push_back( item );
         }
     }
@@ -1763,21 +1806,14 @@ void SCH_COMPONENT::GetConnectionPoints( std::vector< wxPoint >& aPoints ) const
 {
     if( PART_SPTR part = m_part.lock() )
     {
-        for( LIB_PIN* pin = part->GetNextPin(); pin; pin = part->GetNextPin( pin ) )
-        {
-            wxCHECK_RET( pin->Type() == LIB_PIN_T,
-                         wxT( "GetNextPin() did not return a pin object.  Bad programmer!" ) );
-
-            // Skip items not used for this part.
-            if( m_unit && pin->GetUnit() && ( pin->GetUnit() != m_unit ) )
-                continue;
+        // Only the pins used for this part.
+        const std::vector<wxPoint>& offsets = part->GetUnitPinOffsets( m_unit, m_convert );
 
-            if( m_convert && pin->GetConvert() && ( pin->GetConvert() != m_convert ) )
-                continue;
+        aPoints.reserve( aPoints.size() + offsets.size() );
 
-            // Calculate the pin position relative to the component position and orientation.
-            aPoints.push_back( m_transform.TransformCoordinate( pin->GetPosition() ) + m_Pos );
-        }
+        // Calculate the pin position relative to the component position and orientation.
+        for( const wxPoint& offset : offsets )
+            aPoints.push_back( m_transform.TransformCoordinate( offset ) + m_Pos );
     }
     else
     {
@@ -1856,9 +1892,7 @@ SEARCH_RESULT SCH_COMPONENT::Visit( INSPECTOR aInspector, void* aTestData,
         case LIB_PIN_T:
             if( PART_SPTR part = m_part.lock() )
             {
-                LIB_PINS pins;
-
-                part->GetPins( pins, m_unit, m_convert );
+                const LIB_PINS& pins = part->GetUnitPins( m_unit, m_convert );
 
                 for( size_t i = 0;  i < pins.size();  i++ )
                 {
@@ -1882,19 +1916,17 @@ void SCH_COMPONENT::GetNetListItem( NETLIST_OBJECT_LIST& aNetListItems,
 {
     if( PART_SPTR part = m_part.lock() )
     {
-        for( LIB_PIN* pin = part->GetNextPin();  pin;  pin = part->GetNextPin( pin ) )
-        {
-            wxASSERT( pin->Type() == LIB_PIN_T );
+        // Unit selections and body styles are never 0 for a component.
+        int unit = GetUnitSelection( aSheetPath );
+        const LIB_PINS& pins = part->GetUnitPins( unit, GetConvert() );
+        const std::vector<wxPoint>& offsets = part->GetUnitPinOffsets( unit, GetConvert() );
 
-            if( pin->GetUnit() && ( pin->GetUnit() != GetUnitSelection( aSheetPath ) ) )
-                continue;
-
-            if( pin->GetConvert() && ( pin->GetConvert() != GetConvert() ) )
-                continue;
-
-            wxPoint pos = GetTransform().TransformCoordinate( pin->GetPosition() ) + m_Pos;
+        for( size_t i = 0; i < pins.size(); i++ )
+        {
+            LIB_PIN* pin = pins[i];
+            wxPoint pos = GetTransform().TransformCoordinate( offsets[i] ) + m_Pos;
 
-            NETLIST_OBJECT* item = new NETLIST_OBJECT();
+            NETLIST_OBJECT* item = new( aNetListItems ) NETLIST_OBJECT();
             item->m_SheetPathInclude = *aSheetPath;
             item->m_Comp = (SCH_ITEM*) pin;
             item->m_SheetPath = *aSheetPath;
@@ -1910,7 +1942,7 @@ void SCH_COMPONENT::GetNetListItem( NETLIST_OBJECT_LIST& aNetListItems,
             if( pin->IsPowerConnection() )
             {
                 // There is an associated PIN_LABEL.
-                item = new NETLIST_OBJECT();
+                item = new( aNetListItems ) NETLIST_OBJECT();
                 item->m_SheetPathInclude = *aSheetPath;
                 item->m_Comp = NULL;
                 item->m_SheetPath = *aSheetPath;
@@ -38,6 +38,7 @@
 #include <general.h>
 #include <vector>
 #include <lib_draw_item.h>
+#include <string_pool.h>
 
 class SCH_SCREEN;
 class SCH_SHEET_PATH;
@@ -73,13 +74,13 @@ public:
 private:
 
     wxPoint     m_Pos;
-    wxString    m_part_name;    ///< Name to look for in the library, i.e. "74LS00".
+    INTERNED_STRING m_part_name;    ///< Name to look for in the library, i.e. "74LS00".
 
     int         m_unit;         ///< The unit for multiple part per package components.
     int         m_convert;      ///< The alternate body style for components that have more than
                                 ///< one body style defined.  Primarily used for components that
                                 ///< have a De Morgan conversion.
-    wxString    m_prefix;       ///< C, R, U, Q etc - the first character which typically indicates
+    INTERNED_STRING m_prefix;   ///< C, R, U, Q etc - the first character which typically indicates
                                 ///< what the component is. Determined, upon placement, from the
                                 ///< library component.  Created upon file load, by the first
                                 ///<  non-digits in the reference fields.
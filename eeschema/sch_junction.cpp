@@ -173,7 +173,7 @@ void SCH_JUNCTION::GetConnectionPoints( std::vector< wxPoint >& aPoints ) const
 void SCH_JUNCTION::GetNetListItem( NETLIST_OBJECT_LIST& aNetListItems,
                                    SCH_SHEET_PATH*          aSheetPath )
 {
-    NETLIST_OBJECT* item = new NETLIST_OBJECT();
+    NETLIST_OBJECT* item = new( aNetListItems ) NETLIST_OBJECT();
 
     item->m_SheetPath = *aSheetPath;
     item->m_SheetPathInclude = *aSheetPath;
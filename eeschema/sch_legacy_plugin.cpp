@@ -3339,6 +3339,7 @@ void SCH_LEGACY_PLUGIN::TransferCache( PART_LIB& aTarget )
     aTarget.fileName = m_cache->m_libFileName;
     aTarget.versionMajor = m_cache->m_versionMajor;
     aTarget.versionMinor = m_cache->m_versionMinor;
+    ++aTarget.m_mod_hash;
 
     m_cache->m_aliases.clear();
     delete m_cache;
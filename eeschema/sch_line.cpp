@@ -505,7 +505,7 @@ void SCH_LINE::GetNetListItem( NETLIST_OBJECT_LIST& aNetListItems,
     if( (GetLayer() != LAYER_BUS) && (GetLayer() != LAYER_WIRE) )
         return;
 
-    NETLIST_OBJECT* item = new NETLIST_OBJECT();
+    NETLIST_OBJECT* item = new( aNetListItems ) NETLIST_OBJECT();
     item->m_SheetPath = *aSheetPath;
     item->m_SheetPathInclude = *aSheetPath;
     item->m_Comp = (SCH_ITEM*) this;
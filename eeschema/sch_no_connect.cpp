@@ -191,7 +191,7 @@ void SCH_NO_CONNECT::GetConnectionPoints( std::vector< wxPoint >& aPoints ) cons
 void SCH_NO_CONNECT::GetNetListItem( NETLIST_OBJECT_LIST& aNetListItems,
                                      SCH_SHEET_PATH*      aSheetPath )
 {
-    NETLIST_OBJECT* item = new NETLIST_OBJECT();
+    NETLIST_OBJECT* item = new( aNetListItems ) NETLIST_OBJECT();
 
     item->m_SheetPath = *aSheetPath;
     item->m_SheetPathInclude = *aSheetPath;
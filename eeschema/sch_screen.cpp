@@ -50,9 +50,14 @@
 #include <sch_marker.h>
 #include <sch_no_connect.h>
 #include <sch_sheet.h>
+#include <sch_sheet_path.h>
 #include <sch_component.h>
 #include <sch_text.h>
 #include <lib_pin.h>
+#include <hashtables.h>
+
+#include <algorithm>
+#include <unordered_set>
 
 
 #define EESCHEMA_FILE_STAMP   "EESchema"
@@ -98,6 +103,7 @@ SCH_SCREEN::SCH_SCREEN( KIWAY* aKiway ) :
     m_paper( wxT( "A4" ) )
 {
     m_modification_sync = 0;
+    m_undoBudget = DEFAULT_SCH_UNDO_BUDGET;
 
     SetZoom( 32 );
 
@@ -149,14 +155,46 @@ void SCH_SCREEN::Clear()
 }
 
 
+void SCH_SCREEN::Append( SCH_ITEM* aItem )
+{
+    if( aItem->Type() == SCH_SHEET_T )
+        SCH_SHEET_LIST::InvalidateHierarchy();
+
+    m_drawList.Append( aItem );
+    --m_modification_sync;
+}
+
+
+void SCH_SCREEN::Append( DLIST< SCH_ITEM >& aList )
+{
+    for( SCH_ITEM* item = aList.begin(); item; item = item->Next() )
+    {
+        if( item->Type() == SCH_SHEET_T )
+        {
+            SCH_SHEET_LIST::InvalidateHierarchy();
+            break;
+        }
+    }
+
+    m_drawList.Append( aList );
+    --m_modification_sync;
+}
+
+
 void SCH_SCREEN::FreeDrawList()
 {
+    if( m_drawList.GetCount() )
+        SCH_SHEET_LIST::InvalidateHierarchy();
+
     m_drawList.DeleteAll();
 }
 
 
 void SCH_SCREEN::Remove( SCH_ITEM* aItem )
 {
+    if( aItem->Type() == SCH_SHEET_T )
+        SCH_SHEET_LIST::InvalidateHierarchy();
+
     m_drawList.Remove( aItem );
 }
 
@@ -179,6 +217,9 @@ void SCH_SCREEN::DeleteItem( SCH_ITEM* aItem )
     }
     else
     {
+        if( aItem->Type() == SCH_SHEET_T )
+            SCH_SHEET_LIST::InvalidateHierarchy();
+
         delete m_drawList.Remove( aItem );
     }
 }
@@ -292,6 +333,113 @@ void SCH_SCREEN::ReplaceWires( DLIST< SCH_ITEM >& aWireList )
 }
 
 
+void SCH_SCREEN::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool aRedoCommand )
+{
+    SCH_ITEM* item;
+    SCH_ITEM* alt_item;
+
+    // Exchange the current wires, buses, and junctions with the copy save by the last edit.
+    if( aList->m_Status == UR_WIRE_IMAGE )
+    {
+        DLIST< SCH_ITEM > oldWires;
+
+        // Prevent items from being deleted when the DLIST goes out of scope.
+        oldWires.SetOwnership( false );
+
+        // Remove all of the wires, buses, and junctions from the current screen.
+        ExtractWires( oldWires, false );
+
+        // Copy the saved wires, buses, and junctions to the current screen.
+        for( unsigned int i = 0;  i < aList->GetCount();  i++ )
+            Append( (SCH_ITEM*) aList->GetPickedItem( i ) );
+
+        aList->ClearItemsList();
+
+        // Copy the previous wires, buses, and junctions to the picked item list for the
+        // redo operation.
+        while( oldWires.GetCount() != 0 )
+        {
+            ITEM_PICKER picker = ITEM_PICKER( oldWires.PopFront(), UR_WIRE_IMAGE );
+            aList->PushItem( picker );
+        }
+
+        return;
+    }
+
+    // Undo in the reverse order of list creation: (this can allow stacked changes like the
+    // same item can be changes and deleted in the same complex command.
+    for( int ii = aList->GetCount() - 1; ii >= 0; ii--  )
+    {
+        item = (SCH_ITEM*) aList->GetPickedItem( ii );
+        wxASSERT( item );
+
+        item->ClearFlags();
+
+        SCH_ITEM* image = (SCH_ITEM*) aList->GetPickedItemLink( ii );
+
+        switch( aList->GetPickedItemStatus( ii ) )
+        {
+        case UR_CHANGED: /* Exchange old and new data for each item */
+            item->SwapData( image );
+            break;
+
+        case UR_NEW:     /* new items are deleted */
+            aList->SetPickedItemStatus( UR_DELETED, ii );
+            Remove( item );
+            break;
+
+        case UR_DELETED: /* deleted items are put in the draw item list, as new items */
+            aList->SetPickedItemStatus( UR_NEW, ii );
+            Append( item );
+            break;
+
+        case UR_MOVED:
+            item->ClearFlags();
+            item->SetFlags( aList->GetPickerFlags( ii ) );
+            item->Move( aRedoCommand ? aList->m_TransformPoint : -aList->m_TransformPoint );
+            item->ClearFlags();
+            break;
+
+        case UR_MIRRORED_Y:
+            item->MirrorY( aList->m_TransformPoint.x );
+            break;
+
+        case UR_MIRRORED_X:
+            item->MirrorX( aList->m_TransformPoint.y );
+            break;
+
+        case UR_ROTATED:
+            // To undo a rotate 90 deg transform we must rotate 270 deg to undo
+            // and 90 deg to redo:
+            item->Rotate( aList->m_TransformPoint );
+
+            if( aRedoCommand )
+                break;  // A only one rotate transform is OK
+
+            // Make 3 rotate 90 deg transforms is this is actually an undo command
+            item->Rotate( aList->m_TransformPoint );
+            item->Rotate( aList->m_TransformPoint );
+            break;
+
+        case UR_EXCHANGE_T:
+            alt_item = (SCH_ITEM*) aList->GetPickedItemLink( ii );
+            alt_item->SetNext( NULL );
+            alt_item->SetBack( NULL );
+            Remove( item );
+            Append( alt_item );
+            aList->SetPickedItem( alt_item, ii );
+            aList->SetPickedItemLink( item, ii );
+            break;
+
+        default:
+            wxFAIL_MSG( wxString::Format( wxT( "Unknown undo/redo command %d" ),
+                                          aList->GetPickedItemStatus( ii ) ) );
+            break;
+        }
+    }
+}
+
+
 void SCH_SCREEN::MarkConnections( SCH_LINE* aSegment )
 {
     wxCHECK_RET( (aSegment) && (aSegment->Type() == SCH_LINE_T),
@@ -423,52 +571,216 @@ bool SCH_SCREEN::IsTerminalPoint( const wxPoint& aPosition, int aLayer )
 }
 
 
-bool SCH_SCREEN::SchematicCleanUp()
+/**
+ * Function saveWireChange
+ * adds the undo record of a change of \a aItem to \a aUndoList, unless the list already
+ * holds a record of it: the first one describes the state before the whole command.
+ *
+ * @param aImage is the copy of the item before the change, or NULL to copy \a aItem now.
+ *               It is deleted if it is not needed.
+ */
+static void saveWireChange( PICKED_ITEMS_LIST* aUndoList, SCH_ITEM* aItem, SCH_ITEM* aImage )
+{
+    if( aUndoList->FindItem( aItem ) >= 0 )
+    {
+        delete aImage;
+        return;
+    }
+
+    ITEM_PICKER picker( aItem, UR_CHANGED );
+
+    picker.SetLink( aImage ? aImage : (SCH_ITEM*) aItem->Clone() );
+    aUndoList->PushItem( picker );
+}
+
+
+/**
+ * Function cellOf
+ * @return the cell of a grid of \a aCellSize pitch containing \a aPoint.
+ */
+static wxPoint cellOf( const wxPoint& aPoint, int aCellSize )
+{
+    // Round towards minus infinity, negative coordinates are legal.
+    int x = aPoint.x >= 0 ? aPoint.x / aCellSize : ( aPoint.x + 1 ) / aCellSize - 1;
+    int y = aPoint.y >= 0 ? aPoint.y / aCellSize : ( aPoint.y + 1 ) / aCellSize - 1;
+
+    return wxPoint( x, y );
+}
+
+
+/// Removes \a aLine from the buckets of the end points \a aStart and \a aEnd.
+static void removeLineEnds( std::unordered_map< wxPoint, std::vector<SCH_LINE*>, WXPOINT_HASH >& aEnds,
+                            SCH_LINE* aLine, const wxPoint& aStart, const wxPoint& aEnd )
+{
+    for( const wxPoint& point : { aStart, aEnd } )
+    {
+        std::vector<SCH_LINE*>& bucket = aEnds[point];
+
+        bucket.erase( std::remove( bucket.begin(), bucket.end(), aLine ), bucket.end() );
+    }
+}
+
+
+/// Adds \a aLine to the buckets of its end points.
+static void addLineEnds( std::unordered_map< wxPoint, std::vector<SCH_LINE*>, WXPOINT_HASH >& aEnds,
+                         SCH_LINE* aLine )
+{
+    aEnds[aLine->GetStartPoint()].push_back( aLine );
+
+    if( aLine->GetEndPoint() != aLine->GetStartPoint() )
+        aEnds[aLine->GetEndPoint()].push_back( aLine );
+}
+
+
+bool SCH_SCREEN::SchematicCleanUp( PICKED_ITEMS_LIST* aUndoList )
 {
-    bool      modified = false;
+    // Segments can only be merged when they have a common end point, and junctions are
+    // only duplicates when they are closer than their size: both passes look up their
+    // candidates in an index rather than testing every pair of items of the screen.
+    std::unordered_map< wxPoint, std::vector<SCH_LINE*>, WXPOINT_HASH > lineEnds;
+    std::unordered_map< wxPoint, std::vector<SCH_JUNCTION*>, WXPOINT_HASH > junctionCells;
+    std::vector<SCH_LINE*>          lines;
+    std::vector<SCH_JUNCTION*>      junctions;
+    std::vector<SCH_ITEM*>          removedItems;
+    std::unordered_set<SCH_ITEM*>   removed;
+    int                             cellSize = 1;
+
+    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    {
+        if( item->Type() == SCH_LINE_T )
+        {
+            lines.push_back( (SCH_LINE*) item );
+            addLineEnds( lineEnds, (SCH_LINE*) item );
+        }
+        else if( item->Type() == SCH_JUNCTION_T )
+        {
+            EDA_RECT box = item->GetBoundingBox();
+
+            junctions.push_back( (SCH_JUNCTION*) item );
+            cellSize = std::max( cellSize, std::max( box.GetWidth(), box.GetHeight() ) );
+        }
+    }
+
+    // Removed items are only unlinked during the passes, so that no pointer of the
+    // index dangles; they are deleted or handed over to the undo list at the end.
+    auto removeItem = [&]( SCH_ITEM* aItem )
+    {
+        Remove( aItem );
+        removed.insert( aItem );
+        removedItems.push_back( aItem );
+    };
 
-    for( SCH_ITEM* item = m_drawList.begin() ; item; item = item->Next() )
+    for( SCH_LINE* line : lines )
     {
-        if( ( item->Type() != SCH_LINE_T ) && ( item->Type() != SCH_JUNCTION_T ) )
+        if( removed.count( line ) )
             continue;
 
-        bool restart;
+        bool merged;
 
-        for( SCH_ITEM* testItem = item->Next(); testItem; testItem = restart ? m_drawList.begin() : testItem->Next() )
+        do
         {
-            restart = false;
+            merged = false;
+
+            wxPoint start = line->GetStartPoint();
+            wxPoint end = line->GetEndPoint();
 
-            if( ( item->Type() == SCH_LINE_T ) && ( testItem->Type() == SCH_LINE_T ) )
+            for( const wxPoint& point : { start, end } )
             {
-                SCH_LINE* line = (SCH_LINE*) item;
+                auto bucket = lineEnds.find( point );
 
-                if( line->MergeOverlap( (SCH_LINE*) testItem ) )
+                if( bucket == lineEnds.end() )
+                    continue;
+
+                for( SCH_LINE* candidate : bucket->second )
                 {
+                    if( candidate == line || !line->MergeOverlap( candidate ) )
+                        continue;
+
+                    if( aUndoList )
+                    {
+                        // Only copy the segment once it is known to be modified.
+                        SCH_LINE* image = (SCH_LINE*) line->Clone();
+                        image->SetStartPoint( start );
+                        image->SetEndPoint( end );
+                        saveWireChange( aUndoList, line, image );
+                    }
+
                     // Keep the current flags, because the deleted segment can be flagged.
-                    item->SetFlags( testItem->GetFlags() );
-                    DeleteItem( testItem );
-                    restart = true;
-                    modified = true;
+                    line->SetFlags( candidate->GetFlags() );
+
+                    removeLineEnds( lineEnds, candidate, candidate->GetStartPoint(),
+                                    candidate->GetEndPoint() );
+                    removeLineEnds( lineEnds, line, start, end );
+                    addLineEnds( lineEnds, line );
+                    removeItem( candidate );
+                    merged = true;
+                    break;
                 }
+
+                if( merged )
+                    break;
             }
-            else if ( ( ( item->Type() == SCH_JUNCTION_T )
-                      && ( testItem->Type() == SCH_JUNCTION_T ) ) && ( testItem != item ) )
+        } while( merged );
+    }
+
+    // A junction is hit within half its size of its position, so the duplicates of a
+    // junction are in its cell of the grid or in the adjacent ones.
+    for( SCH_JUNCTION* junction : junctions )
+        junctionCells[ cellOf( junction->GetPosition(), cellSize ) ].push_back( junction );
+
+    for( SCH_JUNCTION* junction : junctions )
+    {
+        if( removed.count( junction ) )
+            continue;
+
+        wxPoint cell = cellOf( junction->GetPosition(), cellSize );
+
+        for( int dx = -1; dx <= 1; dx++ )
+        {
+            for( int dy = -1; dy <= 1; dy++ )
             {
-                if ( testItem->HitTest( item->GetPosition() ) )
+                auto bucket = junctionCells.find( cell + wxPoint( dx, dy ) );
+
+                if( bucket == junctionCells.end() )
+                    continue;
+
+                for( SCH_JUNCTION* candidate : bucket->second )
                 {
-                    // Keep the current flags, because the deleted segment can be flagged.
-                    item->SetFlags( testItem->GetFlags() );
-                    DeleteItem( testItem );
-                    restart = true;
-                    modified = true;
+                    if( candidate == junction || removed.count( candidate )
+                      || !candidate->HitTest( junction->GetPosition() ) )
+                        continue;
+
+                    // Keep the current flags, because the deleted junction can be flagged.
+                    junction->SetFlags( candidate->GetFlags() );
+                    removeItem( candidate );
                 }
             }
         }
     }
 
+    for( SCH_ITEM* item : removedItems )
+    {
+        int index = aUndoList ? aUndoList->FindItem( item ) : -1;
+
+        // An item added by the same command is simply forgotten: an UR_NEW and an
+        // UR_DELETED record of the same item would put it back in the list on redo.
+        if( index >= 0 && aUndoList->GetPickedItemStatus( index ) == UR_NEW )
+        {
+            aUndoList->RemovePicker( index );
+            delete item;
+        }
+        else if( aUndoList )    // The undo list owns the deleted items.
+            aUndoList->PushItem( ITEM_PICKER( item, UR_DELETED ) );
+        else
+            delete item;
+    }
+
+    if( !removedItems.empty() )
+        SetModify();
+
     TestDanglingEnds();
 
-    return modified;
+    return !removedItems.empty();
 }
 
 
@@ -621,6 +933,125 @@ void SCH_SCREEN::ClearUndoORRedoList( UNDO_REDO_CONTAINER& aList, int aItemCount
 }
 
 
+/**
+ * Function itemFootprint
+ * @return an estimate of the memory used by \a aItem, strings included.
+ */
+static size_t itemFootprint( const EDA_ITEM* aItem )
+{
+    switch( aItem->Type() )
+    {
+    case SCH_COMPONENT_T:
+    {
+        const SCH_COMPONENT* component = static_cast<const SCH_COMPONENT*>( aItem );
+        size_t size = sizeof( SCH_COMPONENT );
+
+        for( int ii = 0; ii < component->GetFieldCount(); ii++ )
+        {
+            size += sizeof( SCH_FIELD )
+                    + component->GetField( ii )->GetText().length() * sizeof( wxChar );
+        }
+
+        return size;
+    }
+
+    case SCH_SHEET_T:
+    {
+        const SCH_SHEET* sheet = static_cast<const SCH_SHEET*>( aItem );
+
+        return sizeof( SCH_SHEET ) + sheet->GetPins().size() * sizeof( SCH_SHEET_PIN );
+    }
+
+    case SCH_TEXT_T:
+    case SCH_LABEL_T:
+    case SCH_GLOBAL_LABEL_T:
+    case SCH_HIERARCHICAL_LABEL_T:
+        return sizeof( SCH_GLOBALLABEL )
+               + static_cast<const SCH_TEXT*>( aItem )->GetText().length() * sizeof( wxChar );
+
+    case SCH_LINE_T:
+        return sizeof( SCH_LINE );
+
+    case SCH_JUNCTION_T:
+        return sizeof( SCH_JUNCTION );
+
+    default:
+        return sizeof( SCH_BUS_WIRE_ENTRY );
+    }
+}
+
+
+/**
+ * Function commandFootprint
+ * @return the estimated memory of the items owned by the undo command \a aCommand,
+ *         following the ownership rules of PICKED_ITEMS_LIST::ClearListAndDeleteItems().
+ */
+static size_t commandFootprint( const PICKED_ITEMS_LIST* aCommand )
+{
+    size_t size = 0;
+
+    for( unsigned ii = 0; ii < aCommand->GetCount(); ii++ )
+    {
+        const EDA_ITEM* owned = NULL;
+
+        switch( aCommand->GetPickedItemStatus( ii ) )
+        {
+        case UR_CHANGED:
+        case UR_EXCHANGE_T:
+            owned = aCommand->GetPickedItemLink( ii );
+            break;
+
+        case UR_DELETED:
+            owned = aCommand->GetPickedItem( ii );
+            break;
+
+        case UR_WIRE_IMAGE:
+            for( owned = aCommand->GetPickedItem( ii ); owned; owned = owned->Next() )
+                size += itemFootprint( owned );
+
+            break;
+
+        default:
+            break;
+        }
+
+        if( owned )
+            size += itemFootprint( owned );
+    }
+
+    return size;
+}
+
+
+void SCH_SCREEN::PushCommandToUndoList( PICKED_ITEMS_LIST* aItem )
+{
+    BASE_SCREEN::PushCommandToUndoList( aItem );
+
+    if( m_undoBudget == 0 )
+        return;
+
+    std::vector<PICKED_ITEMS_LIST*>& commands = m_UndoList.m_CommandsList;
+    size_t total = 0;
+    int    keep = 0;
+
+    // Walk from the newest command, the oldest ones are the first to go.
+    for( int ii = (int) commands.size() - 1; ii >= 0; ii-- )
+    {
+        total += commandFootprint( commands[ii] );
+
+        if( total > m_undoBudget && keep > 0 )
+            break;
+
+        keep++;
+    }
+
+    int extraitems = (int) commands.size() - keep;
+
+    if( extraitems > 0 )
+        ClearUndoORRedoList( m_UndoList, extraitems );
+}
+
+
 void SCH_SCREEN::ClearDrawingState()
 {
     for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
@@ -934,10 +1365,28 @@ bool SCH_SCREEN::TestDanglingEnds()
 }
 
 
-bool SCH_SCREEN::BreakSegment( const wxPoint& aPoint )
+SCH_LINE* SCH_SCREEN::breakSegment( SCH_LINE* aSegment, const wxPoint& aPoint,
+                                     PICKED_ITEMS_LIST* aUndoList )
+{
+    SCH_LINE* newSegment = new SCH_LINE( *aSegment );
+
+    if( aUndoList )
+        saveWireChange( aUndoList, aSegment, NULL );
+
+    newSegment->SetStartPoint( aPoint );
+    aSegment->SetEndPoint( aPoint );
+    m_drawList.Insert( newSegment, aSegment->Next() );
+
+    if( aUndoList )
+        aUndoList->PushItem( ITEM_PICKER( newSegment, UR_NEW ) );
+
+    return newSegment;
+}
+
+
+bool SCH_SCREEN::BreakSegment( const wxPoint& aPoint, PICKED_ITEMS_LIST* aUndoList )
 {
     SCH_LINE* segment;
-    SCH_LINE* newSegment;
     bool brokenSegments = false;
 
     for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
@@ -951,11 +1400,7 @@ bool SCH_SCREEN::BreakSegment( const wxPoint& aPoint )
             continue;
 
         // Break the segment at aPoint and create a new segment.
-        newSegment = new SCH_LINE( *segment );
-        newSegment->SetStartPoint( aPoint );
-        segment->SetEndPoint( aPoint );
-        m_drawList.Insert( newSegment, segment->Next() );
-        item = newSegment;
+        item = breakSegment( segment, aPoint, aUndoList );
         brokenSegments = true;
     }
 
@@ -963,31 +1408,122 @@ bool SCH_SCREEN::BreakSegment( const wxPoint& aPoint )
 }
 
 
-bool SCH_SCREEN::BreakSegmentsOnJunctions()
+/**
+ * Class SEGMENT_INDEX
+ * buckets wire and bus segments by orientation and position, to find the segments going
+ * through a point without walking the whole draw list: horizontal segments are keyed by
+ * their Y coordinate, vertical ones by their X coordinate, and the few other ones are
+ * kept in a plain list.
+ */
+class SEGMENT_INDEX
 {
-    bool brokenSegments = false;
+public:
+    void Add( SCH_LINE* aSegment )
+    {
+        const wxPoint& start = aSegment->GetStartPoint();
+        const wxPoint& end = aSegment->GetEndPoint();
 
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+        if( start.y == end.y )
+            m_horizontal[start.y].push_back( aSegment );
+        else if( start.x == end.x )
+            m_vertical[start.x].push_back( aSegment );
+        else
+            m_other.push_back( aSegment );
+    }
+
+    /**
+     * Function Query
+     * adds to \a aList the segments going through \a aPoint, except the ones ending there,
+     * i.e. the segments SCH_SCREEN::BreakSegment() would break.
+     */
+    void Query( const wxPoint& aPoint, std::vector<SCH_LINE*>& aList ) const
     {
-        if( item->Type() == SCH_JUNCTION_T )
+        auto row = m_horizontal.find( aPoint.y );
+
+        if( row != m_horizontal.end() )
         {
-            SCH_JUNCTION* junction = ( SCH_JUNCTION* ) item;
+            for( SCH_LINE* segment : row->second )
+            {
+                int x0 = segment->GetStartPoint().x;
+                int x1 = segment->GetEndPoint().x;
 
-            if( BreakSegment( junction->GetPosition() ) )
-                brokenSegments = true;
+                if( std::min( x0, x1 ) < aPoint.x && aPoint.x < std::max( x0, x1 ) )
+                    aList.push_back( segment );
+            }
+        }
+
+        auto column = m_vertical.find( aPoint.x );
+
+        if( column != m_vertical.end() )
+        {
+            for( SCH_LINE* segment : column->second )
+            {
+                int y0 = segment->GetStartPoint().y;
+                int y1 = segment->GetEndPoint().y;
+
+                if( std::min( y0, y1 ) < aPoint.y && aPoint.y < std::max( y0, y1 ) )
+                    aList.push_back( segment );
+            }
+        }
+
+        for( SCH_LINE* segment : m_other )
+        {
+            if( segment->HitTest( aPoint, 0 ) && !segment->IsEndPoint( aPoint ) )
+                aList.push_back( segment );
+        }
+    }
+
+private:
+    std::unordered_map< int, std::vector<SCH_LINE*> >   m_horizontal;
+    std::unordered_map< int, std::vector<SCH_LINE*> >   m_vertical;
+    std::vector<SCH_LINE*>                              m_other;
+};
+
+
+bool SCH_SCREEN::BreakSegmentsOnJunctions( PICKED_ITEMS_LIST* aUndoList )
+{
+    SEGMENT_INDEX        index;
+    std::vector<wxPoint> breakPoints;
+
+    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    {
+        if( item->Type() == SCH_LINE_T )
+        {
+            if( item->GetLayer() != LAYER_NOTES )
+                index.Add( (SCH_LINE*) item );
+        }
+        else if( item->Type() == SCH_JUNCTION_T )
+        {
+            breakPoints.push_back( item->GetPosition() );
         }
         else
         {
             SCH_BUS_ENTRY_BASE* busEntry = dynamic_cast<SCH_BUS_ENTRY_BASE*>( item );
+
             if( busEntry )
             {
-                if( BreakSegment( busEntry->GetPosition() )
-                 || BreakSegment( busEntry->m_End() ) )
-                    brokenSegments = true;
+                breakPoints.push_back( busEntry->GetPosition() );
+                breakPoints.push_back( busEntry->m_End() );
             }
         }
     }
 
+    bool brokenSegments = false;
+    std::vector<SCH_LINE*> segments;
+
+    for( const wxPoint& point : breakPoints )
+    {
+        segments.clear();
+        index.Query( point, segments );
+
+        // The new part of a broken segment keeps its orientation and its key.
+        for( SCH_LINE* segment : segments )
+            index.Add( breakSegment( segment, point, aUndoList ) );
+
+        if( !segments.empty() )
+            brokenSegments = true;
+    }
+
     return brokenSegments;
 }
 
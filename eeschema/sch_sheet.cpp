@@ -93,6 +93,8 @@ SCH_SHEET::~SCH_SHEET()
         if( m_screen->GetRefCount() == 0 )
             delete m_screen;
     }
+
+    SCH_SHEET_LIST::InvalidateHierarchy();
 }
 
 
@@ -102,11 +104,20 @@ EDA_ITEM* SCH_SHEET::Clone() const
 }
 
 
+void SCH_SHEET::SetName( const wxString& aName )
+{
+    m_name = aName;
+    SCH_SHEET_LIST::InvalidateHierarchy();
+}
+
+
 void SCH_SHEET::SetScreen( SCH_SCREEN* aScreen )
 {
     if( aScreen == m_screen )
         return;
 
+    SCH_SHEET_LIST::InvalidateHierarchy();
+
     if( m_screen != NULL )
     {
         m_screen->DecRefCount();
@@ -339,6 +350,7 @@ void SCH_SHEET::SwapData( SCH_ITEM* aItem )
     std::swap( m_pos, sheet->m_pos );
     std::swap( m_size, sheet->m_size );
     std::swap( m_name, sheet->m_name );
+    SCH_SHEET_LIST::InvalidateHierarchy();
     std::swap( m_sheetNameSize, sheet->m_sheetNameSize );
     std::swap( m_fileNameSize, sheet->m_fileNameSize );
     m_pins.swap( sheet->m_pins );
@@ -1114,7 +1126,7 @@ void SCH_SHEET::GetNetListItem( NETLIST_OBJECT_LIST& aNetListItems,
 
     for( size_t i = 0;  i < m_pins.size();  i++ )
     {
-        NETLIST_OBJECT* item = new NETLIST_OBJECT();
+        NETLIST_OBJECT* item = new( aNetListItems ) NETLIST_OBJECT();
         item->m_SheetPathInclude = sheetPath;
         item->m_SheetPath = *aSheetPath;
         item->m_Comp = &m_pins[i];
@@ -1124,7 +1136,7 @@ void SCH_SHEET::GetNetListItem( NETLIST_OBJECT_LIST& aNetListItems,
         item->m_Start = item->m_End = m_pins[i].GetPosition();
         aNetListItems.push_back( item );
 
-        if( IsBusLabel( m_pins[i].GetText() ) )
+        if( aNetListItems.IsBusLabel( m_pins[i].GetText() ) )
             item->ConvertBusToNetListItems( aNetListItems );
     }
 }
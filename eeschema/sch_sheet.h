@@ -273,7 +273,8 @@ public:
 
     wxString GetName() const { return m_name; }
 
-    void SetName( const wxString& aName ) { m_name = aName; }
+    /// Sets the sheet name, which is part of the human readable paths of the hierarchy.
+    void SetName( const wxString& aName );
 
     int GetSheetNameSize() const { return m_sheetNameSize; }
 
@@ -29,6 +29,9 @@
  */
 
 #include <fctsys.h>
+#include <pgm_base.h>
+#include <task_scheduler.h>
+#include <hashtables.h>
 
 #include <general.h>
 #include <dlist.h>
@@ -45,10 +48,71 @@
 
 #include <wx/filename.h>
 
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+
+/// Incremented by each change of the sheet hierarchy, 0 is never used.
+static std::atomic<unsigned> s_hierarchyGeneration( 1 );
+
+
+/**
+ * The flattened hierarchy of a root sheet, shared by the SCH_SHEET_LISTs built from it
+ * and by their sheet paths.  It holds the path strings of its sheet paths.
+ */
+struct SCH_SHEET_HIERARCHY
+{
+    const SCH_SHEET*        m_root;
+    unsigned                m_generation;
+    SCH_SHEET_PATHS         m_paths;
+
+    std::vector<wxString>   m_pathStrings;
+    std::vector<wxString>   m_humanReadablePaths;
+
+    /// The time stamps of the sheets of each path, when its path string was built.
+    std::vector< std::vector<time_t> > m_timeStamps;
+
+    std::unordered_map<wxString, unsigned, WXSTRING_HASH> m_pathIndex;
+    std::unordered_map<wxString, unsigned, WXSTRING_HASH> m_humanReadableIndex;
+
+    /// @return true if the path \a aIndex has the sheets of \a aPath and the
+    ///         hierarchy, as well as the time stamps of these sheets, are unchanged.
+    bool Holds( unsigned aIndex, const SCH_SHEETS& aPath ) const
+    {
+        if( m_generation != SCH_SHEET_LIST::GetHierarchyGeneration()
+            || aIndex >= m_paths.size()
+            || static_cast<const SCH_SHEETS&>( m_paths[aIndex] ) != aPath )
+            return false;
+
+        for( unsigned i = 0; i < aPath.size(); i++ )
+        {
+            if( aPath[i]->GetTimeStamp() != m_timeStamps[aIndex][i] )
+                return false;
+        }
+
+        return true;
+    }
+
+    /// @return true if no sheet time stamp has changed since the hierarchy was built.
+    bool TimeStampsUnchanged() const
+    {
+        // Each sheet of the hierarchy ends at least one of its paths.
+        for( unsigned i = 0; i < m_paths.size(); i++ )
+        {
+            if( m_paths[i].Last()->GetTimeStamp() != m_timeStamps[i].back() )
+                return false;
+        }
+
+        return true;
+    }
+};
+
 
 SCH_SHEET_PATH::SCH_SHEET_PATH()
 {
     m_pageNumber = 0;
+    m_hierarchyIndex = 0;
 }
 
 
@@ -129,9 +193,19 @@ SCH_ITEM* SCH_SHEET_PATH::FirstDrawList() const
 
 
 wxString SCH_SHEET_PATH::Path() const
+{
+    if( m_hierarchy && m_hierarchy->Holds( m_hierarchyIndex, *this ) )
+        return m_hierarchy->m_pathStrings[m_hierarchyIndex];
+
+    return buildPath();
+}
+
+
+wxString SCH_SHEET_PATH::buildPath() const
 {
     wxString s, t;
 
+    s.reserve( 1 + 9 * size() );
     s = wxT( "/" );     // This is the root path
 
     // start at 1 to avoid the root sheet,
@@ -139,8 +213,8 @@ wxString SCH_SHEET_PATH::Path() const
     // it's timestamp changes anyway.
     for( unsigned i = 1; i < size(); i++ )
     {
-        t.Printf( _( "%8.8lX/" ), (long unsigned) at( i )->GetTimeStamp() );
-        s = s + t;
+        t.Printf( wxT( "%8.8lX/" ), (long unsigned) at( i )->GetTimeStamp() );
+        s += t;
     }
 
     return s;
@@ -148,6 +222,15 @@ wxString SCH_SHEET_PATH::Path() const
 
 
 wxString SCH_SHEET_PATH::PathHumanReadable() const
+{
+    if( m_hierarchy && m_hierarchy->Holds( m_hierarchyIndex, *this ) )
+        return m_hierarchy->m_humanReadablePaths[m_hierarchyIndex];
+
+    return buildPathHumanReadable();
+}
+
+
+wxString SCH_SHEET_PATH::buildPathHumanReadable() const
 {
     wxString s;
 
@@ -156,7 +239,8 @@ wxString SCH_SHEET_PATH::PathHumanReadable() const
     // start at 1 to avoid the root sheet, as above.
     for( unsigned i = 1; i < size(); i++ )
     {
-        s = s + at( i )->GetName() + wxT( "/" );
+        s += at( i )->GetName();
+        s += wxT( "/" );
     }
 
     return s;
@@ -464,12 +548,93 @@ SCH_SHEET* SCH_SHEET_PATH::FindSheetByName( const wxString& aSheetName )
 /********************************************************************/
 /* Class SCH_SHEET_LIST to handle the list of Sheets in a hierarchy */
 /********************************************************************/
+
 SCH_SHEET_LIST::SCH_SHEET_LIST( SCH_SHEET* aSheet )
 {
     m_isRootSheet = false;
 
-    if( aSheet != NULL )
+    if( aSheet == NULL )
+        return;
+
+    if( aSheet == g_RootSheet )
+    {
+        m_hierarchy = getHierarchy( aSheet );
+        SCH_SHEET_PATHS::operator=( m_hierarchy->m_paths );
+        m_isRootSheet = true;
+
+        for( unsigned i = 0; i < size(); i++ )
+        {
+            at( i ).m_hierarchy = m_hierarchy;
+            at( i ).m_hierarchyIndex = i;
+        }
+    }
+    else
+    {
         BuildSheetList( aSheet );
+    }
+}
+
+
+void SCH_SHEET_LIST::InvalidateHierarchy()
+{
+    if( ++s_hierarchyGeneration == 0 )
+        ++s_hierarchyGeneration;
+}
+
+
+unsigned SCH_SHEET_LIST::GetHierarchyGeneration()
+{
+    return s_hierarchyGeneration.load();
+}
+
+
+std::shared_ptr<const SCH_SHEET_HIERARCHY> SCH_SHEET_LIST::getHierarchy( SCH_SHEET* aRootSheet )
+{
+    static std::mutex                                 cacheLock;
+    static std::shared_ptr<const SCH_SHEET_HIERARCHY> cache;
+
+    std::lock_guard<std::mutex> lock( cacheLock );
+
+    // Read before walking the sheets: a change made meanwhile makes the new cache stale.
+    unsigned generation = GetHierarchyGeneration();
+
+    if( cache && cache->m_root == aRootSheet && cache->m_generation == generation
+        && cache->TimeStampsUnchanged() )
+        return cache;
+
+    SCH_SHEET_LIST flattened;
+    flattened.BuildSheetList( aRootSheet );
+
+    std::shared_ptr<SCH_SHEET_HIERARCHY> hierarchy = std::make_shared<SCH_SHEET_HIERARCHY>();
+    unsigned count = flattened.size();
+
+    hierarchy->m_root = aRootSheet;
+    hierarchy->m_generation = generation;
+    hierarchy->m_paths.swap( flattened );
+    hierarchy->m_pathStrings.reserve( count );
+    hierarchy->m_humanReadablePaths.reserve( count );
+    hierarchy->m_timeStamps.resize( count );
+    hierarchy->m_pathIndex.reserve( count );
+    hierarchy->m_humanReadableIndex.reserve( count );
+
+    for( unsigned i = 0; i < count; i++ )
+    {
+        const SCH_SHEET_PATH& path = hierarchy->m_paths[i];
+
+        hierarchy->m_pathStrings.push_back( path.buildPath() );
+        hierarchy->m_humanReadablePaths.push_back( path.buildPathHumanReadable() );
+
+        for( const SCH_SHEET* sheet : path )
+            hierarchy->m_timeStamps[i].push_back( sheet->GetTimeStamp() );
+
+        // The first sheet wins on duplicates, as in a linear search.
+        hierarchy->m_pathIndex.emplace( hierarchy->m_pathStrings[i], i );
+        hierarchy->m_humanReadableIndex.emplace( hierarchy->m_humanReadablePaths[i], i );
+    }
+
+    cache = hierarchy;
+
+    return cache;
 }
 
 
@@ -477,6 +642,24 @@ SCH_SHEET_PATH* SCH_SHEET_LIST::GetSheetByPath( const wxString aPath, bool aHuma
 {
     wxString sheetPath;
 
+    if( m_hierarchy && m_hierarchy->m_generation == GetHierarchyGeneration()
+        && m_hierarchy->m_paths.size() == size() )
+    {
+        const auto& index = aHumanReadable ? m_hierarchy->m_humanReadableIndex
+                                           : m_hierarchy->m_pathIndex;
+        auto it = index.find( aPath );
+
+        if( it == index.end() )
+            return NULL;
+
+        // Check the list has not been edited since it was copied from the hierarchy.
+        sheetPath = ( aHumanReadable ) ? at( it->second ).PathHumanReadable()
+                                       : at( it->second ).Path();
+
+        if( sheetPath == aPath )
+            return &at( it->second );
+    }
+
     for( unsigned i = 0; i < size(); i++ )
     {
         sheetPath = ( aHumanReadable ) ? at( i ).PathHumanReadable() : at( i ).Path();
@@ -493,6 +676,8 @@ void SCH_SHEET_LIST::BuildSheetList( SCH_SHEET* aSheet )
 {
     wxCHECK_RET( aSheet != NULL, wxT( "Cannot build sheet list from undefined sheet." ) );
 
+    m_hierarchy.reset();
+
     if( aSheet == g_RootSheet )
         m_isRootSheet = true;
 
@@ -572,8 +757,59 @@ void SCH_SHEET_LIST::AnnotatePowerSymbols( PART_LIBS* aLibs )
 void SCH_SHEET_LIST::GetComponents( PART_LIBS* aLibs, SCH_REFERENCE_LIST& aReferences,
                                     bool aIncludePowerSymbols )
 {
-    for( SCH_SHEET_PATHS_ITER it = begin(); it != end(); ++it )
-        (*it).GetComponents( aLibs, aReferences, aIncludePowerSymbols );
+    // Below this number of sheets, handing the work over to the scheduler costs more
+    // than it saves.
+    const unsigned minSheetCount = 4;
+
+    // Creating a SCH_REFERENCE may set the reference of its component, and the sheet paths
+    // sharing a screen share their components: these paths are scanned by the same task.
+    std::vector< std::vector<unsigned> > groups;
+
+    if( size() >= minSheetCount )
+    {
+        std::unordered_map<const SCH_SCREEN*, unsigned> groupIndex;
+
+        for( unsigned i = 0; i < size(); i++ )
+        {
+            auto inserted = groupIndex.emplace( at( i ).LastScreen(), groups.size() );
+
+            if( inserted.second )
+                groups.emplace_back();
+
+            groups[inserted.first->second].push_back( i );
+        }
+    }
+
+    if( groups.size() < 2 )
+    {
+        for( SCH_SHEET_PATHS_ITER it = begin(); it != end(); ++it )
+            (*it).GetComponents( aLibs, aReferences, aIncludePowerSymbols );
+
+        return;
+    }
+
+    // Only read from now on, by FindLibPart().
+    aLibs->UpdateNameIndex();
+
+    std::vector<SCH_REFERENCE_LIST> sheetReferences( size() );
+    TASK_GROUP collectors( Pgm().Scheduler() );
+
+    for( const std::vector<unsigned>& group : groups )
+    {
+        collectors.Run( [this, &group, &sheetReferences, aLibs, aIncludePowerSymbols]()
+        {
+            for( unsigned i : group )
+                at( i ).GetComponents( aLibs, sheetReferences[i], aIncludePowerSymbols );
+        } );
+    }
+
+    collectors.Wait();
+
+    for( SCH_REFERENCE_LIST& references : sheetReferences )
+    {
+        for( unsigned i = 0; i < references.GetCount(); i++ )
+            aReferences.AddItem( references[i] );
+    }
 }
 
 void SCH_SHEET_LIST::GetMultiUnitComponents( PART_LIBS* aLibs,
@@ -34,6 +34,7 @@
 #include <base_struct.h>
 
 #include <map>
+#include <memory>
 
 
 /** Info about complex hierarchies handling:
@@ -86,6 +87,7 @@ class SCH_MARKER;
 class SCH_ITEM;
 class SCH_REFERENCE_LIST;
 class PART_LIBS;
+struct SCH_SHEET_HIERARCHY;
 
 #define SHEET_NOT_FOUND          -1
 
@@ -115,6 +117,17 @@ class SCH_SHEET_PATH : public SCH_SHEETS
 
     int m_pageNumber;              /// Page numbers are maintained by the sheet load order.
 
+    friend class SCH_SHEET_LIST;
+
+    /// The cached hierarchy this path was copied from, see SCH_SHEET_LIST, and the
+    /// index of the path in it.  The path strings held there are only used while the
+    /// hierarchy is unchanged and the path still holds the same sheets.
+    std::shared_ptr<const SCH_SHEET_HIERARCHY> m_hierarchy;
+    unsigned                                   m_hierarchyIndex;
+
+    wxString buildPath() const;
+    wxString buildPathHumanReadable() const;
+
 public:
     SCH_SHEET_PATH();
 
@@ -337,18 +350,39 @@ private:
     bool            m_isRootSheet;
     SCH_SHEET_PATH  m_currentSheetPath;
 
+    /// The cached hierarchy this list was copied from, if any.
+    std::shared_ptr<const SCH_SHEET_HIERARCHY> m_hierarchy;
+
+    /// @return the flattened hierarchy of \a aRootSheet, built again if it has changed.
+    static std::shared_ptr<const SCH_SHEET_HIERARCHY> getHierarchy( SCH_SHEET* aRootSheet );
+
 public:
 
     /**
      * Constructor
      * build a flattened list of SCH_SHEET_PATH objects from \a aSheet.
      *
+     * The hierarchy of the root sheet is cached, with the path strings of its sheet
+     * paths, and is only walked again once it has been changed.
+     *
      * If aSheet == NULL, then this is an empty hierarchy which the user can populate.
      */
     SCH_SHEET_LIST( SCH_SHEET* aSheet = NULL );
 
     ~SCH_SHEET_LIST() {}
 
+    /**
+     * Function InvalidateHierarchy
+     * must be called when a sheet is added to or removed from a screen, or when the
+     * screen or the name of a sheet is changed.  The cached hierarchy and path strings
+     * are then rebuilt on the next use.  Changed sheet time stamps are found by
+     * comparing them with the ones the hierarchy was built with.
+     */
+    static void InvalidateHierarchy();
+
+    /// @return the hierarchy generation, incremented by InvalidateHierarchy().
+    static unsigned GetHierarchyGeneration();
+
     /**
      * Function GetSheetByPath
      * returns a sheet matching the path name in \a aPath.
@@ -387,7 +421,8 @@ public:
     /**
      * Function GetComponents
      * adds a SCH_REFERENCE() object to \a aReferences for each component in the list
-     * of sheets.
+     * of sheets.  The sheets are scanned concurrently, the references are added in the
+     * order of the sheets.
      * @param aLibs the library list to use
      * @param aReferences List of references to populate.
      * @param aIncludePowerSymbols Set to false to only get normal components.
@@ -617,7 +617,7 @@ void SCH_TEXT::GetNetListItem( NETLIST_OBJECT_LIST& aNetListItems,
     if( GetLayer() == LAYER_NOTES || GetLayer() == LAYER_SHEETLABEL )
         return;
 
-    NETLIST_OBJECT* item = new NETLIST_OBJECT();
+    NETLIST_OBJECT* item = new( aNetListItems ) NETLIST_OBJECT();
     item->m_SheetPath = *aSheetPath;
     item->m_SheetPathInclude = *aSheetPath;
     item->m_Comp = (SCH_ITEM*) this;
@@ -634,7 +634,7 @@ void SCH_TEXT::GetNetListItem( NETLIST_OBJECT_LIST& aNetListItems,
     aNetListItems.push_back( item );
 
     /* If a bus connects to label */
-    if( IsBusLabel( m_Text ) )
+    if( aNetListItems.IsBusLabel( m_Text ) )
         item->ConvertBusToNetListItems( aNetListItems );
 }
 
@@ -661,7 +661,7 @@ bool SCH_TEXT::HitTest( const EDA_RECT& aRect, bool aContained, int aAccuracy )
 
 void SCH_TEXT::Plot( PLOTTER* aPlotter )
 {
-    static std::vector <wxPoint> Poly;
+    std::vector <wxPoint> Poly;     // not static, sheets can be plotted concurrently
     EDA_COLOR_T color = GetLayerColor( GetLayer() );
     int         thickness = GetPenSize();
 
@@ -195,26 +195,14 @@ void SCH_EDIT_FRAME::Process_Special_Functions( wxCommandEvent& event )
 
     case ID_POPUP_SCH_BREAK_WIRE:
         {
-            DLIST< SCH_ITEM > oldWires;
+            PICKED_ITEMS_LIST brokenItems;
 
-            oldWires.SetOwnership( false );      // Prevent DLIST for deleting items in destructor.
             m_canvas->MoveCursorToCrossHair();
-            screen->ExtractWires( oldWires, true );
-            screen->BreakSegment( GetCrossHairPosition() );
 
-            if( oldWires.GetCount() != 0 )
+            if( screen->BreakSegment( GetCrossHairPosition(), &brokenItems ) )
             {
-                PICKED_ITEMS_LIST oldItems;
-
-                oldItems.m_Status = UR_WIRE_IMAGE;
-
-                while( oldWires.GetCount() != 0 )
-                {
-                    ITEM_PICKER picker = ITEM_PICKER( oldWires.PopFront(), UR_WIRE_IMAGE );
-                    oldItems.PushItem( picker );
-                }
-
-                SaveCopyInUndoList( oldItems, UR_WIRE_IMAGE );
+                SaveCopyInUndoList( brokenItems, UR_CHANGED );
+                OnModify();
             }
 
             if( screen->TestDanglingEnds() )
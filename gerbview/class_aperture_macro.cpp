@@ -59,7 +59,7 @@ static wxPoint mapPt( double x, double y, bool isMetric )
 }
 
 
-bool AM_PRIMITIVE::IsAMPrimitiveExposureOn(GERBER_DRAW_ITEM* aParent) const
+bool AM_PRIMITIVE::IsAMPrimitiveExposureOn( const std::vector<double>& aValues ) const
 {
     /*
      * Some but not all primitives use the first parameter as an exposure control.
@@ -79,7 +79,7 @@ bool AM_PRIMITIVE::IsAMPrimitiveExposureOn(GERBER_DRAW_ITEM* aParent) const
     case AMP_OUTLINE:
     case AMP_POLYGON:
         // All have an exposure parameter and can return a value (0 or 1)
-        return params[0].GetValue( aParent->GetDcodeDescr() ) != 0;
+        return aValues[0] != 0;
         break;
 
     case AMP_THERMAL:   // Exposure is always on
@@ -93,21 +93,23 @@ bool AM_PRIMITIVE::IsAMPrimitiveExposureOn(GERBER_DRAW_ITEM* aParent) const
 }
 
 
-void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
-                                   SHAPE_POLY_SET& aShapeBuffer,
-                                   wxPoint aShapePos )
+void AM_PRIMITIVE::DrawBasicShape( const std::vector<double>& aValues,
+                                   const GBR_AB_TRANSFORM& aTransform,
+                                   SHAPE_POLY_SET& aShapeBuffer )
 {
     #define TO_POLY_SHAPE { aShapeBuffer.NewOutline(); \
                             for( unsigned jj = 0; jj < polybuffer.size(); jj++ )\
-                                aShapeBuffer.Append( polybuffer[jj].x, polybuffer[jj].y );}
+                            {\
+                                wxPoint abPos = aTransform.Apply( polybuffer[jj] );\
+                                aShapeBuffer.Append( abPos.x, abPos.y );\
+                            }}
 
     const int seg_per_circle = 64;   // Number of segments to approximate a circle
     // Draw the primitive shape for flashed items.
     static std::vector<wxPoint> polybuffer;     // create a static buffer to avoid a lot of memory reallocation
     polybuffer.clear();
 
-    wxPoint curPos = aShapePos;
-    D_CODE* tool   = aParent->GetDcodeDescr();
+    wxPoint curPos;     // the shape is built for a flash at ( 0, 0 )
     double rotation;
 
     switch( primitive_id )
@@ -119,9 +121,9 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
          * type (1), exposure, diameter, pos.x, pos.y
          * type is not stored in parameters list, so the first parameter is exposure
          */
-        curPos += mapPt( params[2].GetValue( tool ), params[3].GetValue( tool ), m_GerbMetric );
-        curPos = aParent->GetABPosition( curPos );
-        int radius = scaletoIU( params[1].GetValue( tool ), m_GerbMetric ) / 2;
+        curPos += mapPt( aValues[2], aValues[3], m_GerbMetric );
+        curPos = aTransform.Apply( curPos );
+        int radius = scaletoIU( aValues[1], m_GerbMetric ) / 2;
 
         TransformCircleToPolygon( aShapeBuffer, curPos, radius, seg_per_circle );
     }
@@ -139,10 +141,10 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
          * type (2), exposure, width, start.x, start.y, end.x, end.y, rotation
          * type is not stored in parameters list, so the first parameter is exposure
          */
-        ConvertShapeToPolygon( aParent, polybuffer );
+        ConvertShapeToPolygon( aValues, polybuffer );
 
         // shape rotation:
-        rotation = params[6].GetValue( tool ) * 10.0;
+        rotation = aValues[6] * 10.0;
         if( rotation != 0)
         {
             for( unsigned ii = 0; ii < polybuffer.size(); ii++ )
@@ -151,10 +153,7 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
 
         // Move to current position:
         for( unsigned ii = 0; ii < polybuffer.size(); ii++ )
-        {
             polybuffer[ii] += curPos;
-            polybuffer[ii] = aParent->GetABPosition( polybuffer[ii] );
-        }
 
         TO_POLY_SHAPE;
     }
@@ -170,10 +169,10 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
          * type (21), exposure, ,width, height, center pos.x, center pos.y, rotation
          * type is not stored in parameters list, so the first parameter is exposure
          */
-        ConvertShapeToPolygon( aParent, polybuffer );
+        ConvertShapeToPolygon( aValues, polybuffer );
 
         // shape rotation:
-        rotation = params[5].GetValue( tool ) * 10.0;
+        rotation = aValues[5] * 10.0;
 
         if( rotation != 0 )
         {
@@ -183,10 +182,7 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
 
         // Move to current position:
         for( unsigned ii = 0; ii < polybuffer.size(); ii++ )
-        {
             polybuffer[ii] += curPos;
-            polybuffer[ii] = aParent->GetABPosition( polybuffer[ii] );
-        }
 
         TO_POLY_SHAPE;
     }
@@ -199,10 +195,10 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
          * type (22), exposure, ,width, height, corner pos.x, corner pos.y, rotation
          * type is not stored in parameters list, so the first parameter is exposure
          */
-        ConvertShapeToPolygon( aParent, polybuffer );
+        ConvertShapeToPolygon( aValues, polybuffer );
 
         // shape rotation:
-        rotation = params[5].GetValue( tool ) * 10.0;
+        rotation = aValues[5] * 10.0;
         if( rotation != 0)
         {
             for( unsigned ii = 0; ii < polybuffer.size(); ii++ )
@@ -211,10 +207,7 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
 
         // Move to current position:
         for( unsigned ii = 0; ii < polybuffer.size(); ii++ )
-        {
             polybuffer[ii] += curPos;
-            polybuffer[ii] = aParent->GetABPosition( polybuffer[ii] );
-        }
 
         TO_POLY_SHAPE;
     }
@@ -230,11 +223,11 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
          * The thermal primitive is a ring (annulus) interrupted by four gaps. Exposure is always on.
          */
         std::vector<wxPoint> subshape_poly;
-        curPos += mapPt( params[0].GetValue( tool ), params[1].GetValue( tool ), m_GerbMetric );
-        ConvertShapeToPolygon( aParent, subshape_poly );
+        curPos += mapPt( aValues[0], aValues[1], m_GerbMetric );
+        ConvertShapeToPolygon( aValues, subshape_poly );
 
         // shape rotation:
-        rotation = params[5].GetValue( tool ) * 10.0;
+        rotation = aValues[5] * 10.0;
 
         // Because a thermal shape has 4 identical sub-shapes, only one is created in subshape_poly.
         // We must draw 4 sub-shapes rotated by 90 deg
@@ -248,10 +241,7 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
 
             // Move to current position:
             for( unsigned jj = 0; jj < polybuffer.size(); jj++ )
-            {
                 polybuffer[jj] += curPos;
-                polybuffer[jj] = aParent->GetABPosition( polybuffer[jj] );
-            }
 
             TO_POLY_SHAPE;
         }
@@ -264,21 +254,20 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
          * The moir primitive is a cross hair centered on concentric rings (annuli).
          * Exposure is always on.
          */
-        curPos += mapPt( params[0].GetValue( tool ), params[1].GetValue( tool ),
-                         m_GerbMetric );
+        curPos += mapPt( aValues[0], aValues[1], m_GerbMetric );
 
         /* Generated by an aperture macro declaration like:
          * "6,0,0,0.125,.01,0.01,3,0.003,0.150,0"
          * type(6), pos.x, pos.y, diam, penwidth, gap, circlecount, crosshair thickness, crosshaire len, rotation
          * type is not stored in parameters list, so the first parameter is pos.x
          */
-        int outerDiam    = scaletoIU( params[2].GetValue( tool ), m_GerbMetric );
-        int penThickness = scaletoIU( params[3].GetValue( tool ), m_GerbMetric );
-        int gap = scaletoIU( params[4].GetValue( tool ), m_GerbMetric );
-        int numCircles = KiROUND( params[5].GetValue( tool ) );
+        int outerDiam    = scaletoIU( aValues[2], m_GerbMetric );
+        int penThickness = scaletoIU( aValues[3], m_GerbMetric );
+        int gap = scaletoIU( aValues[4], m_GerbMetric );
+        int numCircles = KiROUND( aValues[5] );
 
         // Draw circles:
-        wxPoint center = aParent->GetABPosition( curPos );
+        wxPoint center = aTransform.Apply( curPos );
         // adjust outerDiam by this on each nested circle
         int diamAdjust = (gap + penThickness) * 2;
 
@@ -302,16 +291,15 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
         }
 
         // Draw the cross:
-        ConvertShapeToPolygon( aParent, polybuffer );
+        ConvertShapeToPolygon( aValues, polybuffer );
 
-        rotation = params[8].GetValue( tool ) * 10.0;
+        rotation = aValues[8] * 10.0;
         for( unsigned ii = 0; ii < polybuffer.size(); ii++ )
         {
             // shape rotation:
             RotatePoint( &polybuffer[ii], -rotation );
             // Move to current position:
             polybuffer[ii] += curPos;
-            polybuffer[ii] = aParent->GetABPosition( polybuffer[ii] );
         }
 
         TO_POLY_SHAPE;
@@ -334,15 +322,15 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
          * type(4), exposure, corners count, corner1.x, corner.1y, ..., rotation
          * type is not stored in parameters list, so the first parameter is exposure
          */
-        int numPoints = (int) params[1].GetValue( tool );
-        rotation  = params[numPoints * 2 + 4].GetValue( tool ) * 10.0;
+        int numPoints = (int) aValues[1];
+        rotation  = aValues[numPoints * 2 + 4] * 10.0;
         wxPoint pos;
         // Read points. numPoints does not include the starting point, so add 1.
         for( int i = 0; i<numPoints + 1; ++i )
         {
             int jj = i * 2 + 2;
-            pos.x = scaletoIU( params[jj].GetValue( tool ), m_GerbMetric );
-            pos.y = scaletoIU( params[jj + 1].GetValue( tool ), m_GerbMetric );
+            pos.x = scaletoIU( aValues[jj], m_GerbMetric );
+            pos.y = scaletoIU( aValues[jj + 1], m_GerbMetric );
             polybuffer.push_back(pos);
         }
         // rotate polygon and move it to the actual position
@@ -354,10 +342,7 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
 
         // Move to current position:
         for( unsigned ii = 0; ii < polybuffer.size(); ii++ )
-        {
             polybuffer[ii] += curPos;
-            polybuffer[ii] = aParent->GetABPosition( polybuffer[ii] );
-        }
 
         TO_POLY_SHAPE;
     }
@@ -373,17 +358,16 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
          * type(5), exposure, vertices count, pox.x, pos.y, diameter, rotation
          * type is not stored in parameters list, so the first parameter is exposure
          */
-        curPos += mapPt( params[2].GetValue( tool ), params[3].GetValue( tool ), m_GerbMetric );
+        curPos += mapPt( aValues[2], aValues[3], m_GerbMetric );
         // Creates the shape:
-        ConvertShapeToPolygon( aParent, polybuffer );
+        ConvertShapeToPolygon( aValues, polybuffer );
 
         // rotate polygon and move it to the actual position
-        rotation  = params[5].GetValue( tool ) * 10.0;
+        rotation  = aValues[5] * 10.0;
         for( unsigned ii = 0; ii < polybuffer.size(); ii++ )
         {
             RotatePoint( &polybuffer[ii], -rotation );
             polybuffer[ii] += curPos;
-            polybuffer[ii] = aParent->GetABPosition( polybuffer[ii] );
         }
 
         TO_POLY_SHAPE;
@@ -412,11 +396,9 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
  * because circles are very easy to draw (no rotation problem) so convert them in polygons,
  * and draw them as polygons is not a good idea.
  */
-void AM_PRIMITIVE::ConvertShapeToPolygon( GERBER_DRAW_ITEM*     aParent,
-                                          std::vector<wxPoint>& aBuffer )
+void AM_PRIMITIVE::ConvertShapeToPolygon( const std::vector<double>& aValues,
+                                          std::vector<wxPoint>&      aBuffer )
 {
-    D_CODE* tool = aParent->GetDcodeDescr();
-
     switch( primitive_id )
     {
     case AMP_CIRCLE:        // Circle, currently convertion not needed
@@ -425,11 +407,11 @@ void AM_PRIMITIVE::ConvertShapeToPolygon( GERBER_DRAW_ITEM*     aParent,
     case AMP_LINE2:
     case AMP_LINE20:        // Line with rectangle ends. (Width, start and end pos + rotation)
     {
-        int     width = scaletoIU( params[1].GetValue( tool ), m_GerbMetric );
-        wxPoint start = mapPt( params[2].GetValue( tool ),
-                               params[3].GetValue( tool ), m_GerbMetric );
-        wxPoint end = mapPt( params[4].GetValue( tool ),
-                             params[5].GetValue( tool ), m_GerbMetric );
+        int     width = scaletoIU( aValues[1], m_GerbMetric );
+        wxPoint start = mapPt( aValues[2],
+                               aValues[3], m_GerbMetric );
+        wxPoint end = mapPt( aValues[4],
+                             aValues[5], m_GerbMetric );
         wxPoint delta = end - start;
         int     len   = KiROUND( EuclideanNorm( delta ) );
 
@@ -458,8 +440,8 @@ void AM_PRIMITIVE::ConvertShapeToPolygon( GERBER_DRAW_ITEM*     aParent,
 
     case AMP_LINE_CENTER:
     {
-        wxPoint size = mapPt( params[1].GetValue( tool ), params[2].GetValue( tool ), m_GerbMetric );
-        wxPoint pos  = mapPt( params[3].GetValue( tool ), params[4].GetValue( tool ), m_GerbMetric );
+        wxPoint size = mapPt( aValues[1], aValues[2], m_GerbMetric );
+        wxPoint pos  = mapPt( aValues[3], aValues[4], m_GerbMetric );
 
         // Build poly:
         pos.x -= size.x / 2;
@@ -476,9 +458,8 @@ void AM_PRIMITIVE::ConvertShapeToPolygon( GERBER_DRAW_ITEM*     aParent,
 
     case AMP_LINE_LOWER_LEFT:
     {
-        wxPoint size = mapPt( params[1].GetValue( tool ), params[2].GetValue( tool ), m_GerbMetric );
-        wxPoint lowerLeft = mapPt( params[3].GetValue( tool ), params[4].GetValue(
-                                       tool ), m_GerbMetric );
+        wxPoint size = mapPt( aValues[1], aValues[2], m_GerbMetric );
+        wxPoint lowerLeft = mapPt( aValues[3], aValues[4], m_GerbMetric );
 
         // Build poly:
         aBuffer.push_back( lowerLeft );
@@ -496,9 +477,9 @@ void AM_PRIMITIVE::ConvertShapeToPolygon( GERBER_DRAW_ITEM*     aParent,
         // Only 1/4 of the full shape is built, because the other 3 shapes will be draw from this first
         // rotated by 90, 180 and 270 deg.
         // params = center.x (unused here), center.y (unused here), outside diam, inside diam, crosshair thickness
-        int outerRadius   = scaletoIU( params[2].GetValue( tool ), m_GerbMetric ) / 2;
-        int innerRadius   = scaletoIU( params[3].GetValue( tool ), m_GerbMetric ) / 2;
-        int halfthickness = scaletoIU( params[4].GetValue( tool ), m_GerbMetric ) / 2;
+        int outerRadius   = scaletoIU( aValues[2], m_GerbMetric ) / 2;
+        int innerRadius   = scaletoIU( aValues[3], m_GerbMetric ) / 2;
+        int halfthickness = scaletoIU( aValues[4], m_GerbMetric ) / 2;
         double angle_start = RAD2DECIDEG( asin( (double) halfthickness / innerRadius ) );
 
         // Draw shape in the first cadrant (X and Y > 0)
@@ -545,8 +526,8 @@ void AM_PRIMITIVE::ConvertShapeToPolygon( GERBER_DRAW_ITEM*     aParent,
     case AMP_MOIRE:     // A cross hair with n concentric circles. Only the cros is build as polygon
                         // because circles can be drawn easily
     {
-        int crossHairThickness = scaletoIU( params[6].GetValue( tool ), m_GerbMetric );
-        int crossHairLength    = scaletoIU( params[7].GetValue( tool ), m_GerbMetric );
+        int crossHairThickness = scaletoIU( aValues[6], m_GerbMetric );
+        int crossHairLength    = scaletoIU( aValues[7], m_GerbMetric );
 
         // Create cross. First create 1/4 of the shape.
         // Others point are the same, totated by 90, 180 and 270 deg
@@ -578,8 +559,8 @@ void AM_PRIMITIVE::ConvertShapeToPolygon( GERBER_DRAW_ITEM*     aParent,
 
     case AMP_POLYGON:   // Creates a regular polygon
     {
-        int vertexcount = KiROUND( params[1].GetValue( tool ) );
-        int radius    = scaletoIU( params[4].GetValue( tool ), m_GerbMetric ) / 2;
+        int vertexcount = KiROUND( aValues[1] );
+        int radius    = scaletoIU( aValues[4], m_GerbMetric ) / 2;
         // rs274x said: vertex count = 3 ... 10, and the first corner is on the X axis
         if( vertexcount < 3 )
             vertexcount = 3;
@@ -608,36 +589,35 @@ void AM_PRIMITIVE::ConvertShapeToPolygon( GERBER_DRAW_ITEM*     aParent,
  * one cannot calculate the "size" of a shape (only abounding box)
  * but here, the "dimension" of the shape is the diameter of the primitive
  * or for lines the width of the line
- * @param aParent = the parent GERBER_DRAW_ITEM which is actually drawn
+ * @param aValues = the parameter values, evaluated for the D_CODE using the macro
  * @return a dimension, or -1 if no dim to calculate
   */
-int AM_PRIMITIVE::GetShapeDim( GERBER_DRAW_ITEM* aParent )
+int AM_PRIMITIVE::GetShapeDim( const std::vector<double>& aValues ) const
 {
     int dim = -1;
-    D_CODE* tool = aParent->GetDcodeDescr();
 
     switch( primitive_id )
     {
     case AMP_CIRCLE:
         // params = exposure, diameter, pos.x, pos.y
-        dim = scaletoIU( params[1].GetValue( tool ), m_GerbMetric );     // Diameter
+        dim = scaletoIU( aValues[1], m_GerbMetric );     // Diameter
         break;
 
     case AMP_LINE2:
     case AMP_LINE20:        // Line with rectangle ends. (Width, start and end pos + rotation)
-        dim  = scaletoIU( params[1].GetValue( tool ), m_GerbMetric );   // linne width
+        dim  = scaletoIU( aValues[1], m_GerbMetric );   // linne width
     break;
 
     case AMP_LINE_CENTER:
     {
-        wxPoint size = mapPt( params[1].GetValue( tool ), params[2].GetValue( tool ), m_GerbMetric );
+        wxPoint size = mapPt( aValues[1], aValues[2], m_GerbMetric );
         dim = std::min(size.x, size.y);
     }
     break;
 
     case AMP_LINE_LOWER_LEFT:
     {
-        wxPoint size = mapPt( params[1].GetValue( tool ), params[2].GetValue( tool ), m_GerbMetric );
+        wxPoint size = mapPt( aValues[1], aValues[2], m_GerbMetric );
         dim = std::min(size.x, size.y);
     }
     break;
@@ -647,27 +627,27 @@ int AM_PRIMITIVE::GetShapeDim( GERBER_DRAW_ITEM* aParent )
         // Only 1/4 of the full shape is built, because the other 3 shapes will be draw from this first
         // rotated by 90, 180 and 270 deg.
         // params = center.x (unused here), center.y (unused here), outside diam, inside diam, crosshair thickness
-        dim   = scaletoIU( params[2].GetValue( tool ), m_GerbMetric ) / 2;  // Outer diam
+        dim   = scaletoIU( aValues[2], m_GerbMetric ) / 2;  // Outer diam
     }
     break;
 
     case AMP_MOIRE:     // A cross hair with n concentric circles.
-        dim = scaletoIU( params[7].GetValue( tool ), m_GerbMetric );    // = cross hair len
+        dim = scaletoIU( aValues[7], m_GerbMetric );    // = cross hair len
         break;
 
     case AMP_OUTLINE:   // a free polygon :
     // dim = min side of the bounding box (this is a poor criteria, but what is a good criteria b?)
     {
         // exposure, corners count, corner1.x, corner.1y, ..., rotation
-        int numPoints = (int) params[1].GetValue( tool );
+        int numPoints = (int) aValues[1];
         // Read points. numPoints does not include the starting point, so add 1.
         // and calculate the bounding box;
         wxSize pos_min, pos_max, pos;
         for( int i = 0; i<numPoints + 1; ++i )
         {
             int jj = i * 2 + 2;
-            pos.x = scaletoIU( params[jj].GetValue( tool ), m_GerbMetric );
-            pos.y = scaletoIU( params[jj + 1].GetValue( tool ), m_GerbMetric );
+            pos.x = scaletoIU( aValues[jj], m_GerbMetric );
+            pos.y = scaletoIU( aValues[jj + 1], m_GerbMetric );
             if( i == 0 )
                 pos_min = pos_max = pos;
             else
@@ -693,7 +673,7 @@ int AM_PRIMITIVE::GetShapeDim( GERBER_DRAW_ITEM* aParent )
         break;
 
     case AMP_POLYGON:   // Regular polygon
-        dim = scaletoIU( params[4].GetValue( tool ), m_GerbMetric ) / 2;      // Radius
+        dim = scaletoIU( aValues[4], m_GerbMetric ) / 2;      // Radius
         break;
 
     case AMP_COMMENT:
@@ -706,51 +686,79 @@ int AM_PRIMITIVE::GetShapeDim( GERBER_DRAW_ITEM* aParent )
 
 
 /*
- * Function DrawApertureMacroShape
- * Draw the primitive shape for flashed items.
- * When an item is flashed, this is the shape of the item
+ * Function ConvertShapeToPolygon
+ * Build the whole shape of the macro, for a flash at ( 0, 0 ), in AB axis
  */
-void APERTURE_MACRO::DrawApertureMacroShape( GERBER_DRAW_ITEM* aParent,
-                                             EDA_RECT* aClipBox, wxDC* aDC,
-                                             EDA_COLOR_T aColor,
-                                             wxPoint aShapePos, bool aFilledShape )
+void APERTURE_MACRO::ConvertShapeToPolygon( GERBER_DRAW_ITEM* aParent,
+                                            SHAPE_POLY_SET& aShapeBuffer )
 {
-    SHAPE_POLY_SET shapeBuffer;
+    D_CODE* tool = aParent->GetDcodeDescr();
+    GBR_AB_TRANSFORM transform = aParent->GetABTransform();
     SHAPE_POLY_SET holeBuffer;
     bool hasHole = false;
 
-    for( AM_PRIMITIVES::iterator prim_macro = primitives.begin();
-         prim_macro != primitives.end(); ++prim_macro )
+    aShapeBuffer.RemoveAllContours();
+
+    for( unsigned ii = 0; ii < primitives.size(); ii++ )
     {
-        if( prim_macro->IsAMPrimitiveExposureOn( aParent ) )
-            prim_macro->DrawBasicShape( aParent, shapeBuffer, aShapePos );
+        AM_PRIMITIVE& prim_macro = primitives[ii];
+        const std::vector<double>& values = tool->GetMacroValues( ii );
+
+        if( prim_macro.IsAMPrimitiveExposureOn( values ) )
+            prim_macro.DrawBasicShape( values, transform, aShapeBuffer );
         else
         {
-            prim_macro->DrawBasicShape( aParent, holeBuffer, aShapePos );
+            prim_macro.DrawBasicShape( values, transform, holeBuffer );
 
             if( holeBuffer.OutlineCount() )     // we have a new hole in shape: remove the hole
             {
-                shapeBuffer.BooleanSubtract( holeBuffer, SHAPE_POLY_SET::PM_FAST );
+                aShapeBuffer.BooleanSubtract( holeBuffer, SHAPE_POLY_SET::PM_FAST );
                 holeBuffer.RemoveAllContours();
                 hasHole = true;
             }
         }
     }
 
+    // If a hole is defined inside a polygon, we must fracture the polygon
+    // to be able to drawn it (i.e link holes by overlapping edges)
+    if( hasHole && aShapeBuffer.OutlineCount() )
+        aShapeBuffer.Fracture( SHAPE_POLY_SET::PM_FAST );
+}
+
+
+/*
+ * Function DrawApertureMacroShape
+ * Draw the primitive shape for flashed items.
+ * When an item is flashed, this is the shape of the item
+ */
+void APERTURE_MACRO::DrawApertureMacroShape( GERBER_DRAW_ITEM* aParent,
+                                             EDA_RECT* aClipBox, wxDC* aDC,
+                                             EDA_COLOR_T aColor,
+                                             wxPoint aShapePos, bool aFilledShape )
+{
+    // The shape is built once per D_CODE and AB transform, only its position changes
+    const SHAPE_POLY_SET& shapeBuffer = aParent->GetDcodeDescr()->GetMacroShape( aParent );
+
     if( shapeBuffer.OutlineCount() == 0 )
         return;
 
-    // If a hole is defined inside a polygon, we must fracture the polygon
-    // to be able to drawn it (i.e link holes by overlapping edges)
-    if( hasHole )
-        shapeBuffer.Fracture( SHAPE_POLY_SET::PM_FAST );
+    wxPoint offset = aParent->GetABPosition( aShapePos );
+    static std::vector<wxPoint> points;     // static buffer to avoid a lot of memory reallocation
 
     for( int ii = 0; ii < shapeBuffer.OutlineCount(); ii++ )
     {
-        SHAPE_LINE_CHAIN& poly = shapeBuffer.Outline( ii );
+        const SHAPE_LINE_CHAIN& poly = shapeBuffer.COutline( ii );
+
+        points.clear();
+
+        for( int jj = 0; jj < poly.PointCount(); jj++ )
+        {
+            const VECTOR2I& corner = poly.CPoint( jj );
+            points.push_back( wxPoint( corner.x + offset.x, corner.y + offset.y ) );
+        }
 
         GRClosedPoly( aClipBox, aDC,
-                      poly.PointCount(), (wxPoint*)&poly.Point( 0 ), aFilledShape, aColor, aColor );
+                      points.size(), &points[0], aFilledShape, aColor, aColor );
     }
 }
 
@@ -766,11 +774,12 @@ void APERTURE_MACRO::DrawApertureMacroShape( GERBER_DRAW_ITEM* aParent,
  */
 int APERTURE_MACRO::GetShapeDim( GERBER_DRAW_ITEM* aParent )
 {
+    D_CODE* tool = aParent->GetDcodeDescr();
     int dim = -1;
-    for( AM_PRIMITIVES::iterator prim_macro = primitives.begin();
-         prim_macro != primitives.end(); ++prim_macro )
+
+    for( unsigned ii = 0; ii < primitives.size(); ii++ )
     {
-        int pdim = prim_macro->GetShapeDim( aParent );
+        int pdim = primitives[ii].GetShapeDim( tool->GetMacroValues( ii ) );
         if( dim < pdim )
             dim = pdim;
     }
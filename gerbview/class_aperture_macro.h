@@ -37,6 +37,7 @@
 #include <class_am_param.h>
 
 class SHAPE_POLY_SET;
+struct GBR_AB_TRANSFORM;
 
 /*
  *  An aperture macro defines a complex shape and is a list of aperture primitives.
@@ -112,8 +113,9 @@ public: AM_PRIMITIVE( bool aGerbMetric, AM_PRIMITIVE_ID aId = AMP_UNKNOWN )
      * Others are always ON.
      * In a aperture macro shape, a basic primitive with exposure off is a hole in the shape
      * it is NOT a negative shape
+     * @param aValues = the parameter values, evaluated for the D_CODE using the macro
      */
-    bool  IsAMPrimitiveExposureOn( GERBER_DRAW_ITEM* aParent ) const;
+    bool  IsAMPrimitiveExposureOn( const std::vector<double>& aValues ) const;
 
     /* Draw functions: */
 
@@ -124,20 +126,22 @@ public: AM_PRIMITIVE( bool aGerbMetric, AM_PRIMITIVE_ID aId = AMP_UNKNOWN )
      * one cannot calculate the "size" of a shape (only a bounding box)
      * but here, the "dimension" of the shape is the diameter of the primitive
      * or for lines the width of the line
-     * @param aParent = the parent GERBER_DRAW_ITEM which is actually drawn
+     * @param aValues = the parameter values, evaluated for the D_CODE using the macro
      * @return a dimension, or -1 if no dim to calculate
      */
-    int  GetShapeDim( GERBER_DRAW_ITEM* aParent );
+    int  GetShapeDim( const std::vector<double>& aValues ) const;
 
     /**
      * Function drawBasicShape
      * Draw (in fact generate the actual polygonal shape of) the primitive shape of an aperture macro instance.
-     * @param aParent = the parent GERBER_DRAW_ITEM which is actually drawn
+     * The shape is built in AB axis, for a flash at ( 0, 0 ).  As for a flash drawn at
+     * its position, circles are not scaled: only their center is transformed.
+     * @param aValues = the parameter values, evaluated for the D_CODE using the macro
+     * @param aTransform = the XY to AB transform of the flashed item, without offsets
      * @param aShapeBuffer = a SHAPE_POLY_SET to put the shape converted to a polygon
-     * @param aShapePos = the actual shape position
      */
-    void DrawBasicShape( GERBER_DRAW_ITEM* aParent, SHAPE_POLY_SET& aShapeBuffer,
-                         wxPoint aShapePos );
+    void DrawBasicShape( const std::vector<double>& aValues, const GBR_AB_TRANSFORM& aTransform,
+                         SHAPE_POLY_SET& aShapeBuffer );
 private:
 
     /**
@@ -147,7 +151,7 @@ private:
      * Useful when a shape is not a graphic primitive (shape with hole,
      * rotated shape ... ) and cannot be easily drawn.
      */
-    void ConvertShapeToPolygon( GERBER_DRAW_ITEM* aParent, std::vector<wxPoint>& aBuffer );
+    void ConvertShapeToPolygon( const std::vector<double>& aValues, std::vector<wxPoint>& aBuffer );
 };
 
 
@@ -183,6 +187,15 @@ struct APERTURE_MACRO
      */
     double GetLocalParam( const D_CODE* aDcode, unsigned aParamId ) const;
 
+    /**
+     * Function ConvertShapeToPolygon
+     * builds the whole shape of the macro, in AB axis and for a flash at ( 0, 0 ),
+     * holes included: when the shape has holes, its polygons are fractured.
+     * @param aParent = the parent GERBER_DRAW_ITEM, which gives the D_CODE customizing the macro
+     * @param aShapeBuffer = a SHAPE_POLY_SET to put the shape converted to polygons
+     */
+    void ConvertShapeToPolygon( GERBER_DRAW_ITEM* aParent, SHAPE_POLY_SET& aShapeBuffer );
+
    /**
      * Function DrawApertureMacroShape
      * Draw the primitive shape for flashed items.
@@ -114,6 +114,20 @@ wxPoint GERBER_DRAW_ITEM::GetABPosition( const wxPoint& aXYPosition ) const
 }
 
 
+GBR_AB_TRANSFORM GERBER_DRAW_ITEM::GetABTransform() const
+{
+    GBR_AB_TRANSFORM transform;
+
+    transform.m_swapAxis = m_swapAxis;
+    transform.m_mirrorA  = m_mirrorA;
+    transform.m_mirrorB  = m_mirrorB;
+    transform.m_scale    = m_drawScale;
+    transform.m_rotation = m_lyrRotation * 10 + m_GerberImageFile->m_ImageRotation * 10;
+
+    return transform;
+}
+
+
 wxPoint GERBER_DRAW_ITEM::GetXYPosition( const wxPoint& aABPosition ) const
 {
     // do the inverse transform made by GetABPosition
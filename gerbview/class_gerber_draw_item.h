@@ -186,6 +186,13 @@ public:
      */
     wxPoint GetABPosition( const wxPoint& aXYPosition ) const;
 
+    /**
+     * Function GetABTransform
+     * returns the linear part of the transform used by GetABPosition() (axis swap,
+     * scale, rotation and mirroring), i.e. without the offsets.
+     */
+    GBR_AB_TRANSFORM GetABTransform() const;
+
     /**
      * Function GetXYPosition
      * returns the image position of aPosition for this object.
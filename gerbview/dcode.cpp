@@ -88,6 +88,7 @@ void D_CODE::Clear_D_CODE_Data()
     m_Rotation   = 0.0;
     m_EdgesCount = 0;
     m_PolyCorners.clear();
+    clearMacroCache();
 }
 
 
@@ -119,6 +120,57 @@ const wxChar* D_CODE::ShowApertureType( APERTURE_T aType )
     return ret;
 }
 
+const std::vector<double>& D_CODE::GetMacroValues( unsigned aPrimitive )
+{
+    if( !m_macroValuesValid )
+    {
+        m_macroValues.clear();
+
+        if( m_Macro )
+        {
+            const AM_PRIMITIVES& primitives = m_Macro->primitives;
+            m_macroValues.resize( primitives.size() );
+
+            for( unsigned ii = 0; ii < primitives.size(); ii++ )
+            {
+                const AM_PARAMS& params = primitives[ii].params;
+                m_macroValues[ii].reserve( params.size() );
+
+                for( unsigned jj = 0; jj < params.size(); jj++ )
+                    m_macroValues[ii].push_back( params[jj].GetValue( this ) );
+            }
+        }
+
+        m_macroValuesValid = true;
+    }
+
+    wxASSERT( aPrimitive < m_macroValues.size() );
+
+    return m_macroValues[aPrimitive];
+}
+
+
+const SHAPE_POLY_SET& D_CODE::GetMacroShape( GERBER_DRAW_ITEM* aParent )
+{
+    GBR_AB_TRANSFORM transform = aParent->GetABTransform();
+
+    for( unsigned ii = 0; ii < m_macroShapes.size(); ii++ )
+    {
+        if( m_macroShapes[ii].m_transform == transform )
+            return m_macroShapes[ii].m_shape;
+    }
+
+    m_macroShapes.push_back( MACRO_SHAPE() );
+    MACRO_SHAPE& cached = m_macroShapes.back();
+    cached.m_transform = transform;
+
+    if( m_Macro )
+        m_Macro->ConvertShapeToPolygon( aParent, cached.m_shape );
+
+    return cached.m_shape;
+}
+
+
 int D_CODE::GetShapeDim( GERBER_DRAW_ITEM* aParent )
 {
     int dim = -1;
@@ -287,6 +339,29 @@ void D_CODE::DrawFlashedPolygon( GERBER_DRAW_ITEM* aParent,
 }
 
 
+wxPoint GBR_AB_TRANSFORM::Apply( const wxPoint& aXYVector ) const
+{
+    wxPoint abPos = aXYVector;
+
+    if( m_swapAxis )
+        std::swap( abPos.x, abPos.y );
+
+    abPos.x = KiROUND( abPos.x * m_scale.x );
+    abPos.y = KiROUND( abPos.y * m_scale.y );
+
+    if( m_rotation )
+        RotatePoint( &abPos, -m_rotation );
+
+    if( m_mirrorA )
+        abPos.x = -abPos.x;
+
+    if( !m_mirrorB )
+        abPos.y = -abPos.y;
+
+    return abPos;
+}
+
+
 #define SEGS_CNT 32     // number of segments to approximate a circle
 
 
@@ -33,6 +33,7 @@
 #include <vector>
 
 #include <base_struct.h>
+#include <geometry/shape_poly_set.h>
 
 
 class GERBER_DRAW_ITEM;
@@ -71,6 +72,37 @@ enum APERTURE_DEF_HOLETYPE {
 struct APERTURE_MACRO;
 
 
+/**
+ * Struct GBR_AB_TRANSFORM
+ * is the linear part of the XY to AB transform of a GERBER_DRAW_ITEM: axis swap,
+ * scale, rotation and mirroring, without the offsets.  A flashed shape built in
+ * AB axis around ( 0, 0 ) for a given transform is the same for all the items
+ * sharing this transform, and only needs to be translated to each flash position.
+ */
+struct GBR_AB_TRANSFORM
+{
+    bool        m_swapAxis;
+    bool        m_mirrorA;
+    bool        m_mirrorB;
+    wxRealPoint m_scale;
+    double      m_rotation;         ///< in 0.1 degrees
+
+    bool operator==( const GBR_AB_TRANSFORM& aOther ) const
+    {
+        return m_swapAxis == aOther.m_swapAxis && m_mirrorA == aOther.m_mirrorA
+               && m_mirrorB == aOther.m_mirrorB && m_scale == aOther.m_scale
+               && m_rotation == aOther.m_rotation;
+    }
+
+    /**
+     * Function Apply
+     * @return the image of \a aXYVector, following the same steps as
+     * GERBER_DRAW_ITEM::GetABPosition()
+     */
+    wxPoint Apply( const wxPoint& aXYVector ) const;
+};
+
+
 /**
  * Class D_CODE
  * holds a gerber DCODE (also called Aperture) definition.
@@ -91,6 +123,23 @@ private:
                                              * (shapes with hole )
                                              */
 
+    /**
+     * The parameters of the primitives of m_Macro, evaluated for this D_CODE:
+     * m_macroValues[ii][jj] is the value of the parameter jj of the primitive ii.
+     * The macro expressions are only evaluated once, when first needed.
+     */
+    std::vector< std::vector<double> > m_macroValues;
+    bool                  m_macroValuesValid;
+
+    /// APT_MACRO shapes already built, in AB axis, one per transform of the flashes
+    struct MACRO_SHAPE
+    {
+        GBR_AB_TRANSFORM  m_transform;
+        SHAPE_POLY_SET    m_shape;
+    };
+
+    std::vector<MACRO_SHAPE> m_macroShapes;
+
 public:
     wxSize                m_Size;           ///< Horizontal and vertical dimensions.
     APERTURE_T            m_Shape;          ///< shape ( Line, rectangle, circle , oval .. )
@@ -120,6 +169,7 @@ public:
     void AppendParam( double aValue )
     {
         m_am_params.push_back( aValue );
+        clearMacroCache();
     }
 
     /**
@@ -149,11 +199,29 @@ public:
     void SetMacro( APERTURE_MACRO* aMacro )
     {
         m_Macro = aMacro;
+        clearMacroCache();
     }
 
 
     APERTURE_MACRO* GetMacro() const { return m_Macro; }
 
+    /**
+     * Function GetMacroValues
+     * returns the values of the parameters of a primitive of the aperture macro,
+     * customized by this D_CODE.
+     * @param aPrimitive = index of the primitive in the macro primitive list
+     */
+    const std::vector<double>& GetMacroValues( unsigned aPrimitive );
+
+    /**
+     * Function GetMacroShape
+     * returns the shape of an APT_MACRO aperture flashed by \a aParent, as polygons
+     * in AB axis, for a flash at ( 0, 0 ).  The shape is built once for all the
+     * flashes sharing the same AB transform.
+     * @param aParent = the GERBER_DRAW_ITEM being drawn
+     */
+    const SHAPE_POLY_SET& GetMacroShape( GERBER_DRAW_ITEM* aParent );
+
     /**
      * Function ShowApertureType
      * returns a character string telling what type of aperture type \a aType is.
@@ -214,6 +282,14 @@ public:
      * @return a dimension, or -1 if no dim to calculate
      */
     int GetShapeDim( GERBER_DRAW_ITEM* aParent );
+
+private:
+    void clearMacroCache()
+    {
+        m_macroValues.clear();
+        m_macroValuesValid = false;
+        m_macroShapes.clear();
+    }
 };
 
 
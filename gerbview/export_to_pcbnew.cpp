@@ -27,13 +27,20 @@
  * @brief Export the layers to Pcbnew.
  */
 
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <tuple>
+#include <unordered_set>
 #include <vector>
 
 #include <fctsys.h>
 #include <common.h>
 #include <confirm.h>
 #include <macros.h>
+#include <richio.h>
 #include <trigo.h>
+#include <geometry/shape_poly_set.h>
 #include <gerbview.h>
 #include <gerbview_frame.h>
 #include <class_gerber_file_image.h>
@@ -48,6 +55,31 @@ extern const wxString GetPCBDefaultLayerName( LAYER_NUM aLayerNumber );
 
 #define TO_PCB_UNIT( x ) ( x / IU_PER_MM)
 
+
+/// A straight line to export, in board coordinates (Y axis reversed)
+struct EXPORT_SEGMENT
+{
+    wxPoint m_start;
+    wxPoint m_end;
+    int     m_width;
+};
+
+
+/// A chain of connected lines of the same width, in board coordinates
+struct EXPORT_POLYLINE
+{
+    std::vector<wxPoint> m_points;
+    int                  m_width;
+};
+
+
+/// @return a key identifying the position \a aPos
+static uint64_t pointKey( const wxPoint& aPos )
+{
+    return ( (uint64_t) (uint32_t) aPos.x << 32 ) | (uint32_t) aPos.y;
+}
+
+
 /* A helper class to export a Gerber set of files to Pcbnew
  */
 class GBR_TO_PCB_EXPORTER
@@ -55,11 +87,16 @@ class GBR_TO_PCB_EXPORTER
 private:
     GERBVIEW_FRAME*         m_gerbview_frame;   // the main gerber frame
     wxString                m_pcb_file_name;    // BOARD file to write to
-    FILE*                   m_fp;               // the board file
+    OUTPUTFORMATTER*        m_out;              // the board file
     int                     m_pcbCopperLayersCount;
-    std::vector<wxPoint>    m_vias_coordinates; // list of already generated vias,
+    bool                    m_mergeItems;       // true to merge lines, regions and flashes
+    std::unordered_set<uint64_t> m_vias_coordinates;    // already generated vias,
                                                 // used to export only once a via
                                                 // having a given coordinate
+    std::set< std::tuple<int, int, int, int, int, int> > m_pads;  // already generated pads
+                                                // (merged mode): layer, shape, position, size
+    std::vector<std::string> m_layerNames;      // the Pcbnew names of the layers
+
 public:
     GBR_TO_PCB_EXPORTER( GERBVIEW_FRAME* aFrame, const wxString& aFileName );
     ~GBR_TO_PCB_EXPORTER();
@@ -67,10 +104,54 @@ public:
     /**
      * Function ExportPcb
      * saves a board from a set of Gerber images.
+     * @param aLayerLookUpTable = the Pcbnew layer of each Gerber layer
+     * @param aCopperLayers = the number of copper layers of the board
+     * @param aMergeItems = false to export one board item per Gerber item,
+     *  true to merge the connected lines of a same width, to convert the regions
+     *  to zones and to export only once identical flashes, as pads or vias.
+     *  The board file is much smaller, and faster to load in Pcbnew.
      */
-    bool    ExportPcb( LAYER_NUM* aLayerLookUpTable, int aCopperLayers );
+    bool    ExportPcb( LAYER_NUM* aLayerLookUpTable, int aCopperLayers,
+                       bool aMergeItems = false );
 
 private:
+    /**
+     * Function export_layer_merged
+     * write the items of a Gerber layer to the board file, in merged mode.
+     * @param aGerber = the Gerber image to export
+     * @param aLayer = the Pcbnew layer to use
+     */
+    void    export_layer_merged( GERBER_FILE_IMAGE* aGerber, LAYER_NUM aLayer );
+
+    /**
+     * Function export_flashed_pad
+     * write a SMD pad, in a footprint of its own, from a rectangular or oval
+     * flashed item on an external copper layer.  A given pad is written only once.
+     */
+    void    export_flashed_pad( GERBER_DRAW_ITEM* aGbrItem, LAYER_NUM aLayer );
+
+    /**
+     * Function writeRegions
+     * write the merged regions of a layer: as filled zones on copper layers,
+     * as graphic polygons on technical layers.
+     * @param aRegions = the regions, in board coordinates
+     */
+    void    writeRegions( SHAPE_POLY_SET& aRegions, LAYER_NUM aLayer );
+
+    /**
+     * Function writePolyline
+     * write a polyline as one segment per pair of consecutive points: tracks on
+     * copper layers, graphic lines on technical layers.  The board file has no
+     * polyline item, the gain of the merged mode is in the dropped points.
+     */
+    void    writePolyline( EXPORT_POLYLINE& aPolyline, LAYER_NUM aLayer );
+
+    /// @return the Pcbnew name of \a aLayer
+    const char* layerName( LAYER_NUM aLayer ) const
+    {
+        return m_layerNames[aLayer].c_str();
+    }
+
     /**
      * Function export_non_copper_item
      * write a non copper line or arc to the board file.
@@ -139,8 +220,12 @@ GBR_TO_PCB_EXPORTER::GBR_TO_PCB_EXPORTER( GERBVIEW_FRAME* aFrame, const wxString
 {
     m_gerbview_frame    = aFrame;
     m_pcb_file_name     = aFileName;
-    m_fp                = NULL;
+    m_out               = NULL;
     m_pcbCopperLayersCount = 2;
+    m_mergeItems        = false;
+
+    for( int ii = 0; ii < LAYER_ID_COUNT; ii++ )
+        m_layerNames.push_back( TO_UTF8( GetPCBDefaultLayerName( ii ) ) );
 }
 
 
@@ -195,79 +280,102 @@ void GERBVIEW_FRAME::ExportDataInPcbnewFormat( wxCommandEvent& event )
 
     m_mruPath = wxFileName( fileName ).GetPath();
 
+    bool merge = IsOK( this, _( "Merge the connected lines, the regions and the identical flashes?\n"
+                                "The board is much smaller and faster to load, "
+                                "but contains less items than the Gerber files." ) );
+
     GBR_TO_PCB_EXPORTER gbr_exporter( this, fileName );
 
-    gbr_exporter.ExportPcb( layerdlg->GetLayersLookUpTable(), layerdlg->GetCopperLayersCount() );
+    gbr_exporter.ExportPcb( layerdlg->GetLayersLookUpTable(), layerdlg->GetCopperLayersCount(),
+                            merge );
 }
 
 
-bool GBR_TO_PCB_EXPORTER::ExportPcb( LAYER_NUM* aLayerLookUpTable, int aCopperLayers )
+bool GBR_TO_PCB_EXPORTER::ExportPcb( LAYER_NUM* aLayerLookUpTable, int aCopperLayers,
+                                     bool aMergeItems )
 {
     LOCALE_IO   toggle;     // toggles on, then off, the C locale.
 
-    m_fp = wxFopen( m_pcb_file_name, wxT( "wt" ) );
+    m_pcbCopperLayersCount = aCopperLayers;
+    m_mergeItems = aMergeItems;
+    m_vias_coordinates.clear();
+    m_pads.clear();
 
-    if( m_fp == NULL )
+    try
     {
-        wxString msg;
-        msg.Printf( _( "Cannot create file '%s'" ), GetChars( m_pcb_file_name ) );
-        DisplayError( m_gerbview_frame, msg );
-        return false;
-    }
+        // The formatter buffers the output, instead of one system write per item
+        FILE_OUTPUTFORMATTER formatter( m_pcb_file_name );
+        m_out = &formatter;
 
-    m_pcbCopperLayersCount = aCopperLayers;
+        writePcbHeader( aLayerLookUpTable );
 
-    writePcbHeader( aLayerLookUpTable );
+        // create an image of gerber data
+        // First: non copper layers:
+        const int pcbCopperLayerMax = 31;
+        GERBER_FILE_IMAGE_LIST* images = m_gerbview_frame->GetGerberLayout()->GetImagesList();
 
-    // create an image of gerber data
-    // First: non copper layers:
-    const int pcbCopperLayerMax = 31;
-    GERBER_FILE_IMAGE_LIST* images = m_gerbview_frame->GetGerberLayout()->GetImagesList();
+        for( unsigned layer = 0; layer < images->ImagesMaxCount(); ++layer )
+        {
+            GERBER_FILE_IMAGE* gerber = images->GetGbrImage( layer );
 
-    for( unsigned layer = 0; layer < images->ImagesMaxCount(); ++layer )
-    {
-        GERBER_FILE_IMAGE* gerber = images->GetGbrImage( layer );
+            if( gerber == NULL )    // Graphic layer not yet used
+                continue;
 
-        if( gerber == NULL )    // Graphic layer not yet used
-            continue;
+            LAYER_NUM pcb_layer_number = aLayerLookUpTable[layer];
 
-        LAYER_NUM pcb_layer_number = aLayerLookUpTable[layer];
+            if( !IsPcbLayer( pcb_layer_number ) )
+                continue;
 
-        if( !IsPcbLayer( pcb_layer_number ) )
-            continue;
+            if( pcb_layer_number <= pcbCopperLayerMax ) // copper layer
+                continue;
 
-        if( pcb_layer_number <= pcbCopperLayerMax ) // copper layer
-            continue;
+            if( m_mergeItems )
+            {
+                export_layer_merged( gerber, pcb_layer_number );
+                continue;
+            }
 
-        GERBER_DRAW_ITEM* gerb_item = gerber->GetItemsList();
+            GERBER_DRAW_ITEM* gerb_item = gerber->GetItemsList();
 
-        for( ; gerb_item; gerb_item = gerb_item->Next() )
-            export_non_copper_item( gerb_item, pcb_layer_number );
-    }
+            for( ; gerb_item; gerb_item = gerb_item->Next() )
+                export_non_copper_item( gerb_item, pcb_layer_number );
+        }
 
-    // Copper layers
-    for( unsigned layer = 0; layer < images->ImagesMaxCount(); ++layer )
-    {
-        GERBER_FILE_IMAGE* gerber = images->GetGbrImage( layer );
+        // Copper layers
+        for( unsigned layer = 0; layer < images->ImagesMaxCount(); ++layer )
+        {
+            GERBER_FILE_IMAGE* gerber = images->GetGbrImage( layer );
 
-        if( gerber == NULL )    // Graphic layer not yet used
-            continue;
+            if( gerber == NULL )    // Graphic layer not yet used
+                continue;
 
-        LAYER_NUM pcb_layer_number = aLayerLookUpTable[layer];
+            LAYER_NUM pcb_layer_number = aLayerLookUpTable[layer];
 
-        if( pcb_layer_number < 0 || pcb_layer_number > pcbCopperLayerMax )
-            continue;
+            if( pcb_layer_number < 0 || pcb_layer_number > pcbCopperLayerMax )
+                continue;
 
-        GERBER_DRAW_ITEM* gerb_item = gerber->GetItemsList();
+            if( m_mergeItems )
+            {
+                export_layer_merged( gerber, pcb_layer_number );
+                continue;
+            }
 
-        for( ; gerb_item; gerb_item = gerb_item->Next() )
-            export_copper_item( gerb_item, pcb_layer_number );
-    }
+            GERBER_DRAW_ITEM* gerb_item = gerber->GetItemsList();
+
+            for( ; gerb_item; gerb_item = gerb_item->Next() )
+                export_copper_item( gerb_item, pcb_layer_number );
+        }
 
-    fprintf( m_fp, ")\n" );
+        m_out->Print( 0, ")\n" );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        m_out = NULL;
+        DisplayError( m_gerbview_frame, ioe.What() );
+        return false;
+    }
 
-    fclose( m_fp );
-    m_fp = NULL;
+    m_out = NULL;
     return true;
 }
 
@@ -343,17 +451,21 @@ void GBR_TO_PCB_EXPORTER::export_segline_copper_item( GERBER_DRAW_ITEM* aGbrItem
 void GBR_TO_PCB_EXPORTER::writeCopperLineItem( wxPoint& aStart, wxPoint& aEnd,
                                                int aWidth, LAYER_NUM aLayer )
 {
-  fprintf( m_fp, "(segment (start %s %s) (end %s %s) (width %s) (layer %s) (net 0))\n",
+    m_out->Print( 0, "(segment (start %s %s) (end %s %s) (width %s) (layer %s) (net 0))\n",
                   Double2Str( TO_PCB_UNIT(aStart.x) ).c_str(),
                   Double2Str( TO_PCB_UNIT(aStart.y) ).c_str(),
                   Double2Str( TO_PCB_UNIT(aEnd.x) ).c_str(),
                   Double2Str( TO_PCB_UNIT(aEnd.y) ).c_str(),
                   Double2Str( TO_PCB_UNIT( aWidth ) ).c_str(),
-                  TO_UTF8( GetPCBDefaultLayerName( aLayer ) ) );
+                  layerName( aLayer ) );
 }
 
 
-void GBR_TO_PCB_EXPORTER::export_segarc_copper_item( GERBER_DRAW_ITEM* aGbrItem, LAYER_NUM aLayer )
+/*
+ * Pcbnew does not know arcs in tracks: approximate the arc of aGbrItem by segments,
+ * and append the ends of these segments to aPoints, in board coordinates.
+ */
+static void arcToPolyline( GERBER_DRAW_ITEM* aGbrItem, std::vector<wxPoint>& aPoints )
 {
     double  a = atan2( (double) ( aGbrItem->m_Start.y - aGbrItem->m_ArcCentre.y ),
                        (double) ( aGbrItem->m_Start.x - aGbrItem->m_ArcCentre.x ) );
@@ -363,8 +475,7 @@ void GBR_TO_PCB_EXPORTER::export_segarc_copper_item( GERBER_DRAW_ITEM* aGbrItem,
     wxPoint start   = aGbrItem->m_Start;
     wxPoint end     = aGbrItem->m_End;
 
-    /* Because Pcbnew does not know arcs in tracks,
-     * approximate arc by segments (SEG_COUNT__CIRCLE segment per 360 deg)
+    /* Approximate arc by segments (SEG_COUNT__CIRCLE segment per 360 deg)
      * The arc is drawn anticlockwise from the start point to the end point.
      */
     #define SEG_COUNT_CIRCLE    16
@@ -376,33 +487,34 @@ void GBR_TO_PCB_EXPORTER::export_segarc_copper_item( GERBER_DRAW_ITEM* aGbrItem,
         b += 2 * M_PI;
 
     wxPoint curr_start = start;
-    wxPoint seg_start, seg_end;
+
+    // Reverse Y axis:
+    aPoints.push_back( wxPoint( start.x, -start.y ) );
 
     int     ii = 1;
 
     for( double rot = a; rot < (b - DELTA_ANGLE); rot += DELTA_ANGLE, ii++ )
     {
-        seg_start = curr_start;
         wxPoint curr_end = start;
         RotatePoint( &curr_end, aGbrItem->m_ArcCentre,
                      -RAD2DECIDEG( DELTA_ANGLE * ii ) );
-        seg_end = curr_end;
-        // Reverse Y axis:
-        seg_start.y = -seg_start.y;
-        seg_end.y = -seg_end.y;
-        writeCopperLineItem( seg_start, seg_end, aGbrItem->m_Size.x, aLayer );
+        aPoints.push_back( wxPoint( curr_end.x, -curr_end.y ) );
         curr_start = curr_end;
     }
 
     if( end != curr_start )
-    {
-        seg_start   = curr_start;
-        seg_end     = end;
-        // Reverse Y axis:
-        seg_start.y = -seg_start.y;
-        seg_end.y = -seg_end.y;
-        writeCopperLineItem( seg_start, seg_end, aGbrItem->m_Size.x, aLayer );
-    }
+        aPoints.push_back( wxPoint( end.x, -end.y ) );
+}
+
+
+void GBR_TO_PCB_EXPORTER::export_segarc_copper_item( GERBER_DRAW_ITEM* aGbrItem, LAYER_NUM aLayer )
+{
+    std::vector<wxPoint> points;
+
+    arcToPolyline( aGbrItem, points );
+
+    for( unsigned ii = 1; ii < points.size(); ii++ )
+        writeCopperLineItem( points[ii - 1], points[ii], aGbrItem->m_Size.x, aLayer );
 }
 
 
@@ -414,13 +526,8 @@ void GBR_TO_PCB_EXPORTER::export_segarc_copper_item( GERBER_DRAW_ITEM* aGbrItem,
 void GBR_TO_PCB_EXPORTER::export_flashed_copper_item( GERBER_DRAW_ITEM* aGbrItem )
 {
     // First, explore already created vias, before creating a new via
-    for( unsigned ii = 0; ii < m_vias_coordinates.size(); ii++ )
-    {
-        if( m_vias_coordinates[ii] == aGbrItem->m_Start ) // Already created
-            return;
-    }
-
-    m_vias_coordinates.push_back( aGbrItem->m_Start );
+    if( !m_vias_coordinates.insert( pointKey( aGbrItem->m_Start ) ).second )
+        return;     // Already created
 
     wxPoint via_pos = aGbrItem->m_Start;
     int width   = (aGbrItem->m_Size.x + aGbrItem->m_Size.y) / 2;
@@ -428,23 +535,23 @@ void GBR_TO_PCB_EXPORTER::export_flashed_copper_item( GERBER_DRAW_ITEM* aGbrItem
     via_pos.y = -via_pos.y;
 
     // Layers are Front to Back
-    fprintf( m_fp, " (via (at %s %s) (size %s)",
+    m_out->Print( 0, " (via (at %s %s) (size %s)",
                   Double2Str( TO_PCB_UNIT(via_pos.x) ).c_str(),
                   Double2Str( TO_PCB_UNIT(via_pos.y) ).c_str(),
                   Double2Str( TO_PCB_UNIT( width ) ).c_str() );
 
-    fprintf( m_fp, " (layers %s %s))\n",
-                  TO_UTF8( GetPCBDefaultLayerName( F_Cu ) ),
-                  TO_UTF8( GetPCBDefaultLayerName( B_Cu ) ) );
+    m_out->Print( 0, " (layers %s %s))\n",
+                  layerName( F_Cu ),
+                  layerName( B_Cu ) );
 }
 
 void GBR_TO_PCB_EXPORTER::writePcbHeader( LAYER_NUM* aLayerLookUpTable )
 {
-    fprintf( m_fp, "(kicad_pcb (version 4) (host Gerbview \"%s\")\n\n",
-             TO_UTF8( GetBuildVersion() ) );
+    m_out->Print( 0, "(kicad_pcb (version 4) (host Gerbview \"%s\")\n\n",
+                  TO_UTF8( GetBuildVersion() ) );
 
     // Write layers section
-    fprintf( m_fp, "  (layers \n" );
+    m_out->Print( 0, "  (layers \n" );
 
     for( int ii = 0; ii < m_pcbCopperLayersCount; ii++ )
     {
@@ -453,15 +560,15 @@ void GBR_TO_PCB_EXPORTER::writePcbHeader( LAYER_NUM* aLayerLookUpTable )
         if( ii == m_pcbCopperLayersCount-1)
             id = B_Cu;
 
-        fprintf( m_fp, "    (%d %s signal)\n", id, TO_UTF8( GetPCBDefaultLayerName( id ) ) );
+        m_out->Print( 0, "    (%d %s signal)\n", id, layerName( id ) );
     }
 
     for( int ii = B_Adhes; ii < LAYER_ID_COUNT; ii++ )
     {
-        fprintf( m_fp, "    (%d %s user)\n", ii, TO_UTF8( GetPCBDefaultLayerName( ii ) ) );
+        m_out->Print( 0, "    (%d %s user)\n", ii, layerName( ii ) );
     }
 
-    fprintf( m_fp, "  )\n\n" );
+    m_out->Print( 0, "  )\n\n" );
 }
 
 
@@ -470,36 +577,399 @@ void GBR_TO_PCB_EXPORTER::writePcbLineItem( bool aIsArc, wxPoint& aStart, wxPoin
 {
     if( aIsArc && ( aAngle == 360.0 ||  aAngle == 0 ) )
     {
-        fprintf( m_fp, "(gr_circle (center %s %s) (end %s %s)(layer %s) (width %s))\n",
-                 Double2Str( TO_PCB_UNIT(aStart.x) ).c_str(),
-                 Double2Str( TO_PCB_UNIT(aStart.y) ).c_str(),
-                 Double2Str( TO_PCB_UNIT(aEnd.x) ).c_str(),
-                 Double2Str( TO_PCB_UNIT(aEnd.y) ).c_str(),
-                 TO_UTF8( GetPCBDefaultLayerName( aLayer ) ),
-                 Double2Str( TO_PCB_UNIT( aWidth ) ).c_str()
-                 );
+        m_out->Print( 0, "(gr_circle (center %s %s) (end %s %s)(layer %s) (width %s))\n",
+                      Double2Str( TO_PCB_UNIT(aStart.x) ).c_str(),
+                      Double2Str( TO_PCB_UNIT(aStart.y) ).c_str(),
+                      Double2Str( TO_PCB_UNIT(aEnd.x) ).c_str(),
+                      Double2Str( TO_PCB_UNIT(aEnd.y) ).c_str(),
+                      layerName( aLayer ),
+                      Double2Str( TO_PCB_UNIT( aWidth ) ).c_str()
+                      );
     }
     else if( aIsArc )
     {
-        fprintf( m_fp, "(gr_arc (start %s %s) (end %s %s) (angle %s)(layer %s) (width %s))\n",
-                 Double2Str( TO_PCB_UNIT(aStart.x) ).c_str(),
-                 Double2Str( TO_PCB_UNIT(aStart.y) ).c_str(),
-                 Double2Str( TO_PCB_UNIT(aEnd.x) ).c_str(),
-                 Double2Str( TO_PCB_UNIT(aEnd.y) ).c_str(),
-                 Double2Str( aAngle ).c_str(),
-                 TO_UTF8( GetPCBDefaultLayerName( aLayer ) ),
-                 Double2Str( TO_PCB_UNIT( aWidth ) ).c_str()
-                 );
+        m_out->Print( 0, "(gr_arc (start %s %s) (end %s %s) (angle %s)(layer %s) (width %s))\n",
+                      Double2Str( TO_PCB_UNIT(aStart.x) ).c_str(),
+                      Double2Str( TO_PCB_UNIT(aStart.y) ).c_str(),
+                      Double2Str( TO_PCB_UNIT(aEnd.x) ).c_str(),
+                      Double2Str( TO_PCB_UNIT(aEnd.y) ).c_str(),
+                      Double2Str( aAngle ).c_str(),
+                      layerName( aLayer ),
+                      Double2Str( TO_PCB_UNIT( aWidth ) ).c_str()
+                      );
     }
     else
     {
-        fprintf( m_fp, "(gr_line (start %s %s) (end %s %s)(layer %s) (width %s))\n",
-                 Double2Str( TO_PCB_UNIT(aStart.x) ).c_str(),
-                 Double2Str( TO_PCB_UNIT(aStart.y) ).c_str(),
-                 Double2Str( TO_PCB_UNIT(aEnd.x) ).c_str(),
-                 Double2Str( TO_PCB_UNIT(aEnd.y) ).c_str(),
-                 TO_UTF8( GetPCBDefaultLayerName( aLayer ) ),
-                 Double2Str( TO_PCB_UNIT( aWidth ) ).c_str()
-                 );
+        m_out->Print( 0, "(gr_line (start %s %s) (end %s %s)(layer %s) (width %s))\n",
+                      Double2Str( TO_PCB_UNIT(aStart.x) ).c_str(),
+                      Double2Str( TO_PCB_UNIT(aStart.y) ).c_str(),
+                      Double2Str( TO_PCB_UNIT(aEnd.x) ).c_str(),
+                      Double2Str( TO_PCB_UNIT(aEnd.y) ).c_str(),
+                      layerName( aLayer ),
+                      Double2Str( TO_PCB_UNIT( aWidth ) ).c_str()
+                      );
+    }
+}
+
+
+/*
+ * Remove the points in the middle of the straight runs of a polyline
+ */
+static void removeCollinearPoints( std::vector<wxPoint>& aPoints )
+{
+    if( aPoints.size() < 3 )
+        return;
+
+    unsigned count = 1;
+
+    for( unsigned ii = 1; ii + 1 < aPoints.size(); ii++ )
+    {
+        const wxPoint& prev = aPoints[count - 1];
+        const wxPoint& curr = aPoints[ii];
+        const wxPoint& next = aPoints[ii + 1];
+
+        int64_t dx1 = curr.x - prev.x;
+        int64_t dy1 = curr.y - prev.y;
+        int64_t dx2 = next.x - curr.x;
+        int64_t dy2 = next.y - curr.y;
+
+        // Same direction: curr is useless
+        if( dx1 * dy2 == dy1 * dx2 && dx1 * dx2 + dy1 * dy2 > 0 )
+            continue;
+
+        aPoints[count++] = curr;
+    }
+
+    aPoints[count++] = aPoints.back();
+    aPoints.resize( count );
+}
+
+
+/*
+ * Chain the segments of a same width sharing an end point into polylines.
+ * A polyline only goes through the points joining exactly 2 segments, so that
+ * the lines of a T or a cross stay connected.  Duplicated segments are only
+ * kept once.
+ */
+static void mergeSegments( std::vector<EXPORT_SEGMENT>& aSegments,
+                           std::vector<EXPORT_POLYLINE>& aPolylines )
+{
+    // Give a same orientation to the segments, then sort them by width and position:
+    // duplicated segments are now adjacent
+    for( EXPORT_SEGMENT& seg : aSegments )
+    {
+        if( seg.m_end.x < seg.m_start.x
+            || ( seg.m_end.x == seg.m_start.x && seg.m_end.y < seg.m_start.y ) )
+            std::swap( seg.m_start, seg.m_end );
+    }
+
+    auto lessThan = []( const EXPORT_SEGMENT& a, const EXPORT_SEGMENT& b )
+    {
+        return std::tie( a.m_width, a.m_start.x, a.m_start.y, a.m_end.x, a.m_end.y )
+                < std::tie( b.m_width, b.m_start.x, b.m_start.y, b.m_end.x, b.m_end.y );
+    };
+
+    auto equal = []( const EXPORT_SEGMENT& a, const EXPORT_SEGMENT& b )
+    {
+        return a.m_width == b.m_width && a.m_start == b.m_start && a.m_end == b.m_end;
+    };
+
+    std::sort( aSegments.begin(), aSegments.end(), lessThan );
+    aSegments.erase( std::unique( aSegments.begin(), aSegments.end(), equal ), aSegments.end() );
+
+    // The segment ends, as ( position key, segment index * 2 + end ), sorted by position
+    typedef std::pair<uint64_t, unsigned> SEG_END;
+
+    std::vector<SEG_END> ends;
+    std::vector<bool> used( aSegments.size(), false );
+
+    for( unsigned first = 0; first < aSegments.size(); )
+    {
+        int width = aSegments[first].m_width;
+        unsigned last = first;
+
+        ends.clear();
+
+        for( ; last < aSegments.size() && aSegments[last].m_width == width; last++ )
+        {
+            const EXPORT_SEGMENT& seg = aSegments[last];
+
+            // Dots (null length lines) are not chained to anything
+            if( seg.m_start == seg.m_end )
+            {
+                EXPORT_POLYLINE dot;
+                dot.m_width = width;
+                dot.m_points.push_back( seg.m_start );
+                dot.m_points.push_back( seg.m_end );
+                aPolylines.push_back( dot );
+                used[last] = true;
+                continue;
+            }
+
+            ends.push_back( SEG_END( pointKey( seg.m_start ), last * 2 ) );
+            ends.push_back( SEG_END( pointKey( seg.m_end ), last * 2 + 1 ) );
+        }
+
+        std::sort( ends.begin(), ends.end() );
+
+        auto endPoint = [&]( unsigned aEnd ) -> const wxPoint&
+        {
+            const EXPORT_SEGMENT& seg = aSegments[aEnd / 2];
+            return ( aEnd & 1 ) ? seg.m_end : seg.m_start;
+        };
+
+        auto endsAt = [&]( const wxPoint& aPos )
+        {
+            return std::equal_range( ends.begin(), ends.end(), SEG_END( pointKey( aPos ), 0 ),
+                                     []( const SEG_END& a, const SEG_END& b )
+                                     {
+                                         return a.first < b.first;
+                                     } );
+        };
+
+        // Walk from the end aEnd of a segment, as long as the chain is not forked
+        auto walk = [&]( unsigned aEnd )
+        {
+            EXPORT_POLYLINE polyline;
+            polyline.m_width = width;
+            polyline.m_points.push_back( endPoint( aEnd ) );
+
+            while( true )
+            {
+                unsigned seg = aEnd / 2;
+                used[seg] = true;
+
+                const wxPoint& next = endPoint( aEnd ^ 1 );
+                polyline.m_points.push_back( next );
+
+                auto range = endsAt( next );
+
+                if( range.second - range.first != 2 )
+                    break;
+
+                unsigned other = range.first->second / 2 == seg ? range.first[1].second
+                                                                 : range.first->second;
+
+                if( used[other / 2] )
+                    break;
+
+                aEnd = other;
+            }
+
+            removeCollinearPoints( polyline.m_points );
+            aPolylines.push_back( polyline );
+        };
+
+        // Open chains start from a free end or a fork
+        for( unsigned ii = first; ii < last; ii++ )
+        {
+            if( used[ii] )
+                continue;
+
+            auto range = endsAt( aSegments[ii].m_start );
+
+            if( range.second - range.first != 2 )
+            {
+                walk( ii * 2 );
+                continue;
+            }
+
+            range = endsAt( aSegments[ii].m_end );
+
+            if( range.second - range.first != 2 )
+                walk( ii * 2 + 1 );
+        }
+
+        // What remains are closed loops
+        for( unsigned ii = first; ii < last; ii++ )
+        {
+            if( !used[ii] )
+                walk( ii * 2 );
+        }
+
+        first = last;
+    }
+}
+
+
+void GBR_TO_PCB_EXPORTER::export_layer_merged( GERBER_FILE_IMAGE* aGerber, LAYER_NUM aLayer )
+{
+    bool isCopper = IsCopperLayer( aLayer );
+    std::vector<EXPORT_SEGMENT> segments;
+    SHAPE_POLY_SET regions;
+    std::vector<wxPoint> points;
+
+    for( GERBER_DRAW_ITEM* gerb_item = aGerber->GetItemsList(); gerb_item;
+         gerb_item = gerb_item->Next() )
+    {
+        EXPORT_SEGMENT seg;
+
+        seg.m_start = gerb_item->m_Start;
+        seg.m_end   = gerb_item->m_End;
+        seg.m_width = gerb_item->m_Size.x;
+
+        // Reverse Y axis:
+        seg.m_start.y = -seg.m_start.y;
+        seg.m_end.y   = -seg.m_end.y;
+
+        switch( gerb_item->m_Shape )
+        {
+        case GBR_SEGMENT:
+            segments.push_back( seg );
+            break;
+
+        case GBR_ARC:
+            if( !isCopper )
+            {
+                export_non_copper_item( gerb_item, aLayer );
+                break;
+            }
+
+            points.clear();
+            arcToPolyline( gerb_item, points );
+
+            for( unsigned ii = 1; ii < points.size(); ii++ )
+            {
+                seg.m_start = points[ii - 1];
+                seg.m_end   = points[ii];
+                segments.push_back( seg );
+            }
+
+            break;
+
+        case GBR_POLYGON:
+        {
+            if( gerb_item->m_PolyCorners.size() < 3 )
+                break;
+
+            SHAPE_POLY_SET region;
+            region.NewOutline();
+
+            for( const wxPoint& corner : gerb_item->m_PolyCorners )
+                region.Append( corner.x, -corner.y );
+
+            // A region drawn in negative polarity clears the regions drawn before it
+            if( gerb_item->GetLayerPolarity() )
+                regions.BooleanSubtract( region, SHAPE_POLY_SET::PM_FAST );
+            else
+                regions.Append( region );
+        }
+            break;
+
+        case GBR_SPOT_CIRCLE:
+        case GBR_SPOT_RECT:
+        case GBR_SPOT_OVAL:
+            if( !isCopper )
+                segments.push_back( seg );      // identical flashes are removed by mergeSegments
+            else if( gerb_item->m_Shape != GBR_SPOT_CIRCLE && ( aLayer == F_Cu || aLayer == B_Cu ) )
+                export_flashed_pad( gerb_item, aLayer );
+            else
+                export_flashed_copper_item( gerb_item );
+
+            break;
+
+        default:
+            if( isCopper )
+                export_copper_item( gerb_item, aLayer );
+            else
+                export_non_copper_item( gerb_item, aLayer );
+
+            break;
+        }
+    }
+
+    std::vector<EXPORT_POLYLINE> polylines;
+    mergeSegments( segments, polylines );
+
+    for( EXPORT_POLYLINE& polyline : polylines )
+        writePolyline( polyline, aLayer );
+
+    if( regions.OutlineCount() )
+        writeRegions( regions, aLayer );
+}
+
+
+void GBR_TO_PCB_EXPORTER::export_flashed_pad( GERBER_DRAW_ITEM* aGbrItem, LAYER_NUM aLayer )
+{
+    wxPoint pad_pos = aGbrItem->m_Start;
+    wxSize  size    = aGbrItem->m_Size;
+
+    if( !m_pads.insert( std::make_tuple( aLayer, aGbrItem->m_Shape, pad_pos.x, pad_pos.y,
+                                         size.x, size.y ) ).second )
+        return;     // Already created
+
+    // Reverse Y axis:
+    pad_pos.y = -pad_pos.y;
+
+    m_out->Print( 0, "(module gerber_pad (layer %s) (at %s %s)\n",
+                  layerName( aLayer ),
+                  Double2Str( TO_PCB_UNIT(pad_pos.x) ).c_str(),
+                  Double2Str( TO_PCB_UNIT(pad_pos.y) ).c_str() );
+
+    m_out->Print( 1, "(pad 1 smd %s (at 0 0) (size %s %s) (layers %s))\n",
+                  aGbrItem->m_Shape == GBR_SPOT_RECT ? "rect" : "oval",
+                  Double2Str( TO_PCB_UNIT( size.x ) ).c_str(),
+                  Double2Str( TO_PCB_UNIT( size.y ) ).c_str(),
+                  layerName( aLayer ) );
+
+    m_out->Print( 0, ")\n" );
+}
+
+
+void GBR_TO_PCB_EXPORTER::writePolyline( EXPORT_POLYLINE& aPolyline, LAYER_NUM aLayer )
+{
+    std::vector<wxPoint>& points = aPolyline.m_points;
+
+    for( unsigned ii = 1; ii < points.size(); ii++ )
+    {
+        if( IsCopperLayer( aLayer ) )
+            writeCopperLineItem( points[ii - 1], points[ii], aPolyline.m_width, aLayer );
+        else
+            writePcbLineItem( false, points[ii - 1], points[ii], aPolyline.m_width, aLayer );
+    }
+}
+
+
+void GBR_TO_PCB_EXPORTER::writeRegions( SHAPE_POLY_SET& aRegions, LAYER_NUM aLayer )
+{
+    // Merge the overlapping regions, and link the holes to their outline:
+    // both zones and graphic polygons are single outlines
+    aRegions.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+    for( int ii = 0; ii < aRegions.OutlineCount(); ii++ )
+    {
+        const SHAPE_LINE_CHAIN& outline = aRegions.COutline( ii );
+
+        if( outline.PointCount() < 3 )
+            continue;
+
+        // The same list of corners is used for the zone outline and its filled area
+        std::string pts;
+
+        for( int jj = 0; jj < outline.PointCount(); jj++ )
+        {
+            const VECTOR2I& corner = outline.CPoint( jj );
+
+            pts += " (xy " + Double2Str( TO_PCB_UNIT( corner.x ) ) + " "
+                   + Double2Str( TO_PCB_UNIT( corner.y ) ) + ")";
+        }
+
+        if( IsCopperLayer( aLayer ) )
+        {
+            m_out->Print( 0, "(zone (net 0) (net_name \"\") (layer %s) (tstamp 0) (hatch edge 0.508)\n",
+                          layerName( aLayer ) );
+            m_out->Print( 1, "(connect_pads (clearance 0))\n" );
+            m_out->Print( 1, "(min_thickness 0.0254)\n" );
+            m_out->Print( 1, "(fill yes (arc_segments 16) (thermal_gap 0.508) "
+                             "(thermal_bridge_width 0.508))\n" );
+            m_out->Print( 1, "(polygon (pts%s))\n", pts.c_str() );
+            m_out->Print( 1, "(filled_polygon (pts%s))\n", pts.c_str() );
+            m_out->Print( 0, ")\n" );
+        }
+        else
+        {
+            m_out->Print( 0, "(gr_poly (pts%s) (layer %s) (width 0))\n",
+                          pts.c_str(), layerName( aLayer ) );
+        }
     }
 }
@@ -158,6 +158,8 @@ private:
 };
 
 
-extern BASIC_GAL basic_gal;
+// One instance per thread: the text settings are set for each drawn text, and texts
+// can be plotted from several threads at once.
+extern thread_local BASIC_GAL basic_gal;
 
 #endif      // define BASIC_GAL_H
@@ -95,6 +95,23 @@ struct WXSTRING_HASH : std::unary_function<wxString, std::size_t>
 };
 
 
+/// Hash function for wxPoint, for the maps keyed by a coordinate
+struct WXPOINT_HASH : std::unary_function<wxPoint, std::size_t>
+{
+    std::size_t operator()( const wxPoint& aPoint ) const
+    {
+        std::size_t hash = 2166136261u;
+
+        hash ^= static_cast<unsigned>( aPoint.x );
+        hash *= 16777619;
+        hash ^= static_cast<unsigned>( aPoint.y );
+        hash *= 16777619;
+
+        return hash;
+    }
+};
+
+
 class NETINFO_ITEM;
 
 
@@ -177,6 +177,90 @@ public:
 typedef std::bitset<LAYER_ID_COUNT>     BASE_SET;
 
 
+#ifndef SWIG
+/**
+ * Class LSET_RANGE
+ * walks the LAYER_IDs of a set, in ascending order or in the order of a wish list
+ * sequence, without building an LSEQ.  It is meant for the loops run once per item,
+ * where the allocation of an LSEQ costs more than the loop body:
+ * <code>
+ *
+ *      for( LAYER_ID layer : item->GetLayerSet().CuStackLayers() )
+ *      {
+ *          :
+ *      }
+ *
+ * </code>
+ * The range holds a copy of the set, so it may be taken from a temporary.  The
+ * wish list sequence is not copied and must outlive the range.
+ */
+class LSET_RANGE
+{
+public:
+    class iterator
+    {
+    public:
+        iterator( const LSET_RANGE* aRange, unsigned aPos ) :
+            m_range( aRange ),
+            m_pos( aPos )
+        {
+            skip();
+        }
+
+        LAYER_ID operator*() const      { return m_range->at( m_pos ); }
+
+        iterator& operator++()
+        {
+            ++m_pos;
+            skip();
+            return *this;
+        }
+
+        bool operator==( const iterator& aOther ) const { return m_pos == aOther.m_pos; }
+        bool operator!=( const iterator& aOther ) const { return m_pos != aOther.m_pos; }
+
+    private:
+        /// Moves to the next position holding a layer of the set.
+        void skip()
+        {
+            while( m_pos < m_range->m_count && !m_range->m_set.test( m_range->at( m_pos ) ) )
+                ++m_pos;
+        }
+
+        const LSET_RANGE*   m_range;
+        unsigned            m_pos;
+    };
+
+    /**
+     * Constructor
+     * @param aSet is the set of layers to walk.
+     * @param aSequence is the order of the walk, NULL for the ascending LAYER_ID order.
+     * @param aCount is the length of \a aSequence.
+     */
+    LSET_RANGE( const BASE_SET& aSet, const LAYER_ID* aSequence = NULL,
+                unsigned aCount = LAYER_ID_COUNT ) :
+        m_set( aSet ),
+        m_sequence( aSequence ),
+        m_count( aSequence ? aCount : LAYER_ID_COUNT )
+    {
+    }
+
+    iterator begin() const  { return iterator( this, 0 ); }
+    iterator end() const    { return iterator( this, m_count ); }
+
+private:
+    LAYER_ID at( unsigned aPos ) const
+    {
+        return m_sequence ? m_sequence[aPos] : LAYER_ID( aPos );
+    }
+
+    BASE_SET        m_set;
+    const LAYER_ID* m_sequence;
+    unsigned        m_count;
+};
+#endif
+
+
 /**
  * Class LSET
  * is a set of LAYER_IDs.  It can be converted to numerous purpose LSEQs using
@@ -384,6 +468,44 @@ public:
      */
     LSEQ SeqStackupBottom2Top() const;
 
+#ifndef SWIG
+    /**
+     * Function Layers
+     * is the allocation free counterpart of Seq(), see LSET_RANGE.
+     */
+    LSET_RANGE Layers() const
+    {
+        return LSET_RANGE( *this );
+    }
+
+    /**
+     * Function Layers
+     * is the allocation free counterpart of Seq( aWishListSequence, aCount ), see LSET_RANGE.
+     */
+    LSET_RANGE Layers( const LAYER_ID* aWishListSequence, unsigned aCount ) const
+    {
+        return LSET_RANGE( *this, aWishListSequence, aCount );
+    }
+
+    /**
+     * Function CuStackLayers
+     * is the allocation free counterpart of CuStack(), see LSET_RANGE.
+     */
+    LSET_RANGE CuStackLayers() const;
+
+    /**
+     * Function UIOrderLayers
+     * is the allocation free counterpart of UIOrder(), see LSET_RANGE.
+     */
+    LSET_RANGE UIOrderLayers() const;
+
+    /**
+     * Function StackupBottom2TopLayers
+     * is the allocation free counterpart of SeqStackupBottom2Top(), see LSET_RANGE.
+     */
+    LSET_RANGE StackupBottom2TopLayers() const;
+#endif
+
     /**
      * Function FmtHex
      * returns a hex string showing contents of this LSEQ.
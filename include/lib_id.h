@@ -28,6 +28,7 @@
 
 #include <richio.h>
 #include <utf8.h>
+#include <string_pool.h>
 
 /**
  * Class LIB_ID
@@ -94,7 +95,7 @@ public:
      */
     const UTF8& GetLibNickname() const
     {
-        return nickname;
+        return nickname.GetUTF8();
     }
 
     /**
@@ -113,7 +114,7 @@ public:
      *
      * @return the library item name, i.e. footprintName.
      */
-    const UTF8& GetLibItemName() const { return item_name; }
+    const UTF8& GetLibItemName() const { return item_name.GetUTF8(); }
 
     /**
      * Function SetLibItemName
@@ -162,14 +163,14 @@ public:
      * @note A return value of true does not indicated that the #LIB_ID is a valid #LIB_TABLE
      *       entry.
      */
-    bool IsValid() const { return !nickname.empty() && !item_name.empty(); }
+    bool IsValid() const { return !nickname.IsEmpty() && !item_name.IsEmpty(); }
 
     /**
      * Function IsLegacy
      *
      * @return true if the #LIB_ID only has the #item_name name defined.
      */
-    bool IsLegacy() const { return nickname.empty() && !item_name.empty() && revision.empty(); }
+    bool IsLegacy() const { return nickname.IsEmpty() && !item_name.IsEmpty() && revision.empty(); }
 
     /**
      * Function clear
@@ -183,7 +184,7 @@ public:
      *
      * @return a boolean true value if the LIB_ID is empty.  Otherwise return false.
      */
-    bool empty() const { return nickname.empty() && item_name.empty() && revision.empty(); }
+    bool empty() const { return nickname.IsEmpty() && item_name.IsEmpty() && revision.empty(); }
 
     /**
      * Function Compare
@@ -207,9 +208,11 @@ public:
 #endif
 
 protected:
-    UTF8    nickname;       ///< The nickname of the library or empty.
-    UTF8    item_name;      ///< The name of the entry in the logical library.
-    UTF8    revision;       ///< The revision of the entry.
+    // The nicknames and item names are shared by many items (every footprint of a
+    // board has a LIB_ID), so they are interned.
+    INTERNED_STRING nickname;       ///< The nickname of the library or empty.
+    INTERNED_STRING item_name;      ///< The name of the entry in the logical library.
+    UTF8            revision;       ///< The revision of the entry.
 };
 
 
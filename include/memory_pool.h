@@ -0,0 +1,216 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file memory_pool.h
+ * @brief Arena allocators for the large populations of small board objects.
+ */
+
+#ifndef MEMORY_POOL_H_
+#define MEMORY_POOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+
+/**
+ * Class MEMORY_POOL
+ * hands out blocks of a single size, carved from large chunks.  Freed blocks
+ * go to a free list and are reused before a new chunk is allocated, so objects
+ * created together stay close together in memory and the general purpose heap
+ * is not fragmented by millions of tiny allocations.  The chunks are released
+ * when the last block is freed (e.g. when a board is closed) or when the pool is
+ * destroyed.  See tools/memory_pool_bench.cpp for what this buys to a list walk.
+ */
+class MEMORY_POOL
+{
+public:
+    MEMORY_POOL( size_t aBlockSize, size_t aBlocksPerChunk = 4096 ) :
+        m_blockSize( roundUp( aBlockSize ) ),
+        m_blocksPerChunk( aBlocksPerChunk ),
+        m_freeList( nullptr ),
+        m_used( 0 )
+    {
+    }
+
+    size_t GetBlockSize() const     { return m_blockSize; }
+
+    /// Number of blocks currently handed out.
+    size_t GetUsedCount() const     { return m_used; }
+
+    /// Number of bytes reserved from the system.
+    size_t GetReservedBytes() const { return m_chunks.size() * m_blockSize * m_blocksPerChunk; }
+
+    void* Allocate()
+    {
+        std::lock_guard<std::mutex> lock( m_lock );
+
+        if( !m_freeList )
+            addChunk();
+
+        FREE_BLOCK* block = m_freeList;
+        m_freeList = block->m_next;
+        ++m_used;
+
+        return block;
+    }
+
+    void Free( void* aBlock )
+    {
+        if( !aBlock )
+            return;
+
+        std::lock_guard<std::mutex> lock( m_lock );
+
+        if( --m_used == 0 )
+        {
+            // Nothing is left in the pool, give the memory back.
+            m_freeList = nullptr;
+            m_chunks.clear();
+            return;
+        }
+
+        FREE_BLOCK* block = static_cast<FREE_BLOCK*>( aBlock );
+        block->m_next = m_freeList;
+        m_freeList = block;
+    }
+
+private:
+    struct FREE_BLOCK
+    {
+        FREE_BLOCK* m_next;
+    };
+
+    static size_t roundUp( size_t aSize )
+    {
+        const size_t align = alignof( std::max_align_t );
+
+        if( aSize < sizeof( FREE_BLOCK ) )
+            aSize = sizeof( FREE_BLOCK );
+
+        return ( aSize + align - 1 ) / align * align;
+    }
+
+    void addChunk()
+    {
+        std::unique_ptr<char[]> chunk( new char[ m_blockSize * m_blocksPerChunk ] );
+
+        // Thread the new blocks in address order so consecutive allocations are contiguous.
+        for( size_t i = m_blocksPerChunk; i > 0; --i )
+        {
+            FREE_BLOCK* block = reinterpret_cast<FREE_BLOCK*>( &chunk[ ( i - 1 ) * m_blockSize ] );
+            block->m_next = m_freeList;
+            m_freeList = block;
+        }
+
+        m_chunks.push_back( std::move( chunk ) );
+    }
+
+    MEMORY_POOL( const MEMORY_POOL& );
+    MEMORY_POOL& operator=( const MEMORY_POOL& );
+
+    const size_t                        m_blockSize;
+    const size_t                        m_blocksPerChunk;
+    FREE_BLOCK*                         m_freeList;
+    size_t                              m_used;
+    std::vector< std::unique_ptr<char[]> > m_chunks;
+    std::mutex                          m_lock;
+};
+
+
+/**
+ * Class MEMORY_POOL_SET
+ * is a small set of MEMORY_POOLs, one per object size, suited for implementing
+ * a class specific operator new/delete shared by a class and its derivatives.
+ * Sizes above aMaxBlockSize fall back to the global heap.
+ */
+class MEMORY_POOL_SET
+{
+public:
+    MEMORY_POOL_SET( size_t aMaxBlockSize = 512 ) :
+        m_maxBlockSize( aMaxBlockSize )
+    {
+    }
+
+    void* Allocate( size_t aSize )
+    {
+        if( aSize > m_maxBlockSize )
+            return ::operator new( aSize );
+
+        return poolFor( aSize ).Allocate();
+    }
+
+    /// @param aSize must be the size given to Allocate().
+    void Free( void* aBlock, size_t aSize )
+    {
+        if( aSize > m_maxBlockSize )
+            ::operator delete( aBlock );
+        else
+            poolFor( aSize ).Free( aBlock );
+    }
+
+    /// Total number of bytes reserved by the pools of the set.
+    size_t GetReservedBytes()
+    {
+        std::lock_guard<std::mutex> lock( m_lock );
+        size_t total = 0;
+
+        for( const std::unique_ptr<POOL>& pool : m_pools )
+            total += pool->GetReservedBytes();
+
+        return total;
+    }
+
+private:
+    MEMORY_POOL& poolFor( size_t aSize )
+    {
+        std::lock_guard<std::mutex> lock( m_lock );
+
+        // A class hierarchy has a handful of sizes, a linear search is the fastest.
+        for( const std::unique_ptr<POOL>& pool : m_pools )
+        {
+            if( pool->m_requestedSize == aSize )
+                return *pool;
+        }
+
+        m_pools.emplace_back( new POOL( aSize ) );
+
+        return *m_pools.back();
+    }
+
+    struct POOL : public MEMORY_POOL
+    {
+        POOL( size_t aSize ) : MEMORY_POOL( aSize ), m_requestedSize( aSize ) {}
+
+        const size_t m_requestedSize;
+    };
+
+    const size_t                        m_maxBlockSize;
+    std::vector< std::unique_ptr<POOL> >  m_pools;
+    std::mutex                          m_lock;
+};
+
+#endif  // MEMORY_POOL_H_
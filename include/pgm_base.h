@@ -31,7 +31,9 @@
 #ifndef  PGM_BASE_H_
 #define  PGM_BASE_H_
 
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <wx/filename.h>
 #include <search_stack.h>
 #include <wx/gdicmn.h>
@@ -39,6 +41,9 @@
 
 class wxConfigBase;
 class wxSingleInstanceChecker;
+class TASK_SCHEDULER;
+class PROF_TRACE;
+class STRING_POOL;
 class wxApp;
 class wxMenu;
 class wxWindow;
@@ -292,6 +297,37 @@ public:
      */
     VTBL_ENTRY wxApp&   App();
 
+    /**
+     * Function Scheduler
+     * returns the process wide task scheduler, created by InitPgm().  All the
+     * subsystems running work in parallel should share it rather than spawning
+     * threads of their own, see TASK_GROUP.
+     */
+    VTBL_ENTRY TASK_SCHEDULER& Scheduler();
+
+    /**
+     * Function SetWorkerCount
+     * sets the number of worker threads of the task scheduler, 0 meaning one per
+     * hardware thread (minus the UI thread).  Must not be called while tasks are running.
+     */
+    VTBL_ENTRY void SetWorkerCount( int aCount );
+
+    VTBL_ENTRY int GetWorkerCount() const                           { return m_worker_count; }
+
+    /**
+     * Function ProfileTrace
+     * returns the collector of the tracing zones of the whole process.  The kifaces
+     * record into it rather than into their own copy, see KIFACE_I::start_common().
+     */
+    VTBL_ENTRY PROF_TRACE& ProfileTrace();
+
+    /**
+     * Function StringPool
+     * returns the pool of the interned strings of the whole process.  The kifaces
+     * intern into it rather than into their own copy, see KIFACE_I::start_common().
+     */
+    VTBL_ENTRY STRING_POOL& StringPool();
+
     //----</Cross Module API>----------------------------------------------------
 
     static const wxChar workingDirKey[];
@@ -370,6 +406,18 @@ protected:
 
     /// Flag to indicate if the environment variable overwrite warning dialog should be shown.
     bool            m_show_env_var_dialog;
+
+    /// The task scheduler, see Scheduler().
+    std::atomic<TASK_SCHEDULER*> m_scheduler;
+
+    /// Serializes the creation and the replacement of m_scheduler.
+    std::mutex      m_schedulerLock;
+
+    /// Requested worker thread count of m_scheduler, 0 for automatic.
+    int             m_worker_count;
+
+    /// Output file of the profiling trace (from KICAD_PROFILE_TRACE), empty when not tracing.
+    wxString        m_profile_trace_file;
 };
 
 
@@ -32,6 +32,7 @@
 #ifndef PLOT_COMMON_H_
 #define PLOT_COMMON_H_
 
+#include <string>
 #include <vector>
 #include <math/box2.h>
 #include <drawtxt.h>
@@ -790,6 +791,9 @@ public:
         pageTreeHandle = 0;
     }
 
+    /// Closes and removes the temporary file of a stream left open by an error.
+    ~PDF_PLOTTER();
+
     virtual PlotFormat GetPlotterType() const override
     {
         return PLOT_FORMAT_PDF;
@@ -814,6 +818,44 @@ public:
     virtual bool EndPlot() override;
     virtual void StartPage();
     virtual void ClosePage();
+
+    /**
+     * Function StartDocument
+     * starts the plot like StartPlot(), but without opening the first page: the pages
+     * are then added either by StartPage()/ClosePage() or by AddPage().
+     */
+    bool StartDocument();
+
+    /**
+     * Function StartPageStream
+     * starts the content stream of a page on a plotter which has no output file.
+     * The page is then plotted as usual, and its compressed stream is handed by
+     * EndPageStream() to the plotter of the document, see AddPage().  Page plotters
+     * are independent objects, so the pages of a document can be plotted concurrently.
+     *
+     * @param aWorkFilename is the temporary file used to accumulate the stream.  It is
+     *                      removed by EndPageStream(), or by the destructor if the page
+     *                      is not finished.
+     * @return false if the temporary file cannot be created.
+     */
+    bool StartPageStream( const wxString& aWorkFilename );
+
+    /**
+     * Function EndPageStream
+     * closes the stream started by StartPageStream().
+     * @return the compressed content stream of the page.
+     */
+    std::string EndPageStream();
+
+    /**
+     * Function AddPage
+     * appends a page plotted by a page plotter, with the page settings currently set.
+     * No page must be open.
+     *
+     * @param aStream is the compressed content stream returned by EndPageStream().
+     */
+    void AddPage( const std::string& aStream );
+
     virtual void SetCurrentLineWidth( int width, void* aData = NULL ) override;
     virtual void SetDash( bool dashed ) override;
 
@@ -859,6 +901,11 @@ protected:
     void closePdfObject();
     int startPdfStream(int handle = -1);
     void closePdfStream();
+    int beginPdfStream( int handle );
+    void endPdfStream( const std::string& aStream );
+    std::string deflateWorkFile();
+    void startPageContent();
+    void emitPageObject();
     int pageTreeHandle;		 /// Handle to the root of the page tree object
     int fontResDictHandle;	 /// Font resource dictionary
     std::vector<int> pageHandles;/// Handles to the page objects
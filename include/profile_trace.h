@@ -0,0 +1,234 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file profile_trace.h
+ * @brief Named, scoped tracing zones collected into per-thread ring buffers.
+ *
+ * Unlike the prof_counter helpers in profile.h, which have to be wired to a
+ * printf by hand under a debug define, zones are always compiled in and cost a
+ * single relaxed atomic load while tracing is disabled.  When enabled, every
+ * zone closed on a thread is stored in that thread's ring buffer and the whole
+ * set can be written out in the Chrome trace-event JSON format (load it with
+ * chrome://tracing or https://ui.perfetto.dev).
+ *
+ * Usage:
+ * <code>
+ *   void DRC::RunTests( wxTextCtrl* aMessages )
+ *   {
+ *       PROF_ZONE_SCOPE( "DRC::RunTests", "drc" );
+ *       ...
+ *   }
+ * </code>
+ *
+ * Tracing is switched on for a whole process by defining the environment
+ * variable KICAD_PROFILE_TRACE to the name of the output file, see
+ * PGM_BASE::InitPgm().
+ *
+ * The collector is owned by the program, see PGM_BASE::ProfileTrace(): the kifaces
+ * link their own copy of this code, so KIFACE_I::start_common() binds them to the
+ * program's collector and the zones reach it through its virtual functions.
+ */
+
+#ifndef PROFILE_TRACE_H_
+#define PROFILE_TRACE_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+
+/**
+ * Struct PROF_EVENT
+ * is one closed zone as stored in a ring buffer.  Names and categories must
+ * be string literals (or otherwise outlive the trace), only the pointers are kept.
+ */
+struct PROF_EVENT
+{
+    const char* m_name;
+    const char* m_category;
+    uint64_t    m_start;        ///< microseconds since the trace epoch
+    uint64_t    m_duration;     ///< microseconds
+    int         m_depth;        ///< nesting level of the zone on its thread
+};
+
+
+/**
+ * Class PROF_TRACE
+ * is the process wide collector of tracing zones.
+ */
+class PROF_TRACE
+{
+public:
+    /// Number of events kept per thread; the oldest are overwritten first.
+    static const size_t DEFAULT_RING_SIZE = 1 << 16;
+
+    virtual ~PROF_TRACE() {}
+
+    /**
+     * Function Instance
+     * @return the collector bound by Bind(), or the one of this module if none was.
+     */
+    static PROF_TRACE& Instance();
+
+    /**
+     * Function Bind
+     * makes the zones of this module record into \a aTrace, the collector of another
+     * module.  Must be called before any zone of this module is opened.
+     */
+    static void Bind( PROF_TRACE* aTrace );
+
+    /**
+     * Function IsEnabled
+     * is the fast path test made by every zone, keep it inline.
+     */
+    static bool IsEnabled()
+    {
+        PROF_TRACE* trace = s_instance;
+
+        return trace && trace->m_enabled.load( std::memory_order_relaxed );
+    }
+
+    /**
+     * Function Enable
+     * starts or stops collecting zones.  Already collected events are kept.
+     */
+    virtual void Enable( bool aEnable );
+
+    /**
+     * Function Clear
+     * drops all events collected so far, on all threads.
+     */
+    virtual void Clear();
+
+    /**
+     * Function Now
+     * @return the number of microseconds elapsed since the trace epoch.
+     */
+    uint64_t Now() const;
+
+    /**
+     * Function Record
+     * stores a closed zone in the ring buffer of the calling thread.
+     */
+    virtual void Record( const char* aName, const char* aCategory, uint64_t aStart,
+                         uint64_t aEnd, int aDepth );
+
+    /**
+     * Function ExportChromeTrace
+     * writes all collected events as a Chrome trace-event JSON document.
+     */
+    virtual void ExportChromeTrace( std::ostream& aStream );
+
+    /**
+     * Function ExportChromeTrace
+     * writes all collected events to \a aFileName.
+     * @return true on success.
+     */
+    virtual bool ExportChromeTrace( const std::string& aFileName );
+
+    /// Nesting level bookkeeping used by PROF_ZONE.
+    virtual int EnterZone();
+    virtual void LeaveZone();
+
+private:
+    struct RING
+    {
+        RING( int aThreadId, size_t aSize );
+
+        std::mutex              m_lock;     ///< only contended during an export
+        std::vector<PROF_EVENT> m_events;
+        size_t                  m_head;     ///< next slot to write
+        size_t                  m_count;    ///< number of valid slots
+        int                     m_threadId;
+    };
+
+    PROF_TRACE();
+
+    RING* threadRing();
+
+    static PROF_TRACE*                  s_instance;
+
+    std::atomic<bool>                   m_enabled;
+    std::mutex                          m_ringsLock;
+    std::vector<std::unique_ptr<RING>>  m_rings;
+    uint64_t                            m_epoch;
+};
+
+
+/**
+ * Class PROF_ZONE
+ * measures the lifetime of its scope and records it in PROF_TRACE.
+ */
+class PROF_ZONE
+{
+public:
+    PROF_ZONE( const char* aName, const char* aCategory = "kicad" ) :
+        m_name( aName ),
+        m_category( aCategory ),
+        m_start( 0 ),
+        m_depth( -1 )
+    {
+        if( PROF_TRACE::IsEnabled() )
+        {
+            PROF_TRACE& trace = PROF_TRACE::Instance();
+
+            m_depth = trace.EnterZone();
+            m_start = trace.Now();
+        }
+    }
+
+    ~PROF_ZONE()
+    {
+        if( m_depth >= 0 )
+        {
+            PROF_TRACE& trace = PROF_TRACE::Instance();
+
+            trace.Record( m_name, m_category, m_start, trace.Now(), m_depth );
+            trace.LeaveZone();
+        }
+    }
+
+private:
+    PROF_ZONE( const PROF_ZONE& );
+    PROF_ZONE& operator=( const PROF_ZONE& );
+
+    const char* m_name;
+    const char* m_category;
+    uint64_t    m_start;
+    int         m_depth;
+};
+
+
+#define PROF_ZONE_CONCAT_( a, b ) a ## b
+#define PROF_ZONE_CONCAT( a, b ) PROF_ZONE_CONCAT_( a, b )
+
+/// Opens a zone lasting until the end of the enclosing scope.
+#define PROF_ZONE_SCOPE( name, category ) \
+    PROF_ZONE PROF_ZONE_CONCAT( prof_zone_, __LINE__ )( name, category )
+
+#endif  // PROFILE_TRACE_H_
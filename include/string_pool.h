@@ -0,0 +1,227 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file string_pool.h
+ * @brief Pool of interned identifier strings, shared by the modules of the program.
+ */
+
+#ifndef STRING_POOL_H_
+#define STRING_POOL_H_
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include <wx/string.h>
+
+#include <utf8.h>
+
+
+class STRING_POOL;
+
+/**
+ * Struct STRING_POOL_ENTRY
+ * is the unique copy of an interned string.  Entries do not move; an entry is
+ * freed when the last INTERNED_STRING referring to it goes away.
+ */
+struct STRING_POOL_ENTRY
+{
+    wxString    m_Text;
+    UTF8        m_Utf8;     ///< m_Text encoded once, for the users storing UTF8 strings
+    size_t      m_Hash;     ///< WXSTRING_HASH of m_Text
+    unsigned    m_Id;       ///< identifier, never reused; 0 is the empty string
+    STRING_POOL* m_Pool;    ///< the pool which created the entry
+
+    mutable std::atomic<unsigned> m_RefCount;   ///< INTERNED_STRINGs referring to the entry
+};
+
+
+/**
+ * Class STRING_POOL
+ * keeps one copy of each identifier string (net names, references, library
+ * names...) in use by the items of the program.  Strings can be interned from
+ * several threads: the pool is split in shards, each with its own lock.  Only
+ * interning and releasing the last reference to a string take a lock; reading
+ * and comparing interned strings do not.
+ * <p>
+ * The kifaces use the pool of the program rather than their own copy, see
+ * PGM_BASE::StringPool(), so interned strings compare equal across modules and
+ * the strings of a board are released when the board is deleted.
+ */
+class STRING_POOL
+{
+public:
+    virtual ~STRING_POOL();
+
+    /**
+     * Function Instance
+     * @return the pool bound by Bind(), or the one of this module if none was.
+     */
+    static STRING_POOL& Instance();
+
+    /**
+     * Function Bind
+     * makes this module intern its strings into \a aPool, the pool of another module.
+     */
+    static void Bind( STRING_POOL* aPool );
+
+    /**
+     * Function Intern
+     * @return the unique entry of \a aText, created if needed, with one more reference
+     * counted for the caller.
+     */
+    virtual const STRING_POOL_ENTRY* Intern( const wxString& aText );
+
+    /**
+     * Function Release
+     * drops a reference to \a aEntry taken by Intern() or by copying an INTERNED_STRING,
+     * freeing the entry if it was the last one.
+     */
+    static void Release( const STRING_POOL_ENTRY* aEntry );
+
+    /// @return the entry of the empty string, which is never freed.
+    const STRING_POOL_ENTRY* EmptyEntry() const { return m_empty; }
+
+    /// @return the number of distinct strings currently interned.
+    size_t GetCount() const     { return m_count.load(); }
+
+private:
+    static const int SHARD_COUNT = 16;
+
+    struct SHARD
+    {
+        std::mutex                                          m_lock;
+        std::unordered_multimap<size_t, STRING_POOL_ENTRY*> m_index;    ///< by hash
+    };
+
+    STRING_POOL();
+    STRING_POOL( const STRING_POOL& );
+    STRING_POOL& operator=( const STRING_POOL& );
+
+    /// Drops the last reference to \a aEntry, under the lock of its shard.
+    virtual void release( const STRING_POOL_ENTRY* aEntry );
+
+    SHARD& shard( size_t aHash )    { return m_shards[aHash % SHARD_COUNT]; }
+
+    static STRING_POOL*         s_instance;
+
+    SHARD                       m_shards[SHARD_COUNT];
+    std::atomic<unsigned>       m_nextId;
+    std::atomic<size_t>         m_count;
+    const STRING_POOL_ENTRY*    m_empty;
+};
+
+
+/**
+ * Class INTERNED_STRING
+ * is a counted reference to a STRING_POOL entry, the size of a pointer.  Two
+ * interned strings of the same pool are equal if and only if they refer to the
+ * same entry, so comparisons do not look at the characters.  It converts to a const wxString& so
+ * it can replace a wxString member without changing the accessors returning it.
+ */
+class INTERNED_STRING
+{
+public:
+    INTERNED_STRING() :
+        m_entry( STRING_POOL::Instance().EmptyEntry() )
+    {
+        m_entry->m_RefCount++;
+    }
+
+    explicit INTERNED_STRING( const wxString& aText ) :
+        m_entry( STRING_POOL::Instance().Intern( aText ) )
+    {
+    }
+
+    INTERNED_STRING( const INTERNED_STRING& aOther ) :
+        m_entry( aOther.m_entry )
+    {
+        m_entry->m_RefCount++;
+    }
+
+    ~INTERNED_STRING()
+    {
+        STRING_POOL::Release( m_entry );
+    }
+
+    INTERNED_STRING& operator=( const INTERNED_STRING& aOther )
+    {
+        aOther.m_entry->m_RefCount++;
+        STRING_POOL::Release( m_entry );
+        m_entry = aOther.m_entry;
+        return *this;
+    }
+
+    INTERNED_STRING& operator=( const wxString& aText )
+    {
+        const STRING_POOL_ENTRY* entry = STRING_POOL::Instance().Intern( aText );
+
+        STRING_POOL::Release( m_entry );
+        m_entry = entry;
+        return *this;
+    }
+
+    const wxString& GetString() const   { return m_entry->m_Text; }
+    const UTF8& GetUTF8() const         { return m_entry->m_Utf8; }
+    operator const wxString&() const    { return m_entry->m_Text; }
+
+    /// @return the pool identifier of the string, unique while the string is interned.
+    unsigned GetId() const              { return m_entry->m_Id; }
+
+    /// @return the WXSTRING_HASH of the string, computed once by the pool.
+    size_t GetHash() const              { return m_entry->m_Hash; }
+
+    bool IsEmpty() const                { return m_entry->m_Id == 0; }
+
+    bool operator==( const INTERNED_STRING& aOther ) const
+    {
+        // Strings interned by static objects before their module was bound to the
+        // pool of the program come from another pool.
+        return m_entry == aOther.m_entry
+            || ( m_entry->m_Pool != aOther.m_entry->m_Pool
+                 && m_entry->m_Text == aOther.m_entry->m_Text );
+    }
+
+    bool operator!=( const INTERNED_STRING& aOther ) const { return !( *this == aOther ); }
+
+    bool operator==( const wxString& aOther ) const { return m_entry->m_Text == aOther; }
+    bool operator!=( const wxString& aOther ) const { return m_entry->m_Text != aOther; }
+
+private:
+    const STRING_POOL_ENTRY* m_entry;
+};
+
+
+inline bool operator==( const wxString& aText, const INTERNED_STRING& aInterned )
+{
+    return aInterned == aText;
+}
+
+
+inline bool operator!=( const wxString& aText, const INTERNED_STRING& aInterned )
+{
+    return aInterned != aText;
+}
+
+#endif  // STRING_POOL_H_
@@ -0,0 +1,210 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file task_scheduler.h
+ * @brief Process wide work-stealing task scheduler, see PGM_BASE::Scheduler().
+ */
+
+#ifndef TASK_SCHEDULER_H_
+#define TASK_SCHEDULER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <wx/string.h>
+
+class REPORTER;
+class TASK_GROUP;
+class TASK_SCHEDULER;
+
+
+/**
+ * Class TASK_CANCEL_TOKEN
+ * is a cheaply copyable cancellation flag.  All the copies of a token share
+ * the same state, so a token can be handed to several task groups and
+ * cancelled from the UI thread.
+ */
+class TASK_CANCEL_TOKEN
+{
+public:
+    TASK_CANCEL_TOKEN() :
+        m_cancelled( std::make_shared< std::atomic<bool> >( false ) )
+    {
+    }
+
+    void Cancel()                   { m_cancelled->store( true ); }
+    bool IsCancelled() const        { return m_cancelled->load( std::memory_order_relaxed ); }
+
+private:
+    std::shared_ptr< std::atomic<bool> > m_cancelled;
+};
+
+
+/**
+ * Class TASK_GROUP
+ * is a set of tasks submitted to a TASK_SCHEDULER which can be waited for
+ * (and cancelled) together.
+ *
+ * Wait() does not just block: the calling thread executes queued tasks until
+ * the group is complete, so groups can be nested inside tasks without
+ * starving the pool.  The first exception thrown by a task of the group is
+ * rethrown by Wait(), the remaining tasks of the group are then skipped.
+ * <p>
+ * Usage:
+ * <code>
+ *   TASK_GROUP group( Pgm().Scheduler() );
+ *
+ *   for( unsigned i = 0; i < count; ++i )
+ *       group.Run( [&, i]() { process( i ); } );
+ *
+ *   group.Wait();
+ * </code>
+ */
+class TASK_GROUP
+{
+public:
+    TASK_GROUP( TASK_SCHEDULER& aScheduler,
+                const TASK_CANCEL_TOKEN& aToken = TASK_CANCEL_TOKEN() );
+
+    /// Waits for the outstanding tasks, a group must not outlive its tasks.
+    ~TASK_GROUP();
+
+    /**
+     * Function Run
+     * queues \a aTask for execution on the scheduler workers.
+     */
+    void Run( const std::function<void()>& aTask );
+
+    /**
+     * Function Wait
+     * returns once all the tasks of the group have completed or have been skipped
+     * because of a cancellation.  The calling thread takes part in the execution.
+     *
+     * @param aReporter is an optional REPORTER receiving progress messages.  It is only
+     *                  called from the calling thread, so UI reporters are safe.
+     * @param aTitle is the text prefixing the progress messages.
+     */
+    void Wait( REPORTER* aReporter = NULL, const wxString& aTitle = wxEmptyString );
+
+    void Cancel()                   { m_token.Cancel(); }
+    bool IsCancelled() const        { return m_token.IsCancelled(); }
+
+    const TASK_CANCEL_TOKEN& GetCancelToken() const { return m_token; }
+
+    /// Number of tasks submitted so far.
+    int GetTaskCount() const        { return m_submitted.load(); }
+
+    /// Number of tasks which have completed or have been skipped.
+    int GetCompletedCount() const   { return m_completed.load(); }
+
+private:
+    friend class TASK_SCHEDULER;
+
+    TASK_GROUP( const TASK_GROUP& );
+    TASK_GROUP& operator=( const TASK_GROUP& );
+
+    /// Called by the scheduler once a task of the group has run (or been skipped).
+    void taskDone( std::exception_ptr aError );
+
+    TASK_SCHEDULER&         m_scheduler;
+    TASK_CANCEL_TOKEN       m_token;
+
+    std::atomic<int>        m_submitted;
+    std::atomic<int>        m_completed;
+    std::atomic<bool>       m_failed;       ///< a task has thrown, skip the others
+
+    std::mutex              m_lock;
+    std::condition_variable m_done;
+    std::exception_ptr      m_error;
+};
+
+
+/**
+ * Class TASK_SCHEDULER
+ * owns a fixed set of worker threads, each with its own task deque.  A worker
+ * executes the newest task of its own deque first and steals the oldest task of
+ * another worker when idle.  There is a single instance per process, owned by
+ * PGM_BASE, so that the subsystems using it do not oversubscribe the machine.
+ */
+class TASK_SCHEDULER
+{
+public:
+    /**
+     * Constructor
+     * @param aWorkerCount is the number of threads of the pool; 0 selects one less than
+     *                     the number of hardware threads, since the thread calling
+     *                     TASK_GROUP::Wait() is busy too.
+     */
+    TASK_SCHEDULER( int aWorkerCount = 0 );
+    ~TASK_SCHEDULER();
+
+    /// @return the number of threads able to run tasks, the waiting thread included.
+    int GetConcurrency() const      { return (int) m_threads.size() + 1; }
+
+    /// @return the worker count to use for \a aRequested (0 meaning automatic).
+    static int DefaultWorkerCount( int aRequested = 0 );
+
+private:
+    friend class TASK_GROUP;
+
+    struct TASK
+    {
+        std::function<void()>   m_func;
+        TASK_GROUP*             m_group;
+    };
+
+    struct WORKER
+    {
+        std::mutex              m_lock;
+        std::deque<TASK>        m_tasks;
+    };
+
+    TASK_SCHEDULER( const TASK_SCHEDULER& );
+    TASK_SCHEDULER& operator=( const TASK_SCHEDULER& );
+
+    void submit( TASK_GROUP* aGroup, const std::function<void()>& aFunc );
+
+    /// Runs one queued task, looking first at queue \a aHome. @return false if none was found.
+    bool runOne( int aHome );
+
+    void workerLoop( int aIndex );
+
+    std::vector<std::thread>                m_threads;
+    std::vector< std::unique_ptr<WORKER> >  m_workers;     ///< one queue per worker thread
+    std::atomic<unsigned>                   m_nextQueue;   ///< round robin queue for non worker threads
+    std::atomic<int>                        m_pending;
+
+    std::mutex                              m_sleepLock;
+    std::condition_variable                 m_wakeUp;
+    bool                                    m_quit;
+};
+
+#endif  // TASK_SCHEDULER_H_
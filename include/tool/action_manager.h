@@ -28,6 +28,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <unordered_map>
 
 class TOOL_BASE;
 class TOOL_MANAGER;
@@ -82,6 +83,14 @@ public:
      */
     TOOL_ACTION* FindAction( const std::string& aActionName ) const;
 
+    /**
+     * Function FindAction()
+     * Finds an action with a given ID (see TOOL_ACTION::GetId()).
+     * @param aActionId is the searched action ID.
+     * @return Pointer to a TOOL_ACTION object or NULL if there is no such action.
+     */
+    TOOL_ACTION* FindAction( int aActionId ) const;
+
     /**
      * Function RunHotKey()
      * Runs an action associated with a hotkey (if there is one available).
@@ -125,7 +134,10 @@ private:
     TOOL_MANAGER* m_toolMgr;
 
     ///> Map for indexing actions by their names
-    std::map<std::string, TOOL_ACTION*> m_actionNameIndex;
+    std::unordered_map<std::string, TOOL_ACTION*> m_actionNameIndex;
+
+    ///> Map for indexing actions by their IDs, that is in the order of their registration
+    std::map<int, TOOL_ACTION*> m_actionIdIndex;
 
     ///> Map for indexing actions by their hotkeys
     typedef std::map<int, std::list<TOOL_ACTION*> > HOTKEY_LIST;
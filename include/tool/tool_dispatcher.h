@@ -30,6 +30,7 @@
 #include <tool/tool_event.h>
 
 class TOOL_MANAGER;
+class TOOL_EVENT_RECORDER;
 class PCB_BASE_FRAME;
 
 namespace KIGFX
@@ -113,6 +114,9 @@ private:
         return mods;
     }
 
+    ///> Records the event (if requested) and sends it to the tool manager.
+    void processEvent( const TOOL_EVENT& aEvent );
+
     ///> Redraws the status bar and message panel.
     void updateUI();
 
@@ -130,6 +134,9 @@ private:
 
     ///> Instance of tool manager that cooperates with the dispatcher.
     TOOL_MANAGER* m_toolMgr;
+
+    ///> Writes the issued events to the file named by KICAD_RECORD_TOOL_EVENTS, if set.
+    TOOL_EVENT_RECORDER* m_recorder;
 };
 
 #endif
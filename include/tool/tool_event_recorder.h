@@ -0,0 +1,76 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __TOOL_EVENT_RECORDER_H
+#define __TOOL_EVENT_RECORDER_H
+
+#include <cstdio>
+#include <string>
+
+#include <tool/tool_event.h>
+
+/**
+ * Class TOOL_EVENT_RECORDER
+ *
+ * Writes the TOOL_EVENTs issued by the TOOL_DISPATCHER to a file, one per line, so the
+ * stream can be replayed later (see tools/tool_dispatch_bench.cpp).  A line is
+ * "<category> <action> [<argument>]", category and action being the TOOL_EVENT_CATEGORY
+ * and TOOL_ACTIONS values in hex.  The argument is the buttons or key code with modifiers
+ * of mouse and keyboard events, and the name (or '#' followed by the ID) of commands and
+ * messages.  Event parameters and mouse positions are not recorded.
+ */
+class TOOL_EVENT_RECORDER
+{
+public:
+    /**
+     * Constructor
+     *
+     * @param aFileName: the file the events are written to, it is overwritten.
+     */
+    TOOL_EVENT_RECORDER( const std::string& aFileName );
+
+    ~TOOL_EVENT_RECORDER();
+
+    ///> Returns true if the file could be opened.
+    bool IsOpen() const
+    {
+        return m_file != NULL;
+    }
+
+    ///> Appends an event to the file.
+    void Record( const TOOL_EVENT& aEvent );
+
+    /**
+     * Function Parse()
+     * Reads an event from a line written by Record().
+     * @param aLine is the line to be parsed.
+     * @param aEvent is the parsed event.
+     * @return false if the line is not an event (blank line, comment...).
+     */
+    static bool Parse( const std::string& aLine, TOOL_EVENT& aEvent );
+
+private:
+    FILE* m_file;
+};
+
+#endif
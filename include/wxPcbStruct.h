@@ -65,6 +65,7 @@ class REPORTER;
 struct PARSE_ERROR;
 class IO_ERROR;
 class FP_LIB_TABLE;
+class PCB_3D_VIEWER_LISTENER;
 
 namespace PCB { struct IFACE; }     // KIFACE_I is in pcbnew.cpp
 
@@ -94,6 +95,8 @@ protected:
 
     DRC* m_drc;                                 ///< the DRC controller, see drc.cpp
 
+    PCB_3D_VIEWER_LISTENER* m_3dViewerListener; ///< forwards the board changes to the 3D viewer
+
     PARAM_CFG_ARRAY   m_configSettings;         ///< List of Pcbnew configuration settings.
 
     wxString          m_lastNetListRead;        ///< Last net list read with relative path.
@@ -0,0 +1,335 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file board_change_bus.cpp
+ */
+
+#include <board_change_bus.h>
+#include <class_board_connected_item.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <pgm_base.h>
+#include <task_scheduler.h>
+
+#include <algorithm>
+
+
+/// The layers of \a aItem, including the ones of the texts and drawings of a footprint.
+static LSET itemLayers( const BOARD_ITEM* aItem )
+{
+    LSET layers = aItem->GetLayerSet();
+
+    if( aItem->Type() == PCB_MODULE_T )
+    {
+        const MODULE* module = static_cast<const MODULE*>( aItem );
+
+        layers.set( module->Reference().GetLayer() );
+        layers.set( module->Value().GetLayer() );
+
+        for( const BOARD_ITEM* item = module->GraphicalItems(); item; item = item->Next() )
+            layers |= item->GetLayerSet();
+    }
+
+    return layers;
+}
+
+
+static BOARD_CHANGE makeChange( const BOARD_ITEM* aItem, CHANGE_TYPE aChange,
+                                const BOARD_ITEM* aPrevious )
+{
+    BOARD_CHANGE change;
+
+    change.m_item    = aItem;
+    change.m_type    = aItem->Type();
+    change.m_change  = aChange;
+    change.m_layers  = itemLayers( aItem );
+    change.m_netCode = -1;
+    change.m_bbox    = aItem->GetBoundingBox();
+
+    if( aItem->IsConnected() )
+        change.m_netCode = static_cast<const BOARD_CONNECTED_ITEM*>( aItem )->GetNetCode();
+
+    if( aPrevious && aPrevious->Type() == aItem->Type() )
+    {
+        change.m_prevLayers = itemLayers( aPrevious );
+        change.m_prevBBox   = aPrevious->GetBoundingBox();
+    }
+
+    return change;
+}
+
+
+void BOARD_CHANGE_SET::Record( const BOARD_ITEM* aItem, CHANGE_TYPE aChange,
+                               const BOARD_ITEM* aPrevious )
+{
+    aChange = aChange & CHT_TYPE;
+
+    merge( makeChange( aItem, aChange, aPrevious ) );
+
+    if( aItem->Type() == PCB_MODULE_T )
+    {
+        const MODULE* module = static_cast<const MODULE*>( aItem );
+
+        for( const D_PAD* pad = module->Pads(); pad; pad = pad->Next() )
+            merge( makeChange( pad, aChange, NULL ) );
+    }
+}
+
+
+void BOARD_CHANGE_SET::RecordSwap( const BOARD_ITEM* aItem, const BOARD_ITEM* aImage )
+{
+    if( aItem->Type() != PCB_MODULE_T || aImage->Type() != PCB_MODULE_T )
+    {
+        Record( aItem, CHT_MODIFY, aImage );
+        return;
+    }
+
+    merge( makeChange( aItem, CHT_MODIFY, aImage ) );
+
+    for( const D_PAD* pad = static_cast<const MODULE*>( aImage )->Pads(); pad; pad = pad->Next() )
+        merge( makeChange( pad, CHT_REMOVE, NULL ) );
+
+    for( const D_PAD* pad = static_cast<const MODULE*>( aItem )->Pads(); pad; pad = pad->Next() )
+        merge( makeChange( pad, CHT_ADD, NULL ) );
+}
+
+
+void BOARD_CHANGE_SET::Merge( const BOARD_CHANGE_SET& aLater )
+{
+    for( const BOARD_CHANGE& change : aLater.m_changes )
+        merge( change );
+}
+
+
+void BOARD_CHANGE_SET::merge( const BOARD_CHANGE& aChange )
+{
+    auto it = m_index.find( aChange.m_item );
+
+    if( it == m_index.end() )
+    {
+        m_index[aChange.m_item] = m_changes.size();
+        m_changes.push_back( aChange );
+        return;
+    }
+
+    BOARD_CHANGE& existing = m_changes[it->second];
+    CHANGE_TYPE   before = existing.m_change;
+    EDA_RECT      prevBBox = existing.m_prevBBox;
+    LSET          prevLayers = existing.m_prevLayers;
+    LSET          removedLayers = existing.m_layers;
+
+    if( before == CHT_ADD && aChange.m_change == CHT_REMOVE )
+    {
+        // The item never existed as far as the listeners are concerned.
+        size_t slot = it->second;
+        m_index.erase( it );
+
+        if( slot != m_changes.size() - 1 )
+        {
+            m_changes[slot] = m_changes.back();
+            m_index[m_changes[slot].m_item] = slot;
+        }
+
+        m_changes.pop_back();
+        return;
+    }
+
+    existing = aChange;
+
+    if( before == CHT_ADD )
+    {
+        existing.m_change = CHT_ADD;                // added, then modified
+    }
+    else if( before == CHT_REMOVE && aChange.m_change == CHT_ADD )
+    {
+        existing.m_change = CHT_MODIFY;             // removed, then put back
+        existing.m_prevBBox = prevBBox;
+        existing.m_prevLayers = removedLayers;
+    }
+    else if( before == CHT_MODIFY )
+    {
+        // keep the oldest known state
+        if( prevBBox.GetWidth() + prevBBox.GetHeight() > 0 )
+            existing.m_prevBBox = prevBBox;
+
+        if( prevLayers.any() )
+            existing.m_prevLayers = prevLayers;
+    }
+}
+
+
+BOARD_CHANGE_BUS::BOARD_CHANGE_BUS()
+{
+}
+
+
+BOARD_CHANGE_BUS::~BOARD_CHANGE_BUS()
+{
+    Flush();
+
+    for( const std::unique_ptr<SUBSCRIPTION>& subscription : m_subscriptions )
+        freePending( subscription->m_pending.exchange( nullptr ) );
+}
+
+
+void BOARD_CHANGE_BUS::Subscribe( BOARD_LISTENER* aListener, DISPATCH aDispatch )
+{
+    std::unique_ptr<SUBSCRIPTION> subscription( new SUBSCRIPTION );
+
+    subscription->m_listener = aListener;
+    subscription->m_dispatch = aDispatch;
+    subscription->m_pending = nullptr;
+    subscription->m_scheduled = false;
+
+    if( aDispatch == DISPATCH_ASYNC )
+        subscription->m_group.reset( new TASK_GROUP( Pgm().Scheduler() ) );
+
+    m_subscriptions.push_back( std::move( subscription ) );
+}
+
+
+void BOARD_CHANGE_BUS::Unsubscribe( BOARD_LISTENER* aListener )
+{
+    for( auto it = m_subscriptions.begin(); it != m_subscriptions.end(); ++it )
+    {
+        SUBSCRIPTION* subscription = it->get();
+
+        if( subscription->m_listener != aListener )
+            continue;
+
+        if( subscription->m_group )
+            subscription->m_group->Wait();
+
+        freePending( subscription->m_pending.exchange( nullptr ) );
+        m_subscriptions.erase( it );
+        return;
+    }
+}
+
+
+void BOARD_CHANGE_BUS::Publish( const BOARD_CHANGE_SET& aChanges )
+{
+    if( aChanges.Empty() )
+        return;
+
+    std::shared_ptr<const BOARD_CHANGE_SET> shared;
+
+    for( const std::unique_ptr<SUBSCRIPTION>& subscription : m_subscriptions )
+    {
+        if( subscription->m_dispatch == DISPATCH_SYNC )
+        {
+            subscription->m_listener->OnBoardChanged( aChanges );
+            continue;
+        }
+
+        // A single copy of the set is shared by all the background listeners.
+        if( !shared )
+            shared = std::make_shared<const BOARD_CHANGE_SET>( aChanges );
+
+        PENDING* node = new PENDING;
+        node->m_changes = shared;
+        node->m_next = subscription->m_pending.load();
+
+        while( !subscription->m_pending.compare_exchange_weak( node->m_next, node ) )
+            ;
+
+        if( !subscription->m_scheduled.exchange( true ) )
+        {
+            SUBSCRIPTION* target = subscription.get();
+            subscription->m_group->Run( [target]() { drain( target ); } );
+        }
+    }
+}
+
+
+void BOARD_CHANGE_BUS::Flush()
+{
+    for( const std::unique_ptr<SUBSCRIPTION>& subscription : m_subscriptions )
+    {
+        if( subscription->m_group )
+            subscription->m_group->Wait();
+    }
+}
+
+
+void BOARD_CHANGE_BUS::drain( SUBSCRIPTION* aSubscription )
+{
+    while( true )
+    {
+        PENDING* list = aSubscription->m_pending.exchange( nullptr );
+
+        if( !list )
+        {
+            aSubscription->m_scheduled.store( false );
+
+            // Publish() may have queued a set after the exchange, while it still saw
+            // m_scheduled set: take it over unless a new task has been queued meanwhile.
+            if( !aSubscription->m_pending.load() || aSubscription->m_scheduled.exchange( true ) )
+                return;
+
+            continue;
+        }
+
+        try
+        {
+            if( !list->m_next )
+            {
+                aSubscription->m_listener->OnBoardChanged( *list->m_changes );
+            }
+            else
+            {
+                // The queue is newest first, coalesce from the oldest set.
+                std::vector<const BOARD_CHANGE_SET*> sets;
+
+                for( PENDING* node = list; node; node = node->m_next )
+                    sets.push_back( node->m_changes.get() );
+
+                BOARD_CHANGE_SET merged;
+
+                for( auto it = sets.rbegin(); it != sets.rend(); ++it )
+                    merged.Merge( **it );
+
+                aSubscription->m_listener->OnBoardChanged( merged );
+            }
+        }
+        catch( ... )
+        {
+            // A listener must not throw; if it does, a failed task would stop the
+            // group from running anything else, so the error is dropped here.
+        }
+
+        freePending( list );
+    }
+}
+
+
+void BOARD_CHANGE_BUS::freePending( PENDING* aList )
+{
+    while( aList )
+    {
+        PENDING* next = aList->m_next;
+        delete aList;
+        aList = next;
+    }
+}
@@ -0,0 +1,200 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file board_change_bus.h
+ * @brief Change notifications of a BOARD, for the subsystems caching data derived from it.
+ */
+
+#ifndef BOARD_CHANGE_BUS_H_
+#define BOARD_CHANGE_BUS_H_
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <commit.h>
+#include <class_eda_rect.h>
+#include <layers_id_colors_and_visibility.h>
+
+class BOARD_ITEM;
+class TASK_GROUP;
+
+
+/**
+ * Struct BOARD_CHANGE
+ * describes the change of a single board item.  The state of the item is copied
+ * when the change is recorded, so that listeners running in the background never
+ * have to look at the item itself: by then it may have been modified again or
+ * deleted.  m_item is only meant to identify the item.
+ */
+struct BOARD_CHANGE
+{
+    const BOARD_ITEM*   m_item;
+    KICAD_T             m_type;
+    CHANGE_TYPE         m_change;       ///< CHT_ADD, CHT_REMOVE or CHT_MODIFY
+    LSET                m_layers;       ///< for a footprint, with its texts and graphic items
+    LSET                m_prevLayers;   ///< layers before a modification, empty if unknown
+    int                 m_netCode;      ///< -1 for items which are not connected items
+    EDA_RECT            m_bbox;
+    EDA_RECT            m_prevBBox;     ///< area before a modification, empty if unknown
+};
+
+
+/**
+ * Class BOARD_CHANGE_SET
+ * is the set of the changes of a commit, at most one per item.  Successive changes
+ * of an item are coalesced: added then modified is an addition, added then removed
+ * is nothing at all, removed then added again is a modification, and so on.
+ */
+class BOARD_CHANGE_SET
+{
+public:
+    /**
+     * Function Record
+     * adds the change \a aChange of \a aItem, as it is now, to the set.
+     * A footprint change is also recorded for each of its pads.
+     *
+     * @param aPrevious is an optional copy of the item before a modification.
+     */
+    void Record( const BOARD_ITEM* aItem, CHANGE_TYPE aChange,
+                 const BOARD_ITEM* aPrevious = NULL );
+
+    /**
+     * Function RecordSwap
+     * adds the modification of \a aItem by SwapData() with \a aImage, as done by undo
+     * and redo.  The pads of a footprint are swapped with it: the ones now held by
+     * \a aImage are recorded as removed, and the ones of \a aItem as added.
+     */
+    void RecordSwap( const BOARD_ITEM* aItem, const BOARD_ITEM* aImage );
+
+    /// Coalesces the changes of \a aLater, which happened after the ones of this set.
+    void Merge( const BOARD_CHANGE_SET& aLater );
+
+    /// @return the changes, in no particular order.
+    const std::vector<BOARD_CHANGE>& Changes() const { return m_changes; }
+
+    bool Empty() const          { return m_changes.empty(); }
+    size_t Count() const        { return m_changes.size(); }
+
+    void Clear()
+    {
+        m_changes.clear();
+        m_index.clear();
+    }
+
+private:
+    void merge( const BOARD_CHANGE& aChange );
+
+    std::vector<BOARD_CHANGE>                       m_changes;
+    std::unordered_map<const BOARD_ITEM*, size_t>   m_index;
+};
+
+
+/**
+ * Class BOARD_LISTENER
+ * is the interface of the objects interested in the changes of a board.
+ */
+class BOARD_LISTENER
+{
+public:
+    virtual ~BOARD_LISTENER() {}
+
+    /**
+     * Function OnBoardChanged
+     * is called once per published change set.  A background listener may receive
+     * the changes of several commits coalesced in a single set, when it is slower
+     * than the edits.  It must not throw.
+     */
+    virtual void OnBoardChanged( const BOARD_CHANGE_SET& aChanges ) = 0;
+};
+
+
+/**
+ * Class BOARD_CHANGE_BUS
+ * dispatches the change sets of a BOARD, published by BOARD_COMMIT and undo/redo,
+ * to its listeners.
+ *
+ * DISPATCH_SYNC listeners are called by Publish() itself, on the UI thread, which
+ * suits VIEW-like consumers.  DISPATCH_ASYNC listeners are called on the task
+ * scheduler: Publish() only pushes the set on a lock-free per listener queue and
+ * returns, and the changes queued while a listener is busy are coalesced into a
+ * single call.  A given listener is never called concurrently with itself.
+ * <p>
+ * Subscribe(), Unsubscribe() and Publish() must be called from the UI thread, and
+ * not from within OnBoardChanged().
+ */
+class BOARD_CHANGE_BUS
+{
+public:
+    enum DISPATCH
+    {
+        DISPATCH_SYNC,
+        DISPATCH_ASYNC
+    };
+
+    BOARD_CHANGE_BUS();
+
+    /// Waits for the background listeners.
+    ~BOARD_CHANGE_BUS();
+
+    void Subscribe( BOARD_LISTENER* aListener, DISPATCH aDispatch = DISPATCH_SYNC );
+
+    /// Removes \a aListener, after it has processed the changes queued for it.
+    void Unsubscribe( BOARD_LISTENER* aListener );
+
+    void Publish( const BOARD_CHANGE_SET& aChanges );
+
+    /// Returns once the background listeners have processed all the published changes.
+    void Flush();
+
+private:
+    /// A published set waiting for an asynchronous listener, queued newest first.
+    struct PENDING
+    {
+        std::shared_ptr<const BOARD_CHANGE_SET> m_changes;
+        PENDING*                                m_next;
+    };
+
+    struct SUBSCRIPTION
+    {
+        BOARD_LISTENER*             m_listener;
+        DISPATCH                    m_dispatch;
+        std::atomic<PENDING*>       m_pending;
+        std::atomic<bool>           m_scheduled;    ///< a drain() task is queued or running
+        std::unique_ptr<TASK_GROUP> m_group;
+    };
+
+    BOARD_CHANGE_BUS( const BOARD_CHANGE_BUS& );
+    BOARD_CHANGE_BUS& operator=( const BOARD_CHANGE_BUS& );
+
+    /// Body of the background tasks, delivers the pending sets of \a aSubscription.
+    static void drain( SUBSCRIPTION* aSubscription );
+
+    static void freePending( PENDING* aList );
+
+    std::vector< std::unique_ptr<SUBSCRIPTION> > m_subscriptions;
+};
+
+#endif  // BOARD_CHANGE_BUS_H_
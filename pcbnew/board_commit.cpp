@@ -29,6 +29,7 @@
 #include <ratsnest_data.h>
 #include <view/view.h>
 #include <board_commit.h>
+#include <board_change_bus.h>
 #include <tools/pcb_tool.h>
 
 #include <functional>
@@ -62,6 +63,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage )
     PCB_BASE_FRAME* frame = (PCB_BASE_FRAME*) m_toolMgr->GetEditFrame();
     RN_DATA* ratsnest = board->GetRatsnest();
     std::set<EDA_ITEM*> savedModules;
+    BOARD_CHANGE_SET changes;
 
     if( Empty() )
         return;
@@ -130,6 +132,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage )
                 }
 
                 view->Add( boardItem );
+                changes.Record( boardItem, CHT_ADD );
                 break;
             }
 
@@ -180,6 +183,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage )
 
                     if( remove )
                     {
+                        changes.Record( boardItem, CHT_REMOVE );
                         view->Remove( boardItem );
 
                         if( !( changeFlags & CHT_DONE ) )
@@ -205,6 +209,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage )
                 case PCB_MARKER_T:              // a marker used to show something
                 case PCB_ZONE_T:                // SEG_ZONE items are now deprecated
                 case PCB_ZONE_AREA_T:
+                    changes.Record( boardItem, CHT_REMOVE );
                     view->Remove( boardItem );
 
                     if( !( changeFlags & CHT_DONE ) )
@@ -220,6 +225,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage )
 
                     MODULE* module = static_cast<MODULE*>( boardItem );
                     module->ClearFlags();
+                    changes.Record( module, CHT_REMOVE );
                     module->RunOnChildren( std::bind( &KIGFX::VIEW::Remove, view, _1 ) );
 
                     view->Remove( module );
@@ -251,6 +257,10 @@ void BOARD_COMMIT::Push( const wxString& aMessage )
 
                 boardItem->ViewUpdate( KIGFX::VIEW_ITEM::ALL );
                 ratsnest->Update( boardItem );
+
+                // In the module editor the copy is the whole footprint, not the item.
+                changes.Record( boardItem, CHT_MODIFY,
+                                m_editModules ? NULL : static_cast<BOARD_ITEM*>( ent.m_copy ) );
                 break;
             }
 
@@ -266,6 +276,8 @@ void BOARD_COMMIT::Push( const wxString& aMessage )
     if( TOOL_MANAGER* toolMgr = frame->GetToolManager() )
         toolMgr->PostEvent( { TC_MESSAGE, TA_MODEL_CHANGE, AS_GLOBAL } );
 
+    board->GetChangeBus().Publish( changes );
+
     ratsnest->Recalculate();
     frame->OnModify();
     frame->UpdateMsgPanel();
@@ -296,6 +308,7 @@ void BOARD_COMMIT::Revert()
     KIGFX::VIEW* view = m_toolMgr->GetView();
     BOARD* board = (BOARD*) m_toolMgr->GetModel();
     RN_DATA* ratsnest = board->GetRatsnest();
+    BOARD_CHANGE_SET changes;
 
     for( auto it = m_changes.rbegin(); it != m_changes.rend(); ++it )
     {
@@ -314,6 +327,7 @@ void BOARD_COMMIT::Revert()
 
             view->Remove( item );
             ratsnest->Remove( item );
+            changes.Record( item, CHT_REMOVE );
             break;
 
         case CHT_REMOVE:
@@ -326,6 +340,7 @@ void BOARD_COMMIT::Revert()
 
             view->Add( item );
             ratsnest->Add( item );
+            changes.Record( item, CHT_ADD );
             break;
 
         case CHT_MODIFY:
@@ -354,6 +369,7 @@ void BOARD_COMMIT::Revert()
 
             view->Add( item );
             ratsnest->Add( item );
+            changes.RecordSwap( item, copy );
             delete copy;
             break;
         }
@@ -364,6 +380,8 @@ void BOARD_COMMIT::Revert()
         }
     }
 
+    board->GetChangeBus().Publish( changes );
+
     ratsnest->Recalculate();
 
     clear();
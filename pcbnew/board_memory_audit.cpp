@@ -0,0 +1,314 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file board_memory_audit.cpp
+ */
+
+#include <fctsys.h>
+#include <reporter.h>
+#include <macros.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <class_drawsegment.h>
+#include <class_pcb_text.h>
+#include <class_text_mod.h>
+#include <class_edge_mod.h>
+#include <class_dimension.h>
+#include <class_mire.h>
+#include <class_marker_pcb.h>
+
+#include <board_memory_audit.h>
+
+
+/// Approximation of the heap used by a string: the exact figure depends on the
+/// wxString build and on the small string optimization of the library.
+static size_t stringBytes( const wxString& aText )
+{
+    return aText.IsEmpty() ? 0 : ( aText.length() + 1 ) * sizeof( wxChar );
+}
+
+
+template <class T>
+static size_t vectorBytes( const std::vector<T>& aVector )
+{
+    return aVector.capacity() * sizeof( T );
+}
+
+
+static size_t itemSize( const BOARD_ITEM* aItem )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_MODULE_T:          return sizeof( MODULE );
+    case PCB_PAD_T:             return sizeof( D_PAD );
+    case PCB_TRACE_T:           return sizeof( TRACK );
+    case PCB_VIA_T:             return sizeof( VIA );
+    case PCB_ZONE_T:            return sizeof( SEGZONE );
+    case PCB_ZONE_AREA_T:       return sizeof( ZONE_CONTAINER );
+    case PCB_LINE_T:            return sizeof( DRAWSEGMENT );
+    case PCB_TEXT_T:            return sizeof( TEXTE_PCB );
+    case PCB_MODULE_TEXT_T:     return sizeof( TEXTE_MODULE );
+    case PCB_MODULE_EDGE_T:     return sizeof( EDGE_MODULE );
+    case PCB_DIMENSION_T:       return sizeof( DIMENSION );
+    case PCB_TARGET_T:          return sizeof( PCB_TARGET );
+    case PCB_MARKER_T:          return sizeof( MARKER_PCB );
+    default:                    return sizeof( BOARD_ITEM );
+    }
+}
+
+
+BOARD_MEMORY_AUDIT::BOARD_MEMORY_AUDIT( const BOARD* aBoard )
+{
+    for( const MODULE* module = aBoard->m_Modules; module; module = module->Next() )
+    {
+        // The footprint library ids are interned, see the STRING_POOL entry.
+        add( module->GetClass(), sizeof( MODULE ),
+             stringBytes( module->GetDescription() ) + stringBytes( module->GetKeywords() ) +
+             stringBytes( module->GetPath() ) );
+
+        addItem( &module->Reference() );
+        addItem( &module->Value() );
+
+        for( const D_PAD* pad = module->Pads(); pad; pad = pad->Next() )
+            addItem( pad );
+
+        for( const BOARD_ITEM* item = module->GraphicalItems(); item; item = item->Next() )
+            addItem( item );
+    }
+
+    for( const BOARD_ITEM* item = aBoard->m_Drawings; item; item = item->Next() )
+        addItem( item );
+
+    for( const TRACK* track = aBoard->m_Track; track; track = track->Next() )
+        addItem( track );
+
+    for( const SEGZONE* segzone = aBoard->m_Zone; segzone; segzone = segzone->Next() )
+        addItem( segzone );
+
+    for( int ii = 0; ii < aBoard->GetAreaCount(); ii++ )
+        addItem( aBoard->GetArea( ii ) );
+
+    for( int ii = 0; ii < aBoard->GetMARKERCount(); ii++ )
+        addItem( aBoard->GetMARKER( ii ) );
+
+    // Net names are interned, see the STRING_POOL entry.
+    for( NETINFO_LIST::iterator net = aBoard->BeginNets(); net != aBoard->EndNets(); ++net )
+        add( net->GetClass(), sizeof( NETINFO_ITEM ), 0 );
+
+    // Storage shared by all the boards of the process
+    add( wxT( "<connection lists>" ), 0, CONNECTED_LIST_BASE::GetArenaReservedBytes(), 0 );
+    add( wxT( "<track arena>" ), 0, TRACK::GetArenaReservedBytes(), 0 );
+
+    size_t padSettingsCount = PAD_LOCAL_SETTINGS::GetInternedCount();
+    add( wxT( "<pad settings>" ), padSettingsCount * sizeof( PAD_LOCAL_SETTINGS ), 0,
+         padSettingsCount );
+
+    size_t stringCount = STRING_POOL::Instance().GetCount();
+    add( wxT( "<interned strings>" ), stringCount * sizeof( STRING_POOL_ENTRY ), 0, stringCount );
+}
+
+
+BOARD_MEMORY_AUDIT::ENTRY& BOARD_MEMORY_AUDIT::entry( const wxString& aType )
+{
+    // There are only a few types, a linear search is fine.
+    for( ENTRY& entry : m_entries )
+    {
+        if( entry.m_Type == aType )
+            return entry;
+    }
+
+    ENTRY entry;
+    entry.m_Type = aType;
+    entry.m_Count = 0;
+    entry.m_ObjectBytes = 0;
+    entry.m_HeapBytes = 0;
+    entry.m_SavedBytes = 0;
+
+    m_entries.push_back( entry );
+
+    return m_entries.back();
+}
+
+
+const BOARD_MEMORY_AUDIT::ENTRY* BOARD_MEMORY_AUDIT::findEntry( const wxString& aType ) const
+{
+    for( const ENTRY& entry : m_entries )
+    {
+        if( entry.m_Type == aType )
+            return &entry;
+    }
+
+    return NULL;
+}
+
+
+void BOARD_MEMORY_AUDIT::add( const wxString& aType, size_t aObjectBytes, size_t aHeapBytes,
+                              size_t aCount, size_t aSavedBytes )
+{
+    ENTRY& e = entry( aType );
+
+    e.m_Count += aCount;
+    e.m_ObjectBytes += aObjectBytes;
+    e.m_HeapBytes += aHeapBytes;
+    e.m_SavedBytes += aSavedBytes;
+}
+
+
+void BOARD_MEMORY_AUDIT::addItem( const BOARD_ITEM* aItem )
+{
+    size_t heap = 0;
+
+    switch( aItem->Type() )
+    {
+    case PCB_TEXT_T:
+        heap += stringBytes( static_cast<const TEXTE_PCB*>( aItem )->GetText() );
+        break;
+
+    case PCB_MODULE_TEXT_T:
+        heap += stringBytes( static_cast<const TEXTE_MODULE*>( aItem )->GetText() );
+        break;
+
+    case PCB_LINE_T:
+    case PCB_MODULE_EDGE_T:
+    {
+        const DRAWSEGMENT* segment = static_cast<const DRAWSEGMENT*>( aItem );
+
+        heap += vectorBytes( segment->GetPolyPoints() );
+        heap += vectorBytes( segment->GetBezierPoints() );
+        break;
+    }
+
+    case PCB_ZONE_AREA_T:
+    {
+        const ZONE_CONTAINER* zone = static_cast<const ZONE_CONTAINER*>( aItem );
+
+        heap += sizeof( CPolyLine ) + zone->Outline()->GetCornersCount() * sizeof( CPolyPt );
+        heap += zone->GetFilledPolysList().TotalVertices() * sizeof( VECTOR2I );
+        heap += vectorBytes( zone->FillSegments() );
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    size_t saved = 0;
+
+    if( BOARD_CONNECTED_ITEM::ClassOf( aItem ) )
+    {
+        const BOARD_CONNECTED_ITEM* item = static_cast<const BOARD_CONNECTED_ITEM*>( aItem );
+
+        saved += sizeof( std::vector<TRACK*> ) - sizeof( item->m_TracksConnected );
+        saved += sizeof( std::vector<D_PAD*> ) - sizeof( item->m_PadsConnected );
+    }
+
+    // The shared copy has the size of the fields the pads held inline.
+    if( aItem->Type() == PCB_PAD_T )
+        saved += sizeof( PAD_LOCAL_SETTINGS ) - sizeof( PAD_LOCAL_SETTINGS_REF );
+
+    add( aItem->GetClass(), itemSize( aItem ), heap, 1, saved );
+}
+
+
+size_t BOARD_MEMORY_AUDIT::GetTotalBytes() const
+{
+    size_t total = 0;
+
+    for( const ENTRY& e : m_entries )
+        total += e.m_ObjectBytes + e.m_HeapBytes;
+
+    return total;
+}
+
+
+size_t BOARD_MEMORY_AUDIT::GetCount( const wxString& aType ) const
+{
+    const ENTRY* e = findEntry( aType );
+
+    return e ? e->m_Count : 0;
+}
+
+
+size_t BOARD_MEMORY_AUDIT::GetBytes( const wxString& aType ) const
+{
+    const ENTRY* e = findEntry( aType );
+
+    return e ? e->m_ObjectBytes + e->m_HeapBytes : 0;
+}
+
+
+size_t BOARD_MEMORY_AUDIT::GetSavedBytes( const wxString& aType ) const
+{
+    const ENTRY* e = findEntry( aType );
+
+    return e ? e->m_SavedBytes : 0;
+}
+
+
+wxString BOARD_MEMORY_AUDIT::Format() const
+{
+    wxString text;
+
+    text << wxString::Format( wxT( "%-20s %10s %14s %14s %14s\n" ),
+                              wxT( "Type" ), wxT( "Count" ), wxT( "Object bytes" ),
+                              wxT( "Heap bytes" ), wxT( "Saved bytes" ) );
+
+    for( const ENTRY& e : m_entries )
+    {
+        text << wxString::Format( wxT( "%-20s %10lu %14lu %14lu %14lu\n" ),
+                                  GetChars( e.m_Type ), (unsigned long) e.m_Count,
+                                  (unsigned long) e.m_ObjectBytes,
+                                  (unsigned long) e.m_HeapBytes,
+                                  (unsigned long) e.m_SavedBytes );
+    }
+
+    text << wxString::Format( wxT( "%-20s %10s %14lu\n" ), wxT( "Total" ), wxEmptyString,
+                              (unsigned long) GetTotalBytes() );
+
+    return text;
+}
+
+
+void BOARD_MEMORY_AUDIT::Report( REPORTER& aReporter ) const
+{
+    wxString    text = Format();
+    wxString    line;
+
+    for( wxString::const_iterator it = text.begin(); it != text.end(); ++it )
+    {
+        if( *it == '\n' )
+        {
+            aReporter.Report( line, REPORTER::RPT_INFO );
+            line.Clear();
+        }
+        else
+        {
+            line << *it;
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file board_memory_audit.h
+ */
+
+#ifndef BOARD_MEMORY_AUDIT_H_
+#define BOARD_MEMORY_AUDIT_H_
+
+#include <vector>
+#include <wx/string.h>
+
+class BOARD;
+class BOARD_ITEM;
+class REPORTER;
+
+
+/**
+ * Class BOARD_MEMORY_AUDIT
+ * estimates the memory used by the items of a board, per item type.
+ *
+ * Object bytes are the sizeof() of the items; heap bytes are an estimate of what
+ * the items own outside of themselves (strings, polygons, connection lists).
+ * The shared arenas and side tables are reported separately since they are not
+ * owned by a single board.  Saved bytes are what the pads and connected items
+ * would take on top of their object bytes with the side tables and connection
+ * lists stored inline, as they were before these were compacted.
+ * <p>
+ * From the scripting console:
+ * <code>
+ *   print( pcbnew.BOARD_MEMORY_AUDIT( pcbnew.GetBoard() ).Format() )
+ * </code>
+ */
+class BOARD_MEMORY_AUDIT
+{
+public:
+    struct ENTRY
+    {
+        wxString    m_Type;
+        size_t      m_Count;
+        size_t      m_ObjectBytes;
+        size_t      m_HeapBytes;
+        size_t      m_SavedBytes;
+    };
+
+    BOARD_MEMORY_AUDIT( const BOARD* aBoard );
+
+    const std::vector<ENTRY>& GetEntries() const { return m_entries; }
+
+    /// @return the sum of the object and heap bytes of all the entries.
+    size_t GetTotalBytes() const;
+
+    /// @return the number of items of type \a aType (see EDA_ITEM::GetClass()).
+    size_t GetCount( const wxString& aType ) const;
+
+    /// @return the object and heap bytes of the items of type \a aType.
+    size_t GetBytes( const wxString& aType ) const;
+
+    /// @return the bytes saved by the compact layout of the items of type \a aType.
+    size_t GetSavedBytes( const wxString& aType ) const;
+
+    /// @return the audit as a text table, one line per type.
+    wxString Format() const;
+
+    /// Sends the lines of Format() to \a aReporter.
+    void Report( REPORTER& aReporter ) const;
+
+private:
+    ENTRY& entry( const wxString& aType );
+    const ENTRY* findEntry( const wxString& aType ) const;
+
+    void add( const wxString& aType, size_t aObjectBytes, size_t aHeapBytes,
+              size_t aCount = 1, size_t aSavedBytes = 0 );
+    void addItem( const BOARD_ITEM* aItem );
+
+    std::vector<ENTRY>  m_entries;
+};
+
+#endif  // BOARD_MEMORY_AUDIT_H_
@@ -42,6 +42,7 @@
 #include <reporter.h>
 #include <base_units.h>
 #include <ratsnest_data.h>
+#include <board_change_bus.h>
 #include <ratsnest_viewitem.h>
 #include <worksheet_viewitem.h>
 
@@ -107,11 +108,16 @@ BOARD::BOARD() :
 
     // Initialize ratsnest
     m_ratsnest = new RN_DATA( this );
+
+    m_changeBus = new BOARD_CHANGE_BUS;
 }
 
 
 BOARD::~BOARD()
 {
+    // Let the background listeners finish before the items go away.
+    delete m_changeBus;
+
     while( m_ZoneDescriptorList.size() )
     {
         ZONE_CONTAINER* area_to_remove = m_ZoneDescriptorList[0];
@@ -2875,3 +2881,57 @@ bool BOARD::GetBoardPolygonOutlines( SHAPE_POLY_SET& aOutlines,
     return dummy.GetBoardPolygonOutlines( this, aOutlines,
                                           aHoles, aErrorText );
 }
+
+
+BOARD_ITEMS_BY_LAYER::BOARD_ITEMS_BY_LAYER( const BOARD* aBoard )
+{
+    auto isValid = []( LAYER_ID aLayer ) { return unsigned( aLayer ) < LAYER_ID_COUNT; };
+
+    for( TRACK* track = aBoard->m_Track; track; track = track->Next() )
+    {
+        if( track->Type() == PCB_VIA_T )
+        {
+            for( LAYER_ID layer : track->GetLayerSet().Layers() )
+                m_tracks[layer].push_back( track );
+        }
+        else if( isValid( track->GetLayer() ) )
+        {
+            m_tracks[track->GetLayer()].push_back( track );
+        }
+    }
+
+    for( MODULE* module = aBoard->m_Modules; module; module = module->Next() )
+    {
+        for( D_PAD* pad = module->Pads(); pad; pad = pad->Next() )
+        {
+            for( LAYER_ID layer : pad->GetLayerSet().Layers() )
+                m_pads[layer].push_back( pad );
+        }
+
+        if( isValid( module->Reference().GetLayer() ) )
+            m_moduleItems[module->Reference().GetLayer()].push_back( &module->Reference() );
+
+        if( isValid( module->Value().GetLayer() ) )
+            m_moduleItems[module->Value().GetLayer()].push_back( &module->Value() );
+
+        for( BOARD_ITEM* item = module->GraphicalItems(); item; item = item->Next() )
+        {
+            if( isValid( item->GetLayer() ) )
+                m_moduleItems[item->GetLayer()].push_back( item );
+        }
+    }
+
+    for( BOARD_ITEM* item = aBoard->m_Drawings; item; item = item->Next() )
+    {
+        if( isValid( item->GetLayer() ) )
+            m_drawings[item->GetLayer()].push_back( item );
+    }
+
+    for( int ii = 0; ii < aBoard->GetAreaCount(); ++ii )
+    {
+        ZONE_CONTAINER* zone = aBoard->GetArea( ii );
+
+        if( isValid( zone->GetLayer() ) )
+            m_zones[zone->GetLayer()].push_back( zone );
+    }
+}
@@ -58,6 +58,7 @@ class MSG_PANEL_ITEM;
 class NETLIST;
 class REPORTER;
 class RN_DATA;
+class BOARD_CHANGE_BUS;
 class SHAPE_POLY_SET;
 
 
@@ -188,6 +189,7 @@ private:
     EDA_RECT                m_BoundingBox;
     NETINFO_LIST            m_NetInfo;              ///< net info list (name, design constraints ..
     RN_DATA*                m_ratsnest;
+    BOARD_CHANGE_BUS*       m_changeBus;
 
     BOARD_DESIGN_SETTINGS   m_designSettings;
     ZONE_SETTINGS           m_zoneSettings;
@@ -290,6 +292,16 @@ public:
         return m_ratsnest;
     }
 
+    /**
+     * Function GetChangeBus()
+     * returns the bus notifying the changes committed to the board, which the caches
+     * of data derived from the board subscribe to.
+     */
+    BOARD_CHANGE_BUS& GetChangeBus() const
+    {
+        return *m_changeBus;
+    }
+
     /**
      * Function DeleteMARKERs
      * deletes ALL MARKERS from the board.
@@ -1385,4 +1397,58 @@ public:
     TRACK* CreateLockPoint( wxPoint& aPosition, TRACK* aSegment, PICKED_ITEMS_LIST* aList );
 };
 
+
+#ifndef SWIG
+/**
+ * Class BOARD_ITEMS_BY_LAYER
+ * is a snapshot of the items of a BOARD bucketed by layer, so that the passes
+ * handling the board one layer at a time (3D view, plotting, DRC) visit the items
+ * of each layer only, instead of filtering the whole board with IsOnLayer() once
+ * per layer.  Items spanning several layers (vias, pads) are in the bucket of each
+ * of their layers.  Within a bucket, the items keep their order on the board.
+ * <p>
+ * It is only a snapshot: it is built by the pass using it, in a single walk of the
+ * board, and is not kept up to date.  It must not outlive the pass, since any
+ * addition, removal or layer change of a board item makes it stale.  It is not
+ * maintained from the BOARD_CHANGE_BUS because the legacy editing code modifies
+ * the board without going through BOARD_COMMIT.
+ */
+class BOARD_ITEMS_BY_LAYER
+{
+public:
+    BOARD_ITEMS_BY_LAYER( const BOARD* aBoard );
+
+    /// Tracks and vias of BOARD::m_Track on \a aLayer.
+    const std::vector<TRACK*>& Tracks( LAYER_ID aLayer ) const { return m_tracks[aLayer]; }
+
+    /// Pads of all the footprints on \a aLayer.
+    const std::vector<D_PAD*>& Pads( LAYER_ID aLayer ) const { return m_pads[aLayer]; }
+
+    /// Footprint texts (reference and value included) and edges on \a aLayer.
+    const std::vector<BOARD_ITEM*>& ModuleItems( LAYER_ID aLayer ) const
+    {
+        return m_moduleItems[aLayer];
+    }
+
+    /// Items of BOARD::m_Drawings on \a aLayer.
+    const std::vector<BOARD_ITEM*>& Drawings( LAYER_ID aLayer ) const
+    {
+        return m_drawings[aLayer];
+    }
+
+    /// Zone outlines on \a aLayer.
+    const std::vector<ZONE_CONTAINER*>& Zones( LAYER_ID aLayer ) const
+    {
+        return m_zones[aLayer];
+    }
+
+private:
+    std::vector<TRACK*>             m_tracks[LAYER_ID_COUNT];
+    std::vector<D_PAD*>             m_pads[LAYER_ID_COUNT];
+    std::vector<BOARD_ITEM*>        m_moduleItems[LAYER_ID_COUNT];
+    std::vector<BOARD_ITEM*>        m_drawings[LAYER_ID_COUNT];
+    std::vector<ZONE_CONTAINER*>    m_zones[LAYER_ID_COUNT];
+};
+#endif
+
 #endif      // CLASS_BOARD_H_
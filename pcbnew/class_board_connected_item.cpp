@@ -35,6 +35,116 @@
 #include <class_board_item.h>
 
 #include <ratsnest_data.h>
+#include <memory_pool.h>
+
+#include <algorithm>
+
+
+static_assert( sizeof( CONNECTED_LIST<TRACK> ) == sizeof( void* ),
+               "a connection list must stay the size of a pointer" );
+
+// The block sizes are powers of 2, so a handful of pools serve all the lists;
+// the rare lists of more than 31 items come from the general heap.
+// The arena is never destroyed: lists may be freed by static destructors.
+static MEMORY_POOL_SET& connectedListArena()
+{
+    static MEMORY_POOL_SET* arena = new MEMORY_POOL_SET( 256 );
+
+    return *arena;
+}
+
+
+static size_t blockBytes( size_t aCapacity )
+{
+    // BLOCK has room for one item, and its header is the size of another one.
+    return ( aCapacity + 1 ) * sizeof( void* );
+}
+
+
+void CONNECTED_LIST_BASE::clear()
+{
+    if( m_block )
+    {
+        connectedListArena().Free( m_block, blockBytes( m_block->m_capacity ) );
+        m_block = nullptr;
+    }
+}
+
+
+size_t CONNECTED_LIST_BASE::GetReservedBytes() const
+{
+    return m_block ? blockBytes( m_block->m_capacity ) : 0;
+}
+
+
+size_t CONNECTED_LIST_BASE::GetArenaReservedBytes()
+{
+    return connectedListArena().GetReservedBytes();
+}
+
+
+CONNECTED_LIST_BASE::CONNECTED_LIST_BASE( const CONNECTED_LIST_BASE& aOther ) :
+    m_block( nullptr )
+{
+    assign( aOther.items(), aOther.size() );
+}
+
+
+CONNECTED_LIST_BASE& CONNECTED_LIST_BASE::operator=( const CONNECTED_LIST_BASE& aOther )
+{
+    if( this != &aOther )
+        assign( aOther.items(), aOther.size() );
+
+    return *this;
+}
+
+
+void CONNECTED_LIST_BASE::reserve( size_t aCount )
+{
+    if( aCount <= ( m_block ? m_block->m_capacity : 0 ) )
+        return;
+
+    // Capacities of 1, 3, 7, 15... items make blocks of 16, 32, 64, 128... bytes
+    size_t capacity = 1;
+
+    while( capacity < aCount )
+        capacity = capacity * 2 + 1;
+
+    BLOCK* block = static_cast<BLOCK*>( connectedListArena().Allocate( blockBytes( capacity ) ) );
+
+    block->m_size = 0;
+    block->m_capacity = capacity;
+
+    if( m_block )
+    {
+        std::copy( m_block->m_items, m_block->m_items + m_block->m_size, block->m_items );
+        block->m_size = m_block->m_size;
+        clear();
+    }
+
+    m_block = block;
+}
+
+
+void CONNECTED_LIST_BASE::push( void* aItem )
+{
+    reserve( size() + 1 );
+    m_block->m_items[m_block->m_size++] = aItem;
+}
+
+
+void CONNECTED_LIST_BASE::assign( void* const* aItems, size_t aCount )
+{
+    clear();
+
+    if( aCount == 0 )
+        return;
+
+    reserve( aCount );
+    std::copy( aItems, aItems + aCount, m_block->m_items );
+    m_block->m_size = aCount;
+}
+
 
 BOARD_CONNECTED_ITEM::BOARD_CONNECTED_ITEM( BOARD_ITEM* aParent, KICAD_T idtype ) :
     BOARD_ITEM( aParent, idtype ), m_netinfo( &NETINFO_LIST::ORPHANED_ITEM ),
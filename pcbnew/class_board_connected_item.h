@@ -34,10 +34,92 @@
 #include <class_board_item.h>
 #include <class_netinfo.h>
 
+#include <vector>
+#include <stdint.h>
+
 class NETCLASS;
 class TRACK;
 class D_PAD;
 
+#ifndef SWIG
+/**
+ * Class CONNECTED_LIST_BASE
+ * is the untyped storage of CONNECTED_LIST.  An empty list is a single null
+ * pointer; a non empty list is one block holding its size, capacity and items,
+ * carved from an arena shared by all the connection lists of the process.
+ * This keeps the two lists carried by every pad and track at 16 bytes instead
+ * of the 48 bytes of two std::vectors, and their content out of the general heap.
+ */
+class CONNECTED_LIST_BASE
+{
+public:
+    size_t size() const         { return m_block ? m_block->m_size : 0; }
+    bool empty() const          { return size() == 0; }
+
+    /// Empties the list and gives its block back to the arena.
+    void clear();
+
+    /// @return the number of bytes of arena used by the list.
+    size_t GetReservedBytes() const;
+
+    /// @return the number of bytes reserved by the arena of all the lists.
+    static size_t GetArenaReservedBytes();
+
+protected:
+    struct BLOCK
+    {
+        uint32_t    m_size;
+        uint32_t    m_capacity;
+        void*       m_items[1];     ///< m_capacity items actually
+    };
+
+    CONNECTED_LIST_BASE() : m_block( nullptr ) {}
+    CONNECTED_LIST_BASE( const CONNECTED_LIST_BASE& aOther );
+    ~CONNECTED_LIST_BASE()      { clear(); }
+
+    CONNECTED_LIST_BASE& operator=( const CONNECTED_LIST_BASE& aOther );
+
+    void* const* items() const  { return m_block ? m_block->m_items : nullptr; }
+
+    void push( void* aItem );
+    void assign( void* const* aItems, size_t aCount );
+
+private:
+    void reserve( size_t aCount );
+
+    BLOCK*  m_block;
+};
+
+
+/**
+ * Class CONNECTED_LIST
+ * is the compact, vector like container of the connection lists of
+ * BOARD_CONNECTED_ITEM.  Only the subset of the std::vector interface used by
+ * the connectivity code is provided.
+ */
+template <class T>
+class CONNECTED_LIST : public CONNECTED_LIST_BASE
+{
+public:
+    typedef T* const* const_iterator;
+
+    CONNECTED_LIST() {}
+
+    CONNECTED_LIST& operator=( const std::vector<T*>& aItems )
+    {
+        assign( reinterpret_cast<void* const*>( aItems.data() ), aItems.size() );
+        return *this;
+    }
+
+    void push_back( T* aItem )              { push( aItem ); }
+
+    T* operator[]( size_t aIndex ) const    { return static_cast<T*>( items()[aIndex] ); }
+
+    const_iterator begin() const    { return reinterpret_cast<const_iterator>( items() ); }
+    const_iterator end() const      { return begin() + size(); }
+};
+#endif
+
 /**
  * Class BOARD_CONNECTED_ITEM
  * is a base class derived from BOARD_ITEM for items that can be connected
@@ -50,15 +132,29 @@ class BOARD_CONNECTED_ITEM : public BOARD_ITEM
     friend class CONNECTIONS;
 
 public:
+#ifndef SWIG
     // These 2 members are used for temporary storage during connections calculations:
-    std::vector<TRACK*> m_TracksConnected;      // list of other tracks connected to me
-    std::vector<D_PAD*> m_PadsConnected;        // list of other pads connected to me
+    CONNECTED_LIST<TRACK> m_TracksConnected;    // list of other tracks connected to me
+    CONNECTED_LIST<D_PAD> m_PadsConnected;      // list of other pads connected to me
+#endif
 
     BOARD_CONNECTED_ITEM( BOARD_ITEM* aParent, KICAD_T idtype );
 
     // Do not create a copy constructor & operator=.
     // The ones generated by the compiler are adequate.
 
+    /// @return the tracks of m_TracksConnected, for the scripting interface.
+    std::vector<TRACK*> GetTracksConnected() const
+    {
+        return std::vector<TRACK*>( m_TracksConnected.begin(), m_TracksConnected.end() );
+    }
+
+    /// @return the pads of m_PadsConnected, for the scripting interface.
+    std::vector<D_PAD*> GetPadsConnected() const
+    {
+        return std::vector<D_PAD*>( m_PadsConnected.begin(), m_PadsConnected.end() );
+    }
+
     static inline bool ClassOf( const EDA_ITEM* aItem )
     {
         if( aItem == NULL )
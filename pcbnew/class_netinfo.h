@@ -37,6 +37,8 @@
 #include <gr_basic.h>
 #include <class_netclass.h>
 #include <class_board_item.h>
+#include <hashtables.h>
+#include <string_pool.h>
 
 
 
@@ -129,11 +131,11 @@ private:
     int m_NetCode;              ///< A number equivalent to the net name.
                                 ///< Used for fast comparisons in ratsnest and DRC computations.
 
-    wxString m_Netname;         ///< Full net name like /mysheet/mysubsheet/vout used by Eeschema
+    INTERNED_STRING m_Netname;      ///< Full net name like /mysheet/mysubsheet/vout used by Eeschema
 
-    wxString m_ShortNetname;    ///< short net name, like vout from /mysheet/mysubsheet/vout
+    INTERNED_STRING m_ShortNetname; ///< short net name, like vout from /mysheet/mysubsheet/vout
 
-    wxString  m_NetClassName;   // Net Class name. if void this is equivalent
+    INTERNED_STRING m_NetClassName; // Net Class name. if void this is equivalent
                                 // to "default" (the first
                                 // item of the net classes list
     NETCLASSPTR m_NetClass;
@@ -325,6 +327,20 @@ public:
      */
     const wxString& GetShortNetname() const { return m_ShortNetname; }
 
+    /**
+     * Function GetNetnameHash
+     * @return size_t - the WXSTRING_HASH of the full netname, precomputed so that
+     * names can be looked up and compared without hashing them again.
+     */
+    size_t GetNetnameHash() const { return m_Netname.GetHash(); }
+
+    /**
+     * Function GetNetnameId
+     * @return the STRING_POOL identifier of the full netname: nets of different boards
+     * having the same name have the same identifier.
+     */
+    unsigned GetNetnameId() const { return m_Netname.GetId(); }
+
     /**
      * Function GetMsgPanelInfo
      * returns the information about the #NETINFO_ITEM in \a aList to display in the
@@ -396,7 +412,7 @@ public:
     class iterator
     {
     public:
-        iterator( std::map<int, int>::const_iterator aIter, const NETINFO_MAPPING* aMapping ) :
+        iterator( std::vector<int>::const_iterator aIter, const NETINFO_MAPPING* aMapping ) :
             m_iterator( aIter ), m_mapping( aMapping )
         {
         }
@@ -433,7 +449,7 @@ public:
         }
 
     private:
-        std::map<int, int>::const_iterator m_iterator;
+        std::vector<int>::const_iterator m_iterator;
         const NETINFO_MAPPING* m_mapping;
     };
 
@@ -445,7 +461,7 @@ public:
      */
     iterator begin() const
     {
-        return iterator( m_netMapping.begin(), this );
+        return iterator( m_usedNets.begin(), this );
     }
 
     /**
@@ -456,7 +472,7 @@ public:
      */
     iterator end() const
     {
-        return iterator( m_netMapping.end(), this );
+        return iterator( m_usedNets.end(), this );
     }
 
     /**
@@ -465,15 +481,19 @@ public:
      */
     int GetSize() const
     {
-        return m_netMapping.size();
+        return m_usedNets.size();
     }
 
 private:
     ///> Board for which mapping is prepared
     const BOARD* m_board;
 
-    ///> Map that allows saving net codes with consecutive numbers (for compatibility reasons)
-    std::map<int, int> m_netMapping;
+    ///> Sorted net codes in use; the position of a net code is its consecutive number
+    ///> (net codes are saved as consecutive numbers for compatibility reasons)
+    std::vector<int> m_usedNets;
+
+    ///> Consecutive number of each non negative net code, indexed by net code, -1 if unused
+    std::vector<int> m_translation;
 };
 
 
@@ -680,6 +700,13 @@ private:
     NETNAMES_MAP m_netNames;        ///< map of <wxString, NETINFO_ITEM*>, is NETINFO_ITEM owner
     NETCODES_MAP m_netCodes;        ///< map of <int, NETINFO_ITEM*> is NOT owner
 
+#ifndef SWIG
+    // Constant time lookup indices, the maps above are kept for python and for
+    // iterating in name order.  Both are NOT owners.
+    std::vector<NETINFO_ITEM*> m_netCodeIndex;      ///< indexed by net code, NULL for holes
+    std::unordered_multimap<size_t, NETINFO_ITEM*> m_netNameIndex;  ///< keyed by GetNetnameHash()
+#endif
+
     D_PADS  m_PadsFullList;         ///< contains all pads, sorted by pad's netname.
                                     ///< can be used in ratsnest calculations.
 
@@ -51,7 +51,7 @@
 
 NETINFO_ITEM::NETINFO_ITEM( BOARD* aParent, const wxString& aNetName, int aNetCode ) :
     BOARD_ITEM( aParent, PCB_NETINFO_T ),
-    m_NetCode( aNetCode ), m_Netname( aNetName ), m_ShortNetname( m_Netname.AfterLast( '/' ) )
+    m_NetCode( aNetCode ), m_Netname( aNetName ), m_ShortNetname( aNetName.AfterLast( '/' ) )
 {
     m_parent   = aParent;
     m_RatsnestStartIdx = 0;     // Starting point of ratsnests of this net in a
@@ -39,6 +39,8 @@
 #include <class_zone.h>
 #include <class_netinfo.h>
 
+#include <algorithm>
+
 
 // Constructor and destructor
 NETINFO_LIST::NETINFO_LIST( BOARD* aParent ) : m_Parent( aParent )
@@ -65,16 +67,16 @@ void NETINFO_LIST::clear()
     m_PadsFullList.clear();
     m_netNames.clear();
     m_netCodes.clear();
+    m_netCodeIndex.clear();
+    m_netNameIndex.clear();
     m_newNetCode = 0;
 }
 
 
 NETINFO_ITEM* NETINFO_LIST::GetNetItem( int aNetCode ) const
 {
-    NETCODES_MAP::const_iterator result = m_netCodes.find( aNetCode );
-
-    if( result != m_netCodes.end() )
-        return (*result).second;
+    if( aNetCode >= 0 && aNetCode < (int) m_netCodeIndex.size() )
+        return m_netCodeIndex[aNetCode];
 
     return NULL;
 }
@@ -82,10 +84,14 @@ NETINFO_ITEM* NETINFO_LIST::GetNetItem( int aNetCode ) const
 
 NETINFO_ITEM* NETINFO_LIST::GetNetItem( const wxString& aNetName ) const
 {
-    NETNAMES_MAP::const_iterator result = m_netNames.find( aNetName );
+    // Only reads the index, so lookups need no lock once the nets are loaded.
+    auto range = m_netNameIndex.equal_range( WXSTRING_HASH()( aNetName ) );
 
-    if( result != m_netNames.end() )
-        return (*result).second;
+    for( auto it = range.first; it != range.second; ++it )
+    {
+        if( it->second->GetNetname() == aNetName )
+            return it->second;
+    }
 
     return NULL;
 }
@@ -93,20 +99,32 @@ NETINFO_ITEM* NETINFO_LIST::GetNetItem( const wxString& aNetName ) const
 
 void NETINFO_LIST::RemoveNet( NETINFO_ITEM* aNet )
 {
-    for( NETCODES_MAP::iterator i = m_netCodes.begin(); i != m_netCodes.end(); ++i )
+    NETCODES_MAP::iterator codeIt = m_netCodes.find( aNet->GetNet() );
+
+    if( codeIt != m_netCodes.end() && codeIt->second == aNet )
+        m_netCodes.erase( codeIt );
+
+    NETNAMES_MAP::iterator nameIt = m_netNames.find( aNet->GetNetname() );
+
+    if( nameIt != m_netNames.end() && nameIt->second == aNet )
+        m_netNames.erase( nameIt );
+
+    if( aNet->GetNet() >= 0 && aNet->GetNet() < (int) m_netCodeIndex.size()
+            && m_netCodeIndex[aNet->GetNet()] == aNet )
     {
-        if ( i->second == aNet )
-        {
-            m_netCodes.erase(i);
-            break;
-        }
+        m_netCodeIndex[aNet->GetNet()] = NULL;
+
+        while( !m_netCodeIndex.empty() && !m_netCodeIndex.back() )
+            m_netCodeIndex.pop_back();
     }
 
-    for( NETNAMES_MAP::iterator i = m_netNames.begin(); i != m_netNames.end(); ++i )
+    auto range = m_netNameIndex.equal_range( aNet->GetNetnameHash() );
+
+    for( auto it = range.first; it != range.second; ++it )
     {
-        if ( i->second == aNet )
+        if( it->second == aNet )
         {
-            m_netNames.erase(i);
+            m_netNameIndex.erase( it );
             break;
         }
     }
@@ -140,6 +158,15 @@ void NETINFO_LIST::AppendNet( NETINFO_ITEM* aNewElement )
     // add an entry for fast look up by a net name using a map
     m_netNames.insert( std::make_pair( aNewElement->GetNetname(), aNewElement ) );
     m_netCodes.insert( std::make_pair( aNewElement->GetNet(), aNewElement ) );
+
+    // and the same for the constant time lookup indices
+    int netCode = aNewElement->GetNet();
+
+    if( netCode >= (int) m_netCodeIndex.size() )
+        m_netCodeIndex.resize( netCode + 1, NULL );
+
+    m_netCodeIndex[netCode] = aNewElement;
+    m_netNameIndex.insert( std::make_pair( aNewElement->GetNetnameHash(), aNewElement ) );
 }
 
 
@@ -296,7 +323,7 @@ int NETINFO_LIST::getFreeNetCode()
     do {
         if( m_newNetCode < 0 )
             m_newNetCode = 0;
-    } while( m_netCodes.count( ++m_newNetCode ) != 0 );
+    } while( GetNetItem( ++m_newNetCode ) != NULL );
 
     return m_newNetCode;
 }
@@ -304,10 +331,18 @@ int NETINFO_LIST::getFreeNetCode()
 
 int NETINFO_MAPPING::Translate( int aNetCode ) const
 {
-    std::map<int, int>::const_iterator value = m_netMapping.find( aNetCode );
+    if( aNetCode >= 0 && aNetCode < (int) m_translation.size() && m_translation[aNetCode] >= 0 )
+        return m_translation[aNetCode];
 
-    if( value != m_netMapping.end() )
-        return value->second;
+    if( aNetCode < 0 )
+    {
+        // Negative net codes are unusual, they are the first entries of m_usedNets
+        std::vector<int>::const_iterator value =
+            std::lower_bound( m_usedNets.begin(), m_usedNets.end(), aNetCode );
+
+        if( value != m_usedNets.end() && *value == aNetCode )
+            return value - m_usedNets.begin();
+    }
 
     // There was no entry for the given net code
     return aNetCode;
@@ -317,52 +352,57 @@ int NETINFO_MAPPING::Translate( int aNetCode ) const
 void NETINFO_MAPPING::Update()
 {
     // Collect all the used nets
-    std::set<int> nets;
+    std::vector<int> nets;
 
     // Be sure that the unconnected gets 0 and is mapped as 0
-    nets.insert( 0 );
+    nets.push_back( 0 );
 
     // Zones
     for( int i = 0; i < m_board->GetAreaCount(); ++i )
-        nets.insert( m_board->GetArea( i )->GetNetCode() );
+        nets.push_back( m_board->GetArea( i )->GetNetCode() );
 
     // Tracks
     for( TRACK* track = m_board->m_Track; track; track = track->Next() )
-        nets.insert( track->GetNetCode() );
+        nets.push_back( track->GetNetCode() );
 
     // Modules/pads
     for( MODULE* module = m_board->m_Modules; module; module = module->Next() )
     {
         for( D_PAD* pad = module->Pads().GetFirst(); pad; pad = pad->Next() )
         {
-            nets.insert( pad->GetNetCode() );
+            nets.push_back( pad->GetNetCode() );
         }
     }
 
     // Segzones
     for( SEGZONE* zone = m_board->m_Zone; zone; zone = zone->Next() )
-        nets.insert( zone->GetNetCode() );
+        nets.push_back( zone->GetNetCode() );
 
-    // Prepare the new mapping
-    m_netMapping.clear();
+    std::sort( nets.begin(), nets.end() );
+    nets.erase( std::unique( nets.begin(), nets.end() ), nets.end() );
 
     // Now the nets variable stores all the used net codes (not only for pads) and we are ready to
     // assign new consecutive net numbers
-    int newNetCode = 0;
-    for( std::set<int>::const_iterator it = nets.begin(), itEnd = nets.end(); it != itEnd; ++it )
-        m_netMapping[*it] = newNetCode++;
+    m_usedNets.swap( nets );
+    m_translation.assign( m_usedNets.empty() ? 0 : std::max( m_usedNets.back() + 1, 0 ), -1 );
+
+    for( unsigned newNetCode = 0; newNetCode < m_usedNets.size(); ++newNetCode )
+    {
+        if( m_usedNets[newNetCode] >= 0 )
+            m_translation[ m_usedNets[newNetCode] ] = newNetCode;
+    }
 }
 
 
 NETINFO_ITEM* NETINFO_MAPPING::iterator::operator*() const
 {
-    return m_mapping->m_board->FindNet( m_iterator->first );
+    return m_mapping->m_board->FindNet( *m_iterator );
 }
 
 
 NETINFO_ITEM* NETINFO_MAPPING::iterator::operator->() const
 {
-    return m_mapping->m_board->FindNet( m_iterator->first );
+    return m_mapping->m_board->FindNet( *m_iterator );
 }
 
 
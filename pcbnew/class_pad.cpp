@@ -43,10 +43,147 @@
 #include <polygon_test_point_inside.h>
 #include <convert_to_biu.h>
 #include <convert_basic_shapes_to_polygon.h>
+#include <mutex>
+#include <unordered_set>
 
 
 int D_PAD::m_PadSketchModePenSize = 0;      // Pen size used to draw pads in sketch mode
 
+static_assert( sizeof( PAD_LOCAL_SETTINGS_REF ) == sizeof( void* ),
+               "pads must hold their local settings in a single pointer" );
+
+
+PAD_LOCAL_SETTINGS::PAD_LOCAL_SETTINGS() :
+    m_LengthPadToDie( 0 ),
+    m_Clearance( 0 ),
+    m_SolderMaskMargin( 0 ),
+    m_SolderPasteMargin( 0 ),
+    m_SolderPasteMarginRatio( 0.0 ),
+    m_ZoneConnection( PAD_ZONE_CONN_INHERITED ),    // Use parent setting by default
+    m_ThermalWidth( 0 ),                            // Use parent setting by default
+    m_ThermalGap( 0 ),                              // Use parent setting by default
+    m_refCount( 0 )
+{
+}
+
+
+PAD_LOCAL_SETTINGS::PAD_LOCAL_SETTINGS( const PAD_LOCAL_SETTINGS& aOther ) :
+    m_LengthPadToDie( aOther.m_LengthPadToDie ),
+    m_Clearance( aOther.m_Clearance ),
+    m_SolderMaskMargin( aOther.m_SolderMaskMargin ),
+    m_SolderPasteMargin( aOther.m_SolderPasteMargin ),
+    m_SolderPasteMarginRatio( aOther.m_SolderPasteMarginRatio ),
+    m_ZoneConnection( aOther.m_ZoneConnection ),
+    m_ThermalWidth( aOther.m_ThermalWidth ),
+    m_ThermalGap( aOther.m_ThermalGap ),
+    m_refCount( 0 )
+{
+}
+
+
+bool PAD_LOCAL_SETTINGS::operator==( const PAD_LOCAL_SETTINGS& aOther ) const
+{
+    return m_LengthPadToDie == aOther.m_LengthPadToDie
+        && m_Clearance == aOther.m_Clearance
+        && m_SolderMaskMargin == aOther.m_SolderMaskMargin
+        && m_SolderPasteMargin == aOther.m_SolderPasteMargin
+        && m_SolderPasteMarginRatio == aOther.m_SolderPasteMarginRatio
+        && m_ZoneConnection == aOther.m_ZoneConnection
+        && m_ThermalWidth == aOther.m_ThermalWidth
+        && m_ThermalGap == aOther.m_ThermalGap;
+}
+
+
+struct PAD_LOCAL_SETTINGS_HASH
+{
+    size_t operator()( const PAD_LOCAL_SETTINGS& aSettings ) const
+    {
+        int values[] = { aSettings.m_LengthPadToDie, aSettings.m_Clearance,
+                         aSettings.m_SolderMaskMargin, aSettings.m_SolderPasteMargin,
+                         aSettings.m_ZoneConnection, aSettings.m_ThermalWidth,
+                         aSettings.m_ThermalGap };
+        size_t hash = std::hash<double>()( aSettings.m_SolderPasteMarginRatio );
+
+        for( int value : values )
+            hash = hash * 31 + std::hash<int>()( value );
+
+        return hash;
+    }
+};
+
+
+// Elements of an unordered_set do not move, so pads can keep pointers to them.
+// The set is leaked: pads may be destroyed by static destructors.
+typedef std::unordered_set<PAD_LOCAL_SETTINGS, PAD_LOCAL_SETTINGS_HASH> PAD_SETTINGS_SET;
+
+static std::mutex s_padSettingsLock;
+
+
+static PAD_SETTINGS_SET& padSettings()
+{
+    static PAD_SETTINGS_SET* settings = new PAD_SETTINGS_SET;
+
+    return *settings;
+}
+
+
+PAD_LOCAL_SETTINGS_REF PAD_LOCAL_SETTINGS::Intern( const PAD_LOCAL_SETTINGS& aSettings )
+{
+    std::lock_guard<std::mutex> lock( s_padSettingsLock );
+
+    const PAD_LOCAL_SETTINGS* shared = &*padSettings().insert( aSettings ).first;
+
+    shared->m_refCount++;
+
+    return PAD_LOCAL_SETTINGS_REF( shared );
+}
+
+
+void PAD_LOCAL_SETTINGS::release( const PAD_LOCAL_SETTINGS* aSettings )
+{
+    std::lock_guard<std::mutex> lock( s_padSettingsLock );
+
+    if( --aSettings->m_refCount == 0 )
+        padSettings().erase( *aSettings );
+}
+
+
+void PAD_LOCAL_SETTINGS_REF::release()
+{
+    if( !m_settings )
+        return;
+
+    // The count only drops to zero under the lock of Intern(), so a shared copy
+    // cannot be handed out again while it is being removed.
+    int count = m_settings->m_refCount.load();
+
+    while( count > 1 && !m_settings->m_refCount.compare_exchange_weak( count, count - 1 ) )
+        ;
+
+    if( count <= 1 )
+        PAD_LOCAL_SETTINGS::release( m_settings );
+
+    m_settings = nullptr;
+}
+
+
+size_t PAD_LOCAL_SETTINGS::GetInternedCount()
+{
+    std::lock_guard<std::mutex> lock( s_padSettingsLock );
+
+    return padSettings().size();
+}
+
+
+PAD_LOCAL_SETTINGS_REF PAD_LOCAL_SETTINGS::Default()
+{
+    // Leaked, like the set, so the defaults stay shared until the end.
+    static PAD_LOCAL_SETTINGS_REF* defaults =
+            new PAD_LOCAL_SETTINGS_REF( Intern( PAD_LOCAL_SETTINGS() ) );
+
+    return *defaults;
+}
+
 
 D_PAD::D_PAD( MODULE* parent ) :
     BOARD_CONNECTED_ITEM( parent, PCB_PAD_T )
@@ -55,7 +192,7 @@ D_PAD::D_PAD( MODULE* parent ) :
     m_Size.x = m_Size.y   = Mils2iu( 60 );  // Default pad size 60 mils.
     m_Drill.x = m_Drill.y = Mils2iu( 30 );  // Default drill size 30 mils.
     m_Orient              = 0;              // Pad rotation in 1/10 degrees.
-    m_LengthPadToDie      = 0;
+    m_localSettings       = PAD_LOCAL_SETTINGS::Default();
 
     if( m_Parent  &&  m_Parent->Type() == PCB_MODULE_T )
     {
@@ -65,17 +202,9 @@ D_PAD::D_PAD( MODULE* parent ) :
     SetShape( PAD_SHAPE_CIRCLE );                   // Default pad shape is PAD_CIRCLE.
     SetDrillShape( PAD_DRILL_SHAPE_CIRCLE );        // Default pad drill shape is a circle.
     m_Attribute           = PAD_ATTRIB_STANDARD;    // Default pad type is NORMAL (thru hole)
-    m_LocalClearance      = 0;
-    m_LocalSolderMaskMargin  = 0;
-    m_LocalSolderPasteMargin = 0;
-    m_LocalSolderPasteMarginRatio = 0.0;
     // Parameters for round rect only:
     m_padRoundRectRadiusScale = 0.25;                   // from  IPC-7351C standard
 
-    m_ZoneConnection      = PAD_ZONE_CONN_INHERITED; // Use parent setting by default
-    m_ThermalWidth        = 0;                  // Use parent setting by default
-    m_ThermalGap          = 0;                  // Use parent setting by default
-
     // Set layers mask to default for a standard thru hole pad.
     m_layerMask           = StandardMask();
 
@@ -432,22 +561,92 @@ void D_PAD::CopyNetlistSettings( D_PAD* aPad, bool aCopyLocalSettings )
 
     if( aCopyLocalSettings )
     {
-        aPad->SetLocalClearance( m_LocalClearance );
-        aPad->SetLocalSolderMaskMargin( m_LocalSolderMaskMargin );
-        aPad->SetLocalSolderPasteMargin( m_LocalSolderPasteMargin );
-        aPad->SetLocalSolderPasteMarginRatio( m_LocalSolderPasteMarginRatio );
-        aPad->SetZoneConnection( m_ZoneConnection );
-        aPad->SetThermalWidth( m_ThermalWidth );
-        aPad->SetThermalGap( m_ThermalGap );
+        // The pad to die length is a geometry setting, it is not copied.
+        PAD_LOCAL_SETTINGS settings = *m_localSettings;
+
+        settings.m_LengthPadToDie = aPad->GetPadToDieLength();
+        aPad->setLocalSettings( settings );
     }
 }
 
 
+void D_PAD::SetPadToDieLength( int aLength )
+{
+    PAD_LOCAL_SETTINGS settings = *m_localSettings;
+
+    settings.m_LengthPadToDie = aLength;
+    setLocalSettings( settings );
+}
+
+
+void D_PAD::SetLocalSolderMaskMargin( int aMargin )
+{
+    PAD_LOCAL_SETTINGS settings = *m_localSettings;
+
+    settings.m_SolderMaskMargin = aMargin;
+    setLocalSettings( settings );
+}
+
+
+void D_PAD::SetLocalClearance( int aClearance )
+{
+    PAD_LOCAL_SETTINGS settings = *m_localSettings;
+
+    settings.m_Clearance = aClearance;
+    setLocalSettings( settings );
+}
+
+
+void D_PAD::SetLocalSolderPasteMargin( int aMargin )
+{
+    PAD_LOCAL_SETTINGS settings = *m_localSettings;
+
+    settings.m_SolderPasteMargin = aMargin;
+    setLocalSettings( settings );
+}
+
+
+void D_PAD::SetLocalSolderPasteMarginRatio( double aRatio )
+{
+    PAD_LOCAL_SETTINGS settings = *m_localSettings;
+
+    settings.m_SolderPasteMarginRatio = aRatio;
+    setLocalSettings( settings );
+}
+
+
+void D_PAD::SetZoneConnection( ZoneConnection aType )
+{
+    PAD_LOCAL_SETTINGS settings = *m_localSettings;
+
+    settings.m_ZoneConnection = aType;
+    setLocalSettings( settings );
+}
+
+
+void D_PAD::SetThermalWidth( int aWidth )
+{
+    PAD_LOCAL_SETTINGS settings = *m_localSettings;
+
+    settings.m_ThermalWidth = aWidth;
+    setLocalSettings( settings );
+}
+
+
+void D_PAD::SetThermalGap( int aGap )
+{
+    PAD_LOCAL_SETTINGS settings = *m_localSettings;
+
+    settings.m_ThermalGap = aGap;
+    setLocalSettings( settings );
+}
+
+
 int D_PAD::GetClearance( BOARD_CONNECTED_ITEM* aItem ) const
 {
     // A pad can have specific clearance parameters that
     // overrides its NETCLASS clearance value
-    int clearance = m_LocalClearance;
+    int clearance = m_localSettings->m_Clearance;
 
     if( clearance == 0 )
     {
@@ -476,7 +675,7 @@ int D_PAD::GetClearance( BOARD_CONNECTED_ITEM* aItem ) const
 
 int D_PAD::GetSolderMaskMargin() const
 {
-    int     margin = m_LocalSolderMaskMargin;
+    int     margin = m_localSettings->m_SolderMaskMargin;
     MODULE* module = GetParent();
 
     if( module )
@@ -509,8 +708,8 @@ int D_PAD::GetSolderMaskMargin() const
 
 wxSize D_PAD::GetSolderPasteMargin() const
 {
-    int     margin = m_LocalSolderPasteMargin;
-    double  mratio = m_LocalSolderPasteMarginRatio;
+    int     margin = m_localSettings->m_SolderPasteMargin;
+    double  mratio = m_localSettings->m_SolderPasteMarginRatio;
     MODULE* module = GetParent();
 
     if( module )
@@ -551,10 +750,10 @@ ZoneConnection D_PAD::GetZoneConnection() const
 {
     MODULE* module = GetParent();
 
-    if( m_ZoneConnection == PAD_ZONE_CONN_INHERITED && module )
+    if( m_localSettings->m_ZoneConnection == PAD_ZONE_CONN_INHERITED && module )
         return module->GetZoneConnection();
     else
-        return m_ZoneConnection;
+        return m_localSettings->m_ZoneConnection;
 }
 
 
@@ -562,10 +761,10 @@ int D_PAD::GetThermalWidth() const
 {
     MODULE* module = GetParent();
 
-    if( m_ThermalWidth == 0 && module )
+    if( m_localSettings->m_ThermalWidth == 0 && module )
         return module->GetThermalWidth();
     else
-        return m_ThermalWidth;
+        return m_localSettings->m_ThermalWidth;
 }
 
 
@@ -573,10 +772,10 @@ int D_PAD::GetThermalGap() const
 {
     MODULE* module = GetParent();
 
-    if( m_ThermalGap == 0 && module )
+    if( m_localSettings->m_ThermalGap == 0 && module )
         return module->GetThermalGap();
     else
-        return m_ThermalGap;
+        return m_localSettings->m_ThermalGap;
 }
 
 
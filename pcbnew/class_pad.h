@@ -31,6 +31,8 @@
 #define PAD_H_
 
 
+#include <atomic>
+
 #include <class_board_item.h>
 #include <class_board_connected_item.h>
 #include <pad_shapes.h>
@@ -73,6 +75,105 @@ public:
 };
 
 
+#ifndef SWIG
+class PAD_LOCAL_SETTINGS_REF;
+
+/**
+ * Struct PAD_LOCAL_SETTINGS
+ * holds the pad settings overriding the footprint and board values.  They are
+ * left to their default (inherited) values on nearly all the pads, so pads do
+ * not store them but point to a shared, immutable copy: see D_PAD::setLocalSettings().
+ */
+struct PAD_LOCAL_SETTINGS
+{
+    PAD_LOCAL_SETTINGS();
+
+    /// Copies the settings, not the count of the pads sharing them.
+    PAD_LOCAL_SETTINGS( const PAD_LOCAL_SETTINGS& aOther );
+
+    bool operator==( const PAD_LOCAL_SETTINGS& aOther ) const;
+
+    /**
+     * Function Intern
+     * @return a reference to the shared copy of \a aSettings, created on first use.
+     * The shared copy is removed when the last reference to it goes away.
+     */
+    static PAD_LOCAL_SETTINGS_REF Intern( const PAD_LOCAL_SETTINGS& aSettings );
+
+    /// @return the number of distinct settings shared by the pads.
+    static size_t GetInternedCount();
+
+    /// @return a reference to the shared copy of the default settings, which is never removed.
+    static PAD_LOCAL_SETTINGS_REF Default();
+
+    int             m_LengthPadToDie;
+    int             m_Clearance;
+    int             m_SolderMaskMargin;
+    int             m_SolderPasteMargin;
+    double          m_SolderPasteMarginRatio;
+    ZoneConnection  m_ZoneConnection;
+    int             m_ThermalWidth;
+    int             m_ThermalGap;
+
+private:
+    PAD_LOCAL_SETTINGS& operator=( const PAD_LOCAL_SETTINGS& aOther ) = delete;
+
+    friend class PAD_LOCAL_SETTINGS_REF;
+
+    /// Drops the last reference to \a aSettings and removes it if no other one was taken.
+    static void release( const PAD_LOCAL_SETTINGS* aSettings );
+
+    mutable std::atomic<int> m_refCount;    ///< references to the shared copy
+};
+
+
+/**
+ * Class PAD_LOCAL_SETTINGS_REF
+ * is a counted reference to a shared PAD_LOCAL_SETTINGS, as small as a pointer.
+ */
+class PAD_LOCAL_SETTINGS_REF
+{
+public:
+    PAD_LOCAL_SETTINGS_REF() : m_settings( nullptr ) {}
+
+    PAD_LOCAL_SETTINGS_REF( const PAD_LOCAL_SETTINGS_REF& aOther ) :
+        m_settings( aOther.m_settings )
+    {
+        if( m_settings )
+            m_settings->m_refCount++;
+    }
+
+    ~PAD_LOCAL_SETTINGS_REF()   { release(); }
+
+    PAD_LOCAL_SETTINGS_REF& operator=( const PAD_LOCAL_SETTINGS_REF& aOther )
+    {
+        if( aOther.m_settings )
+            aOther.m_settings->m_refCount++;
+
+        release();
+        m_settings = aOther.m_settings;
+        return *this;
+    }
+
+    const PAD_LOCAL_SETTINGS* operator->() const    { return m_settings; }
+    const PAD_LOCAL_SETTINGS& operator*() const     { return *m_settings; }
+
+private:
+    friend struct PAD_LOCAL_SETTINGS;
+
+    /// Takes over a reference already counted by PAD_LOCAL_SETTINGS::Intern().
+    explicit PAD_LOCAL_SETTINGS_REF( const PAD_LOCAL_SETTINGS* aSettings ) :
+        m_settings( aSettings )
+    {
+    }
+
+    void release();
+
+    const PAD_LOCAL_SETTINGS* m_settings;
+};
+#endif
+
+
 class D_PAD : public BOARD_CONNECTED_ITEM
 {
 public:
@@ -225,20 +326,23 @@ public:
     void SetAttribute( PAD_ATTR_T aAttribute );
     PAD_ATTR_T GetAttribute() const             { return m_Attribute; }
 
-    void SetPadToDieLength( int aLength )       { m_LengthPadToDie = aLength; }
-    int GetPadToDieLength() const               { return m_LengthPadToDie; }
+    void SetPadToDieLength( int aLength );
+    int GetPadToDieLength() const               { return m_localSettings->m_LengthPadToDie; }
 
-    int GetLocalSolderMaskMargin() const        { return m_LocalSolderMaskMargin; }
-    void SetLocalSolderMaskMargin( int aMargin ) { m_LocalSolderMaskMargin = aMargin; }
+    int GetLocalSolderMaskMargin() const        { return m_localSettings->m_SolderMaskMargin; }
+    void SetLocalSolderMaskMargin( int aMargin );
 
-    int GetLocalClearance() const               { return m_LocalClearance; }
-    void SetLocalClearance( int aClearance )    { m_LocalClearance = aClearance; }
+    int GetLocalClearance() const               { return m_localSettings->m_Clearance; }
+    void SetLocalClearance( int aClearance );
 
-    int GetLocalSolderPasteMargin() const       { return m_LocalSolderPasteMargin; }
-    void SetLocalSolderPasteMargin( int aMargin ) { m_LocalSolderPasteMargin = aMargin; }
+    int GetLocalSolderPasteMargin() const       { return m_localSettings->m_SolderPasteMargin; }
+    void SetLocalSolderPasteMargin( int aMargin );
 
-    double GetLocalSolderPasteMarginRatio() const { return m_LocalSolderPasteMarginRatio; }
-    void SetLocalSolderPasteMarginRatio( double aRatio ) { m_LocalSolderPasteMarginRatio = aRatio; }
+    double GetLocalSolderPasteMarginRatio() const
+    {
+        return m_localSettings->m_SolderPasteMarginRatio;
+    }
+    void SetLocalSolderPasteMarginRatio( double aRatio );
 
 
     /**
@@ -294,13 +398,13 @@ public:
      */
     wxSize GetSolderPasteMargin() const;
 
-    void SetZoneConnection( ZoneConnection aType ) { m_ZoneConnection = aType; }
+    void SetZoneConnection( ZoneConnection aType );
     ZoneConnection GetZoneConnection() const;
 
-    void SetThermalWidth( int aWidth ) { m_ThermalWidth = aWidth; }
+    void SetThermalWidth( int aWidth );
     int GetThermalWidth() const;
 
-    void SetThermalGap( int aGap ) { m_ThermalGap = aGap; }
+    void SetThermalGap( int aGap );
     int GetThermalGap() const;
 
     /* drawing functions */
@@ -574,6 +678,14 @@ private:
      */
     int boundingRadius() const;
 
+#ifndef SWIG
+    /// Points the pad to the shared copy of \a aSettings, releasing the previous one.
+    void setLocalSettings( const PAD_LOCAL_SETTINGS& aSettings )
+    {
+        m_localSettings = PAD_LOCAL_SETTINGS::Intern( aSettings );
+    }
+#endif
+
 private:    // Private variable members:
 
     // Actually computed and cached on demand by the accessor
@@ -639,25 +751,15 @@ private:    // Private variable members:
                                     ///< PAD_ATTRIB_CONN, PAD_ATTRIB_HOLE_NOT_PLATED
     double      m_Orient;           ///< in 1/10 degrees
 
-    int         m_LengthPadToDie;   ///< Length net from pad to die, inside the package
-
-    /// Local clearance. When null, the module default value is used.
-    /// when the module default value is null, the netclass value is used
-    /// Usually the local clearance is null
-    int         m_LocalClearance;
-
-    /// Local mask margins: when 0, the parent footprint design values are used
-
-    int         m_LocalSolderMaskMargin;        ///< Local solder mask margin
-    int         m_LocalSolderPasteMargin;       ///< Local solder paste margin absolute value
-
-    double      m_LocalSolderPasteMarginRatio;  ///< Local solder mask margin ratio value of pad size
-                                                ///< The final margin is the sum of these 2 values
-    /// how the connection to zone is made: no connection, thermal relief ...
-    ZoneConnection m_ZoneConnection;
-
-    int         m_ThermalWidth;
-    int         m_ThermalGap;
+#ifndef SWIG
+    /// Local overrides, shared between the pads having the same ones:
+    /// - length net from pad to die, inside the package
+    /// - local clearance. When null, the module default value is used;
+    ///   when the module default value is null, the netclass value is used
+    /// - local mask margins: when 0, the parent footprint design values are used
+    /// - how the connection to zone is made: no connection, thermal relief ...
+    PAD_LOCAL_SETTINGS_REF m_localSettings;
+#endif
 };
 
 #endif  // PAD_H_
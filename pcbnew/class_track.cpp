@@ -45,6 +45,7 @@
 #include <pcbnew.h>
 #include <base_units.h>
 #include <msgpanel.h>
+#include <memory_pool.h>
 
 
 /**
@@ -93,6 +94,33 @@ TRACK* GetTrack( TRACK* aStartTrace, const TRACK* aEndTrace,
 }
 
 
+// Never destroyed, tracks may still be freed while static objects are destroyed.
+static MEMORY_POOL_SET& trackArena()
+{
+    static MEMORY_POOL_SET* arena = new MEMORY_POOL_SET;
+
+    return *arena;
+}
+
+
+void* TRACK::operator new( size_t aSize )
+{
+    return trackArena().Allocate( aSize );
+}
+
+
+void TRACK::operator delete( void* aBlock, size_t aSize )
+{
+    trackArena().Free( aBlock, aSize );
+}
+
+
+size_t TRACK::GetArenaReservedBytes()
+{
+    return trackArena().GetReservedBytes();
+}
+
+
 TRACK::TRACK( BOARD_ITEM* aParent, KICAD_T idtype ) :
     BOARD_CONNECTED_ITEM( aParent, idtype )
 {
@@ -42,17 +42,233 @@
 #include <class_draw_panel_gal.h>
 #include <view/view.h>
 #include <geometry/seg.h>
+#include <geometry/rtree.h>
 #include <ratsnest_data.h>
+#include <pgm_base.h>
+#include <task_scheduler.h>
 
 #include <tool/tool_manager.h>
 #include <tools/common_actions.h>
 
 #include <pcbnew.h>
 #include <drc_stuff.h>
+#include <profile_trace.h>
 
 #include <dialog_drc.h>
 #include <wx/progdlg.h>
 
+#include <algorithm>
+#include <cmath>
+
+
+/**
+ * A violation found by a test running on the task scheduler.  Its marker is only
+ * created afterwards, on the calling thread.
+ */
+struct DRC_HIT
+{
+    TRACK*  m_track;        ///< the track or via, NULL for a pad
+    D_PAD*  m_pad;
+    int     m_errorCode;
+};
+
+
+/**
+ * Class DRC_ITEM_INDEX
+ * indexes the tracks, vias and optionally the pads of some copper layers in one R-tree
+ * per layer, so that the texts and keepout areas are only tested against the items
+ * close to them.  The items are stored by their rank in the board lists and are
+ * returned sorted by rank: the tests visit them in the order of a scan of the board,
+ * and create the same markers in the same order.
+ */
+class DRC_ITEM_INDEX
+{
+public:
+    DRC_ITEM_INDEX( BOARD* aBoard, LSET aLayers, bool aIndexPads );
+
+    /// Tracks and vias of BOARD::m_Track, by rank.
+    const std::vector<TRACK*>& Tracks() const   { return m_tracks; }
+
+    /// Pads of BOARD::GetPads(), by rank.
+    const std::vector<D_PAD*>& Pads() const     { return m_pads; }
+
+    int TrackClearance( int aRank ) const       { return m_trackClearances[aRank]; }
+    int PadClearance( int aRank ) const         { return m_padClearances[aRank]; }
+
+    /// @return the largest clearance of the tracks and vias on \a aLayer.
+    int MaxTrackClearance( LAYER_ID aLayer ) const { return m_layers[aLayer].m_maxTrackClearance; }
+
+    /// @return the largest clearance of the pads on \a aLayer.
+    int MaxPadClearance( LAYER_ID aLayer ) const { return m_layers[aLayer].m_maxPadClearance; }
+
+    /**
+     * Function QueryTracks
+     * stores in \a aRanks, in increasing order, the ranks of the tracks and vias on
+     * \a aLayer whose shape may be closer than \a aMargin to \a aArea.
+     */
+    void QueryTracks( LAYER_ID aLayer, const EDA_RECT& aArea, int aMargin,
+                      std::vector<int>& aRanks ) const
+    {
+        query( m_layers[aLayer].m_tracks.get(), aArea, aMargin, aRanks );
+    }
+
+    /// Same as QueryTracks(), for the pads.
+    void QueryPads( LAYER_ID aLayer, const EDA_RECT& aArea, int aMargin,
+                    std::vector<int>& aRanks ) const
+    {
+        query( m_layers[aLayer].m_pads.get(), aArea, aMargin, aRanks );
+    }
+
+    /// @return the bounding box of the copper of \a aTrack, a track or a via.
+    static EDA_RECT TrackArea( const TRACK* aTrack );
+
+private:
+    typedef RTree<int, int, 2, float> TREE;
+
+    struct LAYER_TREES
+    {
+        LAYER_TREES() : m_maxTrackClearance( 0 ), m_maxPadClearance( 0 ) {}
+
+        std::unique_ptr<TREE>   m_tracks;
+        std::unique_ptr<TREE>   m_pads;
+        int                     m_maxTrackClearance;
+        int                     m_maxPadClearance;
+    };
+
+    static void insert( TREE& aTree, const EDA_RECT& aArea, int aRank );
+
+    static void query( const TREE* aTree, const EDA_RECT& aArea, int aMargin,
+                       std::vector<int>& aRanks );
+
+    std::vector<TRACK*> m_tracks;
+    std::vector<D_PAD*> m_pads;
+    std::vector<int>    m_trackClearances;
+    std::vector<int>    m_padClearances;
+    LAYER_TREES         m_layers[LAYER_ID_COUNT];
+};
+
+
+DRC_ITEM_INDEX::DRC_ITEM_INDEX( BOARD* aBoard, LSET aLayers, bool aIndexPads )
+{
+    for( LAYER_ID layer : aLayers.Layers() )
+    {
+        m_layers[layer].m_tracks.reset( new TREE );
+
+        if( aIndexPads )
+            m_layers[layer].m_pads.reset( new TREE );
+    }
+
+    for( TRACK* track = aBoard->m_Track; track; track = track->Next() )
+    {
+        int rank = m_tracks.size();
+        int clearance = track->GetClearance( NULL );
+        EDA_RECT area = TrackArea( track );
+
+        m_tracks.push_back( track );
+        m_trackClearances.push_back( clearance );
+
+        for( LAYER_ID layer : aLayers.Layers() )
+        {
+            if( !track->IsOnLayer( layer ) )
+                continue;
+
+            insert( *m_layers[layer].m_tracks, area, rank );
+            m_layers[layer].m_maxTrackClearance =
+                    std::max( m_layers[layer].m_maxTrackClearance, clearance );
+        }
+    }
+
+    if( !aIndexPads )
+        return;
+
+    m_pads = aBoard->GetPads();
+    m_padClearances.reserve( m_pads.size() );
+
+    for( int rank = 0; rank < (int) m_pads.size(); ++rank )
+    {
+        D_PAD* pad = m_pads[rank];
+        int clearance = pad->GetClearance( NULL );
+
+        m_padClearances.push_back( clearance );
+
+        // The extent used by DRC::checkClearanceSegmToPad(), whatever the pad orientation.
+        wxSize halfSize( pad->GetSize().x / 2, pad->GetSize().y / 2 );
+
+        if( pad->GetShape() == PAD_SHAPE_TRAPEZOID )
+        {
+            halfSize.x += std::abs( pad->GetDelta().y ) / 2;
+            halfSize.y += std::abs( pad->GetDelta().x ) / 2;
+        }
+
+        int radius = KiROUND( hypot( halfSize.x, halfSize.y ) ) + 1;
+        EDA_RECT area( pad->ShapePos(), wxSize( 0, 0 ) );
+
+        area.Inflate( radius );
+
+        for( LAYER_ID layer : aLayers.Layers() )
+        {
+            if( !pad->IsOnLayer( layer ) )
+                continue;
+
+            insert( *m_layers[layer].m_pads, area, rank );
+            m_layers[layer].m_maxPadClearance =
+                    std::max( m_layers[layer].m_maxPadClearance, clearance );
+        }
+    }
+}
+
+
+EDA_RECT DRC_ITEM_INDEX::TrackArea( const TRACK* aTrack )
+{
+    EDA_RECT area;
+
+    if( aTrack->Type() == PCB_VIA_T )
+        area = EDA_RECT( aTrack->GetPosition(), wxSize( 0, 0 ) );
+    else
+        area = EDA_RECT( aTrack->GetStart(), wxSize( aTrack->GetEnd() - aTrack->GetStart() ) );
+
+    area.Normalize();
+    area.Inflate( aTrack->GetWidth() / 2 + 1 );
+
+    return area;
+}
+
+
+void DRC_ITEM_INDEX::insert( TREE& aTree, const EDA_RECT& aArea, int aRank )
+{
+    const int mmin[2] = { aArea.GetX(), aArea.GetY() };
+    const int mmax[2] = { aArea.GetRight(), aArea.GetBottom() };
+
+    aTree.Insert( mmin, mmax, aRank );
+}
+
+
+void DRC_ITEM_INDEX::query( const TREE* aTree, const EDA_RECT& aArea, int aMargin,
+                            std::vector<int>& aRanks )
+{
+    if( !aTree )
+        return;
+
+    EDA_RECT area( aArea );
+
+    area.Normalize();
+    area.Inflate( aMargin );
+
+    const int mmin[2] = { area.GetX(), area.GetY() };
+    const int mmax[2] = { area.GetRight(), area.GetBottom() };
+
+    auto visitor = [&aRanks]( int aRank ) -> bool
+    {
+        aRanks.push_back( aRank );
+        return true;
+    };
+
+    // Searching does not modify the tree, it can run concurrently.
+    const_cast<TREE*>( aTree )->Search( mmin, mmax, visitor );
+
+    std::sort( aRanks.begin(), aRanks.end() );
+}
+
 
 void DRC::ShowDRCDialog( wxWindow* aParent )
 {
@@ -184,6 +400,8 @@ int DRC::Drc( ZONE_CONTAINER* aArea, int aCornerIndex )
 
 void DRC::RunTests( wxTextCtrl* aMessages )
 {
+    PROF_ZONE_SCOPE( "DRC::RunTests", "drc" );
+
     // be sure m_pcb is the current board, not a old one
     // ( the board can be reloaded )
     m_pcb = m_pcbEditorFrame->GetBoard();
@@ -628,7 +846,13 @@ void DRC::testZones()
 
 void DRC::testKeepoutAreas()
 {
-    // Test keepout areas for vias, tracks and pads inside keepout areas
+    // Below this number of areas, handing the work over to the scheduler costs more
+    // than it saves.
+    const int minChunkSize = 4;
+
+    std::vector<ZONE_CONTAINER*> keepouts;
+    LSET layers;
+
     for( int ii = 0; ii < m_pcb->GetAreaCount(); ii++ )
     {
         ZONE_CONTAINER* area = m_pcb->GetArea( ii );
@@ -636,55 +860,101 @@ void DRC::testKeepoutAreas()
         if( !area->GetIsKeepout() )
             continue;
 
-        for( TRACK* segm = m_pcb->m_Track; segm != NULL; segm = segm->Next() )
+        if( !area->GetDoNotAllowTracks() && !area->GetDoNotAllowVias() )
+            continue;
+
+        keepouts.push_back( area );
+        layers.set( area->GetLayer() );
+    }
+
+    if( keepouts.empty() )
+        return;
+
+    DRC_ITEM_INDEX index( m_pcb, layers, false );
+    std::vector< std::vector<DRC_HIT> > hits( keepouts.size() );
+    int count = keepouts.size();
+
+    // Test keepout areas for vias, tracks and pads inside keepout areas
+    auto testRange = [&]( int aFirst, int aLast )
+    {
+        std::vector<int> ranks;
+
+        for( int ii = aFirst; ii < aLast; ii++ )
         {
-            if( segm->Type() == PCB_TRACE_T )
-            {
-                if( ! area->GetDoNotAllowTracks()  )
-                    continue;
+            ZONE_CONTAINER* area = keepouts[ii];
 
-                if( segm->GetLayer() != area->GetLayer() )
-                    continue;
+            ranks.clear();
+            index.QueryTracks( area->GetLayer(), area->GetBoundingBox(), 1, ranks );
 
-                if( area->Outline()->Distance( segm->GetStart(), segm->GetEnd(),
-                                               segm->GetWidth() ) == 0 )
-                {
-                    m_currentMarker = fillMarker( segm, NULL,
-                                                  DRCE_TRACK_INSIDE_KEEPOUT, m_currentMarker );
-                    m_pcb->Add( m_currentMarker );
-                    m_pcbEditorFrame->GetGalCanvas()->GetView()->Add( m_currentMarker );
-                    m_currentMarker = 0;
-                }
-            }
-            else if( segm->Type() == PCB_VIA_T )
+            for( int rank : ranks )
             {
-                if( ! area->GetDoNotAllowVias()  )
-                    continue;
+                TRACK* segm = index.Tracks()[rank];
 
-                if( ! ((VIA*)segm)->IsOnLayer( area->GetLayer() ) )
-                    continue;
+                if( segm->Type() == PCB_TRACE_T )
+                {
+                    if( ! area->GetDoNotAllowTracks()  )
+                        continue;
 
-                if( area->Outline()->Distance( segm->GetPosition() ) < segm->GetWidth()/2 )
+                    if( area->Outline()->Distance( segm->GetStart(), segm->GetEnd(),
+                                                   segm->GetWidth() ) == 0 )
+                    {
+                        hits[ii].push_back( { segm, NULL, DRCE_TRACK_INSIDE_KEEPOUT } );
+                    }
+                }
+                else if( segm->Type() == PCB_VIA_T )
                 {
-                    m_currentMarker = fillMarker( segm, NULL,
-                                                  DRCE_VIA_INSIDE_KEEPOUT, m_currentMarker );
-                    m_pcb->Add( m_currentMarker );
-                    m_pcbEditorFrame->GetGalCanvas()->GetView()->Add( m_currentMarker );
-                    m_currentMarker = 0;
+                    if( ! area->GetDoNotAllowVias()  )
+                        continue;
+
+                    if( area->Outline()->Distance( segm->GetPosition() ) < segm->GetWidth()/2 )
+                        hits[ii].push_back( { segm, NULL, DRCE_VIA_INSIDE_KEEPOUT } );
                 }
             }
+            // Test pads: TODO
+        }
+    };
+
+    if( count < 2 * minChunkSize )
+    {
+        testRange( 0, count );
+    }
+    else
+    {
+        TASK_SCHEDULER& scheduler = Pgm().Scheduler();
+        int chunkSize = std::max( minChunkSize, count / ( 4 * scheduler.GetConcurrency() ) + 1 );
+        TASK_GROUP testers( scheduler );
+
+        for( int first = 0;  first < count;  first += chunkSize )
+        {
+            int last = std::min( first + chunkSize, count );
+            testers.Run( [&testRange, first, last]() { testRange( first, last ); } );
+        }
+
+        testers.Wait();
+    }
+
+    for( const std::vector<DRC_HIT>& areaHits : hits )
+    {
+        for( const DRC_HIT& hit : areaHits )
+        {
+            m_currentMarker = fillMarker( hit.m_track, NULL, hit.m_errorCode, m_currentMarker );
+            m_pcb->Add( m_currentMarker );
+            m_pcbEditorFrame->GetGalCanvas()->GetView()->Add( m_currentMarker );
+            m_currentMarker = 0;
         }
-        // Test pads: TODO
     }
 }
 
 
 void DRC::testTexts()
 {
-    std::vector<wxPoint> textShape;      // a buffer to store the text shape (set of segments)
-    std::vector<D_PAD*> padList = m_pcb->GetPads();
+    // Below this number of texts, handing the work over to the scheduler costs more
+    // than it saves.
+    const int minChunkSize = 8;
+
+    std::vector<TEXTE_PCB*> texts;
+    LSET layers;
 
-    // Test text areas for vias, tracks and pads inside text areas
     for( BOARD_ITEM* item = m_pcb->m_Drawings; item; item = item->Next() )
     {
         // Drc test only items on copper layers
@@ -695,114 +965,168 @@ void DRC::testTexts()
         if( item->Type() !=  PCB_TEXT_T )
             continue;
 
-        textShape.clear();
+        texts.push_back( (TEXTE_PCB*) item );
+        layers.set( item->GetLayer() );
+    }
 
-        // So far the bounding box makes up the text-area
-        TEXTE_PCB* text = (TEXTE_PCB*) item;
-        text->TransformTextShapeToSegmentList( textShape );
+    if( texts.empty() )
+        return;
 
-        if( textShape.size() == 0 )     // Should not happen (empty text?)
-            continue;
+    DRC_ITEM_INDEX index( m_pcb, layers, true );
+    std::vector< std::vector<DRC_HIT> > hits( texts.size() );
+    int count = texts.size();
+
+    // The segment to pad test keeps its state in the DRC object, each task has its own.
+    auto testRange = [&]( int aFirst, int aLast )
+    {
+        DRC checker( m_pcbEditorFrame );
+
+        for( int ii = aFirst; ii < aLast; ii++ )
+            checker.doTextDrc( texts[ii], index, hits[ii] );
+    };
+
+    if( count < 2 * minChunkSize )
+    {
+        testRange( 0, count );
+    }
+    else
+    {
+        TASK_SCHEDULER& scheduler = Pgm().Scheduler();
+        int chunkSize = std::max( minChunkSize, count / ( 4 * scheduler.GetConcurrency() ) + 1 );
+        TASK_GROUP testers( scheduler );
 
-        for( TRACK* track = m_pcb->m_Track; track != NULL; track = track->Next() )
+        for( int first = 0;  first < count;  first += chunkSize )
         {
-            if( ! track->IsOnLayer( item->GetLayer() ) )
-                    continue;
+            int last = std::min( first + chunkSize, count );
+            testers.Run( [&testRange, first, last]() { testRange( first, last ); } );
+        }
 
-            // Test the distance between each segment and the current track/via
-            int min_dist = ( track->GetWidth() + text->GetThickness() ) /2 +
-                           track->GetClearance(NULL);
+        testers.Wait();
+    }
 
-            if( track->Type() == PCB_TRACE_T )
+    for( int ii = 0; ii < count; ii++ )
+    {
+        for( const DRC_HIT& hit : hits[ii] )
+        {
+            if( hit.m_track )
+                m_currentMarker = fillMarker( hit.m_track, texts[ii], hit.m_errorCode,
+                                              m_currentMarker );
+            else
+                m_currentMarker = fillMarker( hit.m_pad, texts[ii], hit.m_errorCode,
+                                              m_currentMarker );
+
+            m_pcb->Add( m_currentMarker );
+            m_pcbEditorFrame->GetGalCanvas()->GetView()->Add( m_currentMarker );
+            m_currentMarker = NULL;
+        }
+    }
+}
+
+
+void DRC::doTextDrc( TEXTE_PCB* aText, const DRC_ITEM_INDEX& aIndex, std::vector<DRC_HIT>& aHits )
+{
+    std::vector<wxPoint> textShape;      // a buffer to store the text shape (set of segments)
+    LAYER_ID layer = aText->GetLayer();
+
+    aText->TransformTextShapeToSegmentList( textShape );
+
+    if( textShape.size() == 0 )     // Should not happen (empty text?)
+        return;
+
+    // Only the items closer to the text segments than their clearance can fail.
+    EDA_RECT textArea( textShape[0], wxSize( 0, 0 ) );
+
+    for( const wxPoint& point : textShape )
+        textArea.Merge( point );
+
+    int halfThickness = aText->GetThickness() / 2 + 1;
+    std::vector<int> ranks;
+
+    aIndex.QueryTracks( layer, textArea, halfThickness + aIndex.MaxTrackClearance( layer ), ranks );
+
+    for( int rank : ranks )
+    {
+        TRACK* track = aIndex.Tracks()[rank];
+
+        // Test the distance between each segment and the current track/via
+        int min_dist = ( track->GetWidth() + aText->GetThickness() ) /2 +
+                       aIndex.TrackClearance( rank );
+
+        if( track->Type() == PCB_TRACE_T )
+        {
+            SEG segref( track->GetStart(), track->GetEnd() );
+
+            // Error condition: Distance between text segment and track segment is
+            // smaller than the clearance of the segment
+            for( unsigned jj = 0; jj < textShape.size(); jj += 2 )
             {
-                SEG segref( track->GetStart(), track->GetEnd() );
+                SEG segtest( textShape[jj], textShape[jj+1] );
+                int dist = segref.Distance( segtest );
 
-                // Error condition: Distance between text segment and track segment is
-                // smaller than the clearance of the segment
-                for( unsigned jj = 0; jj < textShape.size(); jj += 2 )
+                if( dist < min_dist )
                 {
-                    SEG segtest( textShape[jj], textShape[jj+1] );
-                    int dist = segref.Distance( segtest );
-
-                    if( dist < min_dist )
-                    {
-                        m_currentMarker = fillMarker( track, text,
-                                                      DRCE_TRACK_INSIDE_TEXT,
-                                                      m_currentMarker );
-                        m_pcb->Add( m_currentMarker );
-                        m_pcbEditorFrame->GetGalCanvas()->GetView()->Add( m_currentMarker );
-                        m_currentMarker = NULL;
-                        break;
-                    }
+                    aHits.push_back( { track, NULL, DRCE_TRACK_INSIDE_TEXT } );
+                    break;
                 }
             }
-            else if( track->Type() == PCB_VIA_T )
+        }
+        else if( track->Type() == PCB_VIA_T )
+        {
+            // Error condition: Distance between text segment and via is
+            // smaller than the clearance of the via
+            for( unsigned jj = 0; jj < textShape.size(); jj += 2 )
             {
-                // Error condition: Distance between text segment and via is
-                // smaller than the clearance of the via
-                for( unsigned jj = 0; jj < textShape.size(); jj += 2 )
-                {
-                    SEG segtest( textShape[jj], textShape[jj+1] );
+                SEG segtest( textShape[jj], textShape[jj+1] );
 
-                    if( segtest.PointCloserThan( track->GetPosition(), min_dist ) )
-                    {
-                        m_currentMarker = fillMarker( track, text,
-                                                      DRCE_VIA_INSIDE_TEXT, m_currentMarker );
-                        m_pcb->Add( m_currentMarker );
-                        m_pcbEditorFrame->GetGalCanvas()->GetView()->Add( m_currentMarker );
-                        m_currentMarker = NULL;
-                        break;
-                    }
+                if( segtest.PointCloserThan( track->GetPosition(), min_dist ) )
+                {
+                    aHits.push_back( { track, NULL, DRCE_VIA_INSIDE_TEXT } );
+                    break;
                 }
             }
         }
+    }
 
-        // Test pads
-        for( unsigned ii = 0; ii < padList.size(); ii++ )
-        {
-            D_PAD* pad = padList[ii];
-
-            if( ! pad->IsOnLayer( item->GetLayer() ) )
-                    continue;
+    // Test pads
+    ranks.clear();
+    aIndex.QueryPads( layer, textArea, halfThickness + aIndex.MaxPadClearance( layer ), ranks );
 
-            wxPoint shape_pos = pad->ShapePos();
+    for( int rank : ranks )
+    {
+        D_PAD* pad = aIndex.Pads()[rank];
+        wxPoint shape_pos = pad->ShapePos();
 
-            for( unsigned jj = 0; jj < textShape.size(); jj += 2 )
+        for( unsigned jj = 0; jj < textShape.size(); jj += 2 )
+        {
+            /* In order to make some calculations more easier or faster,
+             * pads and tracks coordinates will be made relative
+             * to the segment origin
+             */
+            wxPoint origin = textShape[jj];  // origin will be the origin of other coordinates
+            m_segmEnd = textShape[jj+1] - origin;
+            wxPoint delta = m_segmEnd;
+            m_segmAngle = 0;
+
+            // for a non horizontal or vertical segment Compute the segment angle
+            // in tenths of degrees and its length
+            if( delta.x || delta.y )    // delta.x == delta.y == 0 for vias
             {
-                /* In order to make some calculations more easier or faster,
-                 * pads and tracks coordinates will be made relative
-                 * to the segment origin
-                 */
-                wxPoint origin = textShape[jj];  // origin will be the origin of other coordinates
-                m_segmEnd = textShape[jj+1] - origin;
-                wxPoint delta = m_segmEnd;
-                m_segmAngle = 0;
-
-                // for a non horizontal or vertical segment Compute the segment angle
-                // in tenths of degrees and its length
-                if( delta.x || delta.y )    // delta.x == delta.y == 0 for vias
-                {
-                    // Compute the segment angle in 0,1 degrees
-                    m_segmAngle = ArcTangente( delta.y, delta.x );
+                // Compute the segment angle in 0,1 degrees
+                m_segmAngle = ArcTangente( delta.y, delta.x );
 
-                    // Compute the segment length: we build an equivalent rotated segment,
-                    // this segment is horizontal, therefore dx = length
-                    RotatePoint( &delta, m_segmAngle );    // delta.x = length, delta.y = 0
-                }
+                // Compute the segment length: we build an equivalent rotated segment,
+                // this segment is horizontal, therefore dx = length
+                RotatePoint( &delta, m_segmAngle );    // delta.x = length, delta.y = 0
+            }
 
-                m_segmLength = delta.x;
-                m_padToTestPos = shape_pos - origin;
+            m_segmLength = delta.x;
+            m_padToTestPos = shape_pos - origin;
 
-                if( !checkClearanceSegmToPad( pad, text->GetThickness(),
-                                              pad->GetClearance(NULL) ) )
-                {
-                    m_currentMarker = fillMarker( pad, text,
-                                                  DRCE_PAD_INSIDE_TEXT, m_currentMarker );
-                    m_pcb->Add( m_currentMarker );
-                    m_pcbEditorFrame->GetGalCanvas()->GetView()->Add( m_currentMarker );
-                    m_currentMarker = NULL;
-                    break;
-                }
+            if( !checkClearanceSegmToPad( pad, aText->GetThickness(),
+                                          aIndex.PadClearance( rank ) ) )
+            {
+                aHits.push_back( { NULL, pad, DRCE_PAD_INSIDE_TEXT } );
+                break;
             }
         }
     }
@@ -811,6 +1135,9 @@ void DRC::testTexts()
 
 bool DRC::doTrackKeepoutDrc( TRACK* aRefSeg )
 {
+    // An area whose bounding box does not touch the segment or via cannot contain it.
+    EDA_RECT refArea = DRC_ITEM_INDEX::TrackArea( aRefSeg );
+
     // Test keepout areas for vias, tracks and pads inside keepout areas
     for( int ii = 0; ii < m_pcb->GetAreaCount(); ii++ )
     {
@@ -827,6 +1154,9 @@ bool DRC::doTrackKeepoutDrc( TRACK* aRefSeg )
             if( aRefSeg->GetLayer() != area->GetLayer() )
                 continue;
 
+            if( !refArea.Intersects( area->GetBoundingBox() ) )
+                continue;
+
             if( area->Outline()->Distance( aRefSeg->GetStart(), aRefSeg->GetEnd(),
                                            aRefSeg->GetWidth() ) == 0 )
             {
@@ -843,6 +1173,9 @@ bool DRC::doTrackKeepoutDrc( TRACK* aRefSeg )
             if( ! ((VIA*)aRefSeg)->IsOnLayer( area->GetLayer() ) )
                 continue;
 
+            if( !refArea.Intersects( area->GetBoundingBox() ) )
+                continue;
+
             if( area->Outline()->Distance( aRefSeg->GetPosition() ) < aRefSeg->GetWidth()/2 )
             {
                 m_currentMarker = fillMarker( aRefSeg, NULL,
@@ -93,6 +93,9 @@ class TRACK;
 class MARKER_PCB;
 class DRC_ITEM;
 class NETCLASS;
+class TEXTE_PCB;
+class DRC_ITEM_INDEX;
+struct DRC_HIT;
 
 
 /**
@@ -324,6 +327,15 @@ private:
      */
     bool doTrackKeepoutDrc( TRACK* aRefSeg );
 
+    /**
+     * Function doTextDrc
+     * tests the tracks, vias and pads of \a aIndex which are close to \a aText against
+     * the segments of the text shape, and appends the violations to \a aHits, in the
+     * order of the markers.  Only the segment to pad test state of this DRC object is
+     * used, so texts can be tested concurrently by several DRC objects.
+     */
+    void doTextDrc( TEXTE_PCB* aText, const DRC_ITEM_INDEX& aIndex, std::vector<DRC_HIT>& aHits );
+
 
     /**
      * Function doEdgeZoneDrc
@@ -572,10 +572,8 @@ static void CreatePadsShapesSection( FILE* aFile, BOARD* aPcb )
                  fmt_mask( mask ).c_str(),
                  via->GetDrillValue() / SCALE_FACTOR );
 
-        for( LSEQ seq = mask.Seq( gc_seq, DIM( gc_seq ) );  seq;  ++seq )
+        for( LAYER_ID layer : mask.Layers( gc_seq, DIM( gc_seq ) ) )
         {
-            LAYER_ID layer = *seq;
-
             fprintf( aFile, "PAD V%d.%d.%s %s 0 0\n",
                     via->GetWidth(), via->GetDrillValue(),
                     fmt_mask( mask ).c_str(),
@@ -599,10 +597,8 @@ static void CreatePadsShapesSection( FILE* aFile, BOARD* aPcb )
         LSET pad_set = pad->GetLayerSet() & master_layermask;
 
         // the special gc_seq
-        for( LSEQ seq = pad_set.Seq( gc_seq, DIM( gc_seq ) );  seq;  ++seq )
+        for( LAYER_ID layer : pad_set.Layers( gc_seq, DIM( gc_seq ) ) )
         {
-            LAYER_ID layer = *seq;
-
             fprintf( aFile, "PAD P%u %s 0 0\n", i, GenCADLayerName( cu_count, layer ).c_str() );
         }
 
@@ -610,10 +606,8 @@ static void CreatePadsShapesSection( FILE* aFile, BOARD* aPcb )
         fprintf( aFile, "PADSTACK PAD%uF %g\n", i, pad->GetDrillSize().x / SCALE_FACTOR );
 
         // the normal LAYER_ID sequence is inverted from gc_seq[]
-        for( LSEQ seq = pad_set.Seq();  seq;  ++seq )
+        for( LAYER_ID layer : pad_set.Layers() )
         {
-            LAYER_ID layer = *seq;
-
             fprintf( aFile, "PAD P%u %s 0 0\n", i, GenCADLayerNameFlipped( cu_count, layer ).c_str() );
         }
     }
@@ -38,6 +38,7 @@
 #endif
 
 #include <wildcards_and_files_ext.h>
+#include <profile_trace.h>
 
 #define FMT_UNIMPLEMENTED   _( "Plugin '%s' does not implement the '%s' function." )
 #define FMT_NOTFOUND        _( "Plugin type '%s' is not found." )
@@ -229,6 +230,8 @@ IO_MGR::PCB_FILE_T IO_MGR::GuessPluginTypeFromLibPath( const wxString& aLibPath
 BOARD* IO_MGR::Load( PCB_FILE_T aFileType, const wxString& aFileName,
                      BOARD* aAppendToMe, const PROPERTIES* aProperties )
 {
+    PROF_ZONE_SCOPE( "IO_MGR::Load", "load" );
+
     // release the PLUGIN even if an exception is thrown.
     PLUGIN::RELEASER pi( PluginFind( aFileType ) );
 
@@ -28,13 +28,184 @@
 #include <wx/wx.h>
 #include <netlist_lexer.h>  // netlist_lexer is common to Eeschema and Pcbnew
 #include <macros.h>
+#include <hashtables.h>
+#include <pgm_base.h>
+#include <task_scheduler.h>
+#include <profile_trace.h>
 
 #include <pcb_netlist.h>
 #include <netlist_reader.h>
 
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
 using namespace NL_T;
 
 
+/// Netlists smaller than this are not worth splitting for a parallel parse.
+#define PARALLEL_PARSE_MIN_SIZE     ( 64 * 1024 )
+
+/// Fewer components or nets than this per task are not worth a task.
+#define PARALLEL_PARSE_MIN_ITEMS    256
+
+
+/**
+ * Class SECTION_LINE_READER
+ * reads a part of a netlist, numbering its lines from where the part starts in the
+ * whole netlist so that the parse errors give the right location.
+ */
+class SECTION_LINE_READER : public STRING_LINE_READER
+{
+public:
+    SECTION_LINE_READER( const std::string& aText, const wxString& aSource,
+                         unsigned aLinesBefore ) :
+        STRING_LINE_READER( aText, aSource )
+    {
+        lineNum = aLinesBefore;
+    }
+};
+
+
+/// A parenthesized list of the netlist, as located by splitNetlist().
+struct NETLIST_SPAN
+{
+    size_t      m_Start;    ///< offset of the '('
+    size_t      m_End;      ///< offset following the closing ')'
+    unsigned    m_Line;     ///< count of lines before the one holding the '('
+};
+
+
+/// A top level section of the netlist, with the lists it contains.
+struct NETLIST_SECTION : public NETLIST_SPAN
+{
+    std::string                 m_Keyword;
+    std::vector<NETLIST_SPAN>   m_Items;
+};
+
+
+/// @return the keyword following the '(' located at \a aOffset in \a aText.
+static std::string keywordAt( const std::string& aText, size_t aOffset )
+{
+    size_t start = aOffset + 1;
+
+    while( start < aText.size() && isspace( (unsigned char) aText[start] ) )
+        ++start;
+
+    size_t end = start;
+
+    while( end < aText.size() && ( isalnum( (unsigned char) aText[end] ) || aText[end] == '_' ) )
+        ++end;
+
+    return aText.substr( start, end - start );
+}
+
+
+/**
+ * Function splitNetlist
+ * locates the sections of an (export ...) netlist and their components or nets, following
+ * the tokenizing rules of DSNLEXER for quoted strings and comment lines.
+ * @return false if the text is not a single well formed (export ...) list.
+ */
+static bool splitNetlist( const std::string& aText, std::vector<NETLIST_SECTION>& aSections )
+{
+    int      depth = 0;
+    unsigned line = 0;
+    bool     lineStart = true;      // nothing but blanks since the start of the line
+    bool     exportSeen = false;
+    char     prev = ' ';
+
+    for( size_t i = 0; i < aText.size(); ++i )
+    {
+        char c = aText[i];
+
+        if( c == '\n' )
+        {
+            ++line;
+            lineStart = true;
+            prev = c;
+            continue;
+        }
+
+        if( lineStart && c == '#' )
+        {
+            // A comment line
+            while( i + 1 < aText.size() && aText[i + 1] != '\n' )
+                ++i;
+
+            continue;
+        }
+
+        if( !isspace( (unsigned char) c ) )
+            lineStart = false;
+
+        // A quoted string starts a token only, and ends on the same line
+        if( c == '"' && ( isspace( (unsigned char) prev ) || prev == '(' || prev == ')' ) )
+        {
+            for( ++i; i < aText.size() && aText[i] != '"'; ++i )
+            {
+                if( aText[i] == '\n' )
+                    return false;
+
+                if( aText[i] == '\\' && i + 1 < aText.size() && aText[i + 1] != '\n' )
+                    ++i;
+            }
+
+            if( i >= aText.size() )
+                return false;
+
+            prev = c;
+            continue;
+        }
+
+        if( c == '(' )
+        {
+            ++depth;
+
+            if( depth == 1 )
+            {
+                if( exportSeen || keywordAt( aText, i ) != "export" )
+                    return false;
+
+                exportSeen = true;
+            }
+            else if( depth == 2 )
+            {
+                NETLIST_SECTION section;
+
+                section.m_Start = i;
+                section.m_End = 0;
+                section.m_Line = line;
+                section.m_Keyword = keywordAt( aText, i );
+                aSections.push_back( section );
+            }
+            else if( depth == 3 )
+            {
+                NETLIST_SPAN item = { i, 0, line };
+
+                aSections.back().m_Items.push_back( item );
+            }
+        }
+        else if( c == ')' )
+        {
+            if( depth <= 0 )
+                return false;
+
+            if( depth == 2 )
+                aSections.back().m_End = i + 1;
+            else if( depth == 3 )
+                aSections.back().m_Items.back().m_End = i + 1;
+
+            --depth;
+        }
+
+        prev = c;
+    }
+
+    return exportSeen && depth == 0;
+}
+
+
 void KICAD_NETLIST_READER::LoadNetlist() throw ( IO_ERROR, PARSE_ERROR, boost::bad_pointer )
 {
     m_parser->Parse();
@@ -82,6 +253,192 @@ void KICAD_NETLIST_PARSER::skipCurrent() throw( IO_ERROR, PARSE_ERROR )
 
 
 void KICAD_NETLIST_PARSER::Parse() throw( IO_ERROR, PARSE_ERROR, boost::bad_pointer )
+{
+    PROF_ZONE_SCOPE( "KICAD_NETLIST_PARSER::Parse", "netlist" );
+
+    // The lexer reads the lines of the reader as it goes, so none have been read yet.
+    unsigned    linesBefore = m_lineReader->LineNumber();
+    std::string text;
+
+    while( m_lineReader->ReadLine() )
+        text.append( m_lineReader->Line(), m_lineReader->Length() );
+
+    m_nodes.clear();
+    m_libParts.clear();
+
+    if( text.size() < PARALLEL_PARSE_MIN_SIZE
+            || !parseSectionsConcurrently( text, linesBefore ) )
+    {
+        SECTION_LINE_READER reader( text, m_lineReader->GetSource(), linesBefore );
+        KICAD_NETLIST_PARSER parser( &reader, m_netlist );
+
+        parser.parseSections();
+
+        m_nodes.swap( parser.m_nodes );
+        m_libParts.swap( parser.m_libParts );
+    }
+
+    resolveNodes();
+    resolveFootprintFilters();
+
+    m_nodes.clear();
+    m_libParts.clear();
+}
+
+
+bool KICAD_NETLIST_PARSER::parseSectionsConcurrently( const std::string& aText,
+                                                      unsigned aLinesBefore )
+    throw( IO_ERROR, PARSE_ERROR, boost::bad_pointer )
+{
+    std::vector<NETLIST_SECTION> sections;
+
+    if( !splitNetlist( aText, sections ) )
+        return false;
+
+    const wxString& source = m_lineReader->GetSource();
+
+    // Each task parses a piece of a section, rebuilt as a section of its own, with its own
+    // lexer and into its own netlist, so the tasks share nothing.
+    struct PIECE
+    {
+        std::string                     m_Text;
+        unsigned                        m_Line;
+        NETLIST                         m_Netlist;
+        std::vector<NET_NODE>           m_Nodes;
+        std::vector<LIB_PART_FILTERS>   m_LibParts;
+    };
+
+    std::vector< std::unique_ptr<PIECE> > pieces;
+    TASK_SCHEDULER& scheduler = Pgm().Scheduler();
+    unsigned chunkCount = scheduler.GetConcurrency() * 2;
+
+    for( const NETLIST_SECTION& section : sections )
+    {
+        if( section.m_Keyword == "components" || section.m_Keyword == "nets" )
+        {
+            const std::vector<NETLIST_SPAN>& items = section.m_Items;
+            size_t chunkSize = std::max<size_t>( ( items.size() + chunkCount - 1 ) / chunkCount,
+                                                 PARALLEL_PARSE_MIN_ITEMS );
+
+            for( size_t first = 0; first < items.size(); first += chunkSize )
+            {
+                size_t last = std::min( first + chunkSize, items.size() ) - 1;
+
+                pieces.emplace_back( new PIECE );
+                pieces.back()->m_Line = aLinesBefore + items[first].m_Line;
+                pieces.back()->m_Text = "(" + section.m_Keyword + " "
+                        + aText.substr( items[first].m_Start,
+                                        items[last].m_End - items[first].m_Start )
+                        + ")";
+            }
+        }
+        else if( section.m_Keyword == "libparts" )
+        {
+            pieces.emplace_back( new PIECE );
+            pieces.back()->m_Line = aLinesBefore + section.m_Line;
+            pieces.back()->m_Text = aText.substr( section.m_Start,
+                                                  section.m_End - section.m_Start );
+        }
+
+        // Other sections (version, design, libraries) are not used
+    }
+
+    TASK_GROUP parsers( scheduler );
+
+    for( std::unique_ptr<PIECE>& piece : pieces )
+    {
+        PIECE* p = piece.get();
+
+        parsers.Run( [p, &source]()
+        {
+            SECTION_LINE_READER reader( p->m_Text, source, p->m_Line );
+            KICAD_NETLIST_PARSER parser( &reader, &p->m_Netlist );
+
+            parser.parseSections();
+
+            p->m_Nodes.swap( parser.m_nodes );
+            p->m_LibParts.swap( parser.m_libParts );
+        } );
+    }
+
+    parsers.Wait();
+
+    // Merge in file order, the first component of a given reference wins as before.
+    for( std::unique_ptr<PIECE>& piece : pieces )
+    {
+        m_netlist->TransferComponents( piece->m_Netlist );
+        m_nodes.insert( m_nodes.end(), piece->m_Nodes.begin(), piece->m_Nodes.end() );
+        m_libParts.insert( m_libParts.end(), piece->m_LibParts.begin(),
+                           piece->m_LibParts.end() );
+    }
+
+    return true;
+}
+
+
+void KICAD_NETLIST_PARSER::resolveNodes() throw( PARSE_ERROR )
+{
+    for( const NET_NODE& node : m_nodes )
+    {
+        COMPONENT* component = m_netlist->GetComponentByReference( node.m_Reference );
+
+        // Cannot happen if the netlist is valid.
+        if( component == NULL )
+        {
+            wxString msg;
+            msg.Printf( _( "Cannot find component with reference \"%s\" in netlist." ),
+                           GetChars( node.m_Reference ) );
+            THROW_PARSE_ERROR( msg, m_lineReader->GetSource(), "", node.m_LineNumber, 0 );
+        }
+
+        component->AddNet( node.m_Pin, node.m_NetName );
+    }
+}
+
+
+void KICAD_NETLIST_PARSER::resolveFootprintFilters()
+{
+    if( m_libParts.empty() )
+        return;
+
+    // A component is given the filters of the last libpart naming its part, directly or
+    // as an alias.
+    std::unordered_map<wxString, const LIB_PART_FILTERS*, WXSTRING_HASH> parts;
+
+    for( const LIB_PART_FILTERS& libPart : m_libParts )
+    {
+        parts[libPart.m_Library + wxT( "\n" ) + libPart.m_Part] = &libPart;
+
+        for( unsigned ii = 0; ii < libPart.m_Aliases.GetCount(); ii++ )
+            parts[libPart.m_Library + wxT( "\n" ) + libPart.m_Aliases[ii]] = &libPart;
+    }
+
+    unsigned count = m_netlist->GetCount();
+    TASK_GROUP resolvers( Pgm().Scheduler() );
+
+    for( unsigned first = 0; first < count; first += PARALLEL_PARSE_MIN_ITEMS )
+    {
+        unsigned last = std::min( first + PARALLEL_PARSE_MIN_ITEMS, count );
+
+        resolvers.Run( [this, &parts, first, last]()
+        {
+            for( unsigned i = first; i < last; i++ )
+            {
+                COMPONENT* component = m_netlist->GetComponent( i );
+                auto it = parts.find( component->GetLibrary() + wxT( "\n" )
+                                      + component->GetName() );
+
+                if( it != parts.end() )
+                    component->SetFootprintFilters( it->second->m_Filters );
+            }
+        } );
+    }
+
+    resolvers.Wait();
+}
+
+
+void KICAD_NETLIST_PARSER::parseSections() throw( IO_ERROR, PARSE_ERROR, boost::bad_pointer )
 {
     int plevel = 0;     // the count of ')' to read and end of file,
                         // after parsing all sections
@@ -186,7 +543,6 @@ void KICAD_NETLIST_PARSER::parseNet() throw( IO_ERROR, PARSE_ERROR )
      *  (node (ref U9) (pin M6)))
      */
 
-    COMPONENT* component = NULL;
     wxString   code;
     wxString   name;
     wxString   reference;
@@ -244,19 +600,12 @@ void KICAD_NETLIST_PARSER::parseNet() throw( IO_ERROR, PARSE_ERROR )
             }
 
 
-            component = m_netlist->GetComponentByReference( reference );
-
-            // Cannot happen if the netlist is valid.
-            if( component == NULL )
-            {
-                wxString msg;
-                msg.Printf( _( "Cannot find component with reference \"%s\" in netlist." ),
-                               GetChars( reference ) );
-                THROW_PARSE_ERROR( msg, m_lineReader->GetSource(), m_lineReader->Line(),
-                                   m_lineReader->LineNumber(), m_lineReader->Length() );
-            }
-
-            component->AddNet( pin, name );
+            // The components are looked up once the whole netlist is read.
+            m_nodes.push_back( NET_NODE() );
+            m_nodes.back().m_Reference  = reference;
+            m_nodes.back().m_Pin        = pin;
+            m_nodes.back().m_NetName    = name;
+            m_nodes.back().m_LineNumber = m_lineReader->LineNumber();
             nodecount++;
             break;
 
@@ -402,7 +751,6 @@ void KICAD_NETLIST_PARSER::parseLibPartList() throw( IO_ERROR, PARSE_ERROR )
     * Currently footprints section/fp are read and data stored
     * other fields (unused) are skipped
     */
-    COMPONENT*        component = NULL;
     wxString          libName;
     wxString          libPartName;
     wxArrayString     footprintFilters;
@@ -466,19 +814,11 @@ void KICAD_NETLIST_PARSER::parseLibPartList() throw( IO_ERROR, PARSE_ERROR )
         }
     }
 
-    // Find all of the components that reference this component library part definition.
-    for( unsigned i = 0;  i < m_netlist->GetCount();  i++ )
-    {
-        component = m_netlist->GetComponent( i );
-
-        if( component->IsLibSource( libName, libPartName ) )
-            component->SetFootprintFilters( footprintFilters );
-
-        for( unsigned jj = 0; jj < aliases.GetCount(); jj++ )
-        {
-            if( component->IsLibSource( libName, aliases[jj] ) )
-                component->SetFootprintFilters( footprintFilters );
-        }
-
-    }
+    // The components using this library part definition are found once the whole
+    // netlist is read.
+    m_libParts.push_back( LIB_PART_FILTERS() );
+    m_libParts.back().m_Library = libName;
+    m_libParts.back().m_Part    = libPartName;
+    m_libParts.back().m_Aliases = aliases;
+    m_libParts.back().m_Filters = footprintFilters;
 }
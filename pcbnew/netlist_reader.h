@@ -32,6 +32,9 @@
 
 #include <boost/ptr_container/ptr_vector.hpp>
 
+#include <string>
+#include <vector>
+
 #include <fctsys.h>
 #include <macros.h>
 #include <lib_id.h>
@@ -294,10 +297,61 @@ public:
 class KICAD_NETLIST_PARSER : public NETLIST_LEXER
 {
 private:
+    /// A (node (ref U3) (pin 3)) of a net, attached to its component once all are known.
+    struct NET_NODE
+    {
+        wxString    m_Reference;
+        wxString    m_Pin;
+        wxString    m_NetName;
+        int         m_LineNumber;
+    };
+
+    /// The footprint filters of a (libpart ...), given to the components using the part.
+    struct LIB_PART_FILTERS
+    {
+        wxString        m_Library;
+        wxString        m_Part;
+        wxArrayString   m_Aliases;
+        wxArrayString   m_Filters;
+    };
+
     NL_T::T      token;
     LINE_READER* m_lineReader;  ///< The line reader used to parse the netlist.  Not owned.
     NETLIST*     m_netlist;     ///< The netlist to parse into.  Not owned.
 
+    std::vector<NET_NODE>           m_nodes;
+    std::vector<LIB_PART_FILTERS>   m_libParts;
+
+    /**
+     * Function parseSections
+     * reads the sections of the netlist sequentially, from the current position of the lexer.
+     */
+    void parseSections() throw( IO_ERROR, PARSE_ERROR, boost::bad_pointer );
+
+    /**
+     * Function parseSectionsConcurrently
+     * splits \a aText, the whole netlist, in its top level sections and parses the
+     * components, the nets and the libparts sections at the same time, the large ones
+     * in several pieces, each piece with its own lexer.
+     * @param aLinesBefore is the number of lines of the reader preceding \a aText.
+     * @return false if the text does not have the expected (export ...) layout, nothing
+     *         has been parsed then.
+     */
+    bool parseSectionsConcurrently( const std::string& aText, unsigned aLinesBefore )
+        throw( IO_ERROR, PARSE_ERROR, boost::bad_pointer );
+
+    /**
+     * Function resolveNodes
+     * adds the pin to net associations read in the nets section to their components.
+     */
+    void resolveNodes() throw( PARSE_ERROR );
+
+    /**
+     * Function resolveFootprintFilters
+     * gives to each component the footprint filters of its libpart.
+     */
+    void resolveFootprintFilters();
+
     /**
      * Function skipCurrent
      * Skip the current token level, i.e
@@ -325,7 +379,7 @@ private:
      *  (node (ref U3) (pin 3))
      *  (node (ref U9) (pin M6)))
      *
-     * and set the corresponding pads netnames
+     * and stores its nodes, see resolveNodes().
      */
     void parseNet() throw( IO_ERROR, PARSE_ERROR );
 
@@ -346,8 +400,8 @@ private:
      *       (pin (num 1) (name ~) (type passive))
      *       (pin (num 2) (name ~) (type passive))))
      *
-     *  And add the strings giving the footprint filter (subsection footprints)
-     *  of the corresponding module info
+     *  And stores the strings giving the footprint filter (subsection footprints)
+     *  of the corresponding module info, see resolveFootprintFilters()
      *  <p>This section is used by CvPcb, and is not useful in Pcbnew,
      *  therefore it it not always read </p>
      */
@@ -363,7 +417,8 @@ public:
 
     /**
      * Function Parse
-     * parse the full netlist
+     * parse the full netlist.  The lines of the reader are read at once, so that the
+     * large sections can be parsed in parallel.
      */
     void Parse() throw( IO_ERROR, PARSE_ERROR, boost::bad_pointer );
 
@@ -155,40 +155,40 @@ void NETLIST::Format( const char* aDocName, OUTPUTFORMATTER* aOut, int aNestLeve
 void NETLIST::AddComponent( COMPONENT* aComponent )
 {
     m_components.push_back( aComponent );
+
+    // Keep the first one, as a linear search would.
+    m_referenceIndex.insert( std::make_pair( aComponent->GetReference(), aComponent ) );
+    m_timeStampIndex.insert( std::make_pair( aComponent->GetTimeStamp(), aComponent ) );
 }
 
 
-COMPONENT* NETLIST::GetComponentByReference( const wxString& aReference )
+void NETLIST::TransferComponents( NETLIST& aSource )
 {
-    COMPONENT* component = NULL;
-
-    for( unsigned i = 0;  i < m_components.size();  i++ )
+    for( COMPONENT& component : aSource.m_components )
     {
-        if( m_components[i].GetReference() == aReference )
-        {
-            component = &m_components[i];
-            break;
-        }
+        m_referenceIndex.insert( std::make_pair( component.GetReference(), &component ) );
+        m_timeStampIndex.insert( std::make_pair( component.GetTimeStamp(), &component ) );
     }
 
-    return component;
+    m_components.transfer( m_components.end(), aSource.m_components );
+    aSource.m_referenceIndex.clear();
+    aSource.m_timeStampIndex.clear();
 }
 
 
-COMPONENT* NETLIST::GetComponentByTimeStamp( const wxString& aTimeStamp )
+COMPONENT* NETLIST::GetComponentByReference( const wxString& aReference )
 {
-    COMPONENT* component = NULL;
+    COMPONENT_INDEX::const_iterator it = m_referenceIndex.find( aReference );
 
-    for( unsigned i = 0;  i < m_components.size();  i++ )
-    {
-        if( m_components[i].GetTimeStamp() == aTimeStamp )
-        {
-            component = &m_components[i];
-            break;
-        }
-    }
+    return it != m_referenceIndex.end() ? it->second : NULL;
+}
+
+
+COMPONENT* NETLIST::GetComponentByTimeStamp( const wxString& aTimeStamp )
+{
+    COMPONENT_INDEX::const_iterator it = m_timeStampIndex.find( aTimeStamp );
 
-    return component;
+    return it != m_timeStampIndex.end() ? it->second : NULL;
 }
 
 
@@ -32,9 +32,11 @@
 
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <wx/arrstr.h>
+#include <unordered_map>
 
 #include <lib_id.h>
 #include <class_module.h>
+#include <hashtables.h>
 
 
 class REPORTER;
@@ -211,8 +213,14 @@ typedef COMPONENTS::const_iterator     COMPONENTS_CITER;
  */
 class NETLIST
 {
+    typedef std::unordered_map< wxString, COMPONENT*, WXSTRING_HASH > COMPONENT_INDEX;
+
     COMPONENTS         m_components;           ///< Components found in the netlist.
 
+    /// The first component of each reference designator and of each time stamp.
+    COMPONENT_INDEX    m_referenceIndex;
+    COMPONENT_INDEX    m_timeStampIndex;
+
     /// Remove footprints from #BOARD not found in netlist when true.
     bool               m_deleteExtraFootprints;
 
@@ -245,7 +253,12 @@ public:
      * Function Clear
      * removes all components from the netlist.
      */
-    void Clear() { m_components.clear(); }
+    void Clear()
+    {
+        m_components.clear();
+        m_referenceIndex.clear();
+        m_timeStampIndex.clear();
+    }
 
     /**
      * Function GetCount
@@ -273,6 +286,12 @@ public:
      */
     void AddComponent( COMPONENT* aComponent );
 
+    /**
+     * Function TransferComponents
+     * moves all the components of \a aSource to the end of this NETLIST.
+     */
+    void TransferComponents( NETLIST& aSource );
+
     /**
      * Function GetComponentByReference
      * returns a #COMPONENT by \a aReference.
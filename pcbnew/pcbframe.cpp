@@ -62,6 +62,7 @@
 #include <class_track.h>
 #include <class_board.h>
 #include <class_module.h>
+#include <board_change_bus.h>
 #include <worksheet_viewitem.h>
 #include <ratsnest_data.h>
 #include <ratsnest_viewitem.h>
@@ -95,6 +96,62 @@ static const wxString ShowPageLimitsEntry =     "ShowPageLimits";
 ///@}
 
 
+/**
+ * Class PCB_3D_VIEWER_LISTENER
+ * collects the changes of the board, so that the 3D viewer only rebuilds the parts
+ * of its scene which are concerned.
+ */
+class PCB_3D_VIEWER_LISTENER : public BOARD_LISTENER
+{
+public:
+    PCB_3D_VIEWER_LISTENER( PCB_EDIT_FRAME* aFrame ) :
+        m_frame( aFrame ),
+        m_flushQueued( false )
+    {
+    }
+
+    void OnBoardChanged( const BOARD_CHANGE_SET& aChanges ) override
+    {
+        m_pending.Merge( aChanges );
+
+        // Most changes are followed by OnModify(), but not all of them (revert of a
+        // commit for instance)
+        if( !m_flushQueued )
+        {
+            m_flushQueued = true;
+            m_frame->CallAfter( [this]() { Flush(); } );
+        }
+    }
+
+    /**
+     * Function Flush
+     * sends the pending changes to the 3D viewer, if it is open.
+     * @return false if there was no pending change.
+     */
+    bool Flush()
+    {
+        m_flushQueued = false;
+
+        if( m_pending.Empty() )
+            return false;
+
+        EDA_3D_VIEWER* draw3DFrame = m_frame->Get3DViewerFrame();
+
+        if( draw3DFrame )
+            draw3DFrame->ReloadRequest( m_pending );
+
+        m_pending.Clear();
+
+        return true;
+    }
+
+private:
+    PCB_EDIT_FRAME*     m_frame;
+    BOARD_CHANGE_SET    m_pending;
+    bool                m_flushQueued;
+};
+
+
 BEGIN_EVENT_TABLE( PCB_EDIT_FRAME, PCB_BASE_FRAME )
     EVT_SOCKET( ID_EDA_SOCKET_EVENT_SERV, PCB_EDIT_FRAME::OnSockRequestServer )
     EVT_SOCKET( ID_EDA_SOCKET_EVENT, PCB_EDIT_FRAME::OnSockRequest )
@@ -333,6 +390,8 @@ PCB_EDIT_FRAME::PCB_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
 
     m_rotationAngle = 900;
 
+    m_3dViewerListener = new PCB_3D_VIEWER_LISTENER( this );
+
     // Create GAL canvas
     EDA_DRAW_PANEL_GAL* galCanvas = new PCB_DRAW_PANEL_GAL( this, -1, wxPoint( 0, 0 ),
                                                 m_FrameSize, EDA_DRAW_PANEL_GAL::GAL_TYPE_NONE );
@@ -490,14 +549,26 @@ PCB_EDIT_FRAME::PCB_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
 
 PCB_EDIT_FRAME::~PCB_EDIT_FRAME()
 {
+    if( m_Pcb )
+        m_Pcb->GetChangeBus().Unsubscribe( m_3dViewerListener );
+
+    delete m_3dViewerListener;
     delete m_drc;
 }
 
 
 void PCB_EDIT_FRAME::SetBoard( BOARD* aBoard )
 {
+    bool newBoard = ( aBoard != m_Pcb );
+
+    if( newBoard && m_Pcb )
+        m_Pcb->GetChangeBus().Unsubscribe( m_3dViewerListener );
+
     PCB_BASE_EDIT_FRAME::SetBoard( aBoard );
 
+    if( newBoard && aBoard )
+        aBoard->GetChangeBus().Subscribe( m_3dViewerListener );
+
     if( IsGalCanvasActive() )
     {
         aBoard->GetRatsnest()->ProcessBoard();
@@ -972,7 +1043,8 @@ void PCB_EDIT_FRAME::OnModify( )
 
     EDA_3D_VIEWER* draw3DFrame = Get3DViewerFrame();
 
-    if( draw3DFrame )
+    // Changes which were not published on the board change bus need a full reload
+    if( !m_3dViewerListener->Flush() && draw3DFrame )
         draw3DFrame->ReloadRequest();
 }
 
@@ -51,6 +51,7 @@
 #include <pcbnew.h>
 #include <pcbplot.h>
 #include <plot_auxiliary_data.h>
+#include <profile_trace.h>
 
 // Local
 /* Plot a solder mask layer.
@@ -153,6 +154,8 @@ void PlotSilkScreen( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
 void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, LAYER_ID aLayer,
                         const PCB_PLOT_PARAMS& aPlotOpt )
 {
+    PROF_ZONE_SCOPE( "PlotOneBoardLayer", "plot" );
+
     PCB_PLOT_PARAMS plotOpt = aPlotOpt;
     int soldermask_min_thickness = aBoard->GetDesignSettings().m_SolderMaskMinWidth;
 
@@ -28,10 +28,6 @@
  * @brief Class that computes missing connections on a PCB.
  */
 
-#ifdef USE_OPENMP
-#include <omp.h>
-#endif /* USE_OPENMP */
-
 #include <ratsnest_data.h>
 
 #include <class_board.h>
@@ -53,6 +49,10 @@ using namespace std::placeholders;
 #include <profile.h>
 #endif
 
+#include <profile_trace.h>
+#include <pgm_base.h>
+#include <task_scheduler.h>
+
 static uint64_t getDistance( const RN_NODE_PTR& aNode1, const RN_NODE_PTR& aNode2 )
 {
     // Drop the least significant bits to avoid overflow
@@ -1212,6 +1212,8 @@ bool RN_DATA::Update( const BOARD_ITEM* aItem )
 
 void RN_DATA::ProcessBoard()
 {
+    PROF_ZONE_SCOPE( "RN_DATA::ProcessBoard", "ratsnest" );
+
     int netCount = m_board->GetNetCount();
     m_nets.clear();
     m_nets.resize( netCount );
@@ -1264,6 +1266,8 @@ void RN_DATA::ProcessBoard()
 
 void RN_DATA::Recalculate( int aNet )
 {
+    PROF_ZONE_SCOPE( "RN_DATA::Recalculate", "ratsnest" );
+
     unsigned int netCount = m_board->GetNetCount();
 
     if( aNet <= 0 && netCount > 1 )              // Recompute everything
@@ -1273,22 +1277,16 @@ void RN_DATA::Recalculate( int aNet )
     prof_start( &totalRealTime );
 #endif
 
-        unsigned int i;
+        TASK_GROUP updaters( Pgm().Scheduler() );
 
-#ifdef USE_OPENMP
-        #pragma omp parallel shared(netCount) private(i)
-        {
-            #pragma omp for schedule(guided, 1)
-#else /* USE_OPENMP */
+        // Start with net number 1, as 0 stands for not connected
+        for( unsigned int i = 1; i < netCount; ++i )
         {
-#endif
-            // Start with net number 1, as 0 stands for not connected
-            for( i = 1; i < netCount; ++i )
-            {
-                if( m_nets[i].IsDirty() )
-                    updateNet( i );
-            }
-        }  /* end of parallel section */
+            if( m_nets[i].IsDirty() )
+                updaters.Run( [this, i]() { updateNet( i ); } );
+        }
+
+        updaters.Wait();
 #ifdef PROFILE
     prof_end( &totalRealTime );
 
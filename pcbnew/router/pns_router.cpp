@@ -57,6 +57,7 @@
 #include <ratsnest_data.h>
 #include <layers_id_colors_and_visibility.h>
 #include <geometry/convex_hull.h>
+#include <profile_trace.h>
 
 namespace PNS {
 
@@ -132,6 +133,8 @@ const ITEM_SET ROUTER::QueryHoverItems( const VECTOR2I& aP )
 
 bool ROUTER::StartDragging( const VECTOR2I& aP, ITEM* aStartItem )
 {
+    PROF_ZONE_SCOPE( "PNS::ROUTER::StartDragging", "router" );
+
     if( !aStartItem || aStartItem->OfKind( ITEM::SOLID_T ) )
         return false;
 
@@ -153,6 +156,8 @@ bool ROUTER::StartDragging( const VECTOR2I& aP, ITEM* aStartItem )
 
 bool ROUTER::StartRouting( const VECTOR2I& aP, ITEM* aStartItem, int aLayer )
 {
+    PROF_ZONE_SCOPE( "PNS::ROUTER::StartRouting", "router" );
+
     switch( m_mode )
     {
         case PNS_MODE_ROUTE_SINGLE:
@@ -198,6 +203,8 @@ void ROUTER::DisplayItems( const ITEM_SET& aItems )
 
 void ROUTER::Move( const VECTOR2I& aP, ITEM* endItem )
 {
+    PROF_ZONE_SCOPE( "PNS::ROUTER::Move", "router" );
+
     m_currentEnd = aP;
 
     switch( m_state )
@@ -336,6 +343,8 @@ void ROUTER::CommitRouting( NODE* aNode )
 
 bool ROUTER::FixRoute( const VECTOR2I& aP, ITEM* aEndItem )
 {
+    PROF_ZONE_SCOPE( "PNS::ROUTER::FixRoute", "router" );
+
     bool rv = false;
 
     switch( m_state )
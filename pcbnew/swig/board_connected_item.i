@@ -1,7 +1,21 @@
 
+class TRACK;
+class D_PAD;
+%template(TRACK_Vector) std::vector<TRACK*>;
+%template(PAD_Vector)   std::vector<D_PAD*>;
+
 %include class_board_connected_item.h
 
 %{
 #include <class_board_connected_item.h>
 %}
 
+%extend BOARD_CONNECTED_ITEM
+{
+    %pythoncode
+    %{
+    # The connection lists are compact containers in C++, read them as lists.
+    m_TracksConnected = property( lambda self: self.GetTracksConnected() )
+    m_PadsConnected = property( lambda self: self.GetPadsConnected() )
+    %}
+}
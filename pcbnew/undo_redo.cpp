@@ -46,6 +46,7 @@ using namespace std::placeholders;
 #include <class_edge_mod.h>
 
 #include <ratsnest_data.h>
+#include <board_change_bus.h>
 
 #include <tools/selection_tool.h>
 #include <tool/tool_manager.h>
@@ -382,6 +383,7 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
 
     KIGFX::VIEW* view = GetGalCanvas()->GetView();
     RN_DATA* ratsnest = GetBoard()->GetRatsnest();
+    BOARD_CHANGE_SET changes;
 
     // Undo in the reverse order of list creation: (this can allow stacked changes
     // like the same item can be changes and deleted in the same complex command
@@ -483,6 +485,7 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
             ratsnest->Add( item );
             item->ClearFlags();
             item->ViewUpdate( KIGFX::VIEW_ITEM::LAYERS );
+            changes.RecordSwap( item, image );
         }
         break;
 
@@ -498,6 +501,7 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
 
             view->Remove( item );
             item->ViewUpdate( KIGFX::VIEW_ITEM::GEOMETRY );
+            changes.Record( item, CHT_REMOVE );
             break;
 
         case UR_DELETED:    /* deleted items are put in List, as new items */
@@ -512,6 +516,7 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
 
             view->Add( item );
             item->ViewUpdate( KIGFX::VIEW_ITEM::GEOMETRY );
+            changes.Record( item, CHT_ADD );
             build_item_list = true;
             break;
 
@@ -519,6 +524,7 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
             item->Move( aRedoCommand ? aList->m_TransformPoint : -aList->m_TransformPoint );
             item->ViewUpdate( KIGFX::VIEW_ITEM::GEOMETRY );
             ratsnest->Update( item );
+            changes.Record( item, CHT_MODIFY );
             break;
 
         case UR_ROTATED:
@@ -526,6 +532,7 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
                           aRedoCommand ? m_rotationAngle : -m_rotationAngle );
             item->ViewUpdate( KIGFX::VIEW_ITEM::GEOMETRY );
             ratsnest->Update( item );
+            changes.Record( item, CHT_MODIFY );
             break;
 
         case UR_ROTATED_CLOCKWISE:
@@ -533,12 +540,14 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
                           aRedoCommand ? -m_rotationAngle : m_rotationAngle );
             item->ViewUpdate( KIGFX::VIEW_ITEM::GEOMETRY );
             ratsnest->Update( item );
+            changes.Record( item, CHT_MODIFY );
             break;
 
         case UR_FLIPPED:
             item->Flip( aList->m_TransformPoint );
             item->ViewUpdate( KIGFX::VIEW_ITEM::LAYERS );
             ratsnest->Update( item );
+            changes.Record( item, CHT_MODIFY );
             break;
 
         default:
@@ -555,6 +564,8 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
     if( not_found )
         wxMessageBox( wxT( "Incomplete undo/redo operation: some items not found" ) );
 
+    GetBoard()->GetChangeBus().Publish( changes );
+
     // Rebuild pointers and ratsnest that can be changed.
     if( reBuild_ratsnest )
     {
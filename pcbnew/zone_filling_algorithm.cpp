@@ -38,6 +38,7 @@
 
 #include <pcbnew.h>
 #include <zones.h>
+#include <profile_trace.h>
 
 /* Build the filled solid areas data from real outlines (stored in m_Poly)
  * The solid areas can be more than one on copper layers, and do not have holes
@@ -57,6 +58,8 @@
 
 bool ZONE_CONTAINER::BuildFilledSolidAreasPolygons( BOARD* aPcb, SHAPE_POLY_SET* aOutlineBuffer )
 {
+    PROF_ZONE_SCOPE( "ZONE_CONTAINER::BuildFilledSolidAreasPolygons", "zones" );
+
     /* convert outlines + holes to outlines without holes (adding extra segments if necessary)
      * m_Poly data is expected normalized, i.e. NormalizeAreaOutlines was used after building
      * this zone
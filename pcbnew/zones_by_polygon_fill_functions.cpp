@@ -42,6 +42,7 @@
 
 #include <pcbnew.h>
 #include <zones.h>
+#include <profile_trace.h>
 
 #define FORMAT_STRING _( "Filling zone %d out of %d (net %s)..." )
 
@@ -126,6 +127,8 @@ int PCB_EDIT_FRAME::Fill_Zone( ZONE_CONTAINER* aZone )
 
 int PCB_EDIT_FRAME::Fill_All_Zones( wxWindow * aActiveWindow, bool aVerbose )
 {
+    PROF_ZONE_SCOPE( "PCB_EDIT_FRAME::Fill_All_Zones", "zones" );
+
     int errorLevel = 0;
     int areaCount = GetBoard()->GetAreaCount();
     wxBusyCursor dummyCursor;
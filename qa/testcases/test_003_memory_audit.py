@@ -0,0 +1,52 @@
+import unittest
+import pcbnew
+
+
+class TestMemoryAudit(unittest.TestCase):
+
+    def setUp(self):
+        self.pcb = pcbnew.LoadBoard("data/complex_hierarchy.kicad_pcb")
+        self.pad = list(list(self.pcb.GetModules())[0].Pads())[0]
+
+    def test_pad_count(self):
+        audit = pcbnew.BOARD_MEMORY_AUDIT(self.pcb)
+        pads = sum(len(list(module.Pads())) for module in self.pcb.GetModules())
+
+        self.assertEqual(audit.GetCount("PAD"), pads)
+
+    def test_pad_bytes_saved(self):
+        audit = pcbnew.BOARD_MEMORY_AUDIT(self.pcb)
+        used = audit.GetBytes("PAD")
+        saved = audit.GetSavedBytes("PAD")
+
+        # The shared settings and compact connection lists take off at least
+        # a tenth of the memory the pads used when these were stored inline.
+        self.assertGreater(used, 0)
+        self.assertGreaterEqual(saved * 10, used + saved)
+
+    def test_track_bytes_saved(self):
+        audit = pcbnew.BOARD_MEMORY_AUDIT(self.pcb)
+
+        self.assertGreater(audit.GetSavedBytes("TRACK"), 0)
+
+    def test_pad_settings_released(self):
+        pad = self.pad
+        clearance = pad.GetLocalClearance()
+        shared = pcbnew.BOARD_MEMORY_AUDIT(self.pcb).GetCount("<pad settings>")
+
+        pad.SetLocalClearance(clearance + 12345)
+        self.assertEqual(pcbnew.BOARD_MEMORY_AUDIT(self.pcb).GetCount("<pad settings>"),
+                         shared + 1)
+
+        pad.SetLocalClearance(clearance)
+        self.assertEqual(pcbnew.BOARD_MEMORY_AUDIT(self.pcb).GetCount("<pad settings>"),
+                         shared)
+
+    def test_connection_lists(self):
+        pad = self.pad
+
+        self.assertEqual(len(pad.m_PadsConnected), len(pad.GetPadsConnected()))
+        self.assertEqual(len(pad.m_TracksConnected), len(pad.GetTracksConnected()))
+
+if __name__ == '__main__':
+    unittest.main()
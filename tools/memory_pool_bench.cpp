@@ -0,0 +1,171 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Measures what the track arena (MEMORY_POOL_SET, see TRACK::operator new) buys
+ * to the passes walking the DLIST<TRACK>: builds a linked list of track sized
+ * items from the general heap and from the arena, with the other allocations a
+ * board load makes interleaved, then times the creation, walks and destruction.
+ *
+ * Usage: memory_pool_bench [item_count]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <memory_pool.h>
+
+#define DEFAULT_ITEM_COUNT  500000
+#define WALK_COUNT          20
+
+/// About the size of a TRACK, which is mostly EDA_ITEM and BOARD_CONNECTED_ITEM
+#define ITEM_SIZE           192
+
+
+static MEMORY_POOL_SET s_arena;
+
+
+struct HEAP_ITEM
+{
+    HEAP_ITEM*  m_next;
+    HEAP_ITEM*  m_back;
+    int         m_netCode;
+    int         m_width;
+    char        m_payload[ITEM_SIZE - 2 * sizeof( void* ) - 2 * sizeof( int )];
+};
+
+
+struct POOL_ITEM : public HEAP_ITEM
+{
+    static void* operator new( size_t aSize )
+    {
+        return s_arena.Allocate( aSize );
+    }
+
+    static void operator delete( void* aBlock, size_t aSize )
+    {
+        s_arena.Free( aBlock, aSize );
+    }
+};
+
+
+static double elapsedMs( std::chrono::steady_clock::time_point aStart )
+{
+    using namespace std::chrono;
+
+    return duration_cast<microseconds>( steady_clock::now() - aStart ).count() / 1000.0;
+}
+
+
+template <class T>
+static void run( const char* aName, int aCount )
+{
+    using namespace std::chrono;
+
+    // Strings standing for the net names, footprint fields and other small objects
+    // allocated while a board is read.
+    std::vector<std::string*> others;
+    HEAP_ITEM* first = NULL;
+    HEAP_ITEM* last = NULL;
+
+    srand( 1 );
+
+    steady_clock::time_point start = steady_clock::now();
+
+    for( int i = 0; i < aCount; ++i )
+    {
+        T* item = new T;
+
+        item->m_next = NULL;
+        item->m_back = last;
+        item->m_netCode = i / 16;
+        item->m_width = i & 0xFF;
+
+        if( last )
+            last->m_next = item;
+        else
+            first = item;
+
+        last = item;
+
+        others.push_back( new std::string( 24 + rand() % 200, 'x' ) );
+    }
+
+    double createMs = elapsedMs( start );
+
+    // Free half of the other objects, as the temporary ones of a load would be.
+    for( size_t i = 0; i < others.size(); i += 2 )
+    {
+        delete others[i];
+        others[i] = NULL;
+    }
+
+    start = steady_clock::now();
+    long long sum = 0;
+
+    for( int walk = 0; walk < WALK_COUNT; ++walk )
+    {
+        for( HEAP_ITEM* item = first; item; item = item->m_next )
+            sum += item->m_width + item->m_netCode;
+    }
+
+    double walkMs = elapsedMs( start ) / WALK_COUNT;
+
+    start = steady_clock::now();
+
+    for( HEAP_ITEM* item = first; item; )
+    {
+        T* next = static_cast<T*>( item->m_next );
+        delete static_cast<T*>( item );
+        item = next;
+    }
+
+    double deleteMs = elapsedMs( start );
+
+    for( std::string* other : others )
+        delete other;
+
+    printf( "%-6s create %8.2f ms   walk %8.2f ms   delete %8.2f ms   (%lld)\n",
+            aName, createMs, walkMs, deleteMs, sum );
+}
+
+
+int main( int argc, char** argv )
+{
+    int count = argc > 1 ? atoi( argv[1] ) : DEFAULT_ITEM_COUNT;
+
+    printf( "%d items of %u bytes, walks averaged over %d runs\n",
+            count, (unsigned) sizeof( POOL_ITEM ), WALK_COUNT );
+
+    run<HEAP_ITEM>( "heap", count );
+    run<POOL_ITEM>( "arena", count );
+    run<HEAP_ITEM>( "heap", count );
+    run<POOL_ITEM>( "arena", count );
+
+    printf( "arena reserved: %u KiB\n", (unsigned) ( s_arena.GetReservedBytes() / 1024 ) );
+
+    return 0;
+}
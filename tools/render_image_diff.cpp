@@ -0,0 +1,162 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+/**
+ * Compares two renders of the same board and view, e.g. a final quality raytracing
+ * render saved with the 3D viewer screenshot command before and after a change of
+ * the renderer.  A pixel differs when one of its channels differs by more than the
+ * pixel threshold; the comparison fails when more than the given percentage of
+ * pixels differ.  The raytracer uses random samples, so two renders made with the
+ * same code are not bit identical either: the default thresholds allow for this.
+ *
+ * When a diff image name is given, the differences are written to it, amplified,
+ * as a grey level image.
+ *
+ * Usage: render_image_diff reference_image new_image [pixel_threshold [max_percent [diff_image]]]
+ *
+ * Returns 0 when the images match, 1 when they differ and 2 on errors.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#include <wx/init.h>
+#include <wx/image.h>
+
+#define DEFAULT_PIXEL_THRESHOLD     16      // over 255
+#define DEFAULT_MAX_PERCENT         1.0
+
+/// Amplification of the differences written to the diff image
+#define DIFF_IMAGE_GAIN             8
+
+
+int main( int argc, char** argv )
+{
+    if( argc < 3 )
+    {
+        printf( "Usage: render_image_diff reference_image new_image "
+                "[pixel_threshold [max_percent [diff_image]]]\n" );
+        return 2;
+    }
+
+    wxInitializer initializer;
+
+    if( !initializer.IsOk() )
+    {
+        printf( "Cannot initialize wxWidgets\n" );
+        return 2;
+    }
+
+    wxInitAllImageHandlers();
+
+    int     pixelThreshold = argc > 3 ? atoi( argv[3] ) : DEFAULT_PIXEL_THRESHOLD;
+    double  maxPercent = argc > 4 ? atof( argv[4] ) : DEFAULT_MAX_PERCENT;
+
+    wxImage reference;
+    wxImage render;
+
+    if( !reference.LoadFile( wxString::FromUTF8( argv[1] ) ) )
+    {
+        printf( "Cannot read %s\n", argv[1] );
+        return 2;
+    }
+
+    if( !render.LoadFile( wxString::FromUTF8( argv[2] ) ) )
+    {
+        printf( "Cannot read %s\n", argv[2] );
+        return 2;
+    }
+
+    if( reference.GetWidth() != render.GetWidth()
+        || reference.GetHeight() != render.GetHeight() )
+    {
+        printf( "The image sizes differ: %dx%d and %dx%d\n",
+                reference.GetWidth(), reference.GetHeight(),
+                render.GetWidth(), render.GetHeight() );
+        return 1;
+    }
+
+    const int       width = reference.GetWidth();
+    const int       height = reference.GetHeight();
+    const long      pixelCount = (long) width * height;
+    const unsigned char* refData = reference.GetData();
+    const unsigned char* newData = render.GetData();
+
+    wxImage         diffImage;
+    unsigned char*  diffData = NULL;
+
+    if( argc > 5 )
+    {
+        diffImage.Create( width, height, false );
+        diffData = diffImage.GetData();
+    }
+
+    long    differingPixels = 0;
+    int     maxDiff = 0;
+    double  sumDiff = 0.0;
+
+    for( long ii = 0; ii < pixelCount; ++ii )
+    {
+        int diff = 0;
+
+        for( int channel = 0; channel < 3; ++channel )
+            diff = std::max( diff, abs( refData[ii * 3 + channel] - newData[ii * 3 + channel] ) );
+
+        if( diff > pixelThreshold )
+            differingPixels++;
+
+        maxDiff = std::max( maxDiff, diff );
+        sumDiff += diff;
+
+        if( diffData )
+        {
+            unsigned char level = (unsigned char) std::min( diff * DIFF_IMAGE_GAIN, 255 );
+
+            diffData[ii * 3] = diffData[ii * 3 + 1] = diffData[ii * 3 + 2] = level;
+        }
+    }
+
+    if( diffData && !diffImage.SaveFile( wxString::FromUTF8( argv[5] ), wxBITMAP_TYPE_PNG ) )
+    {
+        printf( "Cannot write %s\n", argv[5] );
+        return 2;
+    }
+
+    double percent = pixelCount ? 100.0 * differingPixels / pixelCount : 0.0;
+
+    printf( "%dx%d pixels, mean difference %.3f, max difference %d, "
+            "%ld pixels (%.3f%%) differ by more than %d\n",
+            width, height, pixelCount ? sumDiff / pixelCount : 0.0, maxDiff,
+            differingPixels, percent, pixelThreshold );
+
+    if( percent > maxPercent )
+    {
+        printf( "FAILED: more than %.3f%% of the pixels differ\n", maxPercent );
+        return 1;
+    }
+
+    printf( "render_image_diff: ok\n" );
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Checks the undo records of SCH_SCREEN::SchematicCleanUp(): draws wires the way
+ * SCH_EDIT_FRAME::EndSegment() does, lets the clean up merge them with an existing
+ * wire, then undoes and redoes the command with SCH_SCREEN::PutDataInPreviousState(), the
+ * code of the undo and redo commands of the schematic editor.
+ *
+ * Usage: sch_cleanup_undo_test
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <set>
+
+#include <fctsys.h>
+#include <general.h>
+#include <class_sch_screen.h>
+#include <class_undoredo_container.h>
+#include <sch_line.h>
+
+
+static int failures = 0;
+
+
+static void check( bool aCondition, const char* aWhat )
+{
+    if( !aCondition )
+    {
+        printf( "FAILED: %s\n", aWhat );
+        failures++;
+    }
+}
+
+
+static SCH_LINE* newWire( int aStartX, int aEndX )
+{
+    SCH_LINE* wire = new SCH_LINE( wxPoint( aStartX, 0 ), LAYER_WIRE );
+
+    wire->SetEndPoint( wxPoint( aEndX, 0 ) );
+    return wire;
+}
+
+
+/**
+ * Checks that the screen holds exactly the horizontal wires given by their ends.
+ */
+static bool hasWires( SCH_SCREEN& aScreen, const std::set< std::pair<int, int> >& aWires )
+{
+    std::set< std::pair<int, int> > found;
+    int count = 0;
+
+    for( SCH_ITEM* item = aScreen.GetDrawItems(); item; item = item->Next() )
+    {
+        if( item->Type() != SCH_LINE_T )
+            continue;
+
+        SCH_LINE* wire = (SCH_LINE*) item;
+        int startX = std::min( wire->GetStartPoint().x, wire->GetEndPoint().x );
+        int endX = std::max( wire->GetStartPoint().x, wire->GetEndPoint().x );
+
+        found.insert( std::make_pair( startX, endX ) );
+        count++;
+    }
+
+    return count == (int) aWires.size() && found == aWires;
+}
+
+
+int main( int argc, char** argv )
+{
+    SCH_SCREEN screen( NULL );
+
+    // The existing wire.
+    screen.Append( newWire( 0, 100 ) );
+
+    // The drawn segment, in two collinear parts.
+    DLIST<SCH_ITEM> wires;
+    PICKED_ITEMS_LIST itemList;
+
+    wires.PushBack( newWire( 100, 150 ) );
+    wires.PushBack( newWire( 150, 200 ) );
+
+    for( SCH_ITEM* wire = wires.begin(); wire; wire = wire->Next() )
+        itemList.PushItem( ITEM_PICKER( wire, UR_NEW ) );
+
+    screen.Append( wires );
+    screen.SchematicCleanUp( &itemList );
+
+    check( hasWires( screen, { { 0, 200 } } ), "the wires are merged" );
+
+    std::set<EDA_ITEM*> recorded;
+
+    for( unsigned ii = 0; ii < itemList.GetCount(); ii++ )
+        recorded.insert( itemList.GetPickedItem( ii ) );
+
+    check( recorded.size() == itemList.GetCount(), "every item is recorded once" );
+
+    screen.PutDataInPreviousState( &itemList, false );
+    check( hasWires( screen, { { 0, 100 } } ), "undo restores the existing wire" );
+
+    screen.PutDataInPreviousState( &itemList, true );
+    check( hasWires( screen, { { 0, 200 } } ), "redo restores the merged wire" );
+
+    // The command is done: the undo list owns the copies and the deleted items.
+    for( unsigned ii = 0; ii < itemList.GetCount(); ii++ )
+    {
+        if( itemList.GetPickedItemStatus( ii ) == UR_CHANGED )
+            delete itemList.GetPickedItemLink( ii );
+        else if( itemList.GetPickedItemStatus( ii ) == UR_DELETED )
+            delete itemList.GetPickedItem( ii );
+    }
+
+    if( failures )
+        return 1;
+
+    printf( "sch_cleanup_undo_test: ok\n" );
+    return 0;
+}
@@ -0,0 +1,476 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Replays an event stream through TOOL_DISPATCHER, the way the canvas feeds it
+ * with wx events, and reports the dispatch cost.
+ *
+ * Usage: tool_dispatch_bench [events_file]
+ *
+ * The events file is in the TOOL_EVENT_RECORDER format, so a real session can be
+ * captured by running pcbnew with KICAD_RECORD_TOOL_EVENTS=<events_file> set.
+ * Without a file, a stream dominated by mouse motion is synthesized.
+ *
+ * The dispatcher reads the cursor position and the mouse buttons from the system,
+ * so mouse events are replayed as motion, made visible to the dispatcher by panning
+ * the view.  Keyboard events go through the hot keys of the bench actions.  Named
+ * commands are run by name with TOOL_MANAGER::RunAction(), as menus do.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <wx/app.h>
+#include <wx/init.h>
+
+#include <common.h>
+#include <pgm_base.h>
+#include <kiface_i.h>
+#include <draw_frame.h>
+#include <class_draw_panel_gal.h>
+#include <class_page_info.h>
+#include <class_title_block.h>
+#include <tool/tool_manager.h>
+#include <tool/tool_dispatcher.h>
+#include <tool/tool_interactive.h>
+#include <tool/tool_event_recorder.h>
+#include <tools/common_actions.h>
+
+#define TOOL_COUNT          40
+#define ACTIVE_TOOL_COUNT   8
+#define ACTIONS_PER_TOOL    25
+#define SYNTHETIC_EVENTS    200000
+#define REPEAT_COUNT        10
+
+
+static std::string toolName( int aTool )
+{
+    char buf[64];
+
+    sprintf( buf, "bench.Tool%d", aTool );
+    return buf;
+}
+
+
+static std::string actionName( int aTool, int aAction )
+{
+    char buf[64];
+
+    sprintf( buf, "bench.Tool%d.action%d", aTool, aAction );
+    return buf;
+}
+
+
+/**
+ * A tool waiting for many commands, like the real pcbnew tools do.  Once activated,
+ * it waits for clicks, so the active tools get their share of the replayed events.
+ */
+class BENCH_TOOL_BASE : public TOOL_INTERACTIVE
+{
+public:
+    BENCH_TOOL_BASE( int aIndex ) :
+        TOOL_INTERACTIVE( toolName( aIndex ) ),
+        m_index( aIndex )
+    {
+    }
+
+    void Reset( RESET_REASON aReason ) override
+    {
+    }
+
+    void SetTransitions() override
+    {
+        Go( &BENCH_TOOL_BASE::main, TOOL_EVENT( TC_COMMAND, TA_ACTIVATE, GetName() ) );
+
+        for( int i = 0; i < ACTIONS_PER_TOOL; ++i )
+            Go( &BENCH_TOOL_BASE::handler, TOOL_EVENT( TC_COMMAND, TA_ACTION, actionName( m_index, i ) ) );
+
+        Go( &BENCH_TOOL_BASE::handler, TOOL_EVENT( TC_MESSAGE, TA_ANY, GetName() + ".message" ) );
+    }
+
+    int main( const TOOL_EVENT& aEvent )
+    {
+        while( OPT_TOOL_EVENT evt = Wait( TOOL_EVENT( TC_MOUSE, TA_MOUSE_CLICK, BUT_ANY ) ||
+                                          TOOL_EVENT( TC_COMMAND, TA_ANY, GetName() + ".stop" ) ) )
+        {
+            if( evt->Category() == TC_COMMAND )     // the stop command
+                break;
+        }
+
+        return 0;
+    }
+
+    int handler( const TOOL_EVENT& aEvent )
+    {
+        return 0;
+    }
+
+private:
+    int m_index;
+};
+
+
+/**
+ * TOOL_MANAGER::RegisterTool() expects every tool to be of its own type.
+ */
+template<int N>
+class BENCH_TOOL : public BENCH_TOOL_BASE
+{
+public:
+    BENCH_TOOL() :
+        BENCH_TOOL_BASE( N )
+    {
+    }
+};
+
+
+template<int N>
+struct REGISTER_TOOLS
+{
+    static void Run( TOOL_MANAGER& aToolMgr )
+    {
+        REGISTER_TOOLS<N - 1>::Run( aToolMgr );
+        aToolMgr.RegisterTool( new BENCH_TOOL<N - 1>() );
+    }
+};
+
+
+template<>
+struct REGISTER_TOOLS<0>
+{
+    static void Run( TOOL_MANAGER& aToolMgr )
+    {
+    }
+};
+
+
+/**
+ * The smallest frame the TOOL_MANAGER can work with: a hidden frame holding a GAL
+ * canvas with the stub GAL.
+ */
+class BENCH_FRAME : public EDA_DRAW_FRAME
+{
+public:
+    BENCH_FRAME() :
+        EDA_DRAW_FRAME( NULL, NULL, FRAME_PCB, wxT( "tool_dispatch_bench" ),
+                        wxDefaultPosition, wxDefaultSize, wxDEFAULT_FRAME_STYLE,
+                        wxT( "BenchFrame" ) )
+    {
+        SetGalCanvas( new EDA_DRAW_PANEL_GAL( this, -1, wxPoint( 0, 0 ), m_FrameSize,
+                                              EDA_DRAW_PANEL_GAL::GAL_TYPE_NONE ) );
+    }
+
+    void SetPageSettings( const PAGE_INFO& aPageSettings ) override { m_page = aPageSettings; }
+    const PAGE_INFO& GetPageSettings() const override { return m_page; }
+    const wxSize GetPageSizeIU() const override { return m_page.GetSizeMils(); }
+    const wxPoint& GetAuxOrigin() const override { return m_origin; }
+    void SetAuxOrigin( const wxPoint& aPosition ) override {}
+    const wxPoint& GetGridOrigin() const override { return m_origin; }
+    void SetGridOrigin( const wxPoint& aPosition ) override {}
+    const TITLE_BLOCK& GetTitleBlock() const override { return m_titleBlock; }
+    void SetTitleBlock( const TITLE_BLOCK& aTitleBlock ) override {}
+    EDA_HOTKEY* GetHotKeyDescription( int aCommand ) const override { return NULL; }
+    void ReCreateHToolbar() override {}
+    void ReCreateVToolbar() override {}
+    double BestZoom() override { return 1.0; }
+    void RedrawActiveWindow( wxDC* DC, bool EraseBg ) override {}
+    void OnLeftClick( wxDC* DC, const wxPoint& MousePos ) override {}
+    bool OnRightClick( const wxPoint& MousePos, wxMenu* PopMenu ) override { return false; }
+
+private:
+    PAGE_INFO   m_page;
+    TITLE_BLOCK m_titleBlock;
+    wxPoint     m_origin;
+};
+
+
+// The frame and the canvas need a program and a kiface, none of them is configured.
+static struct BENCH_KIFACE : public KIFACE_I
+{
+    BENCH_KIFACE() :
+        KIFACE_I( "tool_dispatch_bench", KIWAY::FACE_PCB )
+    {
+    }
+
+    bool OnKifaceStart( PGM_BASE* aProgram, int aCtlBits ) override
+    {
+        return true;
+    }
+
+    wxWindow* CreateWindow( wxWindow* aParent, int aClassId, KIWAY* aKiway,
+                            int aCtlBits = 0 ) override
+    {
+        return NULL;
+    }
+
+    void* IfaceOrAddress( int aDataId ) override
+    {
+        return NULL;
+    }
+} kiface;
+
+
+static struct BENCH_PGM : public PGM_BASE
+{
+    bool OnPgmInit() override
+    {
+        return true;
+    }
+
+    void OnPgmExit() override
+    {
+    }
+
+    void MacOpenFile( const wxString& aFileName ) override
+    {
+    }
+} program;
+
+
+KIFACE_I& Kiface()
+{
+    return kiface;
+}
+
+
+PGM_BASE& Pgm()
+{
+    return program;
+}
+
+
+// TOOL_DISPATCHER::DispatchWxCommand() translates the menu IDs of pcbnew, which
+// is not linked in.
+boost::optional<TOOL_EVENT> COMMON_ACTIONS::TranslateLegacyId( int aId )
+{
+    return boost::optional<TOOL_EVENT>();
+}
+
+
+/**
+ * Creates the TOOL_ACTIONs of the bench tools, which the TOOL_MANAGERs created
+ * afterwards register.  The actions of the first tool, which is active, get the
+ * hot keys 'A', 'B'...
+ */
+static void createActions( std::vector<std::unique_ptr<TOOL_ACTION>>& aActions,
+                           std::set<std::string>& aNames )
+{
+    for( int tool = 0; tool < TOOL_COUNT; ++tool )
+    {
+        for( int i = 0; i < ACTIONS_PER_TOOL; ++i )
+        {
+            int hotkey = ( tool == 0 && i < 26 ) ? 'A' + i : 0;
+
+            aActions.emplace_back( new TOOL_ACTION( actionName( tool, i ), AS_CONTEXT, hotkey ) );
+            aNames.insert( actionName( tool, i ) );
+        }
+    }
+}
+
+
+/**
+ * Feeds \a aEvent to the dispatcher as the wx event it comes from, or runs it
+ * as a command.
+ */
+static void dispatch( TOOL_DISPATCHER& aDispatcher, TOOL_MANAGER& aToolMgr, KIGFX::VIEW* aView,
+                      const std::set<std::string>& aActionNames, const TOOL_EVENT& aEvent )
+{
+    switch( aEvent.Category() )
+    {
+    case TC_MOUSE:
+    {
+        aView->SetCenter( aView->GetCenter() + VECTOR2D( 1.0, 0.0 ) );
+
+        wxMouseEvent event( wxEVT_MOTION );
+        aDispatcher.DispatchWxEvent( event );
+        break;
+    }
+
+    case TC_KEYBOARD:
+    {
+        wxKeyEvent event( wxEVT_CHAR );
+        event.m_keyCode = aEvent.KeyCode();
+        event.SetControlDown( aEvent.Modifier( MD_CTRL ) );
+        event.SetAltDown( aEvent.Modifier( MD_ALT ) );
+        event.SetShiftDown( aEvent.Modifier( MD_SHIFT ) );
+        aDispatcher.DispatchWxEvent( event );
+        break;
+    }
+
+    default:
+        if( aEvent.IsCancel() )
+        {
+            wxKeyEvent event( wxEVT_CHAR );
+            event.m_keyCode = WXK_ESCAPE;
+            aDispatcher.DispatchWxEvent( event );
+        }
+        else if( aEvent.GetCommandStr() && aActionNames.count( *aEvent.GetCommandStr() ) )
+        {
+            aToolMgr.RunAction( *aEvent.GetCommandStr(), true );
+        }
+        else
+        {
+            // Commands without an action, like the ones posted by the tools themselves.
+            aToolMgr.ProcessEvent( aEvent );
+        }
+        break;
+    }
+}
+
+
+static bool loadEvents( const char* aFileName, std::vector<TOOL_EVENT>& aEvents )
+{
+    std::ifstream in( aFileName );
+
+    if( !in.is_open() )
+        return false;
+
+    std::string line;
+    TOOL_EVENT event;
+
+    while( std::getline( in, line ) )
+    {
+        if( TOOL_EVENT_RECORDER::Parse( line, event ) )
+            aEvents.push_back( event );
+    }
+
+    return true;
+}
+
+
+static void synthesizeEvents( std::vector<TOOL_EVENT>& aEvents )
+{
+    for( int i = 0; i < SYNTHETIC_EVENTS; ++i )
+    {
+        int kind = i % 100;
+
+        if( kind < 85 )
+            aEvents.push_back( TOOL_EVENT( TC_MOUSE, TA_MOUSE_MOTION, BUT_NONE ) );
+        else if( kind < 92 )
+            aEvents.push_back( TOOL_EVENT( TC_MOUSE, TA_MOUSE_DRAG, BUT_LEFT ) );
+        else if( kind < 93 )
+            aEvents.push_back( TOOL_EVENT( TC_MOUSE, TA_MOUSE_CLICK, BUT_LEFT ) );
+        else if( kind < 97 )
+            aEvents.push_back( TOOL_EVENT( TC_KEYBOARD, TA_KEY_PRESSED, 'A' + kind % 26 ) );
+        else if( kind < 99 )
+            aEvents.push_back( TOOL_EVENT( TC_COMMAND, TA_ACTION, "bench.unknown" ) );
+        else
+            aEvents.push_back( TOOL_EVENT( TC_COMMAND, TA_ACTION,
+                                           actionName( TOOL_COUNT - 1, i % ACTIONS_PER_TOOL ) ) );
+    }
+}
+
+
+static void runBench( BENCH_FRAME* aFrame, const std::vector<TOOL_EVENT>& aEvents,
+                      const std::set<std::string>& aActionNames )
+{
+    EDA_DRAW_PANEL_GAL* canvas = aFrame->GetGalCanvas();
+    KIGFX::VIEW* view = canvas->GetView();
+    TOOL_MANAGER toolMgr;
+
+    toolMgr.SetEnvironment( NULL, view, canvas->GetViewControls(), aFrame );
+
+    TOOL_DISPATCHER dispatcher( &toolMgr );
+
+    REGISTER_TOOLS<TOOL_COUNT>::Run( toolMgr );
+    toolMgr.ResetTools( TOOL_BASE::RUN );
+
+    for( int i = 0; i < ACTIVE_TOOL_COUNT; ++i )
+        toolMgr.InvokeTool( toolName( i ) );
+
+    // Warm up, then measure.
+    for( const TOOL_EVENT& event : aEvents )
+        dispatch( dispatcher, toolMgr, view, aActionNames, event );
+
+    unsigned start = GetRunningMicroSecs();
+
+    for( int r = 0; r < REPEAT_COUNT; ++r )
+    {
+        for( const TOOL_EVENT& event : aEvents )
+            dispatch( dispatcher, toolMgr, view, aActionNames, event );
+    }
+
+    unsigned stop = GetRunningMicroSecs();
+    double total = (double) aEvents.size() * REPEAT_COUNT;
+
+    printf( "%d tools (%d active), %d transitions each, %u events x %d\n",
+            TOOL_COUNT, ACTIVE_TOOL_COUNT, ACTIONS_PER_TOOL + 2,
+            (unsigned) aEvents.size(), REPEAT_COUNT );
+    printf( "dispatch: %u usecs total, %.3f usecs per event\n",
+            stop - start, ( stop - start ) / total );
+
+    // Let the active tools finish before the manager goes away.
+    for( int i = 0; i < ACTIVE_TOOL_COUNT; ++i )
+        toolMgr.ProcessEvent( TOOL_EVENT( TC_COMMAND, TA_ACTION, toolName( i ) + ".stop" ) );
+}
+
+
+int main( int argc, char** argv )
+{
+    std::vector<TOOL_EVENT> events;
+
+    if( argc > 1 )
+    {
+        if( !loadEvents( argv[1], events ) )
+        {
+            fprintf( stderr, "cannot read %s\n", argv[1] );
+            return 1;
+        }
+    }
+    else
+    {
+        synthesizeEvents( events );
+    }
+
+    if( events.empty() )
+    {
+        fprintf( stderr, "no events to replay\n" );
+        return 1;
+    }
+
+    wxApp::SetInstance( new wxApp() );
+
+    if( !wxEntryStart( argc, argv ) )
+    {
+        fprintf( stderr, "cannot initialize wxWidgets\n" );
+        return 1;
+    }
+
+    std::vector<std::unique_ptr<TOOL_ACTION>> actions;
+    std::set<std::string> actionNames;
+
+    createActions( actions, actionNames );
+
+    BENCH_FRAME* frame = new BENCH_FRAME();
+
+    runBench( frame, events, actionNames );
+
+    delete frame;
+    wxEntryCleanup();
+
+    return 0;
+}